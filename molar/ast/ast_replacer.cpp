@@ -57,6 +57,14 @@ namespace molar::ast {
         return true;
     }
 
+    bool details::ReplaceVisitor::visit_arrow_access(class ArrowAccess& expression) {
+        expression.get_lhs() =
+            std::move(this->visitor.replace(std::move(expression.get_lhs())));
+        expression.get_rhs() =
+            std::move(this->visitor.replace(std::move(expression.get_rhs())));
+        return true;
+    }
+
     bool details::ReplaceVisitor::visit_loop(class LoopExpression& expression) {
         expression.get_count_expression() =
             std::move(this->visitor.replace(std::move(expression.get_count_expression())));
@@ -32,6 +32,8 @@ namespace molar::ast {
 
             bool visit_array_access(class ArrayAccess& expression) override;
 
+            bool visit_arrow_access(class ArrowAccess& expression) override;
+
             bool visit_loop(class LoopExpression& expression) override;
 
             bool visit_for_each(class ForEachExpression& expression) override;
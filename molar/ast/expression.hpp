@@ -43,7 +43,11 @@ namespace molar::ast {
         PreAllocatedVariableReference,
         PreAllocatedAssignment,
         PreAllocatedCall,
-        PreAllocatedForLoop
+        PreAllocatedForLoop,
+        PreAllocatedString,
+        PreAllocatedArrayAccess,
+        SelectExpression,
+        FusedExpression
     };
 
     std::string ast_kind_to_string(const AstKind kind);
@@ -13,6 +13,9 @@ namespace molar::ast {
     public:
         BoolLiteral(const Token& token, const molar_impl::SourceBuffer& buffer);
 
+        BoolLiteral(const size_t position, const size_t size, const bool value)
+            : Expression(position, size, AstKind::BooleanLiteral), VariableManager(value) {}
+
         ~BoolLiteral() override = default;
 
         void print(std::ostream& out, const uint32_t index) override;
@@ -35,6 +38,9 @@ namespace molar::ast {
     public:
         NumericLiteral(const Token& token, const molar_impl::SourceBuffer& buffer);
 
+        NumericLiteral(const size_t position, const size_t size, const float value)
+            : Expression(position, size, AstKind::NumericLiteral), VariableManager(value) {}
+
         ~NumericLiteral() override = default;
 
         void print(std::ostream& out, const uint32_t index) override;
@@ -52,6 +58,11 @@ namespace molar::ast {
 
         IdentifierLiteral() = default;
 
+        IdentifierLiteral(const size_t position, const size_t size, std::string value)
+            : Expression(position, size, AstKind::IdentifierLiteral) {
+            this->value = std::move(value);
+        }
+
         void print(std::ostream& out, const uint32_t index) override;
 
         void visit_node(class AstVisitor& visitor) override;
@@ -0,0 +1,414 @@
+//
+// Created by Akashic on 10/19/2026.
+//
+
+#include "definite_assignment.hpp"
+
+#include "execution/passes/processed_tree.hpp"
+
+namespace molar::exec {
+    using namespace molar::ast;
+    using molar::details::type_asserted_cast;
+
+    namespace {
+        ///@brief Which slots are set on every path reaching a point. An unreachable state is
+        /// the identity of meet, it's what a `break` target starts as before any `break` ran
+        struct State {
+            std::vector<bool> variables{};
+            std::vector<bool> temps{};
+            bool              reachable{true};
+
+            static State unreachable() { return State{{}, {}, false}; }
+
+            std::vector<bool>::reference slot(const ast::PreAllocatedVariable& variable) {
+                return variable.get_storage() == VariableDeclarationType::Temp
+                           ? this->temps.at(variable.get_value())
+                           : this->variables.at(variable.get_value());
+            }
+
+            ///@brief Keeps what's set on both paths
+            void meet(const State& other) {
+                if (!other.reachable) {
+                    return;
+                }
+                if (!this->reachable) {
+                    *this = other;
+                    return;
+                }
+
+                for (size_t i = 0; i < this->variables.size(); i++) {
+                    this->variables[i] = this->variables[i] && other.variables[i];
+                }
+                for (size_t i = 0; i < this->temps.size(); i++) {
+                    this->temps[i] = this->temps[i] && other.temps[i];
+                }
+            }
+
+            bool operator==(const State&) const = default;
+        };
+
+        ///@brief Walks the program in evaluation order. A `break`, `continue` or `return`
+        /// hands its state to whatever it jumps to, the walk then goes on with the same state
+        /// since whatever follows the jump never runs and can only make the result smaller
+        class Walker {
+        public:
+            Walker(MolangProgram& program, State entry)
+                : program(program), entry(std::move(entry)),
+                  variables_always_set(program.get_variable_slot_count(), true),
+                  temps_always_set(program.get_temp_slot_count(), true) {}
+
+            void run() {
+                auto state = this->entry;
+                for (auto& statement : this->program.get_expressions()) {
+                    this->statement_end = State::unreachable();
+                    this->walk(*statement, state, true);
+                    state.meet(this->statement_end);
+                }
+                this->exit.meet(state);
+            }
+
+            MolangProgram&                                    program;
+            State                                             entry;
+            State                                             exit{State::unreachable()};
+            std::unordered_map<const RawExpression*, bool>    reads{};
+            std::unordered_map<const BinaryExpression*, bool> coalesces{};
+            std::vector<bool>                                 variables_always_set;
+            std::vector<bool>                                 temps_always_set;
+            bool                                              analyzed{true};
+
+        private:
+            struct LoopTargets {
+                State breaks{State::unreachable()};
+                State continues{State::unreachable()};
+            };
+
+            ///@brief Returns whether the expression's value is never null. `statement` is
+            /// true where a jump stops the enclosing list, the only place the evaluator lets
+            /// one take effect right away
+            bool walk(RawExpression& expression, State& state, const bool statement) {
+                switch (expression.get_type()) {
+                case AstKind::NumericLiteral:
+                case AstKind::BooleanLiteral:
+                case AstKind::PreAllocatedString:
+                    return true;
+                case AstKind::PreAllocatedVariableReference: {
+                    auto& read = type_asserted_cast<ast::PreAllocatedVariable&>(expression);
+                    const bool set = state.slot(read);
+                    this->reads[&expression] = set;
+
+                    auto& always = read.get_storage() == VariableDeclarationType::Temp
+                                       ? this->temps_always_set
+                                       : this->variables_always_set;
+                    always.at(read.get_value()) = always.at(read.get_value()) && set;
+                    return set;
+                }
+                case AstKind::PreAllocatedAssignment: {
+                    auto& assign =
+                        type_asserted_cast<ast::PreAllocatedVariableAssign&>(expression);
+                    const bool set     = this->walk(*assign.get_assignment(), state, false);
+                    state.slot(assign) = set;
+                    return set;
+                }
+                case AstKind::ParenthesizedExpression:
+                case AstKind::BlockExpression: {
+                    // A block evaluates to null, a list to its last element
+                    bool last = false;
+                    for (auto& inner :
+                         type_asserted_cast<ParenthesizedExpression&>(expression)
+                             .get_expressions()) {
+                        last = this->walk(*inner, state, statement);
+                    }
+                    return expression.get_type() == AstKind::ParenthesizedExpression && last;
+                }
+                case AstKind::BinaryExpression: {
+                    auto& binary = type_asserted_cast<BinaryExpression&>(expression);
+                    const auto operation = binary.get_operation();
+                    const bool left      = this->walk(*binary.get_left(), state, false);
+
+                    if (operation != BinaryOp::And && operation != BinaryOp::Or &&
+                        operation != BinaryOp::Coalesce) {
+                        this->walk(*binary.get_right(), state, false);
+                        return true;
+                    }
+
+                    // The right side only runs sometimes
+                    auto       branch = state;
+                    const bool right  = this->walk(*binary.get_right(), branch, false);
+                    state.meet(branch);
+
+                    if (operation != BinaryOp::Coalesce) {
+                        return true;
+                    }
+                    this->coalesces[&binary] = left;
+                    return left || right;
+                }
+                case AstKind::UnaryExpression:
+                    this->walk(
+                        *type_asserted_cast<UnaryExpression&>(expression).get_expression(),
+                        state, false
+                    );
+                    return true;
+                case AstKind::ConditionalExpression: {
+                    auto& conditional = type_asserted_cast<ConditionalExpression&>(expression);
+                    this->walk(*conditional.get_condition(), state, false);
+
+                    auto branch = state;
+                    this->walk(*conditional.get_if_expression(), branch, statement);
+                    state.meet(branch);
+                    return false;
+                }
+                case AstKind::TernaryExpression: {
+                    auto& ternary = type_asserted_cast<TernaryExpression&>(expression);
+                    this->walk(*ternary.get_condition(), state, false);
+
+                    auto       other = state;
+                    const bool first =
+                        this->walk(*ternary.get_if_expression(), state, statement);
+                    const bool second =
+                        this->walk(*ternary.get_else_expression(), other, statement);
+                    state.meet(other);
+                    return first && second;
+                }
+                case AstKind::SelectExpression: {
+                    // Every side runs, one after the other
+                    auto& select = type_asserted_cast<ast::SelectExpression&>(expression);
+                    this->walk(*select.get_condition(), state, false);
+                    const bool first = this->walk(*select.get_if_expression(), state, false);
+                    if (!select.get_else_expression()) {
+                        return false;
+                    }
+                    const bool second =
+                        this->walk(*select.get_else_expression(), state, false);
+                    return first && second;
+                }
+                case AstKind::PreAllocatedCall: {
+                    auto& call = type_asserted_cast<ast::PreAllocatedCall&>(expression);
+                    for (auto& argument : call.get_arguments()) {
+                        this->walk(*argument, state, false);
+                    }
+                    // Math builtins always produce a number, a query may answer null
+                    return this->program.get_math_bindings().get(call.get_value()) != nullptr;
+                }
+                case AstKind::PreAllocatedArrayAccess:
+                    this->walk(
+                        *type_asserted_cast<ast::PreAllocatedArrayAccess&>(expression)
+                             .get_index_expression(),
+                        state, false
+                    );
+                    return false;
+                case AstKind::ArrowAccessExpression: {
+                    auto& arrow = type_asserted_cast<ArrowAccess&>(expression);
+                    this->walk(*arrow.get_lhs(), state, false);
+
+                    // Skipped when the target isn't an entity
+                    auto branch = state;
+                    this->walk(*arrow.get_rhs(), branch, false);
+                    state.meet(branch);
+                    return false;
+                }
+                case AstKind::LoopExpression: {
+                    auto& loop = type_asserted_cast<LoopExpression&>(expression);
+                    this->walk(*loop.get_count_expression(), state, false);
+                    this->walk_loop(loop.get_loop_expression(), state);
+                    return false;
+                }
+                case AstKind::PreAllocatedForLoop: {
+                    auto& loop = type_asserted_cast<ast::PreAllocatedForLoop&>(expression);
+                    this->walk(*loop.get_array_fetch_expression(), state, false);
+
+                    // An element of a value array may be null
+                    state.slot(loop.get_variable_index()) = false;
+                    this->walk_loop(loop.get_loop(), state);
+                    return false;
+                }
+                case AstKind::Break:
+                case AstKind::Continue:
+                    if (!statement) {
+                        this->analyzed = false;
+                    } else if (this->loops.empty()) {
+                        // Outside a loop it only ends the top level statement it's in, the
+                        // evaluator goes on with the next one
+                        this->statement_end.meet(state);
+                    } else if (expression.get_type() == AstKind::Break) {
+                        this->loops.back().breaks.meet(state);
+                    } else {
+                        this->loops.back().continues.meet(state);
+                    }
+                    return false;
+                case AstKind::Return: {
+                    auto& value = type_asserted_cast<ReturnNode&>(expression).get_value();
+                    if (value) {
+                        this->walk(*value, state, false);
+                    }
+                    if (!statement) {
+                        this->analyzed = false;
+                    }
+                    this->exit.meet(state);
+                    return false;
+                }
+                default:
+                    return false;
+                }
+            }
+
+            ///@brief The body runs any number of times, each iteration starts with what's set
+            /// on entry and at the end of the previous one
+            void walk_loop(BlockExpression& body, State& state) {
+                auto entry = state;
+                while (true) {
+                    this->loops.emplace_back();
+                    auto after = entry;
+                    this->walk(body, after, true);
+                    const auto targets = std::move(this->loops.back());
+                    this->loops.pop_back();
+
+                    auto next = entry;
+                    next.meet(after);
+                    next.meet(targets.continues);
+                    if (next == entry) {
+                        state = entry;
+                        state.meet(targets.breaks);
+                        return;
+                    }
+                    entry = std::move(next);
+                }
+            }
+
+            std::vector<LoopTargets> loops{};
+            // What a `break` or `continue` outside of a loop hands to the next statement
+            State                    statement_end{State::unreachable()};
+        };
+
+        size_t fold(RawExpressionPtr& expression, const AssignmentInfo& info) {
+            size_t folded = 0;
+            while (expression->get_type() == AstKind::BinaryExpression) {
+                auto& binary = type_asserted_cast<BinaryExpression&>(*expression);
+                if (binary.get_operation() != BinaryOp::Coalesce || !info.is_foldable(binary)) {
+                    break;
+                }
+
+                // Moved out first, assigning destroys the node owning it
+                auto left  = std::move(binary.get_left());
+                expression = std::move(left);
+                folded++;
+            }
+
+            for_each_child(*expression, [&](RawExpressionPtr& child) {
+                folded += fold(child, info);
+            });
+            return folded;
+        }
+    } // namespace
+
+    bool AssignmentInfo::is_set(const ast::PreAllocatedVariable& read) const {
+        const auto it = this->reads.find(&read);
+        return it != this->reads.end() && it->second;
+    }
+
+    bool AssignmentInfo::is_always_set(
+        const VariableDeclarationType storage, const uint32_t slot
+    ) const {
+        const auto& slots = storage == VariableDeclarationType::Temp
+                                ? this->temps_always_set
+                                : this->variables_always_set;
+        return slot < slots.size() && slots[slot];
+    }
+
+    AssignmentInfo DefiniteAssignment::analyze(
+        MolangProgram& program, const std::unordered_set<std::string>& set_on_entry
+    ) {
+        const auto& names = program.get_collection_state().variables.index_variable_map;
+
+        State entry{
+            std::vector<bool>(program.get_variable_slot_count(), false),
+            std::vector<bool>(program.get_temp_slot_count(), false)
+        };
+        for (size_t i = 0; i < entry.variables.size(); i++) {
+            const auto name   = names.find(static_cast<uint32_t>(i));
+            entry.variables[i] = name != names.end() && set_on_entry.contains(name->second);
+        }
+
+        Walker walker{program, std::move(entry)};
+        walker.run();
+
+        AssignmentInfo info{};
+        if (!walker.analyzed) {
+            info.analyzed = false;
+            info.variables_always_set.assign(walker.variables_always_set.size(), false);
+            info.temps_always_set.assign(walker.temps_always_set.size(), false);
+            for (const auto& [read, set] : walker.reads) {
+                info.reads.emplace(read, false);
+            }
+            return info;
+        }
+
+        info.reads                = std::move(walker.reads);
+        info.variables_always_set = std::move(walker.variables_always_set);
+        info.temps_always_set     = std::move(walker.temps_always_set);
+        for (const auto& [coalesce, foldable] : walker.coalesces) {
+            if (foldable) {
+                info.foldable.insert(coalesce);
+            }
+        }
+
+        // Variables the program never touches keep whatever they had
+        for (const auto& name : set_on_entry) {
+            if (!program.find_variable_slot(VariableDeclarationType::Var, name)) {
+                info.set_on_exit.insert(name);
+            }
+        }
+        for (size_t i = 0; i < walker.exit.variables.size(); i++) {
+            const auto name = names.find(static_cast<uint32_t>(i));
+            if (walker.exit.variables[i] && name != names.end()) {
+                info.set_on_exit.insert(name->second);
+            }
+        }
+        return info;
+    }
+
+    ScriptAssignments DefiniteAssignment::analyze_scripts(
+        MolangProgram* initialize, const std::span<MolangProgram* const> per_frame,
+        const std::unordered_set<std::string>& set_on_entry
+    ) {
+        ScriptAssignments result{};
+
+        auto after_initialize = set_on_entry;
+        if (initialize != nullptr) {
+            result.initialize = analyze(*initialize, set_on_entry);
+            after_initialize  = result.initialize->get_set_on_exit();
+        }
+
+        // The first frame starts where initialize ended and every later one where the
+        // previous frame ended. Both shrink the entry set, so this settles
+        auto entry = after_initialize;
+        while (true) {
+            result.per_frame.clear();
+
+            auto current = entry;
+            for (auto* program : per_frame) {
+                result.per_frame.push_back(analyze(*program, current));
+                current = result.per_frame.back().get_set_on_exit();
+            }
+
+            std::unordered_set<std::string> next{};
+            for (const auto& name : after_initialize) {
+                if (current.contains(name)) {
+                    next.insert(name);
+                }
+            }
+            if (next == entry) {
+                return result;
+            }
+            entry = std::move(next);
+        }
+    }
+
+    size_t
+    DefiniteAssignment::fold_coalesce(MolangProgram& program, const AssignmentInfo& info) {
+        size_t folded = 0;
+        for (auto& statement : program.get_expressions()) {
+            folded += fold(statement, info);
+        }
+        return folded;
+    }
+} // namespace molar::exec
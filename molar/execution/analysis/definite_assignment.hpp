@@ -0,0 +1,99 @@
+//
+// Created by Akashic on 10/19/2026.
+//
+
+#ifndef DEFINITE_ASSIGNMENT_HPP
+#define DEFINITE_ASSIGNMENT_HPP
+#include <optional>
+#include <span>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "execution/runtime/molang_program.hpp"
+
+namespace molar::ast {
+    class BinaryExpression;
+} // namespace molar::ast
+
+namespace molar::exec {
+    namespace ast {
+        class PreAllocatedVariable;
+    } // namespace ast
+
+    ///@brief Where the slots of a program are known to hold a value. Set means the slot was
+    /// written with something which is never null on every path reaching the point, an
+    /// assignment which may store null unsets it again
+    class AssignmentInfo {
+    public:
+        ///@brief Whether the slot is set wherever this read of it runs
+        [[nodiscard]] bool is_set(const ast::PreAllocatedVariable& read) const;
+
+        ///@brief Whether every read of the slot in the program finds it set, also true for
+        /// a slot which is never read
+        [[nodiscard]] bool
+        is_always_set(molar::ast::VariableDeclarationType storage, uint32_t slot) const;
+
+        ///@brief Whether the left side of this `??` is never null, so the right side never
+        /// runs
+        [[nodiscard]] bool is_foldable(const molar::ast::BinaryExpression& coalesce) const {
+            return this->foldable.contains(&coalesce);
+        }
+
+        ///@brief The `v.` variables which are set whenever the program finishes
+        [[nodiscard]] const std::unordered_set<std::string>& get_set_on_exit() const {
+            return this->set_on_exit;
+        }
+
+        ///@brief False if the program had a `break`, `continue` or `return` the analysis
+        /// can't follow, nothing is known to be set then
+        [[nodiscard]] bool is_analyzed() const { return this->analyzed; }
+
+    private:
+        friend class DefiniteAssignment;
+
+        std::unordered_map<const molar::ast::RawExpression*, bool> reads{};
+        std::vector<bool>                                          variables_always_set{};
+        std::vector<bool>                                          temps_always_set{};
+        std::unordered_set<const molar::ast::BinaryExpression*>    foldable{};
+        std::unordered_set<std::string>                            set_on_exit{};
+        bool                                                       analyzed{true};
+    };
+
+    ///@brief The analysis of every script of an entity, see DefiniteAssignment::analyze_scripts
+    struct ScriptAssignments {
+        std::optional<AssignmentInfo> initialize{};
+        std::vector<AssignmentInfo>   per_frame{};
+    };
+
+    ///@brief Finds the slots which are always written before they're read, following the
+    /// order of evaluation. Temps start unset every evaluation, variables keep their value
+    /// between evaluations and scripts, so whatever is set on entry has to be given.
+    ///
+    /// The host is trusted not to store null in a variable it says is set
+    class DefiniteAssignment {
+    public:
+        ///@brief `set_on_entry` are the names of the `v.` variables, the way
+        /// MolangProgram::find_variable_slot names them, which hold a value whenever the
+        /// program starts
+        static AssignmentInfo analyze(
+            MolangProgram& program, const std::unordered_set<std::string>& set_on_entry = {}
+        );
+
+        ///@brief Analyzes the scripts of an entity in the order they run. `initialize` runs
+        /// once when the entity spawns, `per_frame` (pre_animation then animation) run in
+        /// order every frame after that. A variable counts as set on entry to a per frame
+        /// script only if it's set coming from `initialize` and coming from the previous frame
+        static ScriptAssignments analyze_scripts(
+            MolangProgram* initialize, std::span<MolangProgram* const> per_frame,
+            const std::unordered_set<std::string>& set_on_entry = {}
+        );
+
+        ///@brief Replaces every `??` whose left side is never null by its left side, returns
+        /// how many were replaced. The info is stale afterwards
+        static size_t fold_coalesce(MolangProgram& program, const AssignmentInfo& info);
+    };
+} // namespace molar::exec
+
+#endif // DEFINITE_ASSIGNMENT_HPP
@@ -0,0 +1,35 @@
+//
+// Created by Akashic on 10/19/2026.
+//
+
+#include "purity.hpp"
+
+namespace molar::exec {
+    CallPurity::CallPurity(
+        const MolangProgram& program, const std::unordered_set<std::string>& pure_queries
+    ) {
+        const auto& names    = program.get_collection_state().func_call_state.id_to_name;
+        const auto& bindings = program.get_math_bindings();
+
+        this->pure.resize(names.size());
+        this->queries.resize(names.size());
+        for (uint32_t i = 0; i < names.size(); i++) {
+            if (const auto* function = bindings.get(i)) {
+                this->pure[i] = !function->is_random;
+                continue;
+            }
+
+            // Call names carry a trailing kind marker, see CallExpression::build_full_name
+            const std::string_view name = names[i];
+            this->queries[i]            = true;
+            this->pure[i] = !name.empty() &&
+                            pure_queries.contains(std::string{name.substr(0, name.size() - 1)});
+        }
+    }
+
+    bool CallPurity::is_impure_query(const uint32_t call_id) const {
+        // Ids the program doesn't know can't be told apart, assume the worst
+        return call_id >= this->queries.size() ||
+               (this->queries[call_id] && !this->pure[call_id]);
+    }
+} // namespace molar::exec
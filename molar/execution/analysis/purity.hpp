@@ -0,0 +1,42 @@
+//
+// Created by Akashic on 10/19/2026.
+//
+
+#ifndef PURITY_HPP
+#define PURITY_HPP
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "execution/runtime/molang_program.hpp"
+
+namespace molar::exec {
+    ///@brief Which calls of a program are pure, they change nothing and give the same answer
+    /// for the same arguments during one evaluation. Such a call can be moved, repeated or
+    /// dropped without the program noticing.
+    ///
+    /// Math builtins are pure except the random ones, which advance the frame's random
+    /// counter. A query is pure only if the host says so
+    class CallPurity {
+    public:
+        ///@brief `pure_queries` are keyed by the query name without its prefix (`anim_time`),
+        /// like TypeSignatures::queries
+        CallPurity(
+            const MolangProgram& program, const std::unordered_set<std::string>& pure_queries
+        );
+
+        [[nodiscard]] bool is_pure(const uint32_t call_id) const {
+            return call_id < this->pure.size() && this->pure[call_id];
+        }
+
+        ///@brief Whether the call is a query the host didn't declare pure, it may then also
+        /// change state the program reads
+        [[nodiscard]] bool is_impure_query(uint32_t call_id) const;
+
+    private:
+        std::vector<bool> pure{};
+        std::vector<bool> queries{};
+    };
+} // namespace molar::exec
+
+#endif // PURITY_HPP
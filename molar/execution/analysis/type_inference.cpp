@@ -0,0 +1,392 @@
+//
+// Created by Akashic on 10/19/2026.
+//
+
+#include "type_inference.hpp"
+
+#include "definite_assignment.hpp"
+
+#include "ast/access_expression.hpp"
+#include "ast/controll_flow.hpp"
+#include "ast/keyword.hpp"
+#include "execution/preprocessor/execution_nodes/pre_allocated.hpp"
+#include "execution/preprocessor/execution_nodes/pre_allocated_variable.hpp"
+#include "execution/preprocessor/execution_nodes/select_expression.hpp"
+#include "internal/checked_down_cast.hpp"
+
+namespace molar::exec {
+    using namespace molar::ast;
+    using molar::details::type_asserted_cast;
+
+    TypeSet ProgramTypes::type_of(const RawExpression& expression) const {
+        const auto it = this->nodes.find(&expression);
+        return it != this->nodes.end() ? it->second.type : TypeSet::any();
+    }
+
+    bool ProgramTypes::is_float_only(
+        const RawExpression& expression, const bool read_as_number
+    ) const {
+        const auto it = this->nodes.find(&expression);
+        if (it == this->nodes.end()) {
+            return false;
+        }
+        return read_as_number ? it->second.float_only_number : it->second.float_only_value;
+    }
+
+    ProgramTypes TypeInference::infer(
+        MolangProgram& program, const TypeSignatures& signatures,
+        const AssignmentInfo* assignments
+    ) {
+        TypeInference inference{program, signatures, assignments};
+
+        // Slot types only ever grow and there are 4 kinds, so this settles after a few passes
+        while (inference.propagate()) {
+        }
+        return std::move(inference.types);
+    }
+
+    TypeInference::TypeInference(
+        MolangProgram& program, const TypeSignatures& signatures,
+        const AssignmentInfo* assignments
+    )
+        : program(program), signatures(signatures), assignments(assignments),
+          variable_types(program.get_variable_slot_count()),
+          temp_types(program.get_temp_slot_count(), TypeSet{ValueKind::Null}) {
+        const auto& names = program.get_collection_state().variables.index_variable_map;
+
+        for (uint32_t i = 0; i < this->variable_types.size(); i++) {
+            const auto name = names.find(i);
+            const auto declared =
+                name != names.end() ? signatures.variables.find(name->second)
+                                    : signatures.variables.end();
+            this->variable_types[i] = declared != signatures.variables.end()
+                                          ? declared->second | ValueKind::Null
+                                          : TypeSet::any();
+        }
+    }
+
+    bool TypeInference::propagate() {
+        this->slots_changed = false;
+        this->types         = {};
+        this->return_types  = {};
+        this->returns_float = true;
+
+        auto& statements = this->program.get_expressions();
+        auto  result     = statements.empty() ? TypeSet{ValueKind::Null} : TypeSet{};
+        bool  float_only = true;
+        for (size_t i = 0; i < statements.size(); i++) {
+            const auto node = this->visit(*statements[i]);
+            if (i + 1 == statements.size()) {
+                result |= node.type;
+                float_only &= node.float_only_value;
+            } else {
+                float_only &= node.float_only_number;
+            }
+        }
+
+        this->types.result_type = result | this->return_types;
+        this->types.float_only =
+            float_only && this->returns_float && this->types.result_type.is_number();
+        return this->slots_changed;
+    }
+
+    ProgramTypes::Node TypeInference::visit(RawExpression& expression) {
+        // Applies to nodes whose operands are read the same way whatever the node is used for
+        const auto node = [](const TypeSet type, const bool operands_float,
+                             const bool jumps = false) {
+            return ProgramTypes::Node{
+                type, operands_float && type.reads_as_float(),
+                operands_float && type.is_number(), jumps
+            };
+        };
+
+        ProgramTypes::Node result{};
+        switch (expression.get_type()) {
+        case AstKind::NumericLiteral:
+        case AstKind::BooleanLiteral:
+            result = node(ValueKind::Number, true);
+            break;
+        case AstKind::PreAllocatedString:
+            result = node(ValueKind::String, true);
+            break;
+        case AstKind::ResourceExpression:
+            result = node(ValueKind::Null, true);
+            break;
+        case AstKind::PreAllocatedVariableReference: {
+            auto& read = type_asserted_cast<ast::PreAllocatedVariable&>(expression);
+            auto  type = this->slot(read);
+            if (this->assignments != nullptr && this->assignments->is_set(read)) {
+                type = type.without(ValueKind::Null);
+            }
+            result = node(type, true);
+            break;
+        }
+        case AstKind::PreAllocatedAssignment: {
+            auto& assign = type_asserted_cast<ast::PreAllocatedVariableAssign&>(expression);
+            const auto value = this->visit(*assign.get_assignment());
+            auto& stored     = this->slot(assign);
+
+            if ((stored | value.type) != stored) {
+                stored |= value.type;
+                this->slots_changed = true;
+            }
+            result = node(value.type, value.float_only_value, value.jumps);
+            break;
+        }
+        case AstKind::ParenthesizedExpression: {
+            auto& list =
+                type_asserted_cast<ParenthesizedExpression&>(expression).get_expressions();
+            if (list.empty()) {
+                result = node(ValueKind::Null, true);
+                break;
+            }
+
+            // An element which breaks, continues or returns ends the list early with its own
+            // value, so it counts towards the type as much as the last one
+            TypeSet type{};
+            bool    discarded_float = true;
+            bool    jumps           = false;
+            for (size_t i = 0; i + 1 < list.size(); i++) {
+                const auto inner = this->visit(*list[i]);
+                discarded_float &= inner.float_only_number;
+                jumps |= inner.jumps;
+                if (inner.jumps) {
+                    type |= inner.type;
+                }
+            }
+
+            const auto last = this->visit(*list.back());
+            result          = {
+                type | last.type, discarded_float && last.float_only_number && !jumps,
+                discarded_float && last.float_only_value && !jumps, jumps || last.jumps
+            };
+            break;
+        }
+        case AstKind::BlockExpression: {
+            auto& block      = type_asserted_cast<BlockExpression&>(expression);
+            bool  float_only = true;
+            bool  jumps      = false;
+            for (auto& inner : block.get_expressions()) {
+                const auto element = this->visit(*inner);
+                float_only &= element.float_only_number;
+                jumps |= element.jumps;
+            }
+            result = node(ValueKind::Null, float_only, jumps);
+            break;
+        }
+        case AstKind::BinaryExpression: {
+            auto&      binary = type_asserted_cast<BinaryExpression&>(expression);
+            const auto left   = this->visit(*binary.get_left());
+            const auto right  = this->visit(*binary.get_right());
+            const bool jumps  = left.jumps || right.jumps;
+
+            switch (binary.get_operation()) {
+            case BinaryOp::Coalesce:
+                if (!left.type.contains(ValueKind::Null)) {
+                    // The right side never runs
+                    result = {
+                        left.type, left.float_only_number, left.float_only_value, jumps
+                    };
+                } else if (left.type == TypeSet{ValueKind::Null}) {
+                    result = {
+                        right.type, right.float_only_number, right.float_only_value, jumps
+                    };
+                } else {
+                    // Picking a side needs the kind of the left one
+                    result = node(
+                        left.type.without(ValueKind::Null) | right.type, false, jumps
+                    );
+                }
+                break;
+            case BinaryOp::Equality:
+            case BinaryOp::Inequality:
+                // Only compares as floats when neither side can be a string or an entity
+                result = node(
+                    ValueKind::Number,
+                    left.type.reads_as_float() && right.type.reads_as_float() &&
+                        left.float_only_number && right.float_only_number,
+                    jumps
+                );
+                break;
+            default:
+                result = node(
+                    ValueKind::Number, left.float_only_number && right.float_only_number, jumps
+                );
+                break;
+            }
+            break;
+        }
+        case AstKind::UnaryExpression: {
+            const auto operand =
+                this->visit(*type_asserted_cast<UnaryExpression&>(expression).get_expression());
+            result = node(ValueKind::Number, operand.float_only_number, operand.jumps);
+            break;
+        }
+        case AstKind::ConditionalExpression: {
+            auto&      conditional = type_asserted_cast<ConditionalExpression&>(expression);
+            const auto condition   = this->visit(*conditional.get_condition());
+            const auto branch      = this->visit(*conditional.get_if_expression());
+
+            // A false condition produces null, which is only fine where it's read as 0
+            result = {
+                branch.type | ValueKind::Null,
+                condition.float_only_number && branch.float_only_number, false,
+                condition.jumps || branch.jumps
+            };
+            break;
+        }
+        case AstKind::TernaryExpression: {
+            auto&      ternary   = type_asserted_cast<TernaryExpression&>(expression);
+            const auto condition = this->visit(*ternary.get_condition());
+            const auto first     = this->visit(*ternary.get_if_expression());
+            const auto second    = this->visit(*ternary.get_else_expression());
+
+            result = {
+                first.type | second.type,
+                condition.float_only_number && first.float_only_number &&
+                    second.float_only_number,
+                condition.float_only_number && first.float_only_value &&
+                    second.float_only_value,
+                condition.jumps || first.jumps || second.jumps
+            };
+            break;
+        }
+        case AstKind::SelectExpression: {
+            auto&      select    = type_asserted_cast<ast::SelectExpression&>(expression);
+            const auto condition = this->visit(*select.get_condition());
+            const auto first     = this->visit(*select.get_if_expression());
+
+            if (!select.get_else_expression()) {
+                // Same as a conditional, a false condition picks null
+                result = {
+                    first.type | ValueKind::Null,
+                    condition.float_only_number && first.float_only_number, false,
+                    condition.jumps || first.jumps
+                };
+                break;
+            }
+
+            const auto second = this->visit(*select.get_else_expression());
+            result            = {
+                first.type | second.type,
+                condition.float_only_number && first.float_only_number &&
+                    second.float_only_number,
+                condition.float_only_number && first.float_only_value &&
+                    second.float_only_value,
+                condition.jumps || first.jumps || second.jumps
+            };
+            break;
+        }
+        case AstKind::PreAllocatedCall: {
+            auto&      call = type_asserted_cast<ast::PreAllocatedCall&>(expression);
+            const bool math =
+                this->program.get_math_bindings().get(call.get_value()) != nullptr;
+
+            // Math builtins read their arguments as numbers, queries get the values
+            bool arguments_float = true;
+            bool jumps           = false;
+            for (auto& argument : call.get_arguments()) {
+                const auto inner = this->visit(*argument);
+                arguments_float &= math ? inner.float_only_number : inner.float_only_value;
+                jumps |= inner.jumps;
+            }
+            result = node(
+                math ? TypeSet{ValueKind::Number} : this->query_type(call.get_value()),
+                arguments_float, jumps
+            );
+            break;
+        }
+        case AstKind::PreAllocatedArrayAccess: {
+            const auto index = this->visit(
+                *type_asserted_cast<ast::PreAllocatedArrayAccess&>(expression)
+                     .get_index_expression()
+            );
+            result = node(TypeSet::any(), false, index.jumps);
+            break;
+        }
+        case AstKind::ArrowAccessExpression: {
+            auto&      arrow  = type_asserted_cast<ArrowAccess&>(expression);
+            const auto target = this->visit(*arrow.get_lhs());
+            const auto value  = this->visit(*arrow.get_rhs());
+
+            // Null when the target isn't an entity the host knows
+            result = node(value.type | ValueKind::Null, false, target.jumps || value.jumps);
+            break;
+        }
+        case AstKind::LoopExpression: {
+            auto&      loop  = type_asserted_cast<LoopExpression&>(expression);
+            const auto count = this->visit(*loop.get_count_expression());
+            const auto body  = this->visit(loop.get_loop_expression());
+            result           = node(
+                ValueKind::Null, count.float_only_number && body.float_only_number,
+                count.jumps || body.jumps
+            );
+            break;
+        }
+        case AstKind::PreAllocatedForLoop: {
+            auto&      loop  = type_asserted_cast<ast::PreAllocatedForLoop&>(expression);
+            const auto array = this->visit(*loop.get_array_fetch_expression());
+
+            // Elements can be values or entities, the slot can hold either
+            auto& element = this->slot(loop.get_variable_index());
+            if (element != TypeSet::any()) {
+                element             = TypeSet::any();
+                this->slots_changed = true;
+            }
+
+            const auto body = this->visit(loop.get_loop());
+            result          = node(ValueKind::Null, false, array.jumps || body.jumps);
+            break;
+        }
+        case AstKind::Break:
+        case AstKind::Continue:
+            result = node(ValueKind::Null, true, true);
+            break;
+        case AstKind::Return: {
+            auto& value = type_asserted_cast<ReturnNode&>(expression).get_value();
+            if (value) {
+                const auto inner = this->visit(*value);
+                this->return_types |= inner.type;
+                this->returns_float &= inner.float_only_value;
+                result = {inner.type, inner.float_only_number, inner.float_only_value, true};
+            } else {
+                this->return_types |= ValueKind::Null;
+                this->returns_float = false;
+                result              = node(ValueKind::Null, true, true);
+            }
+            break;
+        }
+        case AstKind::This:
+            result = node(this->signatures.this_value, true);
+            break;
+        default:
+            result = node(TypeSet::any(), false);
+            break;
+        }
+
+        this->types.nodes[&expression] = result;
+        return result;
+    }
+
+    TypeSet& TypeInference::slot(const ast::PreAllocatedVariable& variable) {
+        return variable.get_storage() == VariableDeclarationType::Temp
+                   ? this->temp_types.at(variable.get_value())
+                   : this->variable_types.at(variable.get_value());
+    }
+
+    TypeSet TypeInference::query_type(const uint32_t call_id) const {
+        const auto& names = this->program.get_collection_state().func_call_state.id_to_name;
+        if (call_id >= names.size()) {
+            return TypeSet::any();
+        }
+
+        // Call names carry a trailing kind marker, see CallExpression::build_full_name
+        auto name = names[call_id];
+        name.pop_back();
+        if (const auto it = this->signatures.queries.find(name);
+            it != this->signatures.queries.end()) {
+            return it->second | ValueKind::Null;
+        }
+        return TypeSet::any();
+    }
+} // namespace molar::exec
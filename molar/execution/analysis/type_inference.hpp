@@ -0,0 +1,167 @@
+//
+// Created by Akashic on 10/19/2026.
+//
+
+#ifndef TYPE_INFERENCE_HPP
+#define TYPE_INFERENCE_HPP
+#include <string>
+#include <unordered_map>
+
+#include "execution/runtime/molang_program.hpp"
+#include "execution/runtime/molang_value.hpp"
+
+namespace molar::exec {
+    namespace ast {
+        class PreAllocatedVariable;
+    } // namespace ast
+
+    class AssignmentInfo;
+
+    ///@brief The kinds an expression may evaluate to, one bit per ValueKind
+    class TypeSet {
+    public:
+        constexpr TypeSet() = default;
+
+        constexpr TypeSet(const ValueKind kind) : bits(bit(kind)) {}
+
+        static constexpr TypeSet any() {
+            return TypeSet{ValueKind::Null} | ValueKind::Number | ValueKind::String |
+                   ValueKind::Entity;
+        }
+
+        [[nodiscard]] constexpr bool contains(const ValueKind kind) const {
+            return (this->bits & bit(kind)) != 0;
+        }
+
+        ///@brief Nothing, the expression never produces a value (a `return` for instance)
+        [[nodiscard]] constexpr bool is_empty() const { return this->bits == 0; }
+
+        [[nodiscard]] constexpr bool is_number() const {
+            return this->bits == bit(ValueKind::Number);
+        }
+
+        ///@brief Only ever a number or null. A null's payload is always 0.0f, which is also
+        /// what it reads as, so such a value can be read as a float without checking its kind
+        [[nodiscard]] constexpr bool reads_as_float() const {
+            return !this->is_empty() &&
+                   (this->bits & ~(bit(ValueKind::Null) | bit(ValueKind::Number))) == 0;
+        }
+
+        [[nodiscard]] constexpr TypeSet without(const ValueKind kind) const {
+            TypeSet result{};
+            result.bits = static_cast<uint8_t>(this->bits & ~bit(kind));
+            return result;
+        }
+
+        constexpr TypeSet operator|(const TypeSet other) const {
+            TypeSet result{};
+            result.bits = static_cast<uint8_t>(this->bits | other.bits);
+            return result;
+        }
+
+        constexpr TypeSet& operator|=(const TypeSet other) { return *this = *this | other; }
+
+        constexpr bool operator==(const TypeSet&) const = default;
+
+    private:
+        static constexpr uint8_t bit(const ValueKind kind) {
+            return static_cast<uint8_t>(1u << static_cast<uint8_t>(kind));
+        }
+
+        uint8_t bits{0};
+    };
+
+    ///@brief What the host promises about values whose origin a program can't see. Anything
+    /// which isn't listed can be of any kind
+    struct TypeSignatures {
+        ///@brief Keyed by the query name without its prefix (`anim_time`), what the handler
+        /// returns when it answers. A missing handler always answers null
+        std::unordered_map<std::string, TypeSet> queries{};
+        ///@brief Keyed the way MolangProgram::find_variable_slot names them, what the host or
+        /// other programs may store in the variable. Null is always assumed as well since the
+        /// variable may not have been set yet
+        std::unordered_map<std::string, TypeSet> variables{};
+        TypeSet                                  this_value{TypeSet::any()};
+    };
+
+    ///@brief The types TypeInference found for every node of a program
+    class ProgramTypes {
+    public:
+        ///@brief Anything for a node which isn't part of the program
+        [[nodiscard]] TypeSet type_of(const molar::ast::RawExpression& expression) const;
+
+        ///@brief Whether the subtree can run on untagged floats, so every node in it
+        /// produces a number and every operand it reads is one. With `read_as_number` the
+        /// value is only ever read as a number, like an operand of `*`, and a null is fine
+        /// since it reads the same as 0
+        [[nodiscard]] bool is_float_only(
+            const molar::ast::RawExpression& expression, bool read_as_number = false
+        ) const;
+
+        ///@brief What evaluating the whole program can return
+        [[nodiscard]] TypeSet get_result_type() const { return this->result_type; }
+
+        ///@brief Whether every statement of the program is float only and it always returns
+        /// a number
+        [[nodiscard]] bool is_float_only() const { return this->float_only; }
+
+    private:
+        friend class TypeInference;
+
+        struct Node {
+            TypeSet type{};
+            bool    float_only_number{false};
+            bool    float_only_value{false};
+            // Whether a break, continue or return below can end the evaluation of the node
+            bool    jumps{false};
+        };
+
+        std::unordered_map<const molar::ast::RawExpression*, Node> nodes{};
+        TypeSet                                                    result_type{};
+        bool                                                       float_only{false};
+    };
+
+    ///@brief Infers the kinds every expression of a processed program can produce, seeded
+    /// from literals, the results of operators and math builtins, which are always numbers,
+    /// and the host's signatures.
+    ///
+    /// The inference doesn't follow the order of statements, a variable is given every kind
+    /// any assignment to it in the program can store. Temps also start as null every
+    /// evaluation, variables start as whatever the host signature says. Given the
+    /// DefiniteAssignment of the program, a read of a slot which is set there can't be null
+    class TypeInference {
+    public:
+        static ProgramTypes infer(
+            MolangProgram& program, const TypeSignatures& signatures = {},
+            const AssignmentInfo* assignments = nullptr
+        );
+
+    private:
+        TypeInference(
+            MolangProgram& program, const TypeSignatures& signatures,
+            const AssignmentInfo* assignments
+        );
+
+        ///@brief One pass over the tree with the current slot types, returns whether any
+        /// slot type grew
+        bool propagate();
+
+        ProgramTypes::Node visit(molar::ast::RawExpression& expression);
+
+        TypeSet& slot(const ast::PreAllocatedVariable& variable);
+
+        TypeSet query_type(uint32_t call_id) const;
+
+        MolangProgram&        program;
+        const TypeSignatures& signatures;
+        const AssignmentInfo* assignments;
+        std::vector<TypeSet>  variable_types{};
+        std::vector<TypeSet>  temp_types{};
+        bool                  slots_changed{false};
+        TypeSet               return_types{};
+        bool                  returns_float{true};
+        ProgramTypes          types{};
+    };
+} // namespace molar::exec
+
+#endif // TYPE_INFERENCE_HPP
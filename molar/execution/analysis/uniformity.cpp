@@ -0,0 +1,279 @@
+//
+// Created by Akashic on 10/19/2026.
+//
+
+#include "uniformity.hpp"
+
+#include "execution/passes/processed_tree.hpp"
+#include "purity.hpp"
+
+namespace molar::exec {
+    using namespace molar::ast;
+    using molar::details::type_asserted_cast;
+
+    namespace {
+        ///@brief Walks the program in evaluation order, noting what's uniform. A slot only
+        /// ever goes from uniform to varying, so the walk repeats until nothing changes,
+        /// which covers a loop body reading what a later iteration stores
+        class Walker {
+        public:
+            Walker(MolangProgram& program, const UniformityOptions& options)
+                : program(program), purity(program, options.uniform_queries),
+                  variables(program.get_variable_slot_count(), false),
+                  temps(program.get_temp_slot_count(), true) {
+                // Temps start as null for every particle, variables as the host says
+                const auto& names = program.get_collection_state().variables.index_variable_map;
+                for (size_t i = 0; i < this->variables.size(); i++) {
+                    const auto name = names.find(static_cast<uint32_t>(i));
+                    if (name == names.end()) {
+                        continue;
+                    }
+                    this->variables[i] =
+                        options.uniform_variables.contains(name->second) ||
+                        (!options.uniform_prefix.empty() &&
+                         name->second.starts_with(options.uniform_prefix));
+                }
+            }
+
+            void run() {
+                do {
+                    this->changed  = false;
+                    this->diverged = false;
+                    this->uniform.clear();
+                    for (auto& statement : this->program.get_expressions()) {
+                        this->statement_diverged = false;
+                        this->walk(*statement, false);
+                    }
+                } while (this->changed);
+            }
+
+            MolangProgram&                            program;
+            const CallPurity                          purity;
+            std::vector<bool>                         variables;
+            std::vector<bool>                         temps;
+            std::unordered_set<const RawExpression*>  uniform{};
+
+        private:
+            ///@brief Returns whether the expression is uniform. `divergent` is true where
+            /// particles may disagree about whether the expression runs at all
+            bool walk(RawExpression& expression, const bool divergent) {
+                const bool result = this->classify(expression, divergent);
+                if (result) {
+                    this->uniform.insert(&expression);
+                }
+                return result;
+            }
+
+            bool classify(RawExpression& expression, bool divergent) {
+                divergent = divergent || this->diverged || this->statement_diverged;
+
+                switch (expression.get_type()) {
+                case AstKind::NumericLiteral:
+                case AstKind::BooleanLiteral:
+                case AstKind::PreAllocatedString:
+                    return true;
+                case AstKind::PreAllocatedVariableReference:
+                    return this->slot(
+                        type_asserted_cast<ast::PreAllocatedVariable&>(expression)
+                    );
+                case AstKind::PreAllocatedAssignment: {
+                    auto& assign =
+                        type_asserted_cast<ast::PreAllocatedVariableAssign&>(expression);
+                    const bool value = this->walk(*assign.get_assignment(), divergent);
+                    if (!value || divergent) {
+                        this->make_varying(assign);
+                    }
+                    return false;
+                }
+                case AstKind::ParenthesizedExpression:
+                case AstKind::BlockExpression: {
+                    bool all = true;
+                    for (auto& inner :
+                         type_asserted_cast<ParenthesizedExpression&>(expression)
+                             .get_expressions()) {
+                        all = this->walk(*inner, divergent) && all;
+                    }
+                    return all;
+                }
+                case AstKind::BinaryExpression: {
+                    auto&      binary    = type_asserted_cast<BinaryExpression&>(expression);
+                    const auto operation = binary.get_operation();
+                    const bool left      = this->walk(*binary.get_left(), divergent);
+
+                    // The right side of these only runs for the particles the left allows
+                    const bool conditional = operation == BinaryOp::And ||
+                                             operation == BinaryOp::Or ||
+                                             operation == BinaryOp::Coalesce;
+                    const bool right =
+                        this->walk(*binary.get_right(), divergent || (conditional && !left));
+                    return left && right;
+                }
+                case AstKind::UnaryExpression:
+                    return this->walk(
+                        *type_asserted_cast<UnaryExpression&>(expression).get_expression(),
+                        divergent
+                    );
+                case AstKind::ConditionalExpression: {
+                    auto& conditional = type_asserted_cast<ConditionalExpression&>(expression);
+                    const bool condition = this->walk(*conditional.get_condition(), divergent);
+                    const bool if_value  = this->walk(
+                        *conditional.get_if_expression(), divergent || !condition
+                    );
+                    return condition && if_value;
+                }
+                case AstKind::TernaryExpression: {
+                    auto&      ternary   = type_asserted_cast<TernaryExpression&>(expression);
+                    const bool condition = this->walk(*ternary.get_condition(), divergent);
+                    const bool if_value =
+                        this->walk(*ternary.get_if_expression(), divergent || !condition);
+                    const bool else_value =
+                        this->walk(*ternary.get_else_expression(), divergent || !condition);
+                    return condition && if_value && else_value;
+                }
+                case AstKind::PreAllocatedCall: {
+                    auto& call = type_asserted_cast<ast::PreAllocatedCall&>(expression);
+                    bool  all  = true;
+                    for (auto& argument : call.get_arguments()) {
+                        all = this->walk(*argument, divergent) && all;
+                    }
+
+                    // A query on the right of an arrow asks about another entity
+                    const bool query =
+                        this->program.get_math_bindings().get(call.get_value()) == nullptr;
+                    return all && this->purity.is_pure(call.get_value()) &&
+                           !(query && this->foreign > 0);
+                }
+                case AstKind::PreAllocatedArrayAccess:
+                    // Arrays are defined by the effect, every particle sees the same ones
+                    return this->walk(
+                        *type_asserted_cast<ast::PreAllocatedArrayAccess&>(expression)
+                             .get_index_expression(),
+                        divergent
+                    );
+                case AstKind::ArrowAccessExpression: {
+                    auto& arrow = type_asserted_cast<ArrowAccess&>(expression);
+                    this->walk(*arrow.get_lhs(), divergent);
+                    this->foreign++;
+                    this->walk(*arrow.get_rhs(), divergent);
+                    this->foreign--;
+                    return false;
+                }
+                case AstKind::LoopExpression: {
+                    auto&      loop  = type_asserted_cast<LoopExpression&>(expression);
+                    const bool count = this->walk(*loop.get_count_expression(), divergent);
+                    this->walk_body(
+                        loop, loop.get_loop_expression(),
+                        divergent || !count || this->divergent_loops.contains(&loop)
+                    );
+                    return false;
+                }
+                case AstKind::PreAllocatedForLoop: {
+                    auto& loop = type_asserted_cast<ast::PreAllocatedForLoop&>(expression);
+                    const bool array =
+                        this->walk(*loop.get_array_fetch_expression(), divergent);
+                    const bool body_divergent =
+                        divergent || !array || this->divergent_loops.contains(&loop);
+                    if (body_divergent) {
+                        this->make_varying(loop.get_variable_index());
+                    }
+                    this->walk_body(loop, loop.get_loop(), body_divergent);
+                    return false;
+                }
+                case AstKind::Break:
+                case AstKind::Continue:
+                    // Only some particles leave, the rest of the loop runs for the others
+                    if (divergent && !this->loops.empty()) {
+                        this->make_divergent(*this->loops.back());
+                    } else if (divergent) {
+                        // Outside a loop it ends the statement, only for some particles
+                        this->statement_diverged = true;
+                    }
+                    return false;
+                case AstKind::Return: {
+                    if (auto& value = type_asserted_cast<ReturnNode&>(expression).get_value()) {
+                        this->walk(*value, divergent);
+                    }
+                    if (divergent) {
+                        // Whatever follows only runs for some particles
+                        this->diverged = true;
+                        for (const auto* loop : this->loops) {
+                            this->make_divergent(*loop);
+                        }
+                    }
+                    return false;
+                }
+                case AstKind::SelectExpression: {
+                    bool all = true;
+                    for_each_child(expression, [&](RawExpressionPtr& child) {
+                        all = this->walk(*child, divergent) && all;
+                    });
+                    // A missing else side is null
+                    return all;
+                }
+                default:
+                    // `this` is the particle itself
+                    return false;
+                }
+            }
+
+            void
+            walk_body(const RawExpression& loop, BlockExpression& body, const bool divergent) {
+                this->loops.push_back(&loop);
+                for (auto& inner : body.get_expressions()) {
+                    this->walk(*inner, divergent);
+                }
+                this->loops.pop_back();
+            }
+
+            std::vector<bool>::reference slot(const ast::PreAllocatedVariable& variable) {
+                return variable.get_storage() == VariableDeclarationType::Temp
+                           ? this->temps.at(variable.get_value())
+                           : this->variables.at(variable.get_value());
+            }
+
+            void make_varying(const ast::PreAllocatedVariable& variable) {
+                auto uniform = this->slot(variable);
+                if (uniform) {
+                    uniform       = false;
+                    this->changed = true;
+                }
+            }
+
+            void make_divergent(const RawExpression& loop) {
+                this->changed = this->divergent_loops.insert(&loop).second || this->changed;
+            }
+
+            // Loops some particles leave early, their bodies are divergent
+            std::unordered_set<const RawExpression*> divergent_loops{};
+            std::vector<const RawExpression*>        loops{};
+            // Set after a `return` only some particles took
+            bool                                     diverged{false};
+            // Set after a `break` or `continue` outside a loop only some particles took,
+            // up to the end of the top level statement
+            bool                                     statement_diverged{false};
+            bool                                     changed{false};
+            // How many arrows deep the walk is on the right side
+            uint32_t                                 foreign{0};
+        };
+    } // namespace
+
+    bool UniformityInfo::is_uniform_slot(
+        const VariableDeclarationType storage, const uint32_t slot
+    ) const {
+        const auto& slots = storage == VariableDeclarationType::Temp ? this->temps
+                                                                      : this->variables;
+        return slot < slots.size() && slots[slot];
+    }
+
+    UniformityInfo
+    UniformityAnalysis::analyze(MolangProgram& program, const UniformityOptions& options) {
+        Walker walker{program, options};
+        walker.run();
+
+        UniformityInfo info{};
+        info.uniform   = std::move(walker.uniform);
+        info.variables = std::move(walker.variables);
+        info.temps     = std::move(walker.temps);
+        return info;
+    }
+} // namespace molar::exec
@@ -0,0 +1,66 @@
+//
+// Created by Akashic on 10/19/2026.
+//
+
+#ifndef UNIFORMITY_HPP
+#define UNIFORMITY_HPP
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "execution/runtime/molang_program.hpp"
+
+namespace molar::exec {
+    struct UniformityOptions {
+        ///@brief `v.` variables which hold the same value for every particle of an emitter,
+        /// named the way MolangProgram::find_variable_slot names them. Every other variable
+        /// is per particle
+        std::unordered_set<std::string> uniform_variables{};
+        ///@brief Variables whose name starts with this are uniform too, empty for none
+        std::string                     uniform_prefix{"emitter_"};
+        ///@brief Queries which answer the same for every particle of an emitter during a
+        /// tick and have no side effects, keyed like CallPurity. Every other query is per
+        /// particle
+        std::unordered_set<std::string> uniform_queries{};
+    };
+
+    ///@brief Which subexpressions of a program are uniform, they give the same value for
+    /// every particle of an emitter and have no side effects, so they could run once per
+    /// emitter in place of every particle. The rest is varying
+    class UniformityInfo {
+    public:
+        [[nodiscard]] bool is_uniform(const molar::ast::RawExpression& expression) const {
+            return this->uniform.contains(&expression);
+        }
+
+        ///@brief Whether the slot holds the same value for every particle wherever the
+        /// program reads it
+        [[nodiscard]] bool
+        is_uniform_slot(molar::ast::VariableDeclarationType storage, uint32_t slot) const;
+
+        [[nodiscard]] size_t get_uniform_count() const { return this->uniform.size(); }
+
+    private:
+        friend class UniformityAnalysis;
+
+        std::unordered_set<const molar::ast::RawExpression*> uniform{};
+        std::vector<bool>                                    variables{};
+        std::vector<bool>                                    temps{};
+    };
+
+    ///@brief Classifies every node of a particle program as uniform or varying.
+    ///
+    /// Literals, uniform variables, uniform queries and non random math are uniform, `this`,
+    /// random draws and arrows are varying, and an operation is uniform if all of its
+    /// operands are. A slot stops being uniform once the program stores a varying value in
+    /// it, or stores anything under a branch, loop count or early exit which depends on a
+    /// varying value, since then particles may disagree about whether the store ran.
+    /// Assignments, loops and jumps are never uniform themselves
+    class UniformityAnalysis {
+    public:
+        static UniformityInfo
+        analyze(MolangProgram& program, const UniformityOptions& options = {});
+    };
+} // namespace molar::exec
+
+#endif // UNIFORMITY_HPP
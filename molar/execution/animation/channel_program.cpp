@@ -0,0 +1,66 @@
+//
+// Created by Akashic on 10/19/2026.
+//
+
+#include "channel_program.hpp"
+
+#include <optional>
+
+#include "execution/passes/common_subexpressions.hpp"
+#include "execution/passes/processed_tree.hpp"
+#include "execution/passes/program_linker.hpp"
+
+namespace molar::exec {
+    using namespace molar::ast;
+
+    ChannelProgram ChannelProgram::compile(
+        const std::span<const std::string_view> channels, const ChannelOptions& options,
+        StringPool& string_pool
+    ) {
+        ProgramLinker     linker{};
+        RawExpressionList statements{};
+        // Where the value of each channel is, an empty channel has none
+        std::vector<std::optional<size_t>> values{};
+        for (size_t index = 0; index < channels.size(); index++) {
+            auto channel =
+                MolangProgram::compile(channels[index], string_pool, options.precision);
+            auto linked = linker.add(channel);
+            for (auto& statement : linked) {
+                if (contains_kind(*statement, AstKind::Return)) {
+                    throw std::invalid_argument(std::format(
+                        "Channel {} uses return, a channel has to end in its value", index
+                    ));
+                }
+            }
+
+            for (auto& statement : linked) {
+                statements.emplace_back(std::move(statement));
+            }
+            values.emplace_back(
+                linked.empty() ? std::nullopt : std::optional{statements.size() - 1}
+            );
+        }
+
+        auto program = std::make_unique<MolangProgram>(
+            linker.link(std::move(statements), options.precision)
+        );
+
+        // The output temps only exist once there is a program to add them to
+        std::vector<uint32_t> outputs{};
+        auto&                 expressions = program->get_expressions();
+        for (const auto& value : values) {
+            const auto slot = outputs.emplace_back(program->add_temp("channel"));
+            if (value) {
+                auto& statement = expressions[*value];
+                statement       = std::make_unique<ast::PreAllocatedVariableAssign>(
+                    slot, VariableDeclarationType::Temp, std::move(statement)
+                );
+            }
+        }
+
+        CseOptions cse{};
+        cse.pure_queries  = options.pure_queries;
+        const auto shared = CommonSubexpressions::eliminate(*program, cse);
+        return ChannelProgram{std::move(program), std::move(outputs), shared};
+    }
+} // namespace molar::exec
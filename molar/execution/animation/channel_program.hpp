@@ -0,0 +1,93 @@
+//
+// Created by Akashic on 10/19/2026.
+//
+
+#ifndef CHANNEL_PROGRAM_HPP
+#define CHANNEL_PROGRAM_HPP
+#include <format>
+#include <memory>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+#include "execution/runtime/molang_evaluator.hpp"
+#include "execution/runtime/molang_program.hpp"
+
+namespace molar::exec {
+    struct ChannelOptions {
+        ///@brief Queries which give the same answer during one evaluation and have no side
+        /// effects, see CallPurity. Each of them is asked once per evaluation however many
+        /// channels read it
+        std::unordered_set<std::string> pure_queries{};
+        math::MathPrecision             precision{math::MathPrecision::Exact};
+    };
+
+    ///@brief Every channel of an animation, the rotation, position and scale of each bone
+    /// per axis, as one program which computes all of them in one evaluation.
+    ///
+    /// The channels run in order and each stores its value in a hidden temp, which
+    /// evaluate copies out. Every channel keeps its own temps, `v.` variables are shared as
+    /// usual. Work several channels do, like reading the same query or computing the same
+    /// subexpression, is done once, see CommonSubexpressions
+    class ChannelProgram {
+    public:
+        ///@brief Compiles the channels in the order their values are written. Throws
+        /// MolangSyntaxError for an invalid channel and std::invalid_argument for one which
+        /// uses `return`, which would end every channel after it
+        static ChannelProgram compile(
+            std::span<const std::string_view> channels,
+            const ChannelOptions&             options     = {},
+            StringPool&                       string_pool = StringPool::shared()
+        );
+
+        ///@brief Writes the value of every channel to `outputs`, a channel whose value isn't
+        /// a number writes 0
+        void evaluate(ExecutionFrame& frame, std::span<float> outputs) {
+            this->evaluate(this->evaluator, frame, outputs);
+        }
+
+        ///@brief Same, evaluated by anything with an `evaluate(ExecutionFrame&)` which runs
+        /// get_program(), a JitProgram of it for example
+        template <typename Program>
+        void
+        evaluate(Program& program, ExecutionFrame& frame, std::span<float> outputs) const {
+            if (outputs.size() < this->outputs.size()) {
+                throw std::invalid_argument(std::format(
+                    "{} outputs can't hold {} channels", outputs.size(), this->outputs.size()
+                ));
+            }
+
+            program.evaluate(frame);
+            for (size_t i = 0; i < this->outputs.size(); i++) {
+                outputs[i] = frame.temps[this->outputs[i]].as_number();
+            }
+        }
+
+        [[nodiscard]] MolangProgram& get_program() { return *this->program; }
+
+        [[nodiscard]] size_t get_channel_count() const { return this->outputs.size(); }
+
+        ///@brief How many subexpressions are computed once instead of by every copy
+        [[nodiscard]] size_t get_shared_count() const { return this->shared; }
+
+    private:
+        ChannelProgram(
+            std::unique_ptr<MolangProgram> program, std::vector<uint32_t> outputs,
+            const size_t shared
+        )
+            : program(std::move(program)), evaluator(*this->program),
+              outputs(std::move(outputs)), shared(shared) {}
+
+        // Behind a pointer so the evaluator's reference survives a move
+        std::unique_ptr<MolangProgram> program;
+        MolangEvaluator                evaluator;
+        // The temp each channel's value ends up in
+        std::vector<uint32_t>          outputs;
+        size_t                         shared;
+    };
+} // namespace molar::exec
+
+#endif // CHANNEL_PROGRAM_HPP
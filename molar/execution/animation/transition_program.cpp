@@ -0,0 +1,61 @@
+//
+// Created by Akashic on 10/19/2026.
+//
+
+#include "transition_program.hpp"
+
+#include <format>
+#include <stdexcept>
+
+#include "ast/literal.hpp"
+#include "execution/passes/common_subexpressions.hpp"
+#include "execution/passes/processed_tree.hpp"
+#include "execution/passes/program_linker.hpp"
+
+namespace molar::exec {
+    using namespace molar::ast;
+
+    TransitionProgram TransitionProgram::compile(
+        const std::span<const std::string_view> conditions, const TransitionOptions& options,
+        StringPool& string_pool
+    ) {
+        ProgramLinker     linker{};
+        RawExpressionList statements{};
+        for (uint32_t index = 0; index < conditions.size(); index++) {
+            auto condition =
+                MolangProgram::compile(conditions[index], string_pool, options.precision);
+            auto linked = linker.add(condition);
+            for (auto& statement : linked) {
+                if (contains_kind(*statement, AstKind::Return)) {
+                    throw std::invalid_argument(std::format(
+                        "Transition {} uses return, a condition has to end in its value", index
+                    ));
+                }
+            }
+            if (linked.empty()) {
+                continue;
+            }
+
+            // The statements before the value run as they are, the value decides
+            auto value = std::move(linked.back());
+            linked.pop_back();
+            for (auto& statement : linked) {
+                statements.emplace_back(std::move(statement));
+            }
+            statements.emplace_back(std::make_unique<ConditionalExpression>(
+                0, 0, std::move(value),
+                std::make_unique<ReturnNode>(
+                    0, 0, std::make_unique<NumericLiteral>(0, 0, static_cast<float>(index))
+                )
+            ));
+        }
+
+        auto program = std::make_unique<MolangProgram>(
+            linker.link(std::move(statements), options.precision)
+        );
+        CseOptions cse{};
+        cse.pure_queries  = options.pure_queries;
+        const auto shared = CommonSubexpressions::eliminate(*program, cse);
+        return TransitionProgram{std::move(program), conditions.size(), shared};
+    }
+} // namespace molar::exec
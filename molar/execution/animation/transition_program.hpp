@@ -0,0 +1,111 @@
+//
+// Created by Akashic on 10/19/2026.
+//
+
+#ifndef TRANSITION_PROGRAM_HPP
+#define TRANSITION_PROGRAM_HPP
+#include <memory>
+#include <optional>
+#include <span>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+#include "execution/runtime/molang_evaluator.hpp"
+#include "execution/runtime/molang_program.hpp"
+
+namespace molar::exec {
+    struct TransitionOptions {
+        ///@brief Queries the host promises are pure, see CallPurity. Work the conditions
+        /// share is only computed once if it makes no other call
+        std::unordered_set<std::string> pure_queries{};
+        math::MathPrecision             precision{math::MathPrecision::Exact};
+    };
+
+    ///@brief An entity of a batch which takes a transition
+    struct TransitionHit {
+        ///@brief Index of the entity's frame in the batch
+        size_t   entity;
+        ///@brief Index of the condition which was true first
+        uint32_t transition;
+    };
+
+    ///@brief The transition conditions of one animation controller state as one program.
+    ///
+    /// The conditions are checked in order and the program returns as soon as one is true,
+    /// later conditions never run. Every condition keeps its own temps, `v.` variables are
+    /// shared as usual. Subexpressions several conditions compute are computed once, see
+    /// CommonSubexpressions, which a condition that runs later finds already done
+    class TransitionProgram {
+    public:
+        ///@brief Compiles the conditions of a state in the order they're checked. Throws
+        /// MolangSyntaxError for an invalid condition and std::invalid_argument for one
+        /// which uses `return`, which can't be told apart from the end of the program
+        static TransitionProgram compile(
+            std::span<const std::string_view> conditions,
+            const TransitionOptions&          options     = {},
+            StringPool&                       string_pool = StringPool::shared()
+        );
+
+        ///@brief The first condition which is true, nothing if none is
+        std::optional<uint32_t> evaluate(ExecutionFrame& frame) {
+            return this->evaluate(this->evaluator, frame);
+        }
+
+        ///@brief Same, evaluated by anything with an `evaluate(ExecutionFrame&)` which runs
+        /// get_program(), a JitProgram of it for example
+        template <typename Program>
+        std::optional<uint32_t> evaluate(Program& program, ExecutionFrame& frame) const {
+            const MolangValue result = program.evaluate(frame);
+            if (!result.is_number()) {
+                return std::nullopt;
+            }
+            return static_cast<uint32_t>(result.as_number());
+        }
+
+        ///@brief Evaluates the state for every frame of a batch, in order. Only the entities
+        /// which take a transition are appended to `hits`, returns how many were
+        size_t
+        evaluate_batch(std::span<ExecutionFrame> frames, std::vector<TransitionHit>& hits) {
+            return this->evaluate_batch(this->evaluator, frames, hits);
+        }
+
+        template <typename Program>
+        size_t evaluate_batch(
+            Program& program, std::span<ExecutionFrame> frames,
+            std::vector<TransitionHit>& hits
+        ) const {
+            const size_t before = hits.size();
+            for (size_t i = 0; i < frames.size(); i++) {
+                if (const auto transition = this->evaluate(program, frames[i])) {
+                    hits.push_back(TransitionHit{i, *transition});
+                }
+            }
+            return hits.size() - before;
+        }
+
+        [[nodiscard]] MolangProgram& get_program() { return *this->program; }
+
+        [[nodiscard]] size_t get_transition_count() const { return this->transitions; }
+
+        ///@brief How many subexpressions are computed once instead of by every copy
+        [[nodiscard]] size_t get_shared_count() const { return this->shared; }
+
+    private:
+        TransitionProgram(
+            std::unique_ptr<MolangProgram> program, const size_t transitions,
+            const size_t shared
+        )
+            : program(std::move(program)), evaluator(*this->program), transitions(transitions),
+              shared(shared) {}
+
+        // Behind a pointer so the evaluator's reference survives a move
+        std::unique_ptr<MolangProgram> program;
+        MolangEvaluator                evaluator;
+        size_t                         transitions;
+        size_t                         shared;
+    };
+} // namespace molar::exec
+
+#endif // TRANSITION_PROGRAM_HPP
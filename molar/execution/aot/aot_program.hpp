@@ -0,0 +1,146 @@
+//
+// Created by Akashic on 10/19/2026.
+//
+
+#ifndef AOT_PROGRAM_HPP
+#define AOT_PROGRAM_HPP
+#include <algorithm>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <stdexcept>
+#include <string_view>
+
+#include "execution/math/molang_math.hpp"
+#include "execution/runtime/execution_frame.hpp"
+
+namespace molar::exec {
+    ///@brief A program which molar_aotc compiled ahead of time into a native function. The
+    /// name tables describe the frame the function expects, the same way the lookups of
+    /// MolangProgram do for the interpreter
+    struct AotProgram {
+        using Function = MolangValue (*)(ExecutionFrame& frame);
+
+        // The exact source the function was compiled from
+        std::string_view                  source{};
+        Function                          function{};
+        math::MathPrecision               precision{math::MathPrecision::Exact};
+        // Indexed by slot, named the way the collector stores them (`x` for `v.x`)
+        std::span<const std::string_view> variables{};
+        std::span<const std::string_view> temps{};
+        std::span<const std::string_view> arrays{};
+        // Indexed by call id, math calls have an empty name
+        std::span<const std::string_view> queries{};
+
+        [[nodiscard]] constexpr std::optional<uint32_t>
+        find_variable_slot(const std::string_view name) const {
+            return find(this->variables, name);
+        }
+
+        [[nodiscard]] constexpr std::optional<uint32_t>
+        find_array_slot(const std::string_view name) const {
+            return find(this->arrays, name);
+        }
+
+        ///@brief The call id the function passes to the QueryHandler for `q.name`
+        [[nodiscard]] constexpr std::optional<uint32_t>
+        find_query(const std::string_view name) const {
+            return name.empty() ? std::nullopt : find(this->queries, name);
+        }
+
+    private:
+        static constexpr std::optional<uint32_t>
+        find(const std::span<const std::string_view> names, const std::string_view name) {
+            if (const auto it = std::ranges::find(names, name); it != names.end()) {
+                return static_cast<uint32_t>(it - names.begin());
+            }
+            return std::nullopt;
+        }
+    };
+
+    ///@brief The program compiled from exactly this source, or nullptr if it wasn't part of
+    /// the corpus and has to go through the interpreter
+    constexpr const AotProgram* find_aot_program(
+        const std::span<const AotProgram> programs, const std::string_view source
+    ) {
+        const auto it = std::ranges::find(programs, source, &AotProgram::source);
+        return it != programs.end() ? &*it : nullptr;
+    }
+
+    // What generated code calls for anything which is more than a line, kept here so every
+    // program shares it and it behaves exactly like MolangEvaluator
+    namespace aot {
+        inline void
+        prepare_frame(ExecutionFrame& frame, const size_t variables, const size_t temps) {
+            if (frame.variables.size() < variables || frame.temps.size() < temps) {
+                throw std::invalid_argument("The frame has less slots than the program uses");
+            }
+            std::ranges::fill(frame.temps, MolangValue{});
+        }
+
+        ///@brief `==` of two values, null reads as 0 so it only compares as a number
+        constexpr bool equal(const MolangValue& left, const MolangValue& right) {
+            const bool numeric = !left.is_string() && !left.is_entity() && !right.is_string() &&
+                                 !right.is_entity();
+            return numeric ? left.as_number() == right.as_number() : left == right;
+        }
+
+        inline MolangValue query(
+            const ExecutionFrame& frame, const uint32_t call_id,
+            const std::span<const MolangValue> arguments
+        ) {
+            return frame.queries != nullptr ? frame.queries->query(call_id, arguments)
+                                            : MolangValue{};
+        }
+
+        inline MolangArray query_array(
+            const ExecutionFrame& frame, const uint32_t call_id,
+            const std::span<const MolangValue> arguments
+        ) {
+            return frame.queries != nullptr ? frame.queries->query_array(call_id, arguments)
+                                            : MolangArray{};
+        }
+
+        inline MolangValue
+        array_at(const ExecutionFrame& frame, const uint32_t slot, const float index) {
+            return slot < frame.arrays.size() ? frame.arrays[slot].at_wrapped(index)
+                                              : MolangValue{};
+        }
+
+        ///@brief The handler for the right side of `target->`, or nullptr if it reads as null
+        inline QueryHandler*
+        entity_queries(const ExecutionFrame& frame, const MolangValue target) {
+            return target.is_entity() && frame.queries != nullptr
+                       ? frame.queries->for_entity(target.as_entity())
+                       : nullptr;
+        }
+
+        ///@brief Answers the frame's queries with the handler of `target->` until it goes
+        /// out of scope, like MolangEvaluator it restores the caller's also when a query
+        /// throws
+        class EntityQueryScope {
+        public:
+            EntityQueryScope(ExecutionFrame& frame, QueryHandler* const handler)
+                : frame(frame), previous(frame.queries) {
+                frame.queries = handler;
+            }
+
+            ~EntityQueryScope() { this->frame.queries = this->previous; }
+
+            EntityQueryScope(const EntityQueryScope&)            = delete;
+            EntityQueryScope& operator=(const EntityQueryScope&) = delete;
+
+        private:
+            ExecutionFrame&     frame;
+            QueryHandler* const previous;
+        };
+
+        ///@brief How many times `loop` runs its body, see MolangEvaluator::max_loop_iterations
+        inline uint32_t loop_iterations(const float count, const uint32_t max_iterations) {
+            const float limit = std::min(count, static_cast<float>(max_iterations));
+            return limit > 0.0f ? static_cast<uint32_t>(limit) : 0u;
+        }
+    } // namespace aot
+} // namespace molar::exec
+
+#endif // AOT_PROGRAM_HPP
@@ -0,0 +1,794 @@
+//
+// Created by Akashic on 10/19/2026.
+//
+
+#include "cpp_emitter.hpp"
+
+#include <array>
+#include <cmath>
+#include <format>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "ast/access_expression.hpp"
+#include "ast/keyword.hpp"
+#include "execution/preprocessor/execution_nodes/pre_allocated.hpp"
+#include "execution/preprocessor/execution_nodes/pre_allocated_string.hpp"
+#include "execution/preprocessor/execution_nodes/pre_allocated_variable.hpp"
+#include "execution/preprocessor/execution_nodes/select_expression.hpp"
+#include "execution/runtime/molang_evaluator.hpp"
+#include "internal/checked_down_cast.hpp"
+
+namespace molar::exec::aot {
+    using namespace molar::ast;
+    using molar::details::type_asserted_cast;
+
+    namespace {
+        ///@brief How a random kernel gets its draws
+        enum class Draw : uint8_t { None, Unit, Stream };
+
+        struct Kernel {
+            math::MathFunction id;
+            std::string_view   name;
+            uint8_t            arguments;
+            // Whether fast_kernels has its own version for MathPrecision::Fast
+            bool               fast;
+            Draw               draw;
+        };
+
+        using math::MathFunction;
+
+        // Indexed by MathFunction, the names are the ones of the kernels namespace
+        constexpr auto kernels = std::array<Kernel, math::math_function_names.size()>{{
+            {MathFunction::Abs, "abs", 1, false, Draw::None},
+            {MathFunction::Acos, "acos", 1, false, Draw::None},
+            {MathFunction::Asin, "asin", 1, false, Draw::None},
+            {MathFunction::Atan, "atan", 1, false, Draw::None},
+            {MathFunction::Atan2, "atan2", 2, false, Draw::None},
+            {MathFunction::Ceil, "ceil", 1, false, Draw::None},
+            {MathFunction::Clamp, "clamp", 3, false, Draw::None},
+            {MathFunction::Cos, "cos", 1, true, Draw::None},
+            {MathFunction::DieRoll, "die_roll", 3, false, Draw::Stream},
+            {MathFunction::DieRollInteger, "die_roll_integer", 3, false, Draw::Stream},
+            {MathFunction::Exp, "exp", 1, false, Draw::None},
+            {MathFunction::Floor, "floor", 1, false, Draw::None},
+            {MathFunction::HermiteBlend, "hermite_blend", 1, false, Draw::None},
+            {MathFunction::Lerp, "lerp", 3, false, Draw::None},
+            {MathFunction::LerpRotate, "lerp_rotate", 3, false, Draw::None},
+            {MathFunction::Ln, "ln", 1, false, Draw::None},
+            {MathFunction::Max, "max", 2, false, Draw::None},
+            {MathFunction::Min, "min", 2, false, Draw::None},
+            {MathFunction::MinAngle, "min_angle", 1, false, Draw::None},
+            {MathFunction::Mod, "mod", 2, false, Draw::None},
+            {MathFunction::Pi, "pi", 0, false, Draw::None},
+            {MathFunction::Pow, "pow", 2, false, Draw::None},
+            {MathFunction::Random, "random", 2, false, Draw::Unit},
+            {MathFunction::RandomInteger, "random_integer", 2, false, Draw::Unit},
+            {MathFunction::Round, "round", 1, false, Draw::None},
+            {MathFunction::Sin, "sin", 1, true, Draw::None},
+            {MathFunction::Sqrt, "sqrt", 1, false, Draw::None},
+            {MathFunction::Trunc, "trunc", 1, false, Draw::None},
+        }};
+
+        ///@brief Whether a kernel name is the Molang name, the kernels add underscores
+        /// (`lerp_rotate` for `lerprotate`)
+        constexpr bool same_function(const std::string_view kernel, const std::string_view name) {
+            size_t at = 0;
+            for (const char c : kernel) {
+                if (c == '_' && (at >= name.size() || name[at] != '_')) {
+                    continue;
+                }
+                if (at >= name.size() || name[at++] != c) {
+                    return false;
+                }
+            }
+            return at == name.size();
+        }
+
+        static_assert(
+            [] {
+                for (size_t i = 0; i < kernels.size(); i++) {
+                    const auto& kernel = kernels[i];
+                    if (static_cast<size_t>(kernel.id) != i ||
+                        !same_function(kernel.name, math::math_function_names[i]) ||
+                        (kernel.draw != Draw::None) != math::is_random_math_function(kernel.id)) {
+                        return false;
+                    }
+                }
+                return true;
+            }(),
+            "The kernel table is out of order"
+        );
+
+        std::string float_literal(const float value) {
+            if (std::isnan(value)) {
+                return "std::numeric_limits<float>::quiet_NaN()";
+            }
+            if (std::isinf(value)) {
+                return value > 0.0f ? "std::numeric_limits<float>::infinity()"
+                                    : "-std::numeric_limits<float>::infinity()";
+            }
+
+            // The shortest form which reads back as the same float
+            auto text = std::format("{}", value);
+            if (text.find_first_of(".e") == std::string::npos) {
+                text += ".0";
+            }
+            return text + "f";
+        }
+
+        std::string string_literal(const std::string_view text) {
+            std::string result = "\"";
+            for (const char character : text) {
+                const auto byte = static_cast<unsigned char>(character);
+                if (character == '"' || character == '\\') {
+                    result += '\\';
+                    result += character;
+                } else if (byte < 0x20 || byte >= 0x7F) {
+                    // Octal escapes have a fixed length, a hex escape would eat the next
+                    // character if it happens to be a digit
+                    result += std::format("\\{:03o}", byte);
+                } else {
+                    result += character;
+                }
+            }
+            return result + "\"";
+        }
+
+        std::string join(const std::span<const std::string> parts) {
+            std::string result{};
+            for (const auto& part : parts) {
+                result += result.empty() ? part : ", " + part;
+            }
+            return result;
+        }
+
+        std::vector<std::string>
+        slot_names(const AstCollectorState::VariableState& state) {
+            std::vector<std::string> names(state.variable_index);
+            for (const auto& [index, name] : state.index_variable_map) {
+                if (index < names.size()) {
+                    names[index] = name;
+                }
+            }
+            return names;
+        }
+
+        std::invalid_argument unsupported_jump(const std::string_view keyword) {
+            return std::invalid_argument(
+                std::format("`{}` can only be compiled ahead of time as a statement", keyword)
+            );
+        }
+    } // namespace
+
+    std::string CppEmitter::emit(const std::string_view name, const std::string_view source) {
+        // An emitter may be reused, including after an emit which threw halfway
+        this->out.clear();
+        this->indent              = 0;
+        this->next_temporary      = 0;
+        this->next_string         = 0;
+        this->in_loop             = false;
+        this->statement           = 0;
+        this->statement_count     = 0;
+        this->next_statement_used = false;
+        this->reachable           = true;
+        this->dead_scopes         = 0;
+
+        this->emit_function(name);
+        this->out += '\n';
+        this->emit_tables(name, source);
+        return std::move(this->out);
+    }
+
+    void CppEmitter::emit_function(const std::string_view name) {
+        auto& expressions     = this->program.get_expressions();
+        this->statement_count = expressions.size();
+
+        this->open(std::format("MolangValue {}(ExecutionFrame& frame)", name));
+        this->line(std::format(
+            "aot::prepare_frame(frame, {}, {});", this->program.get_variable_slot_count(),
+            this->program.get_temp_slot_count()
+        ));
+
+        if (expressions.empty()) {
+            this->line("return MolangValue{};");
+        }
+
+        // Top level statements get their own scope when there are several, so `break` outside
+        // of a loop can jump to the next one without crossing any initialization
+        const bool scoped = this->statement_count > 1;
+        for (this->statement = 0; this->statement < this->statement_count; ++this->statement) {
+            if (this->next_statement_used) {
+                this->reachable = true;
+                this->line(std::format("statement_{}:", this->statement));
+                this->next_statement_used = false;
+            } else if (!this->reachable) {
+                // An unconditional return ended the previous statement, nothing after it runs
+                break;
+            }
+            if (scoped) {
+                this->open("");
+            }
+
+            auto&      expression = *expressions[this->statement];
+            const auto value      = this->lower(expression, {.returns = true, .jumps = true});
+
+            if (this->statement + 1 < this->statement_count) {
+                this->discard(value);
+            } else {
+                this->line(std::format("return {};", as_value(value)));
+            }
+
+            // The scope's closing brace would make the code after it look reachable again
+            const bool ended = !this->reachable;
+            if (scoped) {
+                this->close();
+            }
+            this->reachable = !ended;
+        }
+        this->close();
+    }
+
+    void CppEmitter::emit_tables(const std::string_view name, const std::string_view source) {
+        const auto& state = this->program.get_collection_state();
+
+        const auto table = [&](const std::string_view suffix,
+                               const std::span<const std::string> names) {
+            std::vector<std::string> literals{};
+            for (const auto& entry : names) {
+                literals.emplace_back(string_literal(entry));
+            }
+            this->line(std::format(
+                "constexpr std::array<std::string_view, {}> {}_{}{{{}}};", names.size(), name,
+                suffix, join(literals)
+            ));
+        };
+
+        table("variables", slot_names(state.variables));
+        table("temps", slot_names(state.temp_variables));
+        table("arrays", slot_names(state.array_state));
+
+        // Call names end in `m` or `q`, see CallExpression::build_full_name
+        std::vector<std::string> queries{};
+        for (const auto& call : state.func_call_state.id_to_name) {
+            queries.emplace_back(
+                call.ends_with('q') ? call.substr(0, call.size() - 1) : std::string{}
+            );
+        }
+        table("queries", queries);
+
+        const bool fast =
+            this->program.get_math_bindings().get_precision() == math::MathPrecision::Fast;
+        this->out += '\n';
+        this->open(std::format("constexpr AotProgram {}_program", name));
+        this->line(std::format(".source    = {},", string_literal(source)));
+        this->line(std::format(".function  = &{},", name));
+        this->line(
+            std::format(".precision = math::MathPrecision::{},", fast ? "Fast" : "Exact")
+        );
+        this->line(std::format(".variables = {}_variables,", name));
+        this->line(std::format(".temps     = {}_temps,", name));
+        this->line(std::format(".arrays    = {}_arrays,", name));
+        this->line(std::format(".queries   = {}_queries,", name));
+        this->indent--;
+        this->line("};");
+    }
+
+    CppEmitter::Operand CppEmitter::lower(RawExpression& expression, const Position position) {
+        switch (expression.get_type()) {
+        case AstKind::NumericLiteral:
+            return {float_literal(type_asserted_cast<NumericLiteral&>(expression).get_value()),
+                    true};
+        case AstKind::BooleanLiteral:
+            return {type_asserted_cast<BoolLiteral&>(expression).get_value() ? "1.0f" : "0.0f",
+                    true};
+        case AstKind::PreAllocatedString: {
+            const auto& string = type_asserted_cast<ast::PreAllocatedString&>(expression);
+            const auto name   = std::format("string_{}", this->next_string++);
+            // Generated code interns into the shared pool, which is the pool a host uses
+            // when it doesn't compile with its own
+            this->line(std::format(
+                "static const auto {} = StringPool::shared().intern({});", name,
+                string_literal(this->string_pool.resolve(string.get_value()))
+            ));
+            return {std::format("MolangValue{{{}}}", name)};
+        }
+        case AstKind::PreAllocatedVariableReference:
+            return {this->declare(
+                        "const MolangValue",
+                        this->slot(type_asserted_cast<ast::PreAllocatedVariable&>(expression))
+                    ),
+                    false, true};
+        case AstKind::PreAllocatedAssignment: {
+            auto& assign = type_asserted_cast<ast::PreAllocatedVariableAssign&>(expression);
+            auto  value  = this->lower(*assign.get_assignment(), {});
+            this->line(std::format("{} = {};", this->slot(assign), as_value(value)));
+            value.unread = false;
+            return value;
+        }
+        case AstKind::ParenthesizedExpression:
+            return this->lower_list(
+                type_asserted_cast<ParenthesizedExpression&>(expression).get_expressions(),
+                position
+            );
+        case AstKind::BlockExpression: {
+            auto& block = type_asserted_cast<BlockExpression&>(expression);
+            for (auto& inner : block.get_expressions()) {
+                this->discard(this->lower(*inner, position));
+            }
+            return {"MolangValue{}"};
+        }
+        case AstKind::BinaryExpression:
+            return this->lower_binary(type_asserted_cast<BinaryExpression&>(expression));
+        case AstKind::UnaryExpression: {
+            auto&      unary = type_asserted_cast<UnaryExpression&>(expression);
+            const auto value = this->lower(*unary.get_expression(), {});
+
+            if (unary.get_operation() == UnaryOp::Not) {
+                return {this->declare("const float", as_bool(value) + " ? 0.0f : 1.0f"), true,
+                        true};
+            }
+            const auto number = as_number(value);
+            return {this->declare(
+                        "const float",
+                        number.starts_with('-') ? std::format("-({})", number) : "-" + number
+                    ),
+                    true, true};
+        }
+        case AstKind::ConditionalExpression: {
+            auto& conditional = type_asserted_cast<ConditionalExpression&>(expression);
+            const auto condition = this->lower(*conditional.get_condition(), {});
+            const auto result    = this->declare("MolangValue", "");
+
+            this->open(std::format("if ({})", as_bool(condition)));
+            const auto value = this->lower(*conditional.get_if_expression(), position);
+            this->line(std::format("{} = {};", result, as_value(value)));
+            this->close();
+            return {result, false, true};
+        }
+        case AstKind::TernaryExpression: {
+            auto&      ternary   = type_asserted_cast<TernaryExpression&>(expression);
+            const auto condition = this->lower(*ternary.get_condition(), {});
+            const auto result    = this->declare("MolangValue", "");
+
+            this->open(std::format("if ({})", as_bool(condition)));
+            const auto if_value = this->lower(*ternary.get_if_expression(), position);
+            this->line(std::format("{} = {};", result, as_value(if_value)));
+            this->close();
+            this->open("else");
+            const auto else_value = this->lower(*ternary.get_else_expression(), position);
+            this->line(std::format("{} = {};", result, as_value(else_value)));
+            this->close();
+            return {result, false, true};
+        }
+        case AstKind::SelectExpression: {
+            // Every side is computed, the compiler is free to pick with a cmov
+            auto&      select    = type_asserted_cast<ast::SelectExpression&>(expression);
+            const auto condition = this->lower(*select.get_condition(), {});
+            const auto if_value  = this->lower(*select.get_if_expression(), {});
+            const auto else_value =
+                select.get_else_expression()
+                    ? this->lower(*select.get_else_expression(), {})
+                    : Operand{"MolangValue{}"};
+
+            if (if_value.numeric && else_value.numeric) {
+                return {this->declare(
+                            "const float",
+                            std::format(
+                                "({}) ? {} : {}", as_bool(condition), if_value.text,
+                                else_value.text
+                            )
+                        ),
+                        true, true};
+            }
+            return {this->declare(
+                        "const MolangValue",
+                        std::format(
+                            "({}) ? {} : {}", as_bool(condition), as_value(if_value),
+                            as_value(else_value)
+                        )
+                    ),
+                    false, true};
+        }
+        case AstKind::PreAllocatedCall:
+            return this->lower_call(type_asserted_cast<ast::PreAllocatedCall&>(expression));
+        case AstKind::PreAllocatedArrayAccess: {
+            auto& access = type_asserted_cast<ast::PreAllocatedArrayAccess&>(expression);
+            const auto index = this->lower(*access.get_index_expression(), {});
+            return {this->declare(
+                        "const MolangValue",
+                        std::format(
+                            "aot::array_at(frame, {}u, {})", access.get_value(),
+                            as_number(index)
+                        )
+                    ),
+                    false, true};
+        }
+        case AstKind::ArrowAccessExpression: {
+            auto&      arrow  = type_asserted_cast<ArrowAccess&>(expression);
+            const auto target = this->lower(*arrow.get_lhs(), {});
+            const auto result = this->declare("MolangValue", "");
+            const auto handler = this->declare(
+                "QueryHandler* const",
+                std::format("aot::entity_queries(frame, {})", as_value(target))
+            );
+
+            this->open(std::format("if ({} != nullptr)", handler));
+            // Puts the caller's handler back also when a query throws
+            this->declare("const aot::EntityQueryScope", std::format("{{frame, {}}}", handler));
+            const auto value = this->lower(*arrow.get_rhs(), {});
+            this->line(std::format("{} = {};", result, as_value(value)));
+            this->close();
+            return {result, false, true};
+        }
+        case AstKind::LoopExpression: {
+            auto&      loop  = type_asserted_cast<LoopExpression&>(expression);
+            const auto count = this->lower(*loop.get_count_expression(), {});
+            const auto iterations = this->declare(
+                "const uint32_t",
+                std::format(
+                    "aot::loop_iterations({}, {}u)", as_number(count),
+                    MolangEvaluator::max_loop_iterations
+                )
+            );
+            const auto index = std::format("v{}", this->next_temporary++);
+
+            this->open(std::format(
+                "for (uint32_t {0} = 0; {0} < {1}; ++{0})", index, iterations
+            ));
+            this->lower_loop_body(loop.get_loop_expression(), position);
+            this->close();
+            return {"MolangValue{}"};
+        }
+        case AstKind::PreAllocatedForLoop: {
+            auto&      loop  = type_asserted_cast<ast::PreAllocatedForLoop&>(expression);
+            const auto array = this->lower_array(*loop.get_array_fetch_expression());
+            const auto index = std::format("v{}", this->next_temporary++);
+
+            this->open(std::format(
+                "for (size_t {0} = 0; {0} < {1}.size(); ++{0})", index, array
+            ));
+            this->line(std::format(
+                "{} = {}[{}];", this->slot(loop.get_variable_index()), array, index
+            ));
+            this->lower_loop_body(loop.get_loop(), position);
+            this->close();
+            return {"MolangValue{}"};
+        }
+        case AstKind::Break:
+        case AstKind::Continue:
+            this->lower_jump(expression.get_type(), position);
+            return {"MolangValue{}"};
+        case AstKind::Return: {
+            if (!position.returns) {
+                throw unsupported_jump("return");
+            }
+
+            auto&      node  = type_asserted_cast<ReturnNode&>(expression);
+            const auto value = node.get_value() ? this->lower(*node.get_value(), {})
+                                                : Operand{"MolangValue{}"};
+            this->line(std::format("return {};", as_value(value)));
+            this->reachable = false;
+            return {"MolangValue{}"};
+        }
+        case AstKind::This:
+            return {"frame.this_value"};
+        case AstKind::ResourceExpression:
+            // Resources are resolved by the renderer, they have no value in an expression
+            return {"MolangValue{}"};
+        default:
+            throw std::logic_error(std::format(
+                "{} can't be emitted, the program wasn't preprocessed",
+                ast_kind_to_string(expression.get_type())
+            ));
+        }
+    }
+
+    CppEmitter::Operand
+    CppEmitter::lower_list(RawExpressionList& expressions, const Position position) {
+        if (expressions.empty()) {
+            return {"MolangValue{}"};
+        }
+
+        // Only the value of the last expression is kept, the others run for their effects
+        for (size_t i = 0; i + 1 < expressions.size(); i++) {
+            this->discard(this->lower(*expressions[i], position));
+            if (!this->reachable) {
+                // Whatever follows a jump never runs, emitting it would only trip warnings
+                return {"MolangValue{}"};
+            }
+        }
+        return this->lower(*expressions.back(), position);
+    }
+
+    CppEmitter::Operand CppEmitter::lower_binary(BinaryExpression& expression) {
+        const auto operation = expression.get_operation();
+
+        // The short circuiting operators only evaluate the right side when they need it
+        switch (operation) {
+        case BinaryOp::And:
+        case BinaryOp::Or: {
+            const bool is_and = operation == BinaryOp::And;
+            const auto left   = this->lower(*expression.get_left(), {});
+            const auto result = this->declare("float", is_and ? "0.0f" : "1.0f");
+
+            const auto condition = as_bool(left);
+            this->open(std::format("if ({})", is_and ? condition : "!(" + condition + ")"));
+            const auto right = this->lower(*expression.get_right(), {});
+            this->line(std::format("{} = {} ? 1.0f : 0.0f;", result, as_bool(right)));
+            this->close();
+            return {result, true, true};
+        }
+        case BinaryOp::Coalesce: {
+            const auto left = this->lower(*expression.get_left(), {});
+            if (left.numeric) {
+                // A number is never null, the right side would never run
+                return left;
+            }
+
+            const auto result = this->declare("MolangValue", left.text);
+            this->open(std::format("if ({}.is_null())", result));
+            const auto right = this->lower(*expression.get_right(), {});
+            this->line(std::format("{} = {};", result, as_value(right)));
+            this->close();
+            return {result, false, true};
+        }
+        default:
+            break;
+        }
+
+        const auto left  = this->lower(*expression.get_left(), {});
+        const auto right = this->lower(*expression.get_right(), {});
+
+        if (operation == BinaryOp::Equality || operation == BinaryOp::Inequality) {
+            const auto equal =
+                left.numeric && right.numeric
+                    ? std::format("{} == {}", left.text, right.text)
+                    : std::format("aot::equal({}, {})", as_value(left), as_value(right));
+            return {this->declare(
+                        "const float",
+                        std::format(
+                            "{} ? {}", equal,
+                            operation == BinaryOp::Equality ? "1.0f : 0.0f" : "0.0f : 1.0f"
+                        )
+                    ),
+                    true, true};
+        }
+
+        std::string_view symbol{};
+        bool             comparison = false;
+        switch (operation) {
+        case BinaryOp::LessThan:
+            symbol     = "<";
+            comparison = true;
+            break;
+        case BinaryOp::LessEqualThan:
+            symbol     = "<=";
+            comparison = true;
+            break;
+        case BinaryOp::GreaterThan:
+            symbol     = ">";
+            comparison = true;
+            break;
+        case BinaryOp::GreaterEqualThan:
+            symbol     = ">=";
+            comparison = true;
+            break;
+        case BinaryOp::Addition:
+            symbol = "+";
+            break;
+        case BinaryOp::Subtraction:
+            symbol = "-";
+            break;
+        case BinaryOp::Multiplication:
+            symbol = "*";
+            break;
+        case BinaryOp::Division:
+            symbol = "/";
+            break;
+        default:
+            throw std::logic_error("Unknown binary operation");
+        }
+
+        const auto text =
+            std::format("{} {} {}", as_number(left), symbol, as_number(right));
+        return {this->declare("const float", comparison ? text + " ? 1.0f : 0.0f" : text),
+                true, true};
+    }
+
+    CppEmitter::Operand CppEmitter::lower_call(ast::PreAllocatedCall& expression) {
+        const auto call_id = expression.get_value();
+
+        if (const auto* function = this->program.get_math_bindings().get(call_id)) {
+            // Missing arguments are passed as 0, extra ones are still evaluated for their side
+            // effects but ignored
+            const auto&              kernel = kernels[static_cast<size_t>(function->id)];
+            std::vector<std::string> arguments(kernel.arguments, "0.0f");
+            size_t                   index = 0;
+            for (auto& argument : expression.get_arguments()) {
+                const auto value = this->lower(*argument, {});
+                if (index < arguments.size()) {
+                    arguments[index++] = as_number(value);
+                } else {
+                    this->discard(value);
+                }
+            }
+
+            const auto precision = this->program.get_math_bindings().get_precision();
+            const bool fast      = kernel.fast && precision == math::MathPrecision::Fast;
+            const auto call = std::format(
+                "math::{}::{}", fast ? "fast_kernels" : "kernels", kernel.name
+            );
+
+            if (kernel.draw == Draw::None) {
+                return {this->declare(
+                            "const float", std::format("{}({})", call, join(arguments))
+                        ),
+                        true, true};
+            }
+
+            const auto stream = std::format("v{}", this->next_temporary++);
+            this->line(std::format(
+                "math::RandomStream {}{{frame.entity, {}u, frame.random_counter, {}u}};",
+                stream, expression.get_call_site(), this->program.get_program_id()
+            ));
+            arguments.emplace_back(
+                kernel.draw == Draw::Unit ? stream + ".next_unit()" : stream
+            );
+            const auto result =
+                this->declare("const float", std::format("{}({})", call, join(arguments)));
+            this->line(std::format("frame.random_counter = {}.get_counter();", stream));
+            return {result, true, true};
+        }
+
+        std::vector<std::string> arguments{};
+        for (auto& argument : expression.get_arguments()) {
+            arguments.emplace_back(as_value(this->lower(*argument, {})));
+        }
+        return {this->declare(
+                    "const MolangValue",
+                    std::format(
+                        "aot::query(frame, {}u, {})", call_id,
+                        arguments.empty()
+                            ? "std::span<const MolangValue>{}"
+                            : std::format(
+                                  "std::array<MolangValue, {}>{{{}}}", arguments.size(),
+                                  join(arguments)
+                              )
+                    )
+                ),
+                false, true};
+    }
+
+    std::string CppEmitter::lower_array(RawExpression& expression) {
+        const auto is_query =
+            expression.get_type() == AstKind::PreAllocatedCall &&
+            this->program.get_math_bindings().get(
+                type_asserted_cast<ast::PreAllocatedCall&>(expression).get_value()
+            ) == nullptr;
+
+        if (!is_query) {
+            // Anything else can't produce an array, it still runs for its side effects
+            this->discard(this->lower(expression, {}));
+            return this->declare("const MolangArray", "");
+        }
+
+        auto&                    call = type_asserted_cast<ast::PreAllocatedCall&>(expression);
+        std::vector<std::string> arguments{};
+        for (auto& argument : call.get_arguments()) {
+            arguments.emplace_back(as_value(this->lower(*argument, {})));
+        }
+        return this->declare(
+            "const MolangArray",
+            std::format(
+                "aot::query_array(frame, {}u, {})", call.get_value(),
+                arguments.empty()
+                    ? "std::span<const MolangValue>{}"
+                    : std::format(
+                          "std::array<MolangValue, {}>{{{}}}", arguments.size(), join(arguments)
+                      )
+            )
+        );
+    }
+
+    void CppEmitter::lower_loop_body(BlockExpression& body, const Position position) {
+        const bool outer_loop = std::exchange(this->in_loop, true);
+        for (auto& expression : body.get_expressions()) {
+            this->discard(
+                this->lower(*expression, {.returns = position.returns, .jumps = true})
+            );
+            if (!this->reachable) {
+                break;
+            }
+        }
+        this->in_loop = outer_loop;
+    }
+
+    void CppEmitter::lower_jump(const AstKind kind, const Position position) {
+        if (!position.jumps) {
+            throw unsupported_jump(kind == AstKind::Break ? "break" : "continue");
+        }
+
+        if (!this->reachable) {
+            return;
+        }
+
+        if (this->in_loop) {
+            this->line(kind == AstKind::Break ? "break;" : "continue;");
+        } else if (this->statement + 1 == this->statement_count) {
+            // Outside of a loop both only end the top level statement they are in
+            this->line("return MolangValue{};");
+        } else {
+            this->line(std::format("goto statement_{};", this->statement + 1));
+            this->next_statement_used = true;
+        }
+        this->reachable = false;
+    }
+
+    std::string CppEmitter::slot(const ast::PreAllocatedVariable& variable) const {
+        return std::format(
+            "frame.{}[{}]",
+            variable.get_storage() == VariableDeclarationType::Temp ? "temps" : "variables",
+            variable.get_value()
+        );
+    }
+
+    std::string
+    CppEmitter::declare(const std::string_view type, const std::string_view initializer) {
+        auto name = std::format("v{}", this->next_temporary++);
+        this->line(
+            initializer.empty() ? std::format("{} {}{{}};", type, name)
+                                : std::format("{} {} = {};", type, name, initializer)
+        );
+        return name;
+    }
+
+    void CppEmitter::line(const std::string_view text) {
+        if (!this->reachable) {
+            return;
+        }
+        this->out.append(this->indent * 4, ' ');
+        this->out += text;
+        this->out += '\n';
+    }
+
+    void CppEmitter::open(const std::string_view text) {
+        if (!this->reachable) {
+            this->dead_scopes++;
+            return;
+        }
+        this->line(text.empty() ? std::string("{") : std::format("{} {{", text));
+        this->indent++;
+    }
+
+    void CppEmitter::close() {
+        if (this->dead_scopes > 0) {
+            this->dead_scopes--;
+            return;
+        }
+        // A jump only ends the innermost scope, the code after it runs unless every branch
+        // jumped, which isn't tracked
+        this->indent--;
+        this->reachable = true;
+        this->line("}");
+    }
+
+    void CppEmitter::discard(const Operand& operand) {
+        if (operand.unread) {
+            this->line(std::format("static_cast<void>({});", operand.text));
+        }
+    }
+
+    std::string CppEmitter::as_number(const Operand& operand) {
+        return operand.numeric ? operand.text : operand.text + ".as_number()";
+    }
+
+    std::string CppEmitter::as_value(const Operand& operand) {
+        return operand.numeric ? std::format("MolangValue{{{}}}", operand.text) : operand.text;
+    }
+
+    std::string CppEmitter::as_bool(const Operand& operand) {
+        return operand.numeric ? operand.text + " != 0.0f" : operand.text + ".as_bool()";
+    }
+} // namespace molar::exec::aot
@@ -0,0 +1,119 @@
+//
+// Created by Akashic on 10/19/2026.
+//
+
+#ifndef CPP_EMITTER_HPP
+#define CPP_EMITTER_HPP
+#include <cstdint>
+#include <string>
+#include <string_view>
+
+#include "execution/runtime/molang_program.hpp"
+
+namespace molar::exec::ast {
+    class PreAllocatedCall;
+    class PreAllocatedVariable;
+} // namespace molar::exec::ast
+
+namespace molar::exec::aot {
+    ///@brief Lowers a processed program to a C++ function over an ExecutionFrame, which
+    /// behaves exactly like MolangEvaluator on the same program. See aot_program.hpp for what
+    /// the generated code needs at runtime
+    ///
+    /// `break`, `continue` and `return` become plain jumps, which is only exact when they are
+    /// reached through statements. A program which uses one as an operand (`1 + (break)`) is
+    /// rejected with std::invalid_argument and has to stay on the interpreter
+    class CppEmitter {
+    public:
+        ///@brief The pool has to be the one the program was compiled with, string literals are
+        /// resolved through it
+        explicit CppEmitter(
+            MolangProgram& program, const StringPool& string_pool = StringPool::shared()
+        )
+            : program(program), string_pool(string_pool) {}
+
+        ///@brief The definition of `MolangValue name(ExecutionFrame& frame)` followed by its
+        /// name tables and a constexpr AotProgram called `name_program`. The generated source
+        /// has to have molar::exec in scope
+        std::string emit(std::string_view name, std::string_view source);
+
+    private:
+        ///@brief Where an expression sits, which decides whether control flow can jump
+        struct Position {
+            // Every parent up to the top level is a statement, `return` can leave directly
+            bool returns{false};
+            // Every parent up to the innermost loop (or the top level) is a statement
+            bool jumps{false};
+        };
+
+        ///@brief A lowered expression. The text only reads temporaries and literals, so it
+        /// can be used after any later statement was emitted
+        struct Operand {
+            std::string text{};
+            bool        numeric{false};
+            // A temporary nothing has read yet, dropping it needs a cast to void
+            bool        unread{false};
+        };
+
+        void emit_function(std::string_view name);
+
+        void emit_tables(std::string_view name, std::string_view source);
+
+        Operand lower(molar::ast::RawExpression& expression, Position position);
+
+        ///@brief Lowers a statement list, the value is the one of the last statement
+        Operand lower_list(molar::ast::RawExpressionList& expressions, Position position);
+
+        Operand lower_binary(molar::ast::BinaryExpression& expression);
+
+        Operand lower_call(ast::PreAllocatedCall& expression);
+
+        ///@brief Lowers the array of a `for_each`, returns the name of a MolangArray
+        std::string lower_array(molar::ast::RawExpression& expression);
+
+        void lower_loop_body(molar::ast::BlockExpression& body, Position position);
+
+        void lower_jump(molar::ast::AstKind kind, Position position);
+
+        [[nodiscard]] std::string slot(const ast::PreAllocatedVariable& variable) const;
+
+        ///@brief Declares a new temporary, returns its name
+        std::string declare(std::string_view type, std::string_view initializer);
+
+        ///@brief Appends a line, or nothing when the code after a jump is being lowered
+        void line(std::string_view text);
+
+        void open(std::string_view text);
+
+        void close();
+
+        ///@brief Marks the value of a statement whose result is dropped as used
+        void discard(const Operand& operand);
+
+        static std::string as_number(const Operand& operand);
+
+        static std::string as_value(const Operand& operand);
+
+        static std::string as_bool(const Operand& operand);
+
+    private:
+        MolangProgram&    program;
+        const StringPool& string_pool;
+        std::string       out{};
+        uint32_t          indent{0};
+        uint32_t          next_temporary{0};
+        uint32_t          next_string{0};
+        // Whether break and continue leave a loop or jump to the next top level statement
+        bool              in_loop{false};
+        size_t            statement{0};
+        size_t            statement_count{0};
+        // Whether a jump to the label of the next top level statement was emitted
+        bool              next_statement_used{false};
+        // Cleared by a jump, nothing is emitted until the scope it was in closes
+        bool              reachable{true};
+        // Scopes opened after a jump, their braces are dropped with their content
+        uint32_t          dead_scopes{0};
+    };
+} // namespace molar::exec::aot
+
+#endif // CPP_EMITTER_HPP
@@ -0,0 +1,59 @@
+//
+// Created by Akashic on 10/19/2026.
+//
+
+#include "executable_memory.hpp"
+
+#include <cstring>
+
+#if MOLAR_JIT_AVAILABLE
+#include <sys/mman.h>
+#endif
+
+namespace molar::exec::jit {
+    std::optional<ExecutableMemory>
+    ExecutableMemory::create(const std::span<const uint8_t> code) {
+#if MOLAR_JIT_AVAILABLE
+        if (code.empty()) {
+            return std::nullopt;
+        }
+
+        void* pages = ::mmap(
+            nullptr, code.size(), PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0
+        );
+        if (pages == MAP_FAILED) {
+            return std::nullopt;
+        }
+
+        std::memcpy(pages, code.data(), code.size());
+        if (::mprotect(pages, code.size(), PROT_READ | PROT_EXEC) != 0) {
+            ::munmap(pages, code.size());
+            return std::nullopt;
+        }
+        return ExecutableMemory{pages, code.size()};
+#else
+        return std::nullopt;
+#endif
+    }
+
+    ExecutableMemory& ExecutableMemory::operator=(ExecutableMemory&& other) noexcept {
+        if (this != &other) {
+            this->release();
+            this->pages = std::exchange(other.pages, nullptr);
+            this->size  = std::exchange(other.size, 0);
+        }
+        return *this;
+    }
+
+    ExecutableMemory::~ExecutableMemory() { this->release(); }
+
+    void ExecutableMemory::release() {
+#if MOLAR_JIT_AVAILABLE
+        if (this->pages != nullptr) {
+            ::munmap(this->pages, this->size);
+        }
+#endif
+        this->pages = nullptr;
+        this->size  = 0;
+    }
+} // namespace molar::exec::jit
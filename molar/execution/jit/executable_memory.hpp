@@ -0,0 +1,52 @@
+//
+// Created by Akashic on 10/19/2026.
+//
+
+#ifndef EXECUTABLE_MEMORY_HPP
+#define EXECUTABLE_MEMORY_HPP
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <utility>
+
+// The JIT only runs where it can map executable pages and where the code it emits runs
+#if defined(MOLAR_ENABLE_JIT) && defined(__linux__) && defined(__x86_64__)
+#define MOLAR_JIT_AVAILABLE 1
+#else
+#define MOLAR_JIT_AVAILABLE 0
+#endif
+
+namespace molar::exec::jit {
+    ///@brief Pages holding machine code. The pages are writable only while the code is copied
+    /// in and are executable only after that, they are never both
+    class ExecutableMemory {
+    public:
+        ///@brief Maps pages for the code, nothing if the platform doesn't allow it
+        static std::optional<ExecutableMemory> create(std::span<const uint8_t> code);
+
+        ExecutableMemory(const ExecutableMemory&)            = delete;
+        ExecutableMemory& operator=(const ExecutableMemory&) = delete;
+
+        ExecutableMemory(ExecutableMemory&& other) noexcept
+            : pages(std::exchange(other.pages, nullptr)), size(std::exchange(other.size, 0)) {}
+
+        ExecutableMemory& operator=(ExecutableMemory&& other) noexcept;
+
+        ~ExecutableMemory();
+
+        [[nodiscard]] const void* get_entry() const { return this->pages; }
+
+        [[nodiscard]] size_t get_size() const { return this->size; }
+
+    private:
+        ExecutableMemory(void* pages, const size_t size) : pages(pages), size(size) {}
+
+        void release();
+
+        void*  pages{nullptr};
+        size_t size{0};
+    };
+} // namespace molar::exec::jit
+
+#endif // EXECUTABLE_MEMORY_HPP
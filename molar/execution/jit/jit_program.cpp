@@ -0,0 +1,679 @@
+//
+// Created by Akashic on 10/19/2026.
+//
+
+#include "jit_program.hpp"
+
+#include <bit>
+#include <exception>
+#include <utility>
+
+#include "ast/keyword.hpp"
+#include "execution/aot/aot_program.hpp"
+#include "execution/preprocessor/execution_nodes/pre_allocated.hpp"
+#include "execution/preprocessor/execution_nodes/pre_allocated_string.hpp"
+#include "execution/preprocessor/execution_nodes/pre_allocated_variable.hpp"
+#include "execution/preprocessor/execution_nodes/select_expression.hpp"
+#include "internal/checked_down_cast.hpp"
+#include "x64_assembler.hpp"
+
+namespace molar::exec::jit {
+    using namespace molar::ast;
+    using molar::details::type_asserted_cast;
+
+    namespace {
+        using Reg     = X64Assembler::Reg;
+        using Xmm     = X64Assembler::Xmm;
+        using Memory  = X64Assembler::Memory;
+        using SseOp   = X64Assembler::SseOp;
+        using Compare = X64Assembler::Compare;
+
+        // Generated code returns the bits of a MolangValue in rax
+        using Entry = uint64_t (*)(MolangValue* variables, MolangValue* temps, ExecutionFrame*);
+
+        struct Unsupported {};
+
+        static_assert(sizeof(MolangValue) == sizeof(uint64_t), "A value must fit in rax");
+
+        uint64_t to_bits(const MolangValue value) { return std::bit_cast<uint64_t>(value); }
+
+        MolangValue from_bits(const uint64_t bits) { return std::bit_cast<MolangValue>(bits); }
+
+        constexpr uint64_t kind_bits(const ValueKind kind) {
+            return static_cast<uint8_t>(kind);
+        }
+
+        constexpr uint32_t float_bits(const float value) {
+            return std::bit_cast<uint32_t>(value);
+        }
+
+        ///@brief Generated code builds and reads values as the kind in the low byte and the
+        /// payload in the high 4 bytes. That's what every mainstream compiler does with
+        /// MolangValue, but it isn't promised, so it's checked before anything is compiled
+        bool value_layout_matches() {
+            constexpr uint64_t mask = 0xFFFFFFFF000000FFull;
+
+            const auto number = to_bits(MolangValue{1.5f}) & mask;
+            const auto string = to_bits(MolangValue{InternedString{7}}) & mask;
+            const auto payload = uint64_t{float_bits(1.5f)} << 32;
+            return number == (payload | kind_bits(ValueKind::Number)) &&
+                   string == ((uint64_t{7} << 32) | kind_bits(ValueKind::String));
+        }
+
+        // Called from generated code for anything which is more than a few instructions
+
+        float jit_equal(const uint64_t left, const uint64_t right) {
+            return aot::equal(from_bits(left), from_bits(right)) ? 1.0f : 0.0f;
+        }
+
+        // Generated code has no unwind info, so nothing may be thrown through it. A handler
+        // which throws makes jit_query return this kind instead, which no value has, and
+        // the generated code returns it straight away so evaluate can rethrow
+        constexpr uint8_t failed_kind = 0xFF;
+
+        // Set by jit_query right before it returns failed_kind, a query handler may evaluate
+        // other programs on the same thread so it's taken as soon as the program returns
+        thread_local std::exception_ptr query_error{};
+
+        uint64_t jit_query(
+            ExecutionFrame* frame, const uint32_t call_id, const MolangValue* arguments,
+            const size_t count
+        ) noexcept {
+            try {
+                return to_bits(aot::query(*frame, call_id, {arguments, count}));
+            } catch (...) {
+                query_error = std::current_exception();
+                return failed_kind;
+            }
+        }
+
+        float jit_random(
+            const math::MathFunctionInfo* function, const float* arguments,
+            ExecutionFrame* frame, const uint32_t call_site, const uint32_t program
+        ) {
+            math::RandomStream stream{frame->entity, call_site, frame->random_counter, program};
+            const float        result = function->scalar(arguments, stream);
+            frame->random_counter     = stream.get_counter();
+            return result;
+        }
+
+        // Passed to the kernels which aren't random, they never touch it
+        math::RandomStream unused_stream{};
+
+        template <typename Function> uint64_t address_of(Function* function) {
+            return std::bit_cast<uint64_t>(function);
+        }
+
+        ///@brief Lowers the processed tree. An expression leaves a number in xmm0 or the bits
+        /// of a value in rax, intermediate results are spilled to a stack area addressed
+        /// from rsp, which never moves after the prologue.
+        ///
+        /// rbx holds the frame, r12 the variable slots and r13 the temp slots
+        class Compiler {
+        public:
+            Compiler(MolangProgram& program, const TypeSignatures& signatures)
+                : program(program), types(TypeInference::infer(program, signatures)) {}
+
+            std::vector<uint8_t> compile() {
+                auto& as = this->assembler;
+
+                as.push(Reg::Rbp);
+                as.mov(Reg::Rbp, Reg::Rsp);
+                as.push(Reg::Rbx);
+                as.push(Reg::R12);
+                as.push(Reg::R13);
+                const auto frame_size = as.sub_patchable(Reg::Rsp);
+                as.mov(Reg::R12, Reg::Rdi);
+                as.mov(Reg::R13, Reg::Rsi);
+                as.mov(Reg::Rbx, Reg::Rdx);
+
+                this->epilogue   = as.new_label();
+                auto& statements = this->program.get_expressions();
+                if (statements.empty()) {
+                    as.mov_immediate(Reg::Rax, 0);
+                }
+                for (size_t i = 0; i < statements.size(); i++) {
+                    const auto type = this->lower(*statements[i], true);
+                    if (i + 1 == statements.size()) {
+                        this->to_value(type);
+                    }
+                }
+
+                as.bind(this->epilogue);
+                as.lea(Reg::Rsp, {Reg::Rbp, -24});
+                as.pop(Reg::R13);
+                as.pop(Reg::R12);
+                as.pop(Reg::Rbx);
+                as.pop(Reg::Rbp);
+                as.ret();
+
+                // Three pushes after rbp leave rsp 8 bytes off a 16 byte boundary
+                const auto spill = (this->spill_max * 8 + 15) / 16 * 16;
+                as.patch_u32(frame_size, static_cast<uint32_t>(spill + 8));
+                return as.finish();
+            }
+
+        private:
+            enum class Type : uint8_t { Number, Value };
+
+            ///@brief Whether an expression always produces a number, decides the type of a
+            /// ternary before either branch is lowered
+            bool is_number(const RawExpression& expression) const {
+                return this->types.type_of(expression).is_number();
+            }
+
+            ///@brief `statement` is true while every parent up to the top level is a
+            /// statement, only then can `return` jump straight to the epilogue
+            Type lower(RawExpression& expression, const bool statement) {
+                auto& as = this->assembler;
+
+                switch (expression.get_type()) {
+                case AstKind::NumericLiteral:
+                    this->load_number(
+                        type_asserted_cast<NumericLiteral&>(expression).get_value()
+                    );
+                    return Type::Number;
+                case AstKind::BooleanLiteral:
+                    this->load_number(
+                        type_asserted_cast<BoolLiteral&>(expression).get_value() ? 1.0f : 0.0f
+                    );
+                    return Type::Number;
+                case AstKind::PreAllocatedString: {
+                    const auto string =
+                        type_asserted_cast<ast::PreAllocatedString&>(expression).get_value();
+                    as.mov_immediate(
+                        Reg::Rax,
+                        (uint64_t{string.get_id()} << 32) | kind_bits(ValueKind::String)
+                    );
+                    return Type::Value;
+                }
+                case AstKind::ResourceExpression:
+                    // Resources are resolved by the renderer, they have no value
+                    as.mov_immediate(Reg::Rax, kind_bits(ValueKind::Null));
+                    return Type::Value;
+                case AstKind::PreAllocatedVariableReference:
+                    as.mov(
+                        Reg::Rax,
+                        this->slot(type_asserted_cast<ast::PreAllocatedVariable&>(expression))
+                    );
+                    return Type::Value;
+                case AstKind::PreAllocatedAssignment: {
+                    auto& assign =
+                        type_asserted_cast<ast::PreAllocatedVariableAssign&>(expression);
+                    const auto type = this->lower(*assign.get_assignment(), false);
+                    if (type == Type::Number) {
+                        // Boxed into rax for the store, the number stays in xmm0
+                        this->box_number();
+                    }
+                    as.mov(this->slot(assign), Reg::Rax);
+                    return type;
+                }
+                case AstKind::ParenthesizedExpression: {
+                    auto& list = type_asserted_cast<ParenthesizedExpression&>(expression)
+                                     .get_expressions();
+                    if (list.empty()) {
+                        as.mov_immediate(Reg::Rax, kind_bits(ValueKind::Null));
+                        return Type::Value;
+                    }
+
+                    auto type = Type::Value;
+                    for (auto& inner : list) {
+                        type = this->lower(*inner, statement);
+                    }
+                    return type;
+                }
+                case AstKind::BinaryExpression:
+                    return this->lower_binary(
+                        type_asserted_cast<BinaryExpression&>(expression)
+                    );
+                case AstKind::UnaryExpression: {
+                    auto& unary = type_asserted_cast<UnaryExpression&>(expression);
+                    this->lower_number(*unary.get_expression());
+
+                    if (unary.get_operation() == UnaryOp::Not) {
+                        this->truth();
+                        this->load_number(1.0f, Xmm::Xmm1);
+                        as.sse(SseOp::Sub, Xmm::Xmm1, Xmm::Xmm0);
+                        as.sse(SseOp::Move, Xmm::Xmm0, Xmm::Xmm1);
+                    } else {
+                        as.mov_immediate(Reg::Rax, 0x80000000u);
+                        as.movd(Xmm::Xmm1, Reg::Rax);
+                        as.sse(SseOp::Xor, Xmm::Xmm0, Xmm::Xmm1);
+                    }
+                    return Type::Number;
+                }
+                case AstKind::ConditionalExpression: {
+                    auto& conditional = type_asserted_cast<ConditionalExpression&>(expression);
+                    const auto skip   = as.new_label();
+                    const auto end    = as.new_label();
+
+                    this->branch_if_false(*conditional.get_condition(), skip);
+                    this->to_value(this->lower(*conditional.get_if_expression(), statement));
+                    as.jump(end);
+                    as.bind(skip);
+                    as.mov_immediate(Reg::Rax, kind_bits(ValueKind::Null));
+                    as.bind(end);
+                    return Type::Value;
+                }
+                case AstKind::TernaryExpression: {
+                    auto&      ternary = type_asserted_cast<TernaryExpression&>(expression);
+                    const auto type =
+                        this->is_number(expression) ? Type::Number : Type::Value;
+                    const auto other   = as.new_label();
+                    const auto end     = as.new_label();
+
+                    this->branch_if_false(*ternary.get_condition(), other);
+                    this->convert(this->lower(*ternary.get_if_expression(), statement), type);
+                    as.jump(end);
+                    as.bind(other);
+                    this->convert(this->lower(*ternary.get_else_expression(), statement), type);
+                    as.bind(end);
+                    return type;
+                }
+                case AstKind::SelectExpression:
+                    return this->lower_select(
+                        type_asserted_cast<ast::SelectExpression&>(expression)
+                    );
+                case AstKind::PreAllocatedCall:
+                    return this->lower_call(
+                        type_asserted_cast<ast::PreAllocatedCall&>(expression)
+                    );
+                case AstKind::Return: {
+                    if (!statement) {
+                        throw Unsupported{};
+                    }
+
+                    auto& node = type_asserted_cast<ReturnNode&>(expression);
+                    if (node.get_value()) {
+                        this->to_value(this->lower(*node.get_value(), false));
+                    } else {
+                        as.mov_immediate(Reg::Rax, kind_bits(ValueKind::Null));
+                    }
+                    as.jump(this->epilogue);
+                    return Type::Value;
+                }
+                default:
+                    throw Unsupported{};
+                }
+            }
+
+            Type lower_binary(BinaryExpression& expression) {
+                auto&      as        = this->assembler;
+                const auto operation = expression.get_operation();
+
+                // The short circuiting operators only evaluate the right side when they need it
+                if (operation == BinaryOp::And || operation == BinaryOp::Or) {
+                    const auto end = as.new_label();
+
+                    this->lower_number(*expression.get_left());
+                    this->truth();
+                    as.movd(Reg::Rax, Xmm::Xmm0);
+                    as.test(Reg::Rax);
+                    // xmm0 already holds the result when the right side is skipped
+                    as.jump_if(
+                        operation == BinaryOp::And ? X64Assembler::Condition::Equal
+                                                   : X64Assembler::Condition::NotEqual,
+                        end
+                    );
+                    this->lower_number(*expression.get_right());
+                    this->truth();
+                    as.bind(end);
+                    return Type::Number;
+                }
+
+                if (operation == BinaryOp::Coalesce) {
+                    const auto left = this->lower(*expression.get_left(), false);
+                    if (left == Type::Number) {
+                        // A number is never null, the right side would never run
+                        return left;
+                    }
+
+                    const auto end = as.new_label();
+                    as.test_al();
+                    as.jump_if(X64Assembler::Condition::NotEqual, end);
+                    this->to_value(this->lower(*expression.get_right(), false));
+                    as.bind(end);
+                    return Type::Value;
+                }
+
+                const bool equality =
+                    operation == BinaryOp::Equality || operation == BinaryOp::Inequality;
+                if (equality &&
+                    !(this->types.type_of(*expression.get_left()).reads_as_float() &&
+                      this->types.type_of(*expression.get_right()).reads_as_float())) {
+                    // Strings and entities compare by value, see aot::equal
+                    const auto spill = this->allocate(1);
+                    this->to_value(this->lower(*expression.get_left(), false));
+                    as.mov(Memory{Reg::Rsp, spill}, Reg::Rax);
+                    this->to_value(this->lower(*expression.get_right(), false));
+                    as.mov(Reg::Rsi, Reg::Rax);
+                    as.mov(Reg::Rdi, Memory{Reg::Rsp, spill});
+                    this->call(address_of(&jit_equal));
+                    this->release(1);
+
+                    if (operation == BinaryOp::Inequality) {
+                        this->load_number(1.0f, Xmm::Xmm1);
+                        as.sse(SseOp::Sub, Xmm::Xmm1, Xmm::Xmm0);
+                        as.sse(SseOp::Move, Xmm::Xmm0, Xmm::Xmm1);
+                    }
+                    return Type::Number;
+                }
+
+                const auto spill = this->allocate(1);
+                this->lower_number(*expression.get_left());
+                as.movss(Memory{Reg::Rsp, spill}, Xmm::Xmm0);
+                this->lower_number(*expression.get_right());
+
+                // Loads the left side into xmm0 and the right side into xmm1
+                const auto in_order = [&] {
+                    as.sse(SseOp::Move, Xmm::Xmm1, Xmm::Xmm0);
+                    as.movss(Xmm::Xmm0, Memory{Reg::Rsp, spill});
+                };
+                // Loads the left side into xmm1 and keeps the right side in xmm0, `a > b` is
+                // compared as `b < a` since cmpss has no greater than
+                const auto swapped = [&] { as.movss(Xmm::Xmm1, Memory{Reg::Rsp, spill}); };
+
+                switch (operation) {
+                case BinaryOp::Addition:
+                    in_order();
+                    as.sse(SseOp::Add, Xmm::Xmm0, Xmm::Xmm1);
+                    break;
+                case BinaryOp::Subtraction:
+                    in_order();
+                    as.sse(SseOp::Sub, Xmm::Xmm0, Xmm::Xmm1);
+                    break;
+                case BinaryOp::Multiplication:
+                    in_order();
+                    as.sse(SseOp::Mul, Xmm::Xmm0, Xmm::Xmm1);
+                    break;
+                case BinaryOp::Division:
+                    in_order();
+                    as.sse(SseOp::Div, Xmm::Xmm0, Xmm::Xmm1);
+                    break;
+                case BinaryOp::LessThan:
+                    in_order();
+                    this->compare(Compare::LessThan);
+                    break;
+                case BinaryOp::LessEqualThan:
+                    in_order();
+                    this->compare(Compare::LessEqual);
+                    break;
+                case BinaryOp::GreaterThan:
+                    swapped();
+                    this->compare(Compare::LessThan);
+                    break;
+                case BinaryOp::GreaterEqualThan:
+                    swapped();
+                    this->compare(Compare::LessEqual);
+                    break;
+                case BinaryOp::Equality:
+                    swapped();
+                    this->compare(Compare::Equal);
+                    break;
+                case BinaryOp::Inequality:
+                    swapped();
+                    this->compare(Compare::NotEqual);
+                    break;
+                default:
+                    throw std::logic_error("Unknown binary operation");
+                }
+
+                this->release(1);
+                return Type::Number;
+            }
+
+            Type lower_call(ast::PreAllocatedCall& expression) {
+                auto&      as      = this->assembler;
+                const auto call_id = expression.get_value();
+
+                if (const auto* function = this->program.get_math_bindings().get(call_id)) {
+                    // Every kernel reads 4 arguments, missing ones are 0 and extra ones are
+                    // still evaluated for their side effects
+                    const auto arguments = this->allocate(2);
+                    as.mov(Memory{Reg::Rsp, arguments}, 0);
+                    as.mov(Memory{Reg::Rsp, arguments + 8}, 0);
+
+                    int32_t index = 0;
+                    for (auto& argument : expression.get_arguments()) {
+                        if (index < 4) {
+                            this->lower_number(*argument);
+                            as.movss(Memory{Reg::Rsp, arguments + 4 * index++}, Xmm::Xmm0);
+                        } else {
+                            this->lower(*argument, false);
+                        }
+                    }
+
+                    if (function->is_random) {
+                        as.mov_immediate(Reg::Rdi, address_of(function));
+                        as.lea(Reg::Rsi, {Reg::Rsp, arguments});
+                        as.mov(Reg::Rdx, Reg::Rbx);
+                        as.mov_immediate(Reg::Rcx, expression.get_call_site());
+                        as.mov_immediate(Reg::R8, this->program.get_program_id());
+                        this->call(address_of(&jit_random));
+                    } else {
+                        as.lea(Reg::Rdi, {Reg::Rsp, arguments});
+                        as.mov_immediate(Reg::Rsi, address_of(&unused_stream));
+                        this->call(address_of(function->scalar));
+                    }
+                    this->release(2);
+                    return Type::Number;
+                }
+
+                auto&      list      = expression.get_arguments();
+                const auto count     = static_cast<uint32_t>(std::max<size_t>(list.size(), 1));
+                const auto arguments = this->allocate(count);
+                for (size_t i = 0; i < list.size(); i++) {
+                    this->to_value(this->lower(*list[i], false));
+                    as.mov(
+                        Memory{Reg::Rsp, arguments + static_cast<int32_t>(8 * i)}, Reg::Rax
+                    );
+                }
+
+                as.mov(Reg::Rdi, Reg::Rbx);
+                as.mov_immediate(Reg::Rsi, call_id);
+                as.lea(Reg::Rdx, {Reg::Rsp, arguments});
+                as.mov_immediate(Reg::Rcx, list.size());
+                this->call(address_of(&jit_query));
+                this->release(count);
+
+                // The epilogue resets rsp from rbp, so it can be reached from any depth
+                as.cmp_al(failed_kind);
+                as.jump_if(X64Assembler::Condition::Equal, this->epilogue);
+                return Type::Value;
+            }
+
+            ///@brief Runs every side and picks one with a cmov, a number is picked as its
+            /// bits in the low half of rax
+            Type lower_select(ast::SelectExpression& expression) {
+                auto&      as     = this->assembler;
+                const bool number =
+                    expression.get_else_expression() && this->is_number(expression);
+                const auto type   = number ? Type::Number : Type::Value;
+                const auto spill  = this->allocate(2);
+
+                this->lower_number(*expression.get_condition());
+                this->truth();
+                as.movd(Reg::Rax, Xmm::Xmm0);
+                as.mov(Memory{Reg::Rsp, spill}, Reg::Rax);
+
+                const auto side = [&](RawExpression& inner) {
+                    this->convert(this->lower(inner, false), type);
+                    if (type == Type::Number) {
+                        as.movd(Reg::Rax, Xmm::Xmm0);
+                    }
+                };
+                side(*expression.get_if_expression());
+                as.mov(Memory{Reg::Rsp, spill + 8}, Reg::Rax);
+                if (expression.get_else_expression()) {
+                    side(*expression.get_else_expression());
+                } else {
+                    as.mov_immediate(Reg::Rax, kind_bits(ValueKind::Null));
+                }
+
+                as.mov(Reg::Rcx, Memory{Reg::Rsp, spill});
+                as.test(Reg::Rcx);
+                as.cmov(
+                    X64Assembler::Condition::NotEqual, Reg::Rax, Memory{Reg::Rsp, spill + 8}
+                );
+                if (type == Type::Number) {
+                    as.movd(Xmm::Xmm0, Reg::Rax);
+                }
+                this->release(2);
+                return type;
+            }
+
+            ///@brief Lowers a condition and jumps when it reads as false
+            void branch_if_false(RawExpression& condition, const X64Assembler::Label target) {
+                this->lower_number(condition);
+                this->truth();
+                this->assembler.movd(Reg::Rax, Xmm::Xmm0);
+                this->assembler.test(Reg::Rax);
+                this->assembler.jump_if(X64Assembler::Condition::Equal, target);
+            }
+
+            void load_number(const float value, const Xmm target = Xmm::Xmm0) {
+                this->assembler.mov_immediate(Reg::Rax, float_bits(value));
+                this->assembler.movd(target, Reg::Rax);
+            }
+
+            ///@brief Boxes the number in xmm0 into rax
+            void box_number() {
+                this->assembler.movd(Reg::Rax, Xmm::Xmm0);
+                this->assembler.shl(Reg::Rax, 32);
+                this->assembler.or_immediate(Reg::Rax, static_cast<int8_t>(ValueKind::Number));
+            }
+
+            void to_value(const Type type) {
+                if (type == Type::Number) {
+                    this->box_number();
+                }
+            }
+
+            ///@brief MolangValue::as_number of rax into xmm0
+            void to_number(const Type type) {
+                if (type == Type::Number) {
+                    return;
+                }
+
+                auto&      as     = this->assembler;
+                const auto zero   = as.new_label();
+                const auto end    = as.new_label();
+                as.cmp_al(static_cast<uint8_t>(ValueKind::Number));
+                as.jump_if(X64Assembler::Condition::NotEqual, zero);
+                as.shr(Reg::Rax, 32);
+                as.movd(Xmm::Xmm0, Reg::Rax);
+                as.jump(end);
+                as.bind(zero);
+                as.sse(SseOp::Xor, Xmm::Xmm0, Xmm::Xmm0);
+                as.bind(end);
+            }
+
+            ///@brief Lowers an operand which is only read as a number into xmm0
+            void lower_number(RawExpression& expression) {
+                if (this->lower(expression, false) == Type::Number) {
+                    return;
+                }
+
+                if (this->types.type_of(expression).reads_as_float()) {
+                    // A number or a null, whose payload is 0.0f, no need to look at the kind
+                    this->assembler.shr(Reg::Rax, 32);
+                    this->assembler.movd(Xmm::Xmm0, Reg::Rax);
+                } else {
+                    this->to_number(Type::Value);
+                }
+            }
+
+            void convert(const Type from, const Type to) {
+                if (to == Type::Number) {
+                    this->to_number(from);
+                } else {
+                    this->to_value(from);
+                }
+            }
+
+            ///@brief Turns xmm0 into 1 if it reads as true and 0 otherwise, NaN is true
+            void truth() {
+                this->assembler.sse(SseOp::Xor, Xmm::Xmm1, Xmm::Xmm1);
+                this->compare(Compare::NotEqual);
+            }
+
+            ///@brief Compares xmm0 with xmm1 into 1 or 0
+            void compare(const Compare predicate) {
+                this->assembler.cmpss(Xmm::Xmm0, Xmm::Xmm1, predicate);
+                this->load_number(1.0f, Xmm::Xmm1);
+                this->assembler.sse(SseOp::And, Xmm::Xmm0, Xmm::Xmm1);
+            }
+
+            void call(const uint64_t target) {
+                this->assembler.mov_immediate(Reg::Rax, target);
+                this->assembler.call(Reg::Rax);
+            }
+
+            Memory slot(const ast::PreAllocatedVariable& variable) const {
+                // Past this the displacement wouldn't fit, no real program gets close
+                if (variable.get_value() >= (1u << 24)) {
+                    throw Unsupported{};
+                }
+                const auto offset =
+                    static_cast<int32_t>(variable.get_value() * sizeof(MolangValue));
+                const bool temp = variable.get_storage() == VariableDeclarationType::Temp;
+                return {temp ? Reg::R13 : Reg::R12, offset};
+            }
+
+            ///@brief Reserves 8 byte spill slots, released in the reverse order
+            int32_t allocate(const uint32_t count) {
+                const auto offset = static_cast<int32_t>(this->spill_used * 8);
+                this->spill_used += count;
+                this->spill_max = std::max(this->spill_max, this->spill_used);
+                return offset;
+            }
+
+            void release(const uint32_t count) { this->spill_used -= count; }
+
+        private:
+            MolangProgram&      program;
+            ProgramTypes        types;
+            X64Assembler        assembler{};
+            X64Assembler::Label epilogue{};
+            uint32_t            spill_used{0};
+            uint32_t            spill_max{0};
+        };
+    } // namespace
+
+    std::optional<JitProgram>
+    JitProgram::compile(MolangProgram& program, const TypeSignatures& signatures) {
+#if MOLAR_JIT_AVAILABLE
+        if (!value_layout_matches()) {
+            return std::nullopt;
+        }
+
+        std::vector<uint8_t> machine_code{};
+        try {
+            machine_code = Compiler{program, signatures}.compile();
+        } catch (const Unsupported&) {
+            return std::nullopt;
+        }
+
+        auto code = ExecutableMemory::create(machine_code);
+        if (!code) {
+            return std::nullopt;
+        }
+        return JitProgram{
+            std::move(*code), program.get_variable_slot_count(), program.get_temp_slot_count()
+        };
+#else
+        return std::nullopt;
+#endif
+    }
+
+    MolangValue JitProgram::evaluate(ExecutionFrame& frame) const {
+        aot::prepare_frame(frame, this->variable_slot_count, this->temp_slot_count);
+
+        const auto entry = std::bit_cast<Entry>(this->code.get_entry());
+        const auto bits  = entry(frame.variables.data(), frame.temps.data(), &frame);
+        if ((bits & 0xFF) == failed_kind) {
+            std::rethrow_exception(std::exchange(query_error, nullptr));
+        }
+        return from_bits(bits);
+    }
+} // namespace molar::exec::jit
@@ -0,0 +1,70 @@
+//
+// Created by Akashic on 10/19/2026.
+//
+
+#ifndef JIT_PROGRAM_HPP
+#define JIT_PROGRAM_HPP
+#include <optional>
+
+#include "execution/analysis/type_inference.hpp"
+#include "execution/runtime/molang_evaluator.hpp"
+#include "executable_memory.hpp"
+
+namespace molar::exec::jit {
+    ///@brief A program compiled to x86-64 machine code. Numbers are kept unboxed in SSE
+    /// registers and only boxed into a MolangValue where a value can be something else, so
+    /// an expression like `math.sin(q.anim_time * 38) * 2` runs without any dispatch or tag
+    /// check between its operations.
+    ///
+    /// Covers literals, arithmetic, comparisons, logic, `??`, conditionals, slot loads and
+    /// stores, `return` and direct calls to math builtins and queries. Anything else, loops
+    /// and `->` for instance, makes compile return nothing and the program stays on the
+    /// interpreter
+    class JitProgram {
+    public:
+        ///@brief Compiles the program, nothing if it uses anything the JIT doesn't cover or
+        /// the JIT isn't available on this platform, see MOLAR_JIT_AVAILABLE. The signatures
+        /// let values the TypeInference proves to be numbers skip their kind checks
+        static std::optional<JitProgram>
+        compile(MolangProgram& program, const TypeSignatures& signatures = {});
+
+        ///@brief Same contract as MolangEvaluator::evaluate. An exception thrown by a query
+        /// handler stops the program at that query and is rethrown here, it never unwinds
+        /// through the generated code
+        MolangValue evaluate(ExecutionFrame& frame) const;
+
+        [[nodiscard]] size_t get_code_size() const { return this->code.get_size(); }
+
+    private:
+        JitProgram(
+            ExecutableMemory&& code, const size_t variable_slots, const size_t temp_slots
+        )
+            : code(std::move(code)), variable_slot_count(variable_slots),
+              temp_slot_count(temp_slots) {}
+
+        ExecutableMemory code;
+        size_t           variable_slot_count;
+        size_t           temp_slot_count;
+    };
+
+    ///@brief Runs a program natively when the JIT covers it and through MolangEvaluator
+    /// otherwise, so a host never has to care which one it got
+    class JitEvaluator {
+    public:
+        explicit JitEvaluator(MolangProgram& program, const TypeSignatures& signatures = {})
+            : native(JitProgram::compile(program, signatures)), interpreter(program) {}
+
+        MolangValue evaluate(ExecutionFrame& frame) {
+            return this->native ? this->native->evaluate(frame)
+                                : this->interpreter.evaluate(frame);
+        }
+
+        [[nodiscard]] bool is_native() const { return this->native.has_value(); }
+
+    private:
+        std::optional<JitProgram> native;
+        MolangEvaluator           interpreter;
+    };
+} // namespace molar::exec::jit
+
+#endif // JIT_PROGRAM_HPP
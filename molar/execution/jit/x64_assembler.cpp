@@ -0,0 +1,266 @@
+//
+// Created by Akashic on 10/19/2026.
+//
+
+#include "x64_assembler.hpp"
+
+#include <stdexcept>
+
+namespace molar::exec::jit {
+    namespace {
+        uint8_t code_of(const X64Assembler::Reg reg) { return static_cast<uint8_t>(reg); }
+
+        uint8_t code_of(const X64Assembler::Xmm reg) { return static_cast<uint8_t>(reg); }
+    } // namespace
+
+    X64Assembler::Label X64Assembler::new_label() {
+        this->labels.emplace_back(unbound);
+        return static_cast<Label>(this->labels.size() - 1);
+    }
+
+    void X64Assembler::bind(const Label label) { this->labels[label] = this->code.size(); }
+
+    void X64Assembler::push(const Reg reg) {
+        this->rex(false, 0, code_of(reg));
+        this->byte(static_cast<uint8_t>(0x50 + (code_of(reg) & 7)));
+    }
+
+    void X64Assembler::pop(const Reg reg) {
+        this->rex(false, 0, code_of(reg));
+        this->byte(static_cast<uint8_t>(0x58 + (code_of(reg) & 7)));
+    }
+
+    void X64Assembler::ret() { this->byte(0xC3); }
+
+    void X64Assembler::call(const Reg target) {
+        this->rex(false, 0, code_of(target));
+        this->byte(0xFF);
+        this->modrm_register(2, code_of(target));
+    }
+
+    void X64Assembler::jump(const Label label) {
+        this->byte(0xE9);
+        this->rel32(label);
+    }
+
+    void X64Assembler::jump_if(const Condition condition, const Label label) {
+        this->byte(0x0F);
+        this->byte(static_cast<uint8_t>(0x80 + static_cast<uint8_t>(condition)));
+        this->rel32(label);
+    }
+
+    void X64Assembler::mov(const Reg destination, const Reg source) {
+        this->rex(true, code_of(source), code_of(destination));
+        this->byte(0x89);
+        this->modrm_register(code_of(source), code_of(destination));
+    }
+
+    void X64Assembler::mov(const Reg destination, const Memory source) {
+        this->rex(true, code_of(destination), code_of(source.base));
+        this->byte(0x8B);
+        this->modrm_memory(code_of(destination), source);
+    }
+
+    void X64Assembler::mov(const Memory destination, const Reg source) {
+        this->rex(true, code_of(source), code_of(destination.base));
+        this->byte(0x89);
+        this->modrm_memory(code_of(source), destination);
+    }
+
+    void X64Assembler::mov(const Memory destination, const int32_t immediate) {
+        this->rex(true, 0, code_of(destination.base));
+        this->byte(0xC7);
+        this->modrm_memory(0, destination);
+        this->u32(static_cast<uint32_t>(immediate));
+    }
+
+    void X64Assembler::mov_immediate(const Reg destination, const uint64_t immediate) {
+        const bool wide = immediate > UINT32_MAX;
+        this->rex(wide, 0, code_of(destination));
+        this->byte(static_cast<uint8_t>(0xB8 + (code_of(destination) & 7)));
+        if (wide) {
+            this->u64(immediate);
+        } else {
+            this->u32(static_cast<uint32_t>(immediate));
+        }
+    }
+
+    void X64Assembler::lea(const Reg destination, const Memory source) {
+        this->rex(true, code_of(destination), code_of(source.base));
+        this->byte(0x8D);
+        this->modrm_memory(code_of(destination), source);
+    }
+
+    void X64Assembler::cmov(
+        const Condition condition, const Reg destination, const Memory source
+    ) {
+        this->rex(true, code_of(destination), code_of(source.base));
+        this->byte(0x0F);
+        this->byte(static_cast<uint8_t>(0x40 + static_cast<uint8_t>(condition)));
+        this->modrm_memory(code_of(destination), source);
+    }
+
+    size_t X64Assembler::sub_patchable(const Reg reg) {
+        this->rex(true, 0, code_of(reg));
+        this->byte(0x81);
+        this->modrm_register(5, code_of(reg));
+        const auto position = this->code.size();
+        this->u32(0);
+        return position;
+    }
+
+    void X64Assembler::patch_u32(const size_t position, const uint32_t value) {
+        for (size_t i = 0; i < 4; i++) {
+            this->code[position + i] = static_cast<uint8_t>(value >> (8 * i));
+        }
+    }
+
+    void X64Assembler::shl(const Reg reg, const uint8_t count) {
+        this->rex(true, 0, code_of(reg));
+        this->byte(0xC1);
+        this->modrm_register(4, code_of(reg));
+        this->byte(count);
+    }
+
+    void X64Assembler::shr(const Reg reg, const uint8_t count) {
+        this->rex(true, 0, code_of(reg));
+        this->byte(0xC1);
+        this->modrm_register(5, code_of(reg));
+        this->byte(count);
+    }
+
+    void X64Assembler::or_immediate(const Reg reg, const int8_t immediate) {
+        this->rex(true, 0, code_of(reg));
+        this->byte(0x83);
+        this->modrm_register(1, code_of(reg));
+        this->byte(static_cast<uint8_t>(immediate));
+    }
+
+    void X64Assembler::cmp_al(const uint8_t immediate) {
+        this->byte(0x3C);
+        this->byte(immediate);
+    }
+
+    void X64Assembler::test_al() {
+        this->byte(0x84);
+        this->byte(0xC0);
+    }
+
+    void X64Assembler::test(const Reg reg) {
+        this->rex(false, code_of(reg), code_of(reg));
+        this->byte(0x85);
+        this->modrm_register(code_of(reg), code_of(reg));
+    }
+
+    void X64Assembler::movss(const Xmm destination, const Memory source) {
+        this->sse_memory(0xF3, 0x10, code_of(destination), source);
+    }
+
+    void X64Assembler::movss(const Memory destination, const Xmm source) {
+        this->sse_memory(0xF3, 0x11, code_of(source), destination);
+    }
+
+    void X64Assembler::movd(const Xmm destination, const Reg source) {
+        this->byte(0x66);
+        this->rex(false, code_of(destination), code_of(source));
+        this->byte(0x0F);
+        this->byte(0x6E);
+        this->modrm_register(code_of(destination), code_of(source));
+    }
+
+    void X64Assembler::movd(const Reg destination, const Xmm source) {
+        this->byte(0x66);
+        this->rex(false, code_of(source), code_of(destination));
+        this->byte(0x0F);
+        this->byte(0x7E);
+        this->modrm_register(code_of(source), code_of(destination));
+    }
+
+    void X64Assembler::sse(const SseOp operation, const Xmm destination, const Xmm source) {
+        // The packed forms have no prefix, the scalar arithmetic is F3
+        const bool packed = operation == SseOp::And || operation == SseOp::Xor ||
+                            operation == SseOp::Move;
+        if (!packed) {
+            this->byte(0xF3);
+        }
+        this->byte(0x0F);
+        this->byte(static_cast<uint8_t>(operation));
+        this->modrm_register(code_of(destination), code_of(source));
+    }
+
+    void X64Assembler::cmpss(const Xmm destination, const Xmm source, const Compare predicate) {
+        this->byte(0xF3);
+        this->byte(0x0F);
+        this->byte(0xC2);
+        this->modrm_register(code_of(destination), code_of(source));
+        this->byte(static_cast<uint8_t>(predicate));
+    }
+
+    std::vector<uint8_t> X64Assembler::finish() {
+        for (const auto& [position, label] : this->fixups) {
+            if (this->labels[label] == unbound) {
+                throw std::logic_error("A jump targets a label which was never bound");
+            }
+            // Relative to the end of the 4 byte displacement
+            const auto target = static_cast<int64_t>(this->labels[label]);
+            const auto from   = static_cast<int64_t>(position + 4);
+            this->patch_u32(
+                position, static_cast<uint32_t>(static_cast<int32_t>(target - from))
+            );
+        }
+        this->fixups.clear();
+        return std::move(this->code);
+    }
+
+    void X64Assembler::byte(const uint8_t value) { this->code.push_back(value); }
+
+    void X64Assembler::u32(const uint32_t value) {
+        for (size_t i = 0; i < 4; i++) {
+            this->byte(static_cast<uint8_t>(value >> (8 * i)));
+        }
+    }
+
+    void X64Assembler::u64(const uint64_t value) {
+        this->u32(static_cast<uint32_t>(value));
+        this->u32(static_cast<uint32_t>(value >> 32));
+    }
+
+    void X64Assembler::rex(const bool wide, const uint8_t reg, const uint8_t base) {
+        const auto prefix = static_cast<uint8_t>(
+            0x40 | (wide ? 0x08 : 0) | ((reg & 8) != 0 ? 0x04 : 0) |
+            ((base & 8) != 0 ? 0x01 : 0)
+        );
+        if (prefix != 0x40) {
+            this->byte(prefix);
+        }
+    }
+
+    void X64Assembler::modrm_register(const uint8_t reg, const uint8_t rm) {
+        this->byte(static_cast<uint8_t>(0xC0 | ((reg & 7) << 3) | (rm & 7)));
+    }
+
+    void X64Assembler::modrm_memory(const uint8_t reg, const Memory memory) {
+        const auto base = code_of(memory.base);
+        this->byte(static_cast<uint8_t>(0x80 | ((reg & 7) << 3) | (base & 7)));
+        // rsp and r12 can only be a base through a SIB byte
+        if ((base & 7) == 4) {
+            this->byte(0x24);
+        }
+        this->u32(static_cast<uint32_t>(memory.displacement));
+    }
+
+    void X64Assembler::sse_memory(
+        const uint8_t prefix, const uint8_t opcode, const uint8_t reg, const Memory memory
+    ) {
+        this->byte(prefix);
+        this->rex(false, reg, code_of(memory.base));
+        this->byte(0x0F);
+        this->byte(opcode);
+        this->modrm_memory(reg, memory);
+    }
+
+    void X64Assembler::rel32(const Label label) {
+        this->fixups.push_back({this->code.size(), label});
+        this->u32(0);
+    }
+} // namespace molar::exec::jit
@@ -0,0 +1,151 @@
+//
+// Created by Akashic on 10/19/2026.
+//
+
+#ifndef X64_ASSEMBLER_HPP
+#define X64_ASSEMBLER_HPP
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace molar::exec::jit {
+    ///@brief Encodes the handful of x86-64 instructions the JIT needs. Memory operands are
+    /// always encoded with a 32 bit displacement, which keeps every encoding one shape at the
+    /// cost of a few bytes
+    class X64Assembler {
+    public:
+        enum class Reg : uint8_t {
+            Rax,
+            Rcx,
+            Rdx,
+            Rbx,
+            Rsp,
+            Rbp,
+            Rsi,
+            Rdi,
+            R8,
+            R9,
+            R10,
+            R11,
+            R12,
+            R13,
+            R14,
+            R15,
+        };
+
+        enum class Xmm : uint8_t { Xmm0, Xmm1, Xmm2 };
+
+        enum class Condition : uint8_t {
+            Equal    = 0x4,
+            NotEqual = 0x5,
+        };
+
+        enum class SseOp : uint8_t {
+            Add  = 0x58,
+            Mul  = 0x59,
+            Sub  = 0x5C,
+            Div  = 0x5E,
+            // Packed, only used for bit masks
+            And  = 0x54,
+            Xor  = 0x57,
+            Move = 0x28,
+        };
+
+        ///@brief The predicates of cmpss
+        enum class Compare : uint8_t {
+            Equal        = 0,
+            LessThan     = 1,
+            LessEqual    = 2,
+            // True when unordered, like `!=` in C++
+            NotEqual     = 4,
+        };
+
+        struct Memory {
+            Reg     base;
+            int32_t displacement;
+        };
+
+        using Label = uint32_t;
+
+        Label new_label();
+
+        void bind(Label label);
+
+        void push(Reg reg);
+        void pop(Reg reg);
+        void ret();
+        void call(Reg target);
+
+        void jump(Label label);
+        void jump_if(Condition condition, Label label);
+
+        ///@brief 64 bit moves
+        void mov(Reg destination, Reg source);
+        void mov(Reg destination, Memory source);
+        void mov(Memory destination, Reg source);
+        ///@brief Stores a sign extended 32 bit immediate as a qword
+        void mov(Memory destination, int32_t immediate);
+        ///@brief Uses the shortest encoding, a 32 bit move zero extends
+        void mov_immediate(Reg destination, uint64_t immediate);
+
+        void lea(Reg destination, Memory source);
+
+        ///@brief 64 bit `cmovcc`, loads the memory only when the condition holds
+        void cmov(Condition condition, Reg destination, Memory source);
+
+        ///@brief `sub reg, imm32`, returns where the immediate is so it can be patched
+        size_t sub_patchable(Reg reg);
+        void   patch_u32(size_t position, uint32_t value);
+
+        void shl(Reg reg, uint8_t count);
+        void shr(Reg reg, uint8_t count);
+        void or_immediate(Reg reg, int8_t immediate);
+
+        void cmp_al(uint8_t immediate);
+        void test_al();
+        ///@brief 32 bit test of a register with itself
+        void test(Reg reg);
+
+        void movss(Xmm destination, Memory source);
+        void movss(Memory destination, Xmm source);
+        ///@brief Moves the low 32 bits, a move into a general register zero extends
+        void movd(Xmm destination, Reg source);
+        void movd(Reg destination, Xmm source);
+
+        void sse(SseOp operation, Xmm destination, Xmm source);
+        void cmpss(Xmm destination, Xmm source, Compare predicate);
+
+        [[nodiscard]] size_t size() const { return this->code.size(); }
+
+        ///@brief Resolves every jump, throws if a label was used but never bound
+        std::vector<uint8_t> finish();
+
+    private:
+        void byte(uint8_t value);
+        void u32(uint32_t value);
+        void u64(uint64_t value);
+
+        void rex(bool wide, uint8_t reg, uint8_t base);
+        void modrm_register(uint8_t reg, uint8_t rm);
+        void modrm_memory(uint8_t reg, Memory memory);
+
+        ///@brief A scalar single SSE instruction, `prefix 0F opcode`
+        void sse_memory(uint8_t prefix, uint8_t opcode, uint8_t reg, Memory memory);
+
+        void rel32(Label label);
+
+    private:
+        struct Fixup {
+            size_t position;
+            Label  label;
+        };
+
+        static constexpr size_t unbound = SIZE_MAX;
+
+        std::vector<uint8_t> code{};
+        std::vector<size_t>  labels{};
+        std::vector<Fixup>   fixups{};
+    };
+} // namespace molar::exec::jit
+
+#endif // X64_ASSEMBLER_HPP
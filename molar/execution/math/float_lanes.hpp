@@ -0,0 +1,168 @@
+//
+// Created by Akashic on 10/19/2026.
+//
+
+#ifndef FLOAT_LANES_HPP
+#define FLOAT_LANES_HPP
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+namespace molar::exec::math {
+    // Scalar building blocks for lane loops. Each one is branch free and stays out of libm,
+    // whose floor, nearbyint and friends are calls unless SSE4.1 is enabled, so a loop over
+    // lanes built from these, arithmetic and compares vectorises with plain SSE2
+    namespace lanes {
+        ///@brief `condition ? a : b` done on the bits. A plain ternary on floats is kept as a
+        /// branch whenever either side could raise a float exception, which blocks
+        /// vectorisation
+        inline float blend(const bool condition, const float a, const float b) {
+            const uint32_t mask = 0u - static_cast<uint32_t>(condition);
+            return std::bit_cast<float>(
+                (std::bit_cast<uint32_t>(a) & mask) | (std::bit_cast<uint32_t>(b) & ~mask)
+            );
+        }
+
+        ///@brief Copies the sign bit of `sign` onto a value whose sign bit is clear or
+        /// already matches
+        inline float with_sign_of(const float value, const float sign) {
+            return std::bit_cast<float>(
+                std::bit_cast<uint32_t>(value) | (std::bit_cast<uint32_t>(sign) & 0x80000000u)
+            );
+        }
+
+        ///@brief std::nearbyint in the default rounding mode. Adding and removing 2^23 leaves
+        /// no fraction bits, anything at or past 2^23 is already an integer and is kept
+        inline float round_even(const float value) {
+            constexpr float limit     = 8388608.0f;
+            const float     magnitude = std::bit_cast<float>(
+                std::bit_cast<uint32_t>(value) & 0x7FFFFFFFu
+            );
+            const float rounded = (magnitude + limit) - limit;
+            return lanes::blend(magnitude < limit, lanes::with_sign_of(rounded, value), value);
+        }
+
+        ///@brief std::trunc. Below 2^23 it goes through an int32 conversion, everything else,
+        /// NaN included, is already integral and is kept
+        inline float trunc(const float value) {
+            const bool small = std::bit_cast<float>(
+                                   std::bit_cast<uint32_t>(value) & 0x7FFFFFFFu
+                               ) < 8388608.0f;
+            // The conversion only ever sees in range values
+            const auto whole = static_cast<float>(
+                static_cast<int32_t>(lanes::blend(small, value, 0.0f))
+            );
+            return lanes::blend(small, lanes::with_sign_of(whole, value), value);
+        }
+
+        ///@brief std::floor. Every result keeps the sign of the input, -0 included
+        inline float floor(const float value) {
+            const float whole = lanes::trunc(value);
+            return lanes::with_sign_of(
+                whole - lanes::blend(whole > value, 1.0f, 0.0f), value
+            );
+        }
+
+        ///@brief std::ceil
+        inline float ceil(const float value) {
+            const float whole = lanes::trunc(value);
+            return lanes::with_sign_of(
+                whole + lanes::blend(whole < value, 1.0f, 0.0f), value
+            );
+        }
+
+        ///@brief std::round, halfway cases away from zero. The fraction is split off exactly
+        /// so values just below one half aren't rounded up by the addition
+        inline float round(const float value) {
+            const float whole    = lanes::trunc(value);
+            const float fraction = std::bit_cast<float>(
+                std::bit_cast<uint32_t>(value - whole) & 0x7FFFFFFFu
+            );
+            const float step = lanes::with_sign_of(1.0f, value);
+            return lanes::with_sign_of(
+                whole + lanes::blend(fraction >= 0.5f, step, 0.0f), value
+            );
+        }
+    } // namespace lanes
+
+    ///@brief A fixed width group of floats which is operated on lane by lane. Every operation
+    /// is a straight loop over the lanes. The loop vectorises into SSE/AVX/NEON instructions
+    /// when the operation inlines to arithmetic, compares and the `lanes` helpers above; one
+    /// that calls into libm stays a loop of scalar calls
+    template <size_t Width> struct FloatLanes {
+        static constexpr size_t width = Width;
+
+        alignas(Width * sizeof(float)) std::array<float, Width> lanes{};
+
+        static constexpr FloatLanes broadcast(const float value) {
+            FloatLanes result{};
+            result.lanes.fill(value);
+            return result;
+        }
+
+        constexpr float&       operator[](const size_t index) { return this->lanes[index]; }
+        constexpr const float& operator[](const size_t index) const {
+            return this->lanes[index];
+        }
+
+        template <typename Operation>
+        [[nodiscard]] constexpr FloatLanes map(Operation&& operation) const {
+            FloatLanes result{};
+            for (size_t i = 0; i < Width; i++) {
+                result.lanes[i] = operation(this->lanes[i]);
+            }
+            return result;
+        }
+
+        template <typename Operation>
+        [[nodiscard]] constexpr FloatLanes
+        zip(const FloatLanes& other, Operation&& operation) const {
+            FloatLanes result{};
+            for (size_t i = 0; i < Width; i++) {
+                result.lanes[i] = operation(this->lanes[i], other.lanes[i]);
+            }
+            return result;
+        }
+
+        constexpr FloatLanes operator-() const {
+            return this->map([](const float a) { return -a; });
+        }
+
+        friend constexpr FloatLanes operator+(const FloatLanes& lhs, const FloatLanes& rhs) {
+            return lhs.zip(rhs, [](const float a, const float b) { return a + b; });
+        }
+
+        friend constexpr FloatLanes operator-(const FloatLanes& lhs, const FloatLanes& rhs) {
+            return lhs.zip(rhs, [](const float a, const float b) { return a - b; });
+        }
+
+        friend constexpr FloatLanes operator*(const FloatLanes& lhs, const FloatLanes& rhs) {
+            return lhs.zip(rhs, [](const float a, const float b) { return a * b; });
+        }
+
+        friend constexpr FloatLanes operator/(const FloatLanes& lhs, const FloatLanes& rhs) {
+            return lhs.zip(rhs, [](const float a, const float b) { return a / b; });
+        }
+    };
+
+    using FloatLanes4 = FloatLanes<4>;
+    using FloatLanes8 = FloatLanes<8>;
+
+    ///@brief Lane wise `condition ? if_true : if_false`, where any non zero lane is true
+    template <size_t Width>
+    constexpr FloatLanes<Width> select(
+        const FloatLanes<Width>& condition, const FloatLanes<Width>& if_true,
+        const FloatLanes<Width>& if_false
+    ) {
+        FloatLanes<Width> result{};
+        for (size_t i = 0; i < Width; i++) {
+            result.lanes[i] = lanes::blend(
+                condition.lanes[i] != 0.0f, if_true.lanes[i], if_false.lanes[i]
+            );
+        }
+        return result;
+    }
+} // namespace molar::exec::math
+
+#endif // FLOAT_LANES_HPP
@@ -0,0 +1,58 @@
+//
+// Created by Akashic on 10/19/2026.
+//
+
+#ifndef HALF_FLOAT_HPP
+#define HALF_FLOAT_HPP
+#include <bit>
+#include <cstdint>
+
+namespace molar::exec::math {
+    ///@brief The IEEE binary16 bits closest to a float, ties to even. Too large values become
+    /// infinity and a NaN keeps the top bits of its payload, so a float NaN which only uses
+    /// those survives the round trip
+    inline uint16_t to_half(const float value) {
+        const uint32_t bits = std::bit_cast<uint32_t>(value);
+        const auto     sign = static_cast<uint16_t>((bits >> 16) & 0x8000u);
+        uint32_t       abs  = bits & 0x7fffffffu;
+
+        if (abs >= 0x47800000u) {
+            // 2^16 and up, infinity or NaN
+            if (abs > 0x7f800000u) {
+                return static_cast<uint16_t>(sign | 0x7e00u | ((abs >> 13) & 0x3ffu));
+            }
+            return static_cast<uint16_t>(sign | 0x7c00u);
+        }
+        if (abs < 0x38800000u) {
+            // Below 2^-14 the result is subnormal, adding 0.5 lines the half's last bit up
+            // with the float's last bit and lets the addition do the rounding
+            const float    shifted = std::bit_cast<float>(abs) + 0.5f;
+            const uint32_t half    = std::bit_cast<uint32_t>(shifted) - 0x3f000000u;
+            return static_cast<uint16_t>(sign | half);
+        }
+
+        // Rebias the exponent and round on the 13 bits which are cut, a carry out of the
+        // mantissa bumps the exponent which is what rounding up to the next power wants
+        const uint32_t odd = (abs >> 13) & 1u;
+        abs += 0xc8000fffu + odd;
+        return static_cast<uint16_t>(sign | (abs >> 13));
+    }
+
+    ///@brief The float a binary16 value stands for, exact
+    inline float from_half(const uint16_t half) {
+        const uint32_t sign     = static_cast<uint32_t>(half & 0x8000u) << 16;
+        const uint32_t exponent = (half >> 10) & 0x1fu;
+        const uint32_t mantissa = half & 0x3ffu;
+
+        if (exponent == 0) {
+            const float magnitude = static_cast<float>(mantissa) * 0x1p-24f;
+            return std::bit_cast<float>(sign | std::bit_cast<uint32_t>(magnitude));
+        }
+        if (exponent == 0x1f) {
+            return std::bit_cast<float>(sign | 0x7f800000u | (mantissa << 13));
+        }
+        return std::bit_cast<float>(sign | ((exponent + 112) << 23) | (mantissa << 13));
+    }
+} // namespace molar::exec::math
+
+#endif // HALF_FLOAT_HPP
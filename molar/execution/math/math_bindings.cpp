@@ -0,0 +1,36 @@
+//
+// Created by Akashic on 10/19/2026.
+//
+
+#include "math_bindings.hpp"
+
+#include <format>
+#include <stdexcept>
+
+namespace molar::exec::math {
+    MathBindings
+    MathBindings::bind(const AstCollectorState& state, const MathPrecision precision) {
+        MathBindings bindings{};
+        bindings.precision = precision;
+        bindings.functions.reserve(state.func_call_state.id_to_name.size());
+
+        for (const auto& full_name : state.func_call_state.id_to_name) {
+            // See CallExpression::build_full_name, the last character is the call type
+            if (full_name.empty() || full_name.back() != 'm') {
+                bindings.functions.emplace_back(nullptr);
+                continue;
+            }
+
+            const auto name     = std::string_view{full_name}.substr(0, full_name.size() - 1);
+            const auto function = find_math_function(name, precision);
+
+            if (function == nullptr) {
+                throw std::invalid_argument(std::format("Unknown math function math.{}", name));
+            }
+
+            bindings.functions.emplace_back(function);
+        }
+
+        return bindings;
+    }
+} // namespace molar::exec::math
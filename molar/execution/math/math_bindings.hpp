@@ -0,0 +1,39 @@
+//
+// Created by Akashic on 10/19/2026.
+//
+
+#ifndef MATH_BINDINGS_HPP
+#define MATH_BINDINGS_HPP
+#include <vector>
+
+#include "execution/preprocessor/molang_preprocessor.hpp"
+#include "molang_math.hpp"
+
+namespace molar::exec::math {
+    ///@brief Maps the call ids of a processed program (the value of a PreAllocatedCall) to
+    /// native math functions, so a math call is a single indexed function pointer call
+    class MathBindings {
+    public:
+        MathBindings() = default;
+
+        ///@brief Binds every `math.*` call the collector found. Throws if a program calls a
+        /// math function which doesn't exist
+        static MathBindings
+        bind(const AstCollectorState& state, MathPrecision precision = MathPrecision::Exact);
+
+        ///@brief The function for a call id, or nullptr if the call is a query
+        [[nodiscard]] const MathFunctionInfo* get(const uint32_t call_id) const {
+            return call_id < this->functions.size() ? this->functions[call_id] : nullptr;
+        }
+
+        [[nodiscard]] size_t size() const { return this->functions.size(); }
+
+        [[nodiscard]] MathPrecision get_precision() const { return this->precision; }
+
+    private:
+        std::vector<const MathFunctionInfo*> functions{};
+        MathPrecision                        precision{MathPrecision::Exact};
+    };
+} // namespace molar::exec::math
+
+#endif // MATH_BINDINGS_HPP
@@ -0,0 +1,264 @@
+//
+// Created by Akashic on 10/19/2026.
+//
+
+#include "molang_math.hpp"
+#include "molang_math_fast.hpp"
+
+#include <array>
+#include <cctype>
+#include <stdexcept>
+
+namespace molar::exec::math {
+    namespace {
+        // The wide versions map the scalar kernel over the lanes, which vectorises for the
+        // kernels that are plain arithmetic or built on the lanes helpers. acos, asin, atan,
+        // atan2, exp, ln, pow, sqrt and mod are libm calls in both tables and stay one
+        // call per lane, as do the die rolls, whose lanes loop a different number of times.
+        // sin and cos have their own lane kernel since the scalar one reduces with fmod
+
+        template <float (*Kernel)()> float scalar_nullary(const float*, RandomStream&) {
+            return Kernel();
+        }
+
+        template <float (*Kernel)(), size_t Width>
+        FloatLanes<Width> wide_nullary(const FloatLanes<Width>*, RandomLanes<Width>&) {
+            return FloatLanes<Width>::broadcast(Kernel());
+        }
+
+        template <float (*Kernel)(float)>
+        float scalar_unary(const float* arguments, RandomStream&) {
+            return Kernel(arguments[0]);
+        }
+
+        template <float (*Kernel)(float), size_t Width>
+        FloatLanes<Width> wide_unary(const FloatLanes<Width>* arguments, RandomLanes<Width>&) {
+            return arguments[0].map([](const float value) { return Kernel(value); });
+        }
+
+        template <size_t Width>
+        FloatLanes<Width> wide_sin(const FloatLanes<Width>* arguments, RandomLanes<Width>&) {
+            return kernels::sincos_lanes(arguments[0]).sin;
+        }
+
+        template <size_t Width>
+        FloatLanes<Width> wide_cos(const FloatLanes<Width>* arguments, RandomLanes<Width>&) {
+            return kernels::sincos_lanes(arguments[0]).cos;
+        }
+
+        template <float (*Kernel)(float, float)>
+        float scalar_binary(const float* arguments, RandomStream&) {
+            return Kernel(arguments[0], arguments[1]);
+        }
+
+        template <float (*Kernel)(float, float), size_t Width>
+        FloatLanes<Width> wide_binary(const FloatLanes<Width>* arguments, RandomLanes<Width>&) {
+            return arguments[0].zip(arguments[1], [](const float a, const float b) {
+                return Kernel(a, b);
+            });
+        }
+
+        template <float (*Kernel)(float, float, float)>
+        float scalar_ternary(const float* arguments, RandomStream&) {
+            return Kernel(arguments[0], arguments[1], arguments[2]);
+        }
+
+        template <float (*Kernel)(float, float, float), size_t Width>
+        FloatLanes<Width>
+        wide_ternary(const FloatLanes<Width>* arguments, RandomLanes<Width>&) {
+            FloatLanes<Width> result{};
+            for (size_t i = 0; i < Width; i++) {
+                result[i] = Kernel(arguments[0][i], arguments[1][i], arguments[2][i]);
+            }
+            return result;
+        }
+
+        template <float (*Kernel)(float, float, float)>
+        float scalar_random_binary(const float* arguments, RandomStream& stream) {
+            return Kernel(arguments[0], arguments[1], stream.next_unit());
+        }
+
+        template <float (*Kernel)(float, float, float), size_t Width>
+        FloatLanes<Width>
+        wide_random_binary(const FloatLanes<Width>* arguments, RandomLanes<Width>& streams) {
+            const auto        units = streams.next_unit();
+            FloatLanes<Width> result{};
+            for (size_t i = 0; i < Width; i++) {
+                result[i] = Kernel(arguments[0][i], arguments[1][i], units[i]);
+            }
+            return result;
+        }
+
+        template <float (*Kernel)(float, float, float, RandomStream&)>
+        float scalar_random_ternary(const float* arguments, RandomStream& stream) {
+            return Kernel(arguments[0], arguments[1], arguments[2], stream);
+        }
+
+        template <float (*Kernel)(float, float, float, RandomStream&), size_t Width>
+        FloatLanes<Width>
+        wide_random_ternary(const FloatLanes<Width>* arguments, RandomLanes<Width>& streams) {
+            // Every lane can roll a different number of times, so each one draws from its
+            // own stream
+            FloatLanes<Width> result{};
+            for (size_t i = 0; i < Width; i++) {
+                auto stream = streams.get_lane(i);
+                result[i]   = Kernel(arguments[0][i], arguments[1][i], arguments[2][i], stream);
+                streams.set_lane(i, stream);
+            }
+            return result;
+        }
+
+        template <float (*Kernel)()>
+        constexpr MathFunctionInfo nullary(const std::string_view name, const MathFunction id) {
+            return {
+                name, id, false, &scalar_nullary<Kernel>, &wide_nullary<Kernel, 4>,
+                &wide_nullary<Kernel, 8>
+            };
+        }
+
+        template <float (*Kernel)(float)>
+        constexpr MathFunctionInfo unary(const std::string_view name, const MathFunction id) {
+            return {
+                name, id, false, &scalar_unary<Kernel>, &wide_unary<Kernel, 4>,
+                &wide_unary<Kernel, 8>
+            };
+        }
+
+        template <float (*Kernel)(float), WideMathFn<4> Wide4, WideMathFn<8> Wide8>
+        constexpr MathFunctionInfo
+        unary_lanes(const std::string_view name, const MathFunction id) {
+            return {name, id, false, &scalar_unary<Kernel>, Wide4, Wide8};
+        }
+
+        template <float (*Kernel)(float, float)>
+        constexpr MathFunctionInfo binary(const std::string_view name, const MathFunction id) {
+            return {
+                name, id, false, &scalar_binary<Kernel>, &wide_binary<Kernel, 4>,
+                &wide_binary<Kernel, 8>
+            };
+        }
+
+        template <float (*Kernel)(float, float, float)>
+        constexpr MathFunctionInfo ternary(const std::string_view name, const MathFunction id) {
+            return {
+                name, id, false, &scalar_ternary<Kernel>, &wide_ternary<Kernel, 4>,
+                &wide_ternary<Kernel, 8>
+            };
+        }
+
+        template <float (*Kernel)(float, float, float)>
+        constexpr MathFunctionInfo
+        random_binary(const std::string_view name, const MathFunction id) {
+            return {
+                name, id, true, &scalar_random_binary<Kernel>,
+                &wide_random_binary<Kernel, 4>, &wide_random_binary<Kernel, 8>
+            };
+        }
+
+        template <float (*Kernel)(float, float, float, RandomStream&)>
+        constexpr MathFunctionInfo
+        random_ternary(const std::string_view name, const MathFunction id) {
+            return {
+                name, id, true, &scalar_random_ternary<Kernel>,
+                &wide_random_ternary<Kernel, 4>, &wide_random_ternary<Kernel, 8>
+            };
+        }
+
+        using enum MathFunction;
+
+        // Must stay in the same order as MathFunction
+        constexpr auto function_table = std::array{
+            unary<kernels::abs>("abs", Abs),
+            unary<kernels::acos>("acos", Acos),
+            unary<kernels::asin>("asin", Asin),
+            unary<kernels::atan>("atan", Atan),
+            binary<kernels::atan2>("atan2", Atan2),
+            unary<kernels::ceil>("ceil", Ceil),
+            ternary<kernels::clamp>("clamp", Clamp),
+            unary_lanes<kernels::cos, &wide_cos<4>, &wide_cos<8>>("cos", Cos),
+            random_ternary<kernels::die_roll>("die_roll", DieRoll),
+            random_ternary<kernels::die_roll_integer>("die_roll_integer", DieRollInteger),
+            unary<kernels::exp>("exp", Exp),
+            unary<kernels::floor>("floor", Floor),
+            unary<kernels::hermite_blend>("hermite_blend", HermiteBlend),
+            ternary<kernels::lerp>("lerp", Lerp),
+            ternary<kernels::lerp_rotate>("lerprotate", LerpRotate),
+            unary<kernels::ln>("ln", Ln),
+            binary<kernels::max>("max", Max),
+            binary<kernels::min>("min", Min),
+            unary<kernels::min_angle>("min_angle", MinAngle),
+            binary<kernels::mod>("mod", Mod),
+            nullary<kernels::pi>("pi", Pi),
+            binary<kernels::pow>("pow", Pow),
+            random_binary<kernels::random>("random", Random),
+            random_binary<kernels::random_integer>("random_integer", RandomInteger),
+            unary<kernels::round>("round", Round),
+            unary_lanes<kernels::sin, &wide_sin<4>, &wide_sin<8>>("sin", Sin),
+            unary<kernels::sqrt>("sqrt", Sqrt),
+            unary<kernels::trunc>("trunc", Trunc),
+        };
+
+        static_assert(
+            [] {
+                if (function_table.size() != math_function_names.size()) {
+                    return false;
+                }
+                for (size_t i = 0; i < function_table.size(); i++) {
+                    const auto& info = function_table[i];
+                    if (static_cast<size_t>(info.id) != i ||
+                        info.name != math_function_names[i] ||
+                        info.is_random != is_random_math_function(info.id)) {
+                        return false;
+                    }
+                }
+                return true;
+            }(),
+            "The math function table is out of order"
+        );
+
+        constexpr auto fast_function_table = [] {
+            auto table = function_table;
+
+            table[static_cast<size_t>(Sin)] = unary<fast_kernels::sin>("sin", Sin);
+            table[static_cast<size_t>(Cos)] = unary<fast_kernels::cos>("cos", Cos);
+
+            return table;
+        }();
+
+        std::span<const MathFunctionInfo> table_for(const MathPrecision precision) {
+            return precision == MathPrecision::Fast
+                       ? std::span<const MathFunctionInfo>{fast_function_table}
+                       : std::span<const MathFunctionInfo>{function_table};
+        }
+
+        bool caseless_equal(const std::string_view lhs, const std::string_view rhs) {
+            return std::ranges::equal(lhs, rhs, [](const char a, const char b) {
+                return std::tolower(static_cast<unsigned char>(a)) ==
+                       std::tolower(static_cast<unsigned char>(b));
+            });
+        }
+    } // namespace
+
+    std::span<const MathFunctionInfo> math_functions(const MathPrecision precision) {
+        return table_for(precision);
+    }
+
+    const MathFunctionInfo&
+    get_math_function(const MathFunction function, const MathPrecision precision) {
+        const auto table = table_for(precision);
+        if (static_cast<size_t>(function) >= table.size()) {
+            throw std::out_of_range("Invalid math function");
+        }
+        return table[static_cast<size_t>(function)];
+    }
+
+    const MathFunctionInfo*
+    find_math_function(const std::string_view name, const MathPrecision precision) {
+        for (const auto& info : table_for(precision)) {
+            if (caseless_equal(info.name, name)) {
+                return &info;
+            }
+        }
+        return nullptr;
+    }
+} // namespace molar::exec::math
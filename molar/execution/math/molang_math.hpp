@@ -0,0 +1,355 @@
+//
+// Created by Akashic on 10/19/2026.
+//
+
+#ifndef MOLANG_MATH_HPP
+#define MOLANG_MATH_HPP
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numbers>
+#include <span>
+#include <string_view>
+
+#include "float_lanes.hpp"
+#include "molang_random.hpp"
+
+namespace molar::exec::math {
+    enum class MathFunction : uint8_t {
+        Abs,
+        Acos,
+        Asin,
+        Atan,
+        Atan2,
+        Ceil,
+        Clamp,
+        Cos,
+        DieRoll,
+        DieRollInteger,
+        Exp,
+        Floor,
+        HermiteBlend,
+        Lerp,
+        LerpRotate,
+        Ln,
+        Max,
+        Min,
+        MinAngle,
+        Mod,
+        Pi,
+        Pow,
+        Random,
+        RandomInteger,
+        Round,
+        Sin,
+        Sqrt,
+        Trunc,
+    };
+
+    enum class MathPrecision : uint8_t {
+        // libm results, or within 1 ulp of them for the kernels implemented here
+        Exact,
+        // Float polynomial approximations for sin and cos, see molang_math_fast.hpp for their
+        // error. Every other builtin is the exact one. Meant for cosmetic expressions only
+        Fast,
+    };
+
+    // Every function takes an argument array which is always 4 long, missing arguments are
+    // passed as 0 and extra ones are dropped, arity isn't checked anywhere
+    using ScalarMathFn = float (*)(const float* arguments, RandomStream& stream);
+
+    template <size_t Width>
+    using WideMathFn = FloatLanes<Width> (*)(
+        const FloatLanes<Width>* arguments, RandomLanes<Width>& streams
+    );
+
+    struct MathFunctionInfo {
+        std::string_view name{};
+        MathFunction     id{};
+        // Random functions can't be folded, hoisted or shared between call sites
+        bool             is_random{};
+        ScalarMathFn     scalar{};
+        WideMathFn<4>    wide_4{};
+        WideMathFn<8>    wide_8{};
+    };
+
+    ///@brief The Molang name of every builtin, indexed by MathFunction. Kept apart from the
+    /// function table so calls can also be resolved during constant evaluation
+    constexpr auto math_function_names = std::array<std::string_view, 28>{
+        "abs", "acos", "asin", "atan", "atan2", "ceil", "clamp", "cos", "die_roll",
+        "die_roll_integer", "exp", "floor", "hermite_blend", "lerp", "lerprotate", "ln",
+        "max", "min", "min_angle", "mod", "pi", "pow", "random", "random_integer", "round",
+        "sin", "sqrt", "trunc",
+    };
+
+    constexpr bool is_random_math_function(const MathFunction function) {
+        return function == MathFunction::DieRoll || function == MathFunction::DieRollInteger ||
+               function == MathFunction::Random || function == MathFunction::RandomInteger;
+    }
+
+    ///@brief Every math builtin, indexed by MathFunction
+    std::span<const MathFunctionInfo>
+    math_functions(MathPrecision precision = MathPrecision::Exact);
+
+    const MathFunctionInfo&
+    get_math_function(MathFunction function, MathPrecision precision = MathPrecision::Exact);
+
+    ///@brief Looks up a builtin by its Molang name (`sin`, `die_roll`, ...), ignoring case
+    const MathFunctionInfo*
+    find_math_function(std::string_view name, MathPrecision precision = MathPrecision::Exact);
+
+    // The scalar kernels live here so the evaluator and generated code can inline them. All
+    // angles are in degrees like Molang expects
+    namespace kernels {
+        constexpr double degrees_to_radians = std::numbers::pi / 180.0;
+        constexpr double radians_to_degrees = 180.0 / std::numbers::pi;
+
+        ///@brief Brings an angle into [-180, 180]. fmod is exact, so no precision is lost for
+        /// large angles, and folding its (-360, 360) result is exact as well
+        inline double reduce_degrees(const float degrees) {
+            const double value = std::fmod(static_cast<double>(degrees), 360.0);
+            if (value > 180.0) {
+                return value - 360.0;
+            }
+            return value < -180.0 ? value + 360.0 : value;
+        }
+
+        struct SinCos {
+            double sin;
+            double cos;
+        };
+
+        ///@brief Sine and cosine of a finite angle in about [-180, 180] degrees. The angle is
+        /// split into a quadrant and a remainder in [-45, 45] degrees, which keeps exact
+        /// results at multiples of 90 degrees, then both are evaluated with Taylor polynomials
+        /// which are accurate to well below a float ulp over that range. Branch free, so the
+        /// lane kernels below run it as is
+        inline SinCos sincos_finite(const double degrees) {
+            // Adding 1.5 * 2^52 rounds to the nearest integer, which then sits in the low bits
+            // of the sum in two's complement. That's the quadrant without an int conversion
+            constexpr double shift    = 6755399441055744.0;
+            const double     shifted  = degrees * (1.0 / 90.0) + shift;
+            const auto       q        = std::bit_cast<uint64_t>(shifted);
+            const double     quadrant = shifted - shift;
+            const double     t        = (degrees - 90.0 * quadrant) * degrees_to_radians;
+            const double t2       = t * t;
+
+            // Taylor series of sin up to t^9 and of cos up to t^10, evaluated with Horner
+            double s = 1.0 / 362880.0;
+            s        = s * t2 - 1.0 / 5040.0;
+            s        = s * t2 + 1.0 / 120.0;
+            s        = s * t2 - 1.0 / 6.0;
+            s        = (s * t2 + 1.0) * t;
+
+            double c = -1.0 / 3628800.0;
+            c        = c * t2 + 1.0 / 40320.0;
+            c        = c * t2 - 1.0 / 720.0;
+            c        = c * t2 + 1.0 / 24.0;
+            c        = c * t2 - 1.0 / 2.0;
+            c        = c * t2 + 1.0;
+
+            // Quadrant 0: (s, c), 1: (c, -s), 2: (-s, -c), 3: (-c, s)
+            // Selected and negated on the bits so the lanes stay branch free
+            const uint64_t odd      = 0ull - (q & 1u);
+            const uint64_t sin_sign = (q & 2u) << 62;
+            const uint64_t cos_sign = ((q + 1u) & 2u) << 62;
+            const auto     s_bits   = std::bit_cast<uint64_t>(s);
+            const auto     c_bits   = std::bit_cast<uint64_t>(c);
+
+            return {
+                std::bit_cast<double>(((c_bits & odd) | (s_bits & ~odd)) ^ sin_sign),
+                std::bit_cast<double>(((s_bits & odd) | (c_bits & ~odd)) ^ cos_sign)
+            };
+        }
+
+        ///@brief sincos_finite for an angle in [-180, 180] degrees. Infinite and NaN inputs
+        /// give NaN
+        inline SinCos sincos_reduced(const double degrees) {
+            if (!std::isfinite(degrees)) {
+                // The polynomials would give NaN too, but with an arbitrary sign
+                constexpr double nan = std::numeric_limits<double>::quiet_NaN();
+                return {nan, nan};
+            }
+            return sincos_finite(degrees);
+        }
+
+        inline float sin(const float degrees) {
+            return static_cast<float>(sincos_reduced(reduce_degrees(degrees)).sin);
+        }
+
+        inline float cos(const float degrees) {
+            return static_cast<float>(sincos_reduced(reduce_degrees(degrees)).cos);
+        }
+
+        template <size_t Width> struct SinCosLanes {
+            FloatLanes<Width> sin;
+            FloatLanes<Width> cos;
+        };
+
+        ///@brief sin and cos of every lane, bit identical to the scalar kernels. Below 2^24
+        /// degrees the angle is reduced in float as x - 360 * k with k = round(x / 360). 360 * k
+        /// is exact there and the subtraction is between values close enough to be exact too,
+        /// so it lands on the same angle as fmod. Lanes past that or non finite are redone
+        /// with the scalar kernel afterwards, which is one branch per group
+        template <size_t Width> SinCosLanes<Width> sincos_lanes(const FloatLanes<Width>& degrees) {
+            constexpr float limit = 16777216.0f;
+
+            // Two loops, since one mixing the float reduction with the double polynomials
+            // doesn't vectorise
+            FloatLanes<Width> reduced{};
+            uint32_t          outside = 0;
+            for (size_t i = 0; i < Width; i++) {
+                // NaN fails the compare as well
+                const bool  reducible = std::fabs(degrees[i]) < limit;
+                const float input     = lanes::blend(reducible, degrees[i], 0.0f);
+                const float turns     = lanes::round_even(input * (1.0f / 360.0f));
+                const float angle     = input - 360.0f * turns;
+                // fmod gives a zero the sign of the input, the subtraction always gives +0
+                reduced[i] = lanes::blend(angle == 0.0f, input * 0.0f, angle);
+                outside |= static_cast<uint32_t>(!reducible);
+            }
+
+            SinCosLanes<Width> result{};
+            for (size_t i = 0; i < Width; i++) {
+                const auto value = sincos_finite(static_cast<double>(reduced[i]));
+                result.sin[i]    = static_cast<float>(value.sin);
+                result.cos[i]    = static_cast<float>(value.cos);
+            }
+
+            if (outside != 0) [[unlikely]] {
+                for (size_t i = 0; i < Width; i++) {
+                    if (!(std::fabs(degrees[i]) < limit)) {
+                        const auto value = sincos_reduced(reduce_degrees(degrees[i]));
+                        result.sin[i]    = static_cast<float>(value.sin);
+                        result.cos[i]    = static_cast<float>(value.cos);
+                    }
+                }
+            }
+            return result;
+        }
+
+        inline float abs(const float value) { return std::fabs(value); }
+
+        inline float acos(const float value) {
+            return static_cast<float>(std::acos(value) * radians_to_degrees);
+        }
+
+        inline float asin(const float value) {
+            return static_cast<float>(std::asin(value) * radians_to_degrees);
+        }
+
+        inline float atan(const float value) {
+            return static_cast<float>(std::atan(value) * radians_to_degrees);
+        }
+
+        inline float atan2(const float y, const float x) {
+            return static_cast<float>(std::atan2(y, x) * radians_to_degrees);
+        }
+
+        // The rounding kernels use the branch free versions from float_lanes.hpp, which give
+        // the same results as std::ceil and friends without a libm call, so their wide
+        // versions vectorise
+
+        inline float ceil(const float value) { return lanes::ceil(value); }
+
+        inline float floor(const float value) { return lanes::floor(value); }
+
+        inline float round(const float value) { return lanes::round(value); }
+
+        inline float trunc(const float value) { return lanes::trunc(value); }
+
+        inline float sqrt(const float value) { return std::sqrt(value); }
+
+        inline float exp(const float value) { return std::exp(value); }
+
+        inline float ln(const float value) { return std::log(value); }
+
+        inline float pow(const float base, const float exponent) {
+            return std::pow(base, exponent);
+        }
+
+        inline float mod(const float value, const float denominator) {
+            return std::fmod(value, denominator);
+        }
+
+        inline float min(const float a, const float b) { return a < b ? a : b; }
+
+        inline float max(const float a, const float b) { return a > b ? a : b; }
+
+        inline float clamp(const float value, const float low, const float high) {
+            return min(max(value, low), high);
+        }
+
+        inline float lerp(const float start, const float end, const float t) {
+            return start + (end - start) * t;
+        }
+
+        inline float hermite_blend(const float t) { return t * t * (3.0f - 2.0f * t); }
+
+        ///@brief Wraps an angle into [-180, 180)
+        inline float min_angle(const float degrees) {
+            return degrees - 360.0f * lanes::floor((degrees + 180.0f) * (1.0f / 360.0f));
+        }
+
+        ///@brief Interpolates between two angles along the shortest path
+        inline float lerp_rotate(const float start, const float end, const float t) {
+            const float from = min_angle(start);
+            const float diff = min_angle(min_angle(end) - from);
+            return from + diff * t;
+        }
+
+        inline float pi() { return std::numbers::pi_v<float>; }
+
+        // The random kernels take a draw in [0, 1) instead of the stream so the wide
+        // versions can generate every lane's draw in one go
+
+        ///@brief A float in [low, high)
+        inline float random(const float low, const float high, const float unit) {
+            return low + (high - low) * unit;
+        }
+
+        ///@brief An integer in [low, high]
+        inline float random_integer(const float low, const float high, const float unit) {
+            const float from = lanes::round(low);
+            const float to   = lanes::round(high);
+            return lanes::floor(from + (to - from + 1.0f) * unit);
+        }
+
+        ///@brief The most rolls a die_roll sums, larger counts are clamped to it. Same limit
+        /// as `loop`, see MolangEvaluator::max_loop_iterations
+        constexpr uint32_t max_die_rolls = 1024;
+
+        ///@brief How many rolls `count` asks for, NaN and counts below 1 roll nothing
+        inline uint32_t die_roll_count(const float count) {
+            // NaN is kept by min and then fails the compare, so it never reaches the cast
+            const float limit = std::min(count, static_cast<float>(max_die_rolls));
+            return limit > 0.0f ? static_cast<uint32_t>(limit) : 0u;
+        }
+
+        ///@brief The sum of `count` rolls of random(low, high)
+        inline float
+        die_roll(const float count, const float low, const float high, RandomStream& stream) {
+            float total = 0.0f;
+            for (auto i = die_roll_count(count); i > 0; i--) {
+                total += kernels::random(low, high, stream.next_unit());
+            }
+            return total;
+        }
+
+        ///@brief The sum of `count` rolls of random_integer(low, high)
+        inline float die_roll_integer(
+            const float count, const float low, const float high, RandomStream& stream
+        ) {
+            float total = 0.0f;
+            for (auto i = die_roll_count(count); i > 0; i--) {
+                total += kernels::random_integer(low, high, stream.next_unit());
+            }
+            return total;
+        }
+    } // namespace kernels
+} // namespace molar::exec::math
+
+#endif // MOLANG_MATH_HPP
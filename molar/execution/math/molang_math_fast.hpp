@@ -0,0 +1,80 @@
+//
+// Created by Akashic on 10/19/2026.
+//
+
+#ifndef MOLANG_MATH_FAST_HPP
+#define MOLANG_MATH_FAST_HPP
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <numbers>
+
+#include "float_lanes.hpp"
+
+namespace molar::exec::math::fast_kernels {
+    // Approximations used by MathPrecision::Fast. Everything is done in float with no
+    // branches and no libm calls, rounding goes through the lanes helpers, so the wide
+    // versions vectorise. Special inputs are handled with selects. The error bounds are the
+    // maximum measured by molar_bench over the documented range. Only sin and cos are here,
+    // the libm sqrt, exp, ln and pow beat every approximation molar_bench measured
+
+    constexpr float degrees_to_radians = std::numbers::pi_v<float> / 180.0f;
+
+    using lanes::blend;
+
+    struct SinCos {
+        float sin;
+        float cos;
+    };
+
+    ///@brief Same quadrant split as the exact version but with the reduction and the
+    /// polynomials (sin to t^7, cos to t^8) done in float. The reduction is still exact for
+    /// angles below 2^24 degrees since both subtractions are between close values. Infinite
+    /// and NaN inputs give NaN
+    inline SinCos sincos(const float degrees) {
+        constexpr float nan = std::numeric_limits<float>::quiet_NaN();
+
+        // Non finite inputs are replaced before any float to int conversion sees them
+        const bool  finite   = (std::bit_cast<uint32_t>(degrees) & 0x7FFFFFFFu) < 0x7F800000u;
+        const float input    = fast_kernels::blend(finite, degrees, 0.0f);
+        const float reduced  = input - 360.0f * lanes::round_even(input * (1.0f / 360.0f));
+        const float quadrant = lanes::round_even(reduced * (1.0f / 90.0f));
+        const float t        = (reduced - 90.0f * quadrant) * degrees_to_radians;
+        const float t2       = t * t;
+
+        float s = -1.0f / 5040.0f;
+        s       = s * t2 + 1.0f / 120.0f;
+        s       = s * t2 - 1.0f / 6.0f;
+        s       = (s * t2 + 1.0f) * t;
+
+        float c = 1.0f / 40320.0f;
+        c       = c * t2 - 1.0f / 720.0f;
+        c       = c * t2 + 1.0f / 24.0f;
+        c       = c * t2 - 1.0f / 2.0f;
+        c       = c * t2 + 1.0f;
+
+        // Past 2^24 degrees the reduction is off by more than a turn and the quadrant can
+        // leave the int32 range, it is wrapped to [0, 4) in float first, which is exact
+        const float wrapped  = quadrant - 4.0f * lanes::floor(quadrant * 0.25f);
+        const auto  q        = static_cast<int32_t>(wrapped) & 3;
+        const float odd      = static_cast<float>(q & 1);
+        const float sin      = odd * c + (1.0f - odd) * s;
+        const float cos      = odd * s + (1.0f - odd) * c;
+        const float sin_sign = 1.0f - static_cast<float>(q & 2);
+        const float cos_sign = 1.0f - static_cast<float>((q + 1) & 2);
+
+        return {
+            fast_kernels::blend(finite, sin * sin_sign, nan),
+            fast_kernels::blend(finite, cos * cos_sign, nan)
+        };
+    }
+
+    ///@brief Max absolute error 3.8e-7 for |degrees| < 2^24
+    inline float sin(const float degrees) { return sincos(degrees).sin; }
+
+    ///@brief Max absolute error 3.8e-7 for |degrees| < 2^24
+    inline float cos(const float degrees) { return sincos(degrees).cos; }
+} // namespace molar::exec::math::fast_kernels
+
+#endif // MOLANG_MATH_FAST_HPP
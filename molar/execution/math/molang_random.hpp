@@ -0,0 +1,151 @@
+//
+// Created by Akashic on 10/19/2026.
+//
+
+#ifndef MOLANG_RANDOM_HPP
+#define MOLANG_RANDOM_HPP
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include "float_lanes.hpp"
+
+namespace molar::exec::math {
+    namespace details {
+        ///@brief One Philox4x32-10 block. The result is a pure function of the counter and
+        /// the key, so any draw can be regenerated without replaying the ones before it
+        constexpr std::array<uint32_t, 4>
+        philox4x32(std::array<uint32_t, 4> counter, std::array<uint32_t, 2> key) {
+            constexpr uint64_t multiplier_0 = 0xD2511F53u;
+            constexpr uint64_t multiplier_1 = 0xCD9E8D57u;
+
+            for (int round = 0; round < 10; round++) {
+                const uint64_t product_0 = multiplier_0 * counter[0];
+                const uint64_t product_1 = multiplier_1 * counter[2];
+
+                counter = {
+                    static_cast<uint32_t>(product_1 >> 32) ^ counter[1] ^ key[0],
+                    static_cast<uint32_t>(product_1),
+                    static_cast<uint32_t>(product_0 >> 32) ^ counter[3] ^ key[1],
+                    static_cast<uint32_t>(product_0),
+                };
+
+                // Weyl sequence bumps of the key between rounds
+                key[0] += 0x9E3779B9u;
+                key[1] += 0xBB67AE85u;
+            }
+            return counter;
+        }
+
+        ///@brief The draw for an (entity, program, call site, counter) tuple as a float in
+        /// [0, 1). The entity is the key, the rest fills the counter block
+        constexpr float philox_unit(
+            const uint64_t entity, const uint32_t program, const uint32_t call_site,
+            const uint64_t counter
+        ) {
+            const std::array<uint32_t, 4> block = philox4x32(
+                {static_cast<uint32_t>(counter), static_cast<uint32_t>(counter >> 32),
+                 call_site, program},
+                {static_cast<uint32_t>(entity), static_cast<uint32_t>(entity >> 32)}
+            );
+            // The top 24 bits fill the whole float mantissa
+            return static_cast<float>(block[0] >> 8) * 0x1.0p-24f;
+        }
+    } // namespace details
+
+    ///@brief The id which keeps the random streams of different programs apart, the 32 bit
+    /// FNV-1a hash of the source. Call sites are numbered from 0 in every program, without it
+    /// two scripts evaluated for the same entity would draw the same sequence. A hash of the
+    /// source rather than a counter, so the interpreter, program binaries, molar_aotc and
+    /// static programs agree on it
+    constexpr uint32_t program_id(const std::string_view source) {
+        uint32_t hash = 2166136261u;
+        for (const char c : source) {
+            hash = (hash ^ static_cast<uint8_t>(c)) * 16777619u;
+        }
+        return hash;
+    }
+
+    ///@brief A counter based random stream used by the random math builtins. A draw only
+    /// depends on the entity, the program, the call site and how many draws the stream has
+    /// made, so every entity gets the same sequence on replay no matter the thread or the
+    /// evaluation order. There is no shared state, a stream is 24 bytes and owned by whoever
+    /// evaluates
+    class RandomStream {
+    public:
+        constexpr RandomStream() = default;
+
+        constexpr explicit RandomStream(
+            const uint64_t entity, const uint32_t call_site = 0, const uint64_t counter = 0,
+            const uint32_t program = 0
+        )
+            : entity(entity), counter(counter), call_site(call_site), program(program) {}
+
+        ///@brief Returns a float in [0, 1)
+        constexpr float next_unit() {
+            return details::philox_unit(
+                this->entity, this->program, this->call_site, this->counter++
+            );
+        }
+
+        [[nodiscard]] constexpr uint64_t get_entity() const { return this->entity; }
+        [[nodiscard]] constexpr uint32_t get_call_site() const { return this->call_site; }
+        [[nodiscard]] constexpr uint64_t get_counter() const { return this->counter; }
+        [[nodiscard]] constexpr uint32_t get_program() const { return this->program; }
+
+    private:
+        uint64_t entity{0};
+        uint64_t counter{0};
+        uint32_t call_site{0};
+        uint32_t program{0};
+    };
+
+    ///@brief One random stream per lane for the batch mode, stored as separate arrays so a
+    /// whole group of draws is generated by one vectorised Philox pass. Every lane shares the
+    /// program and the call site, since a batch evaluates the same call for different entities
+    template <size_t Width> class RandomLanes {
+    public:
+        constexpr RandomLanes() = default;
+
+        constexpr RandomLanes(
+            const std::array<uint64_t, Width>& entities, const uint32_t call_site,
+            const uint32_t program = 0
+        )
+            : entities(entities), call_site(call_site), program(program) {}
+
+        ///@brief A float in [0, 1) for every lane, identical to what each lane's RandomStream
+        /// would return
+        constexpr FloatLanes<Width> next_unit() {
+            FloatLanes<Width> result{};
+            for (size_t i = 0; i < Width; i++) {
+                const auto counter = this->counters[i]++;
+                result[i]          = details::philox_unit(
+                    this->entities[i], this->program, this->call_site, counter
+                );
+            }
+            return result;
+        }
+
+        ///@brief The stream of a single lane, for builtins which make a different number of
+        /// draws per lane. Write it back with `set_lane` afterwards
+        [[nodiscard]] constexpr RandomStream get_lane(const size_t lane) const {
+            return RandomStream{
+                this->entities[lane], this->call_site, this->counters[lane], this->program
+            };
+        }
+
+        constexpr void set_lane(const size_t lane, const RandomStream& stream) {
+            this->entities[lane] = stream.get_entity();
+            this->counters[lane] = stream.get_counter();
+        }
+
+    private:
+        std::array<uint64_t, Width> entities{};
+        std::array<uint64_t, Width> counters{};
+        uint32_t                    call_site{0};
+        uint32_t                    program{0};
+    };
+} // namespace molar::exec::math
+
+#endif // MOLANG_RANDOM_HPP
@@ -0,0 +1,183 @@
+//
+// Created by Akashic on 10/19/2026.
+//
+
+#include "common_subexpressions.hpp"
+
+#include <algorithm>
+#include <unordered_map>
+
+#include "processed_tree.hpp"
+
+namespace molar::exec {
+    using namespace molar::ast;
+    using molar::details::type_asserted_cast;
+
+    namespace {
+        void
+        collect_nodes(RawExpression& expression, std::unordered_set<RawExpression*>& nodes) {
+            nodes.insert(&expression);
+            for_each_child(expression, [&](RawExpressionPtr& child) {
+                collect_nodes(*child, nodes);
+            });
+        }
+    } // namespace
+
+    size_t
+    CommonSubexpressions::eliminate(MolangProgram& program, const CseOptions& options) {
+        CommonSubexpressions cse{program, options};
+        cse.written_variables.resize(program.get_variable_slot_count());
+        cse.written_temps.resize(program.get_temp_slot_count());
+        for (auto& statement : program.get_expressions()) {
+            cse.collect_written(*statement);
+        }
+        for (auto& statement : program.get_expressions()) {
+            cse.collect(statement);
+        }
+
+        // Groups of equal subexpressions, in the order their first copy was found
+        std::vector<std::vector<Occurrence>>            groups{};
+        std::unordered_map<size_t, std::vector<size_t>> by_hash{};
+        for (const auto& occurrence : cse.occurrences) {
+            auto& candidates = by_hash[hash_expression(*occurrence.node)];
+            const auto match = std::ranges::find_if(candidates, [&](const size_t group) {
+                return same_expression(*groups[group].front().node, *occurrence.node);
+            });
+            if (match != candidates.end()) {
+                groups[*match].push_back(occurrence);
+            } else {
+                candidates.push_back(groups.size());
+                groups.push_back({occurrence});
+            }
+        }
+        std::ranges::stable_sort(groups, std::ranges::greater{}, [](const auto& group) {
+            return group.front().nodes;
+        });
+
+        // Nodes inside a copy which was shared already, they run at most once per group
+        std::unordered_set<RawExpression*> covered{};
+        size_t                             shared = 0;
+        for (auto& group : groups) {
+            const auto uncovered = std::ranges::count_if(group, [&](const Occurrence& copy) {
+                return !covered.contains(copy.node);
+            });
+            if (group.size() < 2 || uncovered == 0) {
+                continue;
+            }
+
+            const auto slot = program.add_temp("cse");
+            for (auto& copy : group) {
+                collect_nodes(*copy.node, covered);
+
+                auto& location = *copy.location;
+                location       = std::make_unique<BinaryExpression>(
+                    0, 0, BinaryOp::Coalesce,
+                    std::make_unique<ast::PreAllocatedVariable>(
+                        slot, VariableDeclarationType::Temp
+                    ),
+                    std::make_unique<ast::PreAllocatedVariableAssign>(
+                        slot, VariableDeclarationType::Temp, std::move(location)
+                    )
+                );
+            }
+            shared++;
+        }
+        return shared;
+    }
+
+    void CommonSubexpressions::collect_written(RawExpression& expression) {
+        const auto mark = [&](const ast::PreAllocatedVariable& variable) {
+            auto& written = variable.get_storage() == VariableDeclarationType::Temp
+                                ? this->written_temps
+                                : this->written_variables;
+            written.at(variable.get_value()) = true;
+        };
+
+        if (expression.get_type() == AstKind::PreAllocatedAssignment) {
+            mark(type_asserted_cast<ast::PreAllocatedVariable&>(expression));
+        } else if (expression.get_type() == AstKind::PreAllocatedForLoop) {
+            mark(
+                type_asserted_cast<ast::PreAllocatedForLoop&>(expression).get_variable_index()
+            );
+        } else if (expression.get_type() == AstKind::PreAllocatedCall) {
+            this->calls_impure_query |= this->purity.is_impure_query(
+                type_asserted_cast<ast::PreAllocatedCall&>(expression).get_value()
+            );
+        }
+        for_each_child(expression, [&](RawExpressionPtr& child) {
+            this->collect_written(*child);
+        });
+    }
+
+    CommonSubexpressions::Candidate
+    CommonSubexpressions::collect(RawExpressionPtr& expression) {
+        if (expression->get_type() == AstKind::ArrowAccessExpression) {
+            auto& arrow = type_asserted_cast<ArrowAccess&>(*expression);
+            this->collect(arrow.get_lhs());
+            this->foreign++;
+            this->collect(arrow.get_rhs());
+            this->foreign--;
+            return Candidate{};
+        }
+
+        const auto kind = expression->get_type();
+        Candidate  candidate{
+            this->is_invariant_node(*expression), 1, kind == AstKind::PreAllocatedCall,
+            kind == AstKind::PreAllocatedVariableReference
+        };
+        for_each_child(*expression, [&](RawExpressionPtr& child) {
+            const auto inner    = this->collect(child);
+            candidate.invariant = candidate.invariant && inner.invariant;
+            candidate.nodes += inner.nodes;
+            candidate.calls = candidate.calls || inner.calls;
+            candidate.reads = candidate.reads || inner.reads;
+        });
+
+        // Arithmetic on literals alone is left to constant folding
+        const bool worth = candidate.calls ||
+                           (candidate.reads && candidate.nodes >= this->options.min_nodes);
+        if (candidate.invariant && worth) {
+            this->occurrences.push_back(
+                Occurrence{&expression, expression.get(), candidate.nodes}
+            );
+        }
+        return candidate;
+    }
+
+    bool CommonSubexpressions::is_invariant_node(RawExpression& expression) const {
+        switch (expression.get_type()) {
+        case AstKind::NumericLiteral:
+        case AstKind::BooleanLiteral:
+        case AstKind::PreAllocatedString:
+        case AstKind::ParenthesizedExpression:
+        case AstKind::BinaryExpression:
+        case AstKind::UnaryExpression:
+        case AstKind::ConditionalExpression:
+        case AstKind::TernaryExpression:
+        case AstKind::SelectExpression:
+            return true;
+        case AstKind::PreAllocatedArrayAccess:
+            return !this->calls_impure_query;
+        case AstKind::PreAllocatedVariableReference: {
+            const auto& read = type_asserted_cast<ast::PreAllocatedVariable&>(expression);
+            const bool  temp = read.get_storage() == VariableDeclarationType::Temp;
+
+            // The host may answer a query by changing the entity's variables
+            if (!temp && this->calls_impure_query) {
+                return false;
+            }
+            const auto& written = temp ? this->written_temps : this->written_variables;
+            return !written.at(read.get_value());
+        }
+        case AstKind::PreAllocatedCall: {
+            const auto call =
+                type_asserted_cast<ast::PreAllocatedCall&>(expression).get_value();
+            const bool query = this->program.get_math_bindings().get(call) == nullptr;
+            return this->purity.is_pure(call) && !(query && this->foreign > 0);
+        }
+        default:
+            // Effects, jumps and `this`
+            return false;
+        }
+    }
+} // namespace molar::exec
@@ -0,0 +1,75 @@
+//
+// Created by Akashic on 10/19/2026.
+//
+
+#ifndef COMMON_SUBEXPRESSIONS_HPP
+#define COMMON_SUBEXPRESSIONS_HPP
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "execution/analysis/purity.hpp"
+#include "execution/runtime/molang_program.hpp"
+
+namespace molar::exec {
+    struct CseOptions {
+        ///@brief Queries the host promises are pure, see CallPurity. Only pure calls are
+        /// shared
+        std::unordered_set<std::string> pure_queries{};
+        ///@brief A repeated subexpression without a call is only shared if it has at least
+        /// this many nodes, a smaller one is cheaper to compute again than to look up
+        size_t                          min_nodes{4};
+    };
+
+    ///@brief Computes every repeated subexpression of a program once per evaluation.
+    ///
+    /// A subexpression qualifies if it only makes pure calls and only reads slots the
+    /// program never writes, it then has the same value wherever it runs during one
+    /// evaluation. A program which calls an impure query may have any of its variables
+    /// changed by the host, so only its temps count as unwritten. Each copy is replaced by
+    /// `t.#cse ?? (t.#cse = copy)`, so whichever copy runs first computes the value and the
+    /// others read it. Nothing runs earlier than it used to, a copy in a branch which isn't
+    /// taken still costs nothing. A value which is null is computed again by every copy. The
+    /// largest repeated subexpressions are shared first. The program gets new temp slots,
+    /// frames have to be sized afterwards
+    class CommonSubexpressions {
+    public:
+        ///@brief Returns how many subexpressions were shared
+        static size_t eliminate(MolangProgram& program, const CseOptions& options = {});
+
+    private:
+        struct Candidate {
+            bool   invariant{false};
+            size_t nodes{0};
+            bool   calls{false};
+            bool   reads{false};
+        };
+
+        struct Occurrence {
+            molar::ast::RawExpressionPtr* location;
+            molar::ast::RawExpression*    node;
+            size_t                        nodes;
+        };
+
+        CommonSubexpressions(MolangProgram& program, const CseOptions& options)
+            : program(program), options(options), purity(program, options.pure_queries) {}
+
+        void collect_written(molar::ast::RawExpression& expression);
+
+        Candidate collect(molar::ast::RawExpressionPtr& expression);
+
+        [[nodiscard]] bool is_invariant_node(molar::ast::RawExpression& expression) const;
+
+        MolangProgram&          program;
+        const CseOptions&       options;
+        const CallPurity        purity;
+        std::vector<bool>       written_variables{};
+        std::vector<bool>       written_temps{};
+        bool                    calls_impure_query{false};
+        std::vector<Occurrence> occurrences{};
+        // How many arrows deep the walk is on the right side
+        uint32_t                foreign{0};
+    };
+} // namespace molar::exec
+
+#endif // COMMON_SUBEXPRESSIONS_HPP
@@ -0,0 +1,242 @@
+//
+// Created by Akashic on 10/19/2026.
+//
+
+#include "dead_code.hpp"
+
+#include "processed_tree.hpp"
+
+namespace molar::exec {
+    using namespace molar::ast;
+    using molar::details::type_asserted_cast;
+
+    namespace {
+        bool is_jump(const RawExpression& expression) {
+            const auto kind = expression.get_type();
+            return kind == AstKind::Return || kind == AstKind::Break ||
+                   kind == AstKind::Continue;
+        }
+
+        ///@brief The assignment a temp assignment is, nothing for anything else
+        ast::PreAllocatedVariableAssign* as_temp_store(RawExpression& expression) {
+            if (expression.get_type() != AstKind::PreAllocatedAssignment) {
+                return nullptr;
+            }
+            auto& store = type_asserted_cast<ast::PreAllocatedVariableAssign&>(expression);
+            return store.get_storage() == VariableDeclarationType::Temp ? &store : nullptr;
+        }
+
+        size_t count_program(MolangProgram& program) {
+            size_t count = 0;
+            for (auto& statement : program.get_expressions()) {
+                count += count_nodes(*statement);
+            }
+            return count;
+        }
+    } // namespace
+
+    DeadCodeStats
+    DeadCodeElimination::eliminate(MolangProgram& program, const DeadCodeOptions& options) {
+        DeadCodeElimination pass{options};
+        const auto          before     = count_program(program);
+        auto&               statements = program.get_expressions();
+
+        pass.prune(statements, true);
+
+        // A temp nothing reads is dead wherever it's assigned, even inside an expression
+        LiveSet read = options.live_temps;
+        for (auto& statement : statements) {
+            collect_reads(*statement, read);
+        }
+        for (auto& statement : statements) {
+            pass.drop_unread(statement, read);
+        }
+
+        // Temps are reset for every evaluation, only the ones the host reads are live at the
+        // end of it
+        LiveSet live = options.live_temps;
+        pass.walk(statements, live, nullptr, true);
+
+        pass.stats.removed_nodes = before - count_program(program);
+        return pass.stats;
+    }
+
+    void DeadCodeElimination::prune(RawExpressionList& list, const bool program) {
+        for (size_t i = 0; i < list.size(); i++) {
+            prune_nested(*list[i]);
+
+            const auto kind = list[i]->get_type();
+            if (program ? kind == AstKind::Return : is_jump(*list[i])) {
+                this->stats.unreachable += list.size() - i - 1;
+                list.erase(list.begin() + static_cast<std::ptrdiff_t>(i) + 1, list.end());
+                return;
+            }
+        }
+    }
+
+    void DeadCodeElimination::prune_nested(RawExpression& expression) {
+        switch (expression.get_type()) {
+        case AstKind::ParenthesizedExpression:
+        case AstKind::BlockExpression:
+            this->prune(
+                type_asserted_cast<ParenthesizedExpression&>(expression).get_expressions(),
+                false
+            );
+            return;
+        case AstKind::LoopExpression: {
+            auto& loop = type_asserted_cast<LoopExpression&>(expression);
+            prune_nested(*loop.get_count_expression());
+            this->prune(loop.get_loop_expression().get_expressions(), false);
+            return;
+        }
+        case AstKind::PreAllocatedForLoop: {
+            auto& loop = type_asserted_cast<ast::PreAllocatedForLoop&>(expression);
+            prune_nested(*loop.get_array_fetch_expression());
+            this->prune(loop.get_loop().get_expressions(), false);
+            return;
+        }
+        default:
+            for_each_child(expression, [&](RawExpressionPtr& child) { prune_nested(*child); });
+            return;
+        }
+    }
+
+    void DeadCodeElimination::drop_unread(RawExpressionPtr& expression, const LiveSet& read) {
+        for_each_child(*expression, [&](RawExpressionPtr& child) {
+            this->drop_unread(child, read);
+        });
+        if (auto* store = as_temp_store(*expression);
+            store != nullptr && !read.contains(store->get_value())) {
+            this->stats.dead_stores++;
+            expression = std::move(store->get_assignment());
+        }
+    }
+
+    void DeadCodeElimination::walk(
+        RawExpressionList& list, LiveSet& live, const Jumps* jumps, const bool keep_last
+    ) {
+        for (size_t i = list.size(); i-- > 0;) {
+            const bool value_used = keep_last && i + 1 == list.size();
+
+            // A jump out of a statement of the program itself lands on the next statement
+            const Jumps  local  = jumps != nullptr ? Jumps{} : Jumps{live, live};
+            const Jumps& target = jumps != nullptr ? *jumps : local;
+            if (this->walk_statement(list[i], live, target, value_used)) {
+                list.erase(list.begin() + static_cast<std::ptrdiff_t>(i));
+            }
+        }
+    }
+
+    bool DeadCodeElimination::walk_statement(
+        RawExpressionPtr& statement, LiveSet& live, const Jumps& jumps, const bool value_used
+    ) {
+        // Every case leaves `live` as what's live before the statement
+        switch (statement->get_type()) {
+        case AstKind::PreAllocatedAssignment: {
+            auto* store = as_temp_store(*statement);
+            if (store == nullptr) {
+                break;
+            }
+            const auto slot = store->get_value();
+            if (!live.contains(slot)) {
+                this->stats.dead_stores++;
+                statement = std::move(store->get_assignment());
+                return this->walk_statement(statement, live, jumps, value_used);
+            }
+            // The value may still jump before the store happens, that's handled below
+            live.erase(slot);
+            break;
+        }
+        case AstKind::Return:
+            live = this->options.live_temps;
+            break;
+        case AstKind::Break:
+            live = jumps.breaks;
+            return false;
+        case AstKind::Continue:
+            live = jumps.continues;
+            return false;
+        case AstKind::BlockExpression:
+            this->walk(
+                type_asserted_cast<BlockExpression&>(*statement).get_expressions(), live,
+                &jumps, false
+            );
+            return false;
+        case AstKind::ConditionalExpression: {
+            auto&   conditional = type_asserted_cast<ConditionalExpression&>(*statement);
+            LiveSet taken       = live;
+            this->walk_statement(conditional.get_if_expression(), taken, jumps, true);
+            live.insert(taken.begin(), taken.end());
+            collect_reads(*conditional.get_condition(), live);
+            return false;
+        }
+        case AstKind::TernaryExpression: {
+            auto&   ternary = type_asserted_cast<TernaryExpression&>(*statement);
+            LiveSet taken   = live;
+            this->walk_statement(ternary.get_if_expression(), taken, jumps, true);
+            this->walk_statement(ternary.get_else_expression(), live, jumps, true);
+            live.insert(taken.begin(), taken.end());
+            collect_reads(*ternary.get_condition(), live);
+            return false;
+        }
+        case AstKind::LoopExpression:
+        case AstKind::PreAllocatedForLoop: {
+            // Anything the loop reads may be read by a later iteration, a `continue` ends
+            // up there and a `break` after the loop
+            Jumps loop{live, live};
+            collect_reads(*statement, loop.continues);
+
+            auto& body = statement->get_type() == AstKind::LoopExpression
+                             ? type_asserted_cast<LoopExpression&>(*statement)
+                                   .get_loop_expression()
+                                   .get_expressions()
+                             : type_asserted_cast<ast::PreAllocatedForLoop&>(*statement)
+                                   .get_loop()
+                                   .get_expressions();
+            LiveSet iteration = loop.continues;
+            this->walk(body, iteration, &loop, false);
+            live = std::move(loop.continues);
+            return false;
+        }
+        case AstKind::ParenthesizedExpression: {
+            auto& inner =
+                type_asserted_cast<ParenthesizedExpression&>(*statement).get_expressions();
+            this->walk(inner, live, &jumps, value_used);
+            // An empty `()` is still the value of the statement when that value is used
+            return inner.empty() && !value_used;
+        }
+        default:
+            if (!value_used && is_inert(*statement)) {
+                return true;
+            }
+            break;
+        }
+
+        collect_reads(*statement, live);
+
+        // A jump deeper in the statement may leave it halfway, so what's live where it lands
+        // is live before it too
+        if (contains_kind(*statement, AstKind::Break)) {
+            live.insert(jumps.breaks.begin(), jumps.breaks.end());
+        }
+        if (contains_kind(*statement, AstKind::Continue)) {
+            live.insert(jumps.continues.begin(), jumps.continues.end());
+        }
+        if (contains_kind(*statement, AstKind::Return)) {
+            live.insert(this->options.live_temps.begin(), this->options.live_temps.end());
+        }
+        return false;
+    }
+
+    void DeadCodeElimination::collect_reads(RawExpression& expression, LiveSet& live) {
+        if (expression.get_type() == AstKind::PreAllocatedVariableReference) {
+            const auto& variable = type_asserted_cast<ast::PreAllocatedVariable&>(expression);
+            if (variable.get_storage() == VariableDeclarationType::Temp) {
+                live.insert(variable.get_value());
+            }
+        }
+        for_each_child(expression, [&](RawExpressionPtr& child) {
+            collect_reads(*child, live);
+        });
+    }
+} // namespace molar::exec
@@ -0,0 +1,84 @@
+//
+// Created by Akashic on 10/19/2026.
+//
+
+#ifndef DEAD_CODE_HPP
+#define DEAD_CODE_HPP
+#include <unordered_set>
+
+#include "execution/runtime/molang_program.hpp"
+
+namespace molar::exec {
+    struct DeadCodeOptions {
+        ///@brief Temps the host reads from the frame after an evaluation, the output temps of
+        /// a ChannelProgram for example. Their stores are always kept
+        std::unordered_set<uint32_t> live_temps{};
+    };
+
+    struct DeadCodeStats {
+        ///@brief Statements which came after a jump
+        size_t unreachable{0};
+        ///@brief Temp assignments whose value is never read, only the assigned value is kept
+        size_t dead_stores{0};
+        ///@brief How many nodes the program lost in total, see count_nodes
+        size_t removed_nodes{0};
+    };
+
+    ///@brief Removes the work of a program which can't change its result.
+    ///
+    /// Statements after a `return` never run, and neither do the statements after a `break`
+    /// or `continue` in a block. A `break` or `continue` directly in the program does nothing
+    /// and ends nothing.
+    ///
+    /// A temp assignment is dead if no read of the temp can see the value before the temp is
+    /// assigned again or the evaluation ends. That is worked out by a liveness analysis
+    /// which follows the branches, loops and jumps. A dead assignment is replaced by the value
+    /// it assigned, which still runs and is still the value of the expression. A statement
+    /// whose value isn't used and which only reads and computes, see is_inert, is removed
+    class DeadCodeElimination {
+    public:
+        static DeadCodeStats
+        eliminate(MolangProgram& program, const DeadCodeOptions& options = {});
+
+    private:
+        using LiveSet = std::unordered_set<uint32_t>;
+
+        ///@brief What is live where a `break` and a `continue` jump to
+        struct Jumps {
+            LiveSet breaks;
+            LiveSet continues;
+        };
+
+        explicit DeadCodeElimination(const DeadCodeOptions& options) : options(options) {}
+
+        ///@brief Drops the statements of a list after its first jump, a `return` only for the
+        /// program itself, and does the same in every list nested in it
+        void prune(molar::ast::RawExpressionList& list, bool program);
+
+        void prune_nested(molar::ast::RawExpression& expression);
+
+        ///@brief Replaces every assignment to a temp which isn't in `read` by its value
+        void drop_unread(molar::ast::RawExpressionPtr& expression, const LiveSet& read);
+
+        ///@brief Walks a list backwards, `live` goes in as what's live after the list and
+        /// comes out as what's live before it. No jumps means the list is the program
+        void walk(
+            molar::ast::RawExpressionList& list, LiveSet& live, const Jumps* jumps,
+            bool keep_last
+        );
+
+        ///@brief Returns whether the statement can be removed
+        bool walk_statement(
+            molar::ast::RawExpressionPtr& statement, LiveSet& live, const Jumps& jumps,
+            bool value_used
+        );
+
+        ///@brief Adds every temp the subtree reads
+        static void collect_reads(molar::ast::RawExpression& expression, LiveSet& live);
+
+        const DeadCodeOptions& options;
+        DeadCodeStats          stats{};
+    };
+} // namespace molar::exec
+
+#endif // DEAD_CODE_HPP
@@ -0,0 +1,161 @@
+//
+// Created by Akashic on 10/19/2026.
+//
+
+#include "if_conversion.hpp"
+
+#include "ast/literal.hpp"
+#include "processed_tree.hpp"
+
+namespace molar::exec {
+    using namespace molar::ast;
+    using molar::details::type_asserted_cast;
+
+    namespace {
+        ///@brief `!!expression`, the truth of a value as 1 or 0 the way `&&` produces it
+        RawExpressionPtr truth_of(RawExpressionPtr&& expression, const Expression& located) {
+            const size_t position = located.get_position();
+            const size_t size     = located.get_size();
+            return std::make_unique<UnaryExpression>(
+                position, size, UnaryOp::Not,
+                std::make_unique<UnaryExpression>(
+                    position, size, UnaryOp::Not, std::move(expression)
+                )
+            );
+        }
+
+        RawExpressionPtr bool_of(const bool value, const Expression& located) {
+            return std::make_unique<BoolLiteral>(
+                located.get_position(), located.get_size(), value
+            );
+        }
+    } // namespace
+
+    size_t IfConversion::convert(MolangProgram& program, const IfConversionOptions& options) {
+        IfConversion conversion{program, options};
+        for (auto& statement : program.get_expressions()) {
+            conversion.visit(statement);
+        }
+        return conversion.converted;
+    }
+
+    void IfConversion::visit(RawExpressionPtr& expression) {
+        // Inner branches first, a side which became a select is cheaper to run than a branch
+        for_each_child(*expression, [&](RawExpressionPtr& child) { this->visit(child); });
+
+        switch (expression->get_type()) {
+        case AstKind::TernaryExpression: {
+            auto& ternary = type_asserted_cast<TernaryExpression&>(*expression);
+            if (!this->fits(
+                    this->side_cost(*ternary.get_if_expression()),
+                    this->side_cost(*ternary.get_else_expression())
+                )) {
+                return;
+            }
+            expression = std::make_unique<ast::SelectExpression>(
+                std::move(ternary.get_condition()), std::move(ternary.get_if_expression()),
+                std::move(ternary.get_else_expression())
+            );
+            break;
+        }
+        case AstKind::ConditionalExpression: {
+            auto& conditional = type_asserted_cast<ConditionalExpression&>(*expression);
+            if (!this->fits(this->side_cost(*conditional.get_if_expression()), 0u)) {
+                return;
+            }
+            expression = std::make_unique<ast::SelectExpression>(
+                std::move(conditional.get_condition()),
+                std::move(conditional.get_if_expression()), nullptr
+            );
+            break;
+        }
+        case AstKind::BinaryExpression: {
+            auto&      binary    = type_asserted_cast<BinaryExpression&>(*expression);
+            const auto operation = binary.get_operation();
+            if (operation != BinaryOp::And && operation != BinaryOp::Or) {
+                return;
+            }
+
+            // The two nots of the right side and the literal
+            const auto right = this->side_cost(*binary.get_right());
+            if (!this->fits(right, 3u)) {
+                return;
+            }
+
+            auto truth = truth_of(std::move(binary.get_right()), binary);
+            auto fixed = bool_of(operation == BinaryOp::Or, binary);
+            expression = operation == BinaryOp::And
+                             ? std::make_unique<ast::SelectExpression>(
+                                   std::move(binary.get_left()), std::move(truth),
+                                   std::move(fixed)
+                               )
+                             : std::make_unique<ast::SelectExpression>(
+                                   std::move(binary.get_left()), std::move(fixed),
+                                   std::move(truth)
+                               );
+            break;
+        }
+        default:
+            return;
+        }
+        this->converted++;
+    }
+
+    std::optional<uint32_t> IfConversion::side_cost(RawExpression& expression) const {
+        uint32_t cost = 1;
+        switch (expression.get_type()) {
+        case AstKind::NumericLiteral:
+        case AstKind::BooleanLiteral:
+        case AstKind::PreAllocatedString:
+        case AstKind::PreAllocatedVariableReference:
+        case AstKind::ResourceExpression:
+        case AstKind::This:
+            return cost;
+        case AstKind::PreAllocatedArrayAccess:
+            cost = 2;
+            break;
+        case AstKind::PreAllocatedCall: {
+            const auto call =
+                type_asserted_cast<ast::PreAllocatedCall&>(expression).get_value();
+            if (!this->purity.is_pure(call)) {
+                return std::nullopt;
+            }
+            cost = this->program.get_math_bindings().get(call) != nullptr ? 4 : 8;
+            break;
+        }
+        case AstKind::ParenthesizedExpression:
+            // Only the elements count, an empty one is a null
+            cost = type_asserted_cast<ParenthesizedExpression&>(expression)
+                           .get_expressions()
+                           .empty()
+                       ? 1
+                       : 0;
+            break;
+        case AstKind::BinaryExpression:
+        case AstKind::UnaryExpression:
+        case AstKind::TernaryExpression:
+        case AstKind::ConditionalExpression:
+        case AstKind::SelectExpression:
+            break;
+        default:
+            // Assignments, jumps, blocks, loops and arrow accesses
+            return std::nullopt;
+        }
+
+        bool pure = true;
+        for_each_child(expression, [&](RawExpressionPtr& child) {
+            if (const auto inner = pure ? this->side_cost(*child) : std::nullopt) {
+                cost += *inner;
+            } else {
+                pure = false;
+            }
+        });
+        return pure ? std::optional{cost} : std::nullopt;
+    }
+
+    bool IfConversion::fits(
+        const std::optional<uint32_t> first, const std::optional<uint32_t> second
+    ) const {
+        return first && second && *first + *second <= this->options.max_select_cost;
+    }
+} // namespace molar::exec
@@ -0,0 +1,61 @@
+//
+// Created by Akashic on 10/19/2026.
+//
+
+#ifndef IF_CONVERSION_HPP
+#define IF_CONVERSION_HPP
+#include <optional>
+#include <string>
+#include <unordered_set>
+
+#include "execution/analysis/purity.hpp"
+#include "execution/runtime/molang_program.hpp"
+
+namespace molar::exec {
+    struct IfConversionOptions {
+        ///@brief Queries the host promises are pure, see CallPurity. A side which calls any
+        /// other query keeps its branch
+        std::unordered_set<std::string> pure_queries{};
+        ///@brief The most work both sides of a branch may take together to still be run
+        /// unconditionally. A literal or a slot read costs 1, an operator 1, an array read
+        /// 2, a math call 4 and a query 8, a mispredicted branch costs about as much as 8
+        uint32_t                        max_select_cost{8};
+    };
+
+    ///@brief Turns branches whose sides are cheap and have no side effects into
+    /// SelectExpressions, which run every side and then pick a value without a branch.
+    ///
+    /// Ternaries and conditionals become a select of their sides, `a && b` becomes
+    /// `a ? !!b : false` and `a || b` becomes `a ? true : !!b`. A side may read slots and
+    /// arrays and make pure calls, anything which assigns, jumps, loops or switches entity
+    /// keeps its branch, as does a pair of sides which costs more than the options allow.
+    ///
+    /// The JIT picks the side of a select with a cmov and the C++ emitter with `?:` on
+    /// computed values, which the compiler turns into one. MolangEvaluator has to evaluate
+    /// both sides, so a program which only ever runs interpreted is better off without it
+    class IfConversion {
+    public:
+        ///@brief Returns how many branches became selects
+        static size_t convert(MolangProgram& program, const IfConversionOptions& options = {});
+
+    private:
+        IfConversion(MolangProgram& program, const IfConversionOptions& options)
+            : program(program), options(options), purity(program, options.pure_queries) {}
+
+        void visit(molar::ast::RawExpressionPtr& expression);
+
+        ///@brief What running the side unconditionally costs, nothing if it can't be
+        [[nodiscard]] std::optional<uint32_t>
+        side_cost(molar::ast::RawExpression& expression) const;
+
+        [[nodiscard]] bool fits(std::optional<uint32_t> first, std::optional<uint32_t> second
+        ) const;
+
+        const MolangProgram&       program;
+        const IfConversionOptions& options;
+        const CallPurity           purity;
+        size_t                     converted{0};
+    };
+} // namespace molar::exec
+
+#endif // IF_CONVERSION_HPP
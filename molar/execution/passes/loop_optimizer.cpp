@@ -0,0 +1,302 @@
+//
+// Created by Akashic on 10/19/2026.
+//
+
+#include "loop_optimizer.hpp"
+
+#include <algorithm>
+
+#include "execution/runtime/molang_evaluator.hpp"
+#include "processed_tree.hpp"
+
+namespace molar::exec {
+    using namespace molar::ast;
+    using molar::details::type_asserted_cast;
+
+    namespace {
+        ///@brief What running a loop, its count included, may change
+        class LoopEffects {
+        public:
+            LoopEffects(RawExpression& loop, const CallPurity& purity) : purity(purity) {
+                this->collect(loop);
+            }
+
+            ///@brief Whether the subtree gives the same value wherever it runs in the loop
+            bool is_invariant(RawExpression& expression) const {
+                switch (expression.get_type()) {
+                case AstKind::NumericLiteral:
+                case AstKind::BooleanLiteral:
+                case AstKind::PreAllocatedString:
+                case AstKind::This:
+                    return true;
+                case AstKind::PreAllocatedVariableReference:
+                    return !this->is_written(
+                        type_asserted_cast<ast::PreAllocatedVariable&>(expression)
+                    );
+                case AstKind::PreAllocatedArrayAccess:
+                    return !this->calls_impure_query &&
+                           this->is_invariant(
+                               *type_asserted_cast<ast::PreAllocatedArrayAccess&>(expression)
+                                    .get_index_expression()
+                           );
+                case AstKind::PreAllocatedCall:
+                    if (!this->purity.is_pure(
+                            type_asserted_cast<ast::PreAllocatedCall&>(expression).get_value()
+                        )) {
+                        return false;
+                    }
+                    break;
+                case AstKind::ParenthesizedExpression:
+                    if (type_asserted_cast<ParenthesizedExpression&>(expression)
+                            .get_expressions()
+                            .empty()) {
+                        return false;
+                    }
+                    break;
+                case AstKind::BinaryExpression:
+                case AstKind::UnaryExpression:
+                case AstKind::ConditionalExpression:
+                case AstKind::TernaryExpression:
+                case AstKind::SelectExpression:
+                    break;
+                default:
+                    // Assignments, jumps, loops and arrow accesses
+                    return false;
+                }
+
+                bool invariant = true;
+                for_each_child(expression, [&](RawExpressionPtr& child) {
+                    invariant = invariant && this->is_invariant(*child);
+                });
+                return invariant;
+            }
+
+        private:
+            void collect(RawExpression& expression) {
+                switch (expression.get_type()) {
+                case AstKind::PreAllocatedAssignment:
+                    this->mark(type_asserted_cast<ast::PreAllocatedVariable&>(expression));
+                    break;
+                case AstKind::PreAllocatedForLoop:
+                    this->mark(
+                        type_asserted_cast<ast::PreAllocatedForLoop&>(expression)
+                            .get_variable_index()
+                    );
+                    break;
+                case AstKind::PreAllocatedCall:
+                    this->calls_impure_query |= this->purity.is_impure_query(
+                        type_asserted_cast<ast::PreAllocatedCall&>(expression).get_value()
+                    );
+                    break;
+                default:
+                    break;
+                }
+
+                for_each_child(expression, [&](RawExpressionPtr& child) {
+                    this->collect(*child);
+                });
+            }
+
+            void mark(const ast::PreAllocatedVariable& variable) {
+                auto& slots = variable.get_storage() == VariableDeclarationType::Temp
+                                  ? this->temps
+                                  : this->variables;
+                if (slots.size() <= variable.get_value()) {
+                    slots.resize(variable.get_value() + 1);
+                }
+                slots[variable.get_value()] = true;
+            }
+
+            bool is_written(const ast::PreAllocatedVariable& variable) const {
+                const bool  temp  = variable.get_storage() == VariableDeclarationType::Temp;
+                const auto& slots = temp ? this->temps : this->variables;
+
+                // The host may answer a query by changing the entity's variables
+                if (!temp && this->calls_impure_query) {
+                    return true;
+                }
+                return variable.get_value() < slots.size() && slots[variable.get_value()];
+            }
+
+            const CallPurity& purity;
+            std::vector<bool> variables{};
+            std::vector<bool> temps{};
+            bool              calls_impure_query{false};
+        };
+
+        bool reads_state(RawExpression& expression) {
+            switch (expression.get_type()) {
+            case AstKind::PreAllocatedVariableReference:
+            case AstKind::PreAllocatedArrayAccess:
+            case AstKind::PreAllocatedCall:
+            case AstKind::This:
+                return true;
+            default:
+                break;
+            }
+
+            bool found = false;
+            for_each_child(expression, [&](RawExpressionPtr& child) {
+                found = found || reads_state(*child);
+            });
+            return found;
+        }
+
+        ///@brief Whether the subtree does any work a temp would save, rather than only reading
+        /// a literal or a single slot. Arithmetic on literals alone is left to constant folding
+        bool is_worth_hoisting(RawExpression& expression) {
+            switch (expression.get_type()) {
+            case AstKind::NumericLiteral:
+            case AstKind::BooleanLiteral:
+            case AstKind::PreAllocatedString:
+            case AstKind::PreAllocatedVariableReference:
+            case AstKind::This:
+                return false;
+            default:
+                return reads_state(expression);
+            }
+        }
+
+        ///@brief Moves the invariant parts of a loop body into assignments to new temps
+        class Hoister {
+        public:
+            Hoister(MolangProgram& program, RawExpression& loop, const CallPurity& purity)
+                : program(program), effects(loop, purity) {}
+
+            void hoist(RawExpressionPtr& expression) {
+                if (this->effects.is_invariant(*expression) && is_worth_hoisting(*expression)) {
+                    const auto slot = this->program.add_temp("hoisted");
+                    this->hoisted.emplace_back(
+                        std::make_unique<ast::PreAllocatedVariableAssign>(
+                            slot, VariableDeclarationType::Temp, std::move(expression)
+                        )
+                    );
+                    expression = std::make_unique<ast::PreAllocatedVariable>(
+                        slot, VariableDeclarationType::Temp
+                    );
+                    return;
+                }
+
+                if (expression->get_type() == AstKind::ArrowAccessExpression) {
+                    this->hoist(type_asserted_cast<ArrowAccess&>(*expression).get_lhs());
+                    return;
+                }
+                for_each_child(*expression, [&](RawExpressionPtr& child) {
+                    this->hoist(child);
+                });
+            }
+
+            RawExpressionList hoisted{};
+
+        private:
+            MolangProgram&    program;
+            const LoopEffects effects;
+        };
+
+        ///@brief Whether a `break` or `continue` in the subtree ends an iteration of the loop
+        /// it's in, rather than one of a loop nested in it
+        bool has_loop_jump(RawExpression& expression) {
+            switch (expression.get_type()) {
+            case AstKind::Break:
+            case AstKind::Continue:
+                return true;
+            case AstKind::LoopExpression:
+                return has_loop_jump(
+                    *type_asserted_cast<LoopExpression&>(expression).get_count_expression()
+                );
+            case AstKind::PreAllocatedForLoop:
+                return has_loop_jump(*type_asserted_cast<ast::PreAllocatedForLoop&>(expression)
+                                          .get_array_fetch_expression());
+            default:
+                break;
+            }
+
+            bool found = false;
+            for_each_child(expression, [&](RawExpressionPtr& child) {
+                found = found || has_loop_jump(*child);
+            });
+            return found;
+        }
+    } // namespace
+
+    LoopStats LoopOptimizer::optimize(MolangProgram& program, const LoopOptions& options) {
+        LoopOptimizer optimizer{program, options};
+        for (auto& statement : program.get_expressions()) {
+            optimizer.visit(statement);
+        }
+        return optimizer.stats;
+    }
+
+    void LoopOptimizer::visit(RawExpressionPtr& expression) {
+        const auto kind = expression->get_type();
+        if (kind == AstKind::LoopExpression || kind == AstKind::PreAllocatedForLoop) {
+            this->optimize_loop(expression);
+            return;
+        }
+
+        for_each_child(*expression, [&](RawExpressionPtr& child) { this->visit(child); });
+    }
+
+    void LoopOptimizer::optimize_loop(RawExpressionPtr& expression) {
+        const bool for_each = expression->get_type() == AstKind::PreAllocatedForLoop;
+        auto&      body =
+            for_each ? type_asserted_cast<ast::PreAllocatedForLoop&>(*expression).get_loop()
+                     : type_asserted_cast<LoopExpression&>(*expression).get_loop_expression();
+
+        // A processed for_each has no source location, the replacement takes its body's
+        const auto&  located  = for_each ? static_cast<Expression&>(body)
+                                         : type_asserted_cast<Expression&>(*expression);
+        const size_t position = located.get_position();
+        const size_t size     = located.get_size();
+
+        // Outer loops first, whatever is invariant in them is also invariant in the loops
+        // nested in them and goes out the furthest
+        Hoister hoister{this->program, *expression, this->purity};
+        for (auto& statement : body.get_expressions()) {
+            hoister.hoist(statement);
+        }
+        this->stats.hoisted += hoister.hoisted.size();
+        auto replacement = std::move(hoister.hoisted);
+
+        for_each_child(*expression, [&](RawExpressionPtr& child) { this->visit(child); });
+
+        std::optional<float> count{};
+        if (!for_each) {
+            count = fold_constant(
+                *type_asserted_cast<LoopExpression&>(*expression).get_count_expression(),
+                this->program
+            );
+        }
+
+        // Same clamping as MolangEvaluator::evaluate_loop
+        constexpr auto max_iterations =
+            static_cast<float>(MolangEvaluator::max_loop_iterations);
+        const float    limit          = count ? std::min(*count, max_iterations) : 0.0f;
+        const auto     iterations     = limit > 0.0f ? static_cast<uint32_t>(limit) : 0u;
+
+        const bool unroll = count && iterations <= this->options.max_unroll_count &&
+                            !has_loop_jump(body) &&
+                            iterations * count_nodes(body) <= this->options.max_unrolled_nodes;
+        if (!unroll) {
+            if (replacement.empty()) {
+                return;
+            }
+            replacement.emplace_back(std::move(expression));
+        } else {
+            // The count is a constant, it has nothing to run. The last copy takes the original
+            auto& statements = body.get_expressions();
+            for (uint32_t i = 0; i + 1 < iterations; i++) {
+                for (auto& statement : statements) {
+                    replacement.emplace_back(clone_expression(*statement));
+                }
+            }
+            if (iterations > 0) {
+                std::ranges::move(statements, std::back_inserter(replacement));
+            }
+            this->stats.unrolled++;
+        }
+
+        // A block evaluates to null like the loop it replaces and stops at a jump the same way
+        expression = std::make_unique<BlockExpression>(position, size, std::move(replacement));
+    }
+} // namespace molar::exec
@@ -0,0 +1,60 @@
+//
+// Created by Akashic on 10/19/2026.
+//
+
+#ifndef LOOP_OPTIMIZER_HPP
+#define LOOP_OPTIMIZER_HPP
+#include <string>
+#include <unordered_set>
+
+#include "execution/analysis/purity.hpp"
+#include "execution/runtime/molang_program.hpp"
+
+namespace molar::exec {
+    struct LoopOptions {
+        ///@brief Queries the host promises are pure, see CallPurity. A loop which calls any
+        /// other query keeps every read of a `v.` variable and an array inside the loop
+        std::unordered_set<std::string> pure_queries{};
+        ///@brief A `loop` whose count is a constant of at most this is unrolled
+        uint32_t                        max_unroll_count{8};
+        ///@brief Unless its copies would have more nodes than this
+        size_t                          max_unrolled_nodes{256};
+    };
+
+    struct LoopStats {
+        size_t hoisted{0};
+        size_t unrolled{0};
+    };
+
+    ///@brief Rewrites the `loop` and `for_each` of a program so their bodies do less work
+    /// per iteration.
+    ///
+    /// Subexpressions of a body which give the same value on every iteration, because they
+    /// only read slots the loop never writes and only make pure calls, are computed once
+    /// into a temp before the loop. A `loop` whose count is a small constant and whose body
+    /// has no `break` or `continue` of its own is replaced by that many copies of the body.
+    ///
+    /// Hoisting is speculative, a hoisted expression also runs when the loop runs 0 times or
+    /// when it sat in a branch which is never taken, which pure calls make unobservable. An
+    /// arrow access runs its right side with another entity's queries, nothing is hoisted
+    /// out of it. The program gets new temp slots, frames have to be sized afterwards
+    class LoopOptimizer {
+    public:
+        static LoopStats optimize(MolangProgram& program, const LoopOptions& options = {});
+
+    private:
+        LoopOptimizer(MolangProgram& program, const LoopOptions& options)
+            : program(program), options(options), purity(program, options.pure_queries) {}
+
+        void visit(molar::ast::RawExpressionPtr& expression);
+
+        void optimize_loop(molar::ast::RawExpressionPtr& expression);
+
+        MolangProgram&     program;
+        const LoopOptions& options;
+        const CallPurity   purity;
+        LoopStats          stats{};
+    };
+} // namespace molar::exec
+
+#endif // LOOP_OPTIMIZER_HPP
@@ -0,0 +1,172 @@
+//
+// Created by Akashic on 10/19/2026.
+//
+
+#include "pass_manager.hpp"
+
+#include <algorithm>
+#include <format>
+#include <stdexcept>
+
+#include "common_subexpressions.hpp"
+#include "dead_code.hpp"
+#include "if_conversion.hpp"
+#include "loop_optimizer.hpp"
+#include "processed_tree.hpp"
+#include "rewrite_engine.hpp"
+#include "specializer.hpp"
+#include "superinstructions.hpp"
+
+namespace molar::exec {
+    namespace {
+        using Clock = std::chrono::steady_clock;
+
+        size_t count_program(MolangProgram& program) {
+            size_t count = 0;
+            for (auto& statement : program.get_expressions()) {
+                count += count_nodes(*statement);
+            }
+            return count;
+        }
+    } // namespace
+
+    PassManager
+    PassManager::for_level(const OptimizationLevel level, const PipelineOptions& options) {
+        PassManager manager{options.precision};
+        if (level == OptimizationLevel::O0) {
+            return manager;
+        }
+
+        // Specializing against no constants leaves only the folding, which the passes after
+        // it rely on to find copies which are the same once folded
+        manager.add("fold", {"rebuild"}, [](MolangProgram& program, StringPool& string_pool) {
+            const auto before = count_program(program);
+            program           = Specializer::specialize(program, {}, string_pool);
+            return before - std::min(before, count_program(program));
+        });
+
+        manager.add("rewrite", {"fold"}, [](MolangProgram& program, StringPool&) {
+            static const auto rules = RewriteEngine::standard();
+            return rules.rewrite(program);
+        });
+
+        // After folding and rewriting, which leave constant branches and their jumps behind
+        manager.add(
+            "dead_code", {"rewrite"},
+            [live_temps = options.live_temps](MolangProgram& program, StringPool&) {
+                DeadCodeOptions dead{};
+                for (const auto& name : live_temps) {
+                    const auto slot = program.find_variable_slot(
+                        molar::ast::VariableDeclarationType::Temp, name
+                    );
+                    if (slot) {
+                        dead.live_temps.insert(*slot);
+                    }
+                }
+                const auto stats = DeadCodeElimination::eliminate(program, dead);
+                return stats.unreachable + stats.dead_stores;
+            }
+        );
+
+        if (level == OptimizationLevel::O2) {
+            LoopOptions loops{};
+            loops.pure_queries = options.pure_queries;
+            manager.add("loops", {"fold"}, [loops](MolangProgram& program, StringPool&) {
+                const auto stats = LoopOptimizer::optimize(program, loops);
+                return stats.hoisted + stats.unrolled;
+            });
+
+            // Before CSE, whose `??` assignments would keep a side from being a select
+            IfConversionOptions selects{};
+            selects.pure_queries = options.pure_queries;
+            manager.add(
+                "if_conversion", {"fold"},
+                [selects](MolangProgram& program, StringPool&) {
+                    return IfConversion::convert(program, selects);
+                }
+            );
+        }
+
+        CseOptions cse{};
+        cse.pure_queries = options.pure_queries;
+        manager.add("cse", {"fold"}, [cse](MolangProgram& program, StringPool&) {
+            return CommonSubexpressions::eliminate(program, cse);
+        });
+
+        if (options.fuse) {
+            manager.add("superinstructions", {"cse"}, [](MolangProgram& program, StringPool&) {
+                return Superinstructions::fuse(program);
+            });
+        }
+        return manager;
+    }
+
+    void PassManager::add(
+        std::string name, const std::vector<std::string>& dependencies, PassFunction run
+    ) {
+        const auto known = [&](const std::string_view pass) {
+            return std::ranges::find(front_end, pass) != std::end(front_end) ||
+                   std::ranges::any_of(this->passes, [&](const Pass& added) {
+                       return added.name == pass;
+                   });
+        };
+
+        if (known(name)) {
+            throw std::invalid_argument(std::format("Pass {} was already added", name));
+        }
+        for (const auto& dependency : dependencies) {
+            if (!known(dependency)) {
+                throw std::invalid_argument(std::format(
+                    "Pass {} depends on {}, which has to be added first", name, dependency
+                ));
+            }
+        }
+        this->passes.push_back(Pass{std::move(name), std::move(run)});
+    }
+
+    std::vector<std::string> PassManager::get_pipeline() const {
+        std::vector<std::string> pipeline(std::begin(front_end), std::end(front_end));
+        for (const auto& pass : this->passes) {
+            pipeline.emplace_back(pass.name);
+        }
+        return pipeline;
+    }
+
+    MolangProgram PassManager::compile(
+        const std::string_view source, std::vector<PassRecord>& records,
+        StringPool& string_pool
+    ) const {
+        auto start = Clock::now();
+        const auto record = [&](const std::string_view name, const size_t nodes) {
+            const auto end = Clock::now();
+            records.push_back(PassRecord{
+                .name = std::string(name), .time = end - start, .nodes_after = nodes
+            });
+            start = end;
+        };
+
+        auto program = MolangProgram::compile(
+            source, string_pool, this->precision,
+            [&](const std::string_view phase) { record(phase, 0); }
+        );
+        record("rebuild", count_program(program));
+
+        this->run(program, records, string_pool);
+        return program;
+    }
+
+    void PassManager::run(
+        MolangProgram& program, std::vector<PassRecord>& records, StringPool& string_pool
+    ) const {
+        for (const auto& pass : this->passes) {
+            PassRecord record{.name = pass.name, .nodes_before = count_program(program)};
+
+            const auto start = Clock::now();
+            record.changes   = pass.run(program, string_pool);
+            record.time      = Clock::now() - start;
+
+            record.nodes_after = count_program(program);
+            records.push_back(std::move(record));
+        }
+    }
+} // namespace molar::exec
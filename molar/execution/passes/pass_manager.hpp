@@ -0,0 +1,109 @@
+//
+// Created by Akashic on 10/19/2026.
+//
+
+#ifndef PASS_MANAGER_HPP
+#define PASS_MANAGER_HPP
+#include <chrono>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
+
+#include "execution/runtime/molang_program.hpp"
+
+namespace molar::exec {
+    ///@brief How much compile time to spend on making a program run faster
+    enum class OptimizationLevel : uint8_t {
+        ///@brief Only the front end, for content which is hot reloaded while editing
+        O0,
+        ///@brief The passes which pay for themselves even in the interpreter
+        O1,
+        ///@brief Everything, for packs loaded at boot and programs a JIT compiles
+        O2,
+    };
+
+    struct PipelineOptions {
+        ///@brief Queries the host promises are pure, see CallPurity
+        std::unordered_set<std::string> pure_queries{};
+        ///@brief Temps the host reads from the frame after an evaluation, see DeadCodeOptions
+        std::unordered_set<std::string> live_temps{};
+        ///@brief Whether the program stays on the interpreter, which then gets superinstructions
+        /// as the last pass at O1 and above, see Superinstructions
+        bool                            fuse{false};
+        math::MathPrecision             precision{math::MathPrecision::Exact};
+    };
+
+    ///@brief What one pass did to one program
+    struct PassRecord {
+        std::string              name{};
+        std::chrono::nanoseconds time{};
+        ///@brief Size of the tree before and after the pass, see count_nodes. 0 for the
+        /// front end stages before `rebuild`, whose tree isn't processed yet
+        size_t                   nodes_before{0};
+        size_t                   nodes_after{0};
+        ///@brief What the pass reports it changed, branches converted for `if_conversion`
+        /// or subexpressions shared for `cse` for example
+        size_t                   changes{0};
+    };
+
+    ///@brief Compiles sources through a configurable list of passes and records what each
+    /// of them cost and did.
+    ///
+    /// The front end, `parse`, `collect` which assigns the slots and `rebuild` which turns
+    /// the tree into processed nodes, always runs first since there is no program before
+    /// it. Every pass added after it runs over the program in the order it was added, and
+    /// may only depend on passes added before it, so a pipeline is always in an order its
+    /// dependencies allow
+    class PassManager {
+    public:
+        ///@brief Runs a pass over a program, returns what it changed, see PassRecord
+        using PassFunction = std::function<size_t(MolangProgram&, StringPool&)>;
+
+        ///@brief A pipeline of only the front end, the same as MolangProgram::compile
+        explicit PassManager(math::MathPrecision precision = math::MathPrecision::Exact)
+            : precision(precision) {}
+
+        ///@brief The pipeline of a level. O1 folds constants, applies the standard rewrite
+        /// rules, removes dead code and shares common subexpressions, O2 also optimizes
+        /// loops and turns cheap branches into selects
+        static PassManager
+        for_level(OptimizationLevel level, const PipelineOptions& options = {});
+
+        ///@brief Appends a pass. Throws std::invalid_argument if a pass of that name was
+        /// already added or if a dependency wasn't, `collect` and `rebuild` included
+        void
+        add(std::string name, const std::vector<std::string>& dependencies, PassFunction run);
+
+        ///@brief The names of the passes in the order they run, the front end included
+        [[nodiscard]] std::vector<std::string> get_pipeline() const;
+
+        ///@brief Runs the front end and every pass over a source, appending a record per
+        /// stage to `records`. Throws what MolangProgram::compile does
+        MolangProgram compile(
+            std::string_view source, std::vector<PassRecord>& records,
+            StringPool& string_pool = StringPool::shared()
+        ) const;
+
+        ///@brief Runs every pass over an already compiled program. The program may get new
+        /// slots, frames have to be sized afterwards
+        void run(
+            MolangProgram& program, std::vector<PassRecord>& records,
+            StringPool& string_pool = StringPool::shared()
+        ) const;
+
+    private:
+        struct Pass {
+            std::string  name;
+            PassFunction run;
+        };
+
+        static constexpr std::string_view front_end[] = {"parse", "collect", "rebuild"};
+
+        math::MathPrecision precision;
+        std::vector<Pass>   passes{};
+    };
+} // namespace molar::exec
+
+#endif // PASS_MANAGER_HPP
@@ -0,0 +1,513 @@
+//
+// Created by Akashic on 10/19/2026.
+//
+
+#include "processed_tree.hpp"
+
+#include <array>
+#include <bit>
+#include <format>
+#include <stdexcept>
+#include <string_view>
+#include <vector>
+
+#include "ast/literal.hpp"
+#include "execution/preprocessor/execution_nodes/pre_allocated_string.hpp"
+#include "execution/runtime/molang_value.hpp"
+
+namespace molar::exec {
+    using namespace molar::ast;
+    using molar::details::type_asserted_cast;
+
+    namespace {
+        RawExpressionList clone_list(RawExpressionList& list) {
+            RawExpressionList copy{};
+            copy.reserve(list.size());
+            for (auto& element : list) {
+                copy.emplace_back(clone_expression(*element));
+            }
+            return copy;
+        }
+
+        BlockExpression clone_block(BlockExpression& block) {
+            return BlockExpression{
+                block.get_position(), block.get_size(), clone_list(block.get_expressions())
+            };
+        }
+
+        RawExpressionPtr clone_optional(RawExpressionPtr& expression) {
+            return expression ? clone_expression(*expression) : nullptr;
+        }
+
+        ///@brief Whether two fused nodes run the same instruction with the same parameters,
+        /// the constant compared by its bits like a NumericLiteral
+        bool same_fused(ast::FusedExpression& left, ast::FusedExpression& right) {
+            const auto& a = left.get_parameters();
+            const auto& b = right.get_parameters();
+            return left.get_instruction() == right.get_instruction() &&
+                   a.operation == b.operation && a.outer_operation == b.outer_operation &&
+                   std::bit_cast<uint32_t>(a.constant) == std::bit_cast<uint32_t>(b.constant) &&
+                   a.reversed == b.reversed && a.outer_call == b.outer_call &&
+                   a.inner_call == b.inner_call && a.inner_arguments == b.inner_arguments;
+        }
+
+        ///@brief What a node holds besides its kind and children, as one number. Resources
+        /// only get a hash of their name and fused nodes one of their parameters,
+        /// same_expression compares those themselves
+        uint64_t payload_of(RawExpression& expression) {
+            switch (expression.get_type()) {
+            case AstKind::NumericLiteral:
+                return std::bit_cast<uint32_t>(
+                    type_asserted_cast<NumericLiteral&>(expression).get_value()
+                );
+            case AstKind::BooleanLiteral:
+                return type_asserted_cast<BoolLiteral&>(expression).get_value() ? 1 : 0;
+            case AstKind::PreAllocatedString:
+                return type_asserted_cast<ast::PreAllocatedString&>(expression)
+                    .get_value()
+                    .get_id();
+            case AstKind::PreAllocatedVariableReference:
+            case AstKind::PreAllocatedAssignment: {
+                const auto& variable =
+                    type_asserted_cast<ast::PreAllocatedVariable&>(expression);
+                return static_cast<uint64_t>(variable.get_storage()) << 32 |
+                       variable.get_value();
+            }
+            case AstKind::PreAllocatedForLoop: {
+                auto& loop = type_asserted_cast<ast::PreAllocatedForLoop&>(expression);
+                const auto& variable = loop.get_variable_index();
+                return static_cast<uint64_t>(variable.get_storage()) << 32 |
+                       variable.get_value();
+            }
+            case AstKind::PreAllocatedCall:
+                return type_asserted_cast<ast::PreAllocatedCall&>(expression).get_value();
+            case AstKind::PreAllocatedArrayAccess:
+                return type_asserted_cast<ast::PreAllocatedArrayAccess&>(expression)
+                    .get_value();
+            case AstKind::BinaryExpression:
+                return static_cast<uint64_t>(
+                    type_asserted_cast<BinaryExpression&>(expression).get_operation()
+                );
+            case AstKind::UnaryExpression:
+                return static_cast<uint64_t>(
+                    type_asserted_cast<UnaryExpression&>(expression).get_operation()
+                );
+            case AstKind::ResourceExpression: {
+                auto& resource = type_asserted_cast<ResourceExpression&>(expression);
+                return static_cast<uint64_t>(resource.get_resource_kind()) ^
+                       std::hash<std::string_view>{}(resource.get_resource_id().get_value());
+            }
+            case AstKind::FusedExpression: {
+                auto& fused = type_asserted_cast<ast::FusedExpression&>(expression);
+                const auto& parameters = fused.get_parameters();
+                const auto  shape =
+                    static_cast<uint64_t>(fused.get_instruction()) |
+                    static_cast<uint64_t>(parameters.operation) << 8 |
+                    static_cast<uint64_t>(parameters.outer_operation) << 16 |
+                    uint64_t{parameters.reversed} << 24 |
+                    uint64_t{std::bit_cast<uint32_t>(parameters.constant)} << 32;
+                const auto calls =
+                    uint64_t{parameters.outer_call} << 32 | parameters.inner_call;
+                return shape ^ std::hash<uint64_t>{}(calls) ^
+                       std::hash<uint32_t>{}(parameters.inner_arguments) << 1;
+            }
+            default:
+                return 0;
+            }
+        }
+
+        std::vector<RawExpression*> children_of(RawExpression& expression) {
+            std::vector<RawExpression*> children{};
+            for_each_child(expression, [&](RawExpressionPtr& child) {
+                children.push_back(child.get());
+            });
+            return children;
+        }
+    } // namespace
+
+    RawExpressionPtr clone_expression(RawExpression& expression) {
+        switch (expression.get_type()) {
+        case AstKind::PreAllocatedVariableReference: {
+            const auto& read = type_asserted_cast<ast::PreAllocatedVariable&>(expression);
+            return std::make_unique<ast::PreAllocatedVariable>(
+                read.get_value(), read.get_storage()
+            );
+        }
+        case AstKind::PreAllocatedAssignment: {
+            auto& assign = type_asserted_cast<ast::PreAllocatedVariableAssign&>(expression);
+            return std::make_unique<ast::PreAllocatedVariableAssign>(
+                assign.get_value(), assign.get_storage(),
+                clone_expression(*assign.get_assignment())
+            );
+        }
+        case AstKind::PreAllocatedCall: {
+            auto& call = type_asserted_cast<ast::PreAllocatedCall&>(expression);
+            return std::make_unique<ast::PreAllocatedCall>(
+                call.get_value(), call.get_call_site(), clone_list(call.get_arguments())
+            );
+        }
+        case AstKind::PreAllocatedForLoop: {
+            auto&       loop     = type_asserted_cast<ast::PreAllocatedForLoop&>(expression);
+            const auto& variable = loop.get_variable_index();
+            return std::make_unique<ast::PreAllocatedForLoop>(
+                ast::PreAllocatedVariable{variable.get_value(), variable.get_storage()},
+                clone_expression(*loop.get_array_fetch_expression()),
+                clone_block(loop.get_loop())
+            );
+        }
+        case AstKind::PreAllocatedString:
+            return std::make_unique<ast::PreAllocatedString>(
+                type_asserted_cast<ast::PreAllocatedString&>(expression).get_value()
+            );
+        case AstKind::PreAllocatedArrayAccess: {
+            auto& access = type_asserted_cast<ast::PreAllocatedArrayAccess&>(expression);
+            return std::make_unique<ast::PreAllocatedArrayAccess>(
+                access.get_value(), clone_expression(*access.get_index_expression())
+            );
+        }
+        case AstKind::SelectExpression: {
+            auto& select = type_asserted_cast<ast::SelectExpression&>(expression);
+            return std::make_unique<ast::SelectExpression>(
+                clone_expression(*select.get_condition()),
+                clone_expression(*select.get_if_expression()),
+                clone_optional(select.get_else_expression())
+            );
+        }
+        case AstKind::FusedExpression: {
+            auto& fused = type_asserted_cast<ast::FusedExpression&>(expression);
+            return std::make_unique<ast::FusedExpression>(
+                fused.get_instruction(), fused.get_parameters(), clone_list(fused.get_operands())
+            );
+        }
+        default:
+            break;
+        }
+
+        // Everything else is an unprocessed node kind which keeps its source location
+        auto&        located  = type_asserted_cast<Expression&>(expression);
+        const size_t position = located.get_position();
+        const size_t size     = located.get_size();
+
+        switch (expression.get_type()) {
+        case AstKind::BooleanLiteral:
+            return std::make_unique<BoolLiteral>(
+                position, size, type_asserted_cast<BoolLiteral&>(expression).get_value()
+            );
+        case AstKind::NumericLiteral:
+            return std::make_unique<NumericLiteral>(
+                position, size, type_asserted_cast<NumericLiteral&>(expression).get_value()
+            );
+        case AstKind::ParenthesizedExpression:
+            return std::make_unique<ParenthesizedExpression>(
+                position, size,
+                clone_list(
+                    type_asserted_cast<ParenthesizedExpression&>(expression).get_expressions()
+                )
+            );
+        case AstKind::BlockExpression:
+            return std::make_unique<BlockExpression>(
+                clone_block(type_asserted_cast<BlockExpression&>(expression))
+            );
+        case AstKind::BinaryExpression: {
+            auto& binary = type_asserted_cast<BinaryExpression&>(expression);
+            return std::make_unique<BinaryExpression>(
+                position, size, binary.get_operation(), clone_expression(*binary.get_left()),
+                clone_expression(*binary.get_right())
+            );
+        }
+        case AstKind::UnaryExpression: {
+            auto& unary = type_asserted_cast<UnaryExpression&>(expression);
+            return std::make_unique<UnaryExpression>(
+                position, size, unary.get_operation(), clone_expression(*unary.get_expression())
+            );
+        }
+        case AstKind::ConditionalExpression: {
+            auto& conditional = type_asserted_cast<ConditionalExpression&>(expression);
+            return std::make_unique<ConditionalExpression>(
+                position, size, clone_expression(*conditional.get_condition()),
+                clone_expression(*conditional.get_if_expression())
+            );
+        }
+        case AstKind::TernaryExpression: {
+            auto& ternary = type_asserted_cast<TernaryExpression&>(expression);
+            return std::make_unique<TernaryExpression>(
+                position, size, clone_expression(*ternary.get_condition()),
+                clone_expression(*ternary.get_if_expression()),
+                clone_expression(*ternary.get_else_expression())
+            );
+        }
+        case AstKind::ResourceExpression: {
+            auto& resource = type_asserted_cast<ResourceExpression&>(expression);
+            auto& id       = resource.get_resource_id();
+            return std::make_unique<ResourceExpression>(
+                position, size, resource.get_resource_kind(),
+                IdentifierLiteral{id.get_position(), id.get_size(), id.get_value()}
+            );
+        }
+        case AstKind::ArrowAccessExpression: {
+            auto& arrow = type_asserted_cast<ArrowAccess&>(expression);
+            return std::make_unique<ArrowAccess>(
+                position, size, clone_expression(*arrow.get_lhs()),
+                clone_expression(*arrow.get_rhs())
+            );
+        }
+        case AstKind::LoopExpression: {
+            auto& loop = type_asserted_cast<LoopExpression&>(expression);
+            return std::make_unique<LoopExpression>(
+                position, size, clone_expression(*loop.get_count_expression()),
+                clone_block(loop.get_loop_expression())
+            );
+        }
+        case AstKind::Break:
+            return std::make_unique<BreakNode>(position, size);
+        case AstKind::Continue:
+            return std::make_unique<ContinueNode>(position, size);
+        case AstKind::This:
+            return std::make_unique<ThisNode>(position, size);
+        case AstKind::Return:
+            return std::make_unique<ReturnNode>(
+                position, size,
+                clone_optional(type_asserted_cast<ReturnNode&>(expression).get_value())
+            );
+        default:
+            throw std::logic_error(std::format(
+                "{} can't be cloned, the program wasn't preprocessed",
+                ast_kind_to_string(expression.get_type())
+            ));
+        }
+    }
+
+    bool contains_kind(RawExpression& expression, const AstKind kind) {
+        if (expression.get_type() == kind) {
+            return true;
+        }
+
+        bool found = false;
+        for_each_child(expression, [&](RawExpressionPtr& child) {
+            found = found || contains_kind(*child, kind);
+        });
+        return found;
+    }
+
+    bool is_inert(RawExpression& expression) {
+        switch (expression.get_type()) {
+        case AstKind::NumericLiteral:
+        case AstKind::BooleanLiteral:
+        case AstKind::PreAllocatedString:
+        case AstKind::PreAllocatedVariableReference:
+        case AstKind::This:
+            return true;
+        case AstKind::ParenthesizedExpression:
+        case AstKind::BinaryExpression:
+        case AstKind::UnaryExpression:
+        case AstKind::TernaryExpression:
+        case AstKind::SelectExpression:
+        case AstKind::PreAllocatedArrayAccess: {
+            bool inert = true;
+            for_each_child(expression, [&](RawExpressionPtr& child) {
+                inert = inert && is_inert(*child);
+            });
+            return inert;
+        }
+        default:
+            return false;
+        }
+    }
+
+    size_t count_nodes(RawExpression& expression) {
+        size_t count = 1;
+        for_each_child(expression, [&](RawExpressionPtr& child) {
+            count += count_nodes(*child);
+        });
+        return count;
+    }
+
+    bool same_expression(RawExpression& left, RawExpression& right) {
+        if (left.get_type() != right.get_type() || payload_of(left) != payload_of(right)) {
+            return false;
+        }
+        if (left.get_type() == AstKind::ResourceExpression &&
+            type_asserted_cast<ResourceExpression&>(left).get_resource_id().get_value() !=
+                type_asserted_cast<ResourceExpression&>(right).get_resource_id().get_value()) {
+            return false;
+        }
+        if (left.get_type() == AstKind::FusedExpression &&
+            !same_fused(
+                type_asserted_cast<ast::FusedExpression&>(left),
+                type_asserted_cast<ast::FusedExpression&>(right)
+            )) {
+            return false;
+        }
+
+        const auto left_children  = children_of(left);
+        const auto right_children = children_of(right);
+        if (left_children.size() != right_children.size()) {
+            return false;
+        }
+        for (size_t i = 0; i < left_children.size(); i++) {
+            if (!same_expression(*left_children[i], *right_children[i])) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    size_t hash_expression(RawExpression& expression) {
+        const auto mix = [](const size_t seed, const uint64_t value) {
+            return seed ^ (std::hash<uint64_t>{}(value) + 0x9e3779b97f4a7c15ull + (seed << 6) +
+                           (seed >> 2));
+        };
+
+        size_t hash = mix(static_cast<size_t>(expression.get_type()), payload_of(expression));
+        for_each_child(expression, [&](RawExpressionPtr& child) {
+            hash = mix(hash, hash_expression(*child));
+        });
+        return hash;
+    }
+
+    std::optional<float>
+    fold_constant(RawExpression& expression, const MolangProgram& program) {
+        const auto fold = [&](RawExpressionPtr& inner) {
+            return fold_constant(*inner, program);
+        };
+
+        switch (expression.get_type()) {
+        case AstKind::NumericLiteral:
+            return type_asserted_cast<NumericLiteral&>(expression).get_value();
+        case AstKind::BooleanLiteral:
+            return MolangValue{type_asserted_cast<BoolLiteral&>(expression).get_value()}
+                .as_number();
+        case AstKind::ParenthesizedExpression: {
+            std::optional<float> last{};
+            for (auto& inner :
+                 type_asserted_cast<ParenthesizedExpression&>(expression).get_expressions()) {
+                if (!(last = fold(inner))) {
+                    return std::nullopt;
+                }
+            }
+            return last;
+        }
+        case AstKind::UnaryExpression: {
+            auto&      unary = type_asserted_cast<UnaryExpression&>(expression);
+            const auto value = fold(unary.get_expression());
+            if (!value) {
+                return std::nullopt;
+            }
+            if (unary.get_operation() == UnaryOp::Not) {
+                return MolangValue{*value == 0.0f}.as_number();
+            }
+            return -*value;
+        }
+        case AstKind::BinaryExpression: {
+            auto&      binary    = type_asserted_cast<BinaryExpression&>(expression);
+            const auto operation = binary.get_operation();
+            const auto left      = fold(binary.get_left());
+            if (!left) {
+                return std::nullopt;
+            }
+
+            // The right side of these may never run, it doesn't have to be constant then
+            if (operation == BinaryOp::Coalesce) {
+                return left;
+            }
+            if (operation == BinaryOp::And && *left == 0.0f) {
+                return 0.0f;
+            }
+            if (operation == BinaryOp::Or && *left != 0.0f) {
+                return 1.0f;
+            }
+
+            const auto right = fold(binary.get_right());
+            if (!right) {
+                return std::nullopt;
+            }
+
+            const float lhs = *left;
+            const float rhs = *right;
+            switch (operation) {
+            case BinaryOp::And:
+            case BinaryOp::Or:
+                return MolangValue{rhs != 0.0f}.as_number();
+            case BinaryOp::Equality:
+                return MolangValue{lhs == rhs}.as_number();
+            case BinaryOp::Inequality:
+                return MolangValue{lhs != rhs}.as_number();
+            case BinaryOp::LessThan:
+                return MolangValue{lhs < rhs}.as_number();
+            case BinaryOp::LessEqualThan:
+                return MolangValue{lhs <= rhs}.as_number();
+            case BinaryOp::GreaterThan:
+                return MolangValue{lhs > rhs}.as_number();
+            case BinaryOp::GreaterEqualThan:
+                return MolangValue{lhs >= rhs}.as_number();
+            case BinaryOp::Addition:
+                return lhs + rhs;
+            case BinaryOp::Subtraction:
+                return lhs - rhs;
+            case BinaryOp::Multiplication:
+                return lhs * rhs;
+            case BinaryOp::Division:
+                return lhs / rhs;
+            default:
+                return std::nullopt;
+            }
+        }
+        case AstKind::TernaryExpression: {
+            auto&      ternary   = type_asserted_cast<TernaryExpression&>(expression);
+            const auto condition = fold(ternary.get_condition());
+            if (!condition) {
+                return std::nullopt;
+            }
+            return *condition != 0.0f ? fold(ternary.get_if_expression())
+                                      : fold(ternary.get_else_expression());
+        }
+        case AstKind::ConditionalExpression: {
+            // A false condition produces null, which isn't a number
+            auto&      conditional = type_asserted_cast<ConditionalExpression&>(expression);
+            const auto condition   = fold(conditional.get_condition());
+            if (!condition || *condition == 0.0f) {
+                return std::nullopt;
+            }
+            return fold(conditional.get_if_expression());
+        }
+        case AstKind::SelectExpression: {
+            // Both sides run, but they have no side effects so only the picked one matters
+            auto&      select    = type_asserted_cast<ast::SelectExpression&>(expression);
+            const auto condition = fold(select.get_condition());
+            if (!condition) {
+                return std::nullopt;
+            }
+            if (*condition != 0.0f) {
+                return fold(select.get_if_expression());
+            }
+            auto& else_expression = select.get_else_expression();
+            return else_expression ? fold(else_expression) : std::nullopt;
+        }
+        case AstKind::PreAllocatedCall: {
+            auto&       call     = type_asserted_cast<ast::PreAllocatedCall&>(expression);
+            const auto* function = program.get_math_bindings().get(call.get_value());
+            if (function == nullptr || function->is_random) {
+                return std::nullopt;
+            }
+
+            // Same argument handling as MolangEvaluator::evaluate_call
+            std::array<float, 4> arguments{};
+            size_t               index = 0;
+            for (auto& argument : call.get_arguments()) {
+                const auto value = fold(argument);
+                if (!value) {
+                    return std::nullopt;
+                }
+                if (index < arguments.size()) {
+                    arguments[index++] = *value;
+                }
+            }
+
+            math::RandomStream unused{};
+            return function->scalar(arguments.data(), unused);
+        }
+        default:
+            return std::nullopt;
+        }
+    }
+} // namespace molar::exec
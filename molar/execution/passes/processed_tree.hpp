@@ -0,0 +1,141 @@
+//
+// Created by Akashic on 10/19/2026.
+//
+
+#ifndef PROCESSED_TREE_HPP
+#define PROCESSED_TREE_HPP
+#include <optional>
+
+#include "ast/access_expression.hpp"
+#include "ast/controll_flow.hpp"
+#include "ast/keyword.hpp"
+#include "execution/preprocessor/execution_nodes/fused_expression.hpp"
+#include "execution/preprocessor/execution_nodes/pre_allocated.hpp"
+#include "execution/preprocessor/execution_nodes/pre_allocated_variable.hpp"
+#include "execution/preprocessor/execution_nodes/select_expression.hpp"
+#include "execution/runtime/molang_program.hpp"
+#include "internal/checked_down_cast.hpp"
+
+namespace molar::exec {
+    ///@brief Calls the function with every direct child pointer of a processed node, in the
+    /// order the evaluator runs them. The body of a loop is a BlockExpression member rather
+    /// than a pointer, its elements are passed instead
+    template <typename Function>
+    void for_each_child(molar::ast::RawExpression& expression, Function&& function) {
+        using namespace molar::ast;
+        using molar::details::type_asserted_cast;
+
+        const auto list = [&](RawExpressionList& children) {
+            for (auto& child : children) {
+                function(child);
+            }
+        };
+
+        switch (expression.get_type()) {
+        case AstKind::PreAllocatedAssignment:
+            function(type_asserted_cast<ast::PreAllocatedVariableAssign&>(expression)
+                         .get_assignment());
+            break;
+        case AstKind::ParenthesizedExpression:
+        case AstKind::BlockExpression:
+            list(type_asserted_cast<ParenthesizedExpression&>(expression).get_expressions());
+            break;
+        case AstKind::BinaryExpression: {
+            auto& binary = type_asserted_cast<BinaryExpression&>(expression);
+            function(binary.get_left());
+            function(binary.get_right());
+            break;
+        }
+        case AstKind::UnaryExpression:
+            function(type_asserted_cast<UnaryExpression&>(expression).get_expression());
+            break;
+        case AstKind::ConditionalExpression: {
+            auto& conditional = type_asserted_cast<ConditionalExpression&>(expression);
+            function(conditional.get_condition());
+            function(conditional.get_if_expression());
+            break;
+        }
+        case AstKind::TernaryExpression: {
+            auto& ternary = type_asserted_cast<TernaryExpression&>(expression);
+            function(ternary.get_condition());
+            function(ternary.get_if_expression());
+            function(ternary.get_else_expression());
+            break;
+        }
+        case AstKind::SelectExpression: {
+            auto& select = type_asserted_cast<ast::SelectExpression&>(expression);
+            function(select.get_condition());
+            function(select.get_if_expression());
+            if (select.get_else_expression()) {
+                function(select.get_else_expression());
+            }
+            break;
+        }
+        case AstKind::PreAllocatedCall:
+            list(type_asserted_cast<ast::PreAllocatedCall&>(expression).get_arguments());
+            break;
+        case AstKind::FusedExpression:
+            list(type_asserted_cast<ast::FusedExpression&>(expression).get_operands());
+            break;
+        case AstKind::PreAllocatedArrayAccess:
+            function(type_asserted_cast<ast::PreAllocatedArrayAccess&>(expression)
+                         .get_index_expression());
+            break;
+        case AstKind::ArrowAccessExpression: {
+            auto& arrow = type_asserted_cast<ArrowAccess&>(expression);
+            function(arrow.get_lhs());
+            function(arrow.get_rhs());
+            break;
+        }
+        case AstKind::LoopExpression: {
+            auto& loop = type_asserted_cast<LoopExpression&>(expression);
+            function(loop.get_count_expression());
+            list(loop.get_loop_expression().get_expressions());
+            break;
+        }
+        case AstKind::PreAllocatedForLoop: {
+            auto& loop = type_asserted_cast<ast::PreAllocatedForLoop&>(expression);
+            function(loop.get_array_fetch_expression());
+            list(loop.get_loop().get_expressions());
+            break;
+        }
+        case AstKind::Return:
+            if (auto& value = type_asserted_cast<ReturnNode&>(expression).get_value()) {
+                function(value);
+            }
+            break;
+        default:
+            break;
+        }
+    }
+
+    ///@brief A deep copy of a processed subtree. Calls keep their call site, so a copy of a
+    /// `math.random` draws from the same stream as the original
+    molar::ast::RawExpressionPtr clone_expression(molar::ast::RawExpression& expression);
+
+    ///@brief Whether the subtree has a node of the kind, the root included
+    bool contains_kind(molar::ast::RawExpression& expression, molar::ast::AstKind kind);
+
+    ///@brief Whether running the subtree a different number of times, or at another point,
+    /// is unobservable. It only reads slots and arrays and computes, without calls,
+    /// assignments or jumps
+    bool is_inert(molar::ast::RawExpression& expression);
+
+    ///@brief How many nodes the subtree has, a rough measure of the work it takes
+    size_t count_nodes(molar::ast::RawExpression& expression);
+
+    ///@brief Whether two subtrees have the same shape, operators, literals, slots and
+    /// callees. Calls compare by the function they call and not by their call site, so two
+    /// `math.random` compare the same even though they draw from different streams
+    bool same_expression(molar::ast::RawExpression& left, molar::ast::RawExpression& right);
+
+    ///@brief A hash which agrees with same_expression
+    size_t hash_expression(molar::ast::RawExpression& expression);
+
+    ///@brief The number a subtree evaluates to if it only does arithmetic and non random math
+    /// on literals, computed the way MolangEvaluator would
+    std::optional<float>
+    fold_constant(molar::ast::RawExpression& expression, const MolangProgram& program);
+} // namespace molar::exec
+
+#endif // PROCESSED_TREE_HPP
@@ -0,0 +1,130 @@
+//
+// Created by Akashic on 10/19/2026.
+//
+
+#include "program_linker.hpp"
+
+#include <algorithm>
+#include <format>
+#include <string>
+
+#include "processed_tree.hpp"
+
+namespace molar::exec {
+    using namespace molar::ast;
+    using molar::details::type_asserted_cast;
+
+    namespace {
+        using VariableState = AstCollectorState::VariableState;
+
+        ///@brief The slot in `to` of every slot of `from`, adding the missing names. Private
+        /// slots and the hidden slots of passes get names of their own
+        std::vector<uint32_t> merge_slots(
+            const VariableState& from, VariableState& to, const uint32_t program,
+            const bool shared
+        ) {
+            const auto rename = [&](const std::string& name) {
+                return shared && !name.starts_with('#') ? name
+                                                        : std::format("#{}:{}", program, name);
+            };
+
+            std::vector<uint32_t> slots(from.variable_index);
+            for (uint32_t i = 0; i < from.variable_index; i++) {
+                const auto name     = from.index_variable_map.find(i);
+                const auto original = name != from.index_variable_map.end()
+                                          ? name->second
+                                          : std::format("#{}", i);
+                slots[i]            = to.add_variable(rename(original));
+            }
+
+            for (const auto& [name, info] : from.struct_info_map) {
+                auto& children = to.create_or_get_struct(rename(name)).children_id;
+                for (const auto child : info.children_id) {
+                    if (std::ranges::find(children, slots.at(child)) == children.end()) {
+                        children.push_back(slots.at(child));
+                    }
+                }
+            }
+            return slots;
+        }
+    } // namespace
+
+    RawExpressionList ProgramLinker::add(MolangProgram& program) {
+        const auto& source = program.get_collection_state();
+        const auto  index  = this->programs++;
+
+        Mapping mapping{};
+        mapping.variables = merge_slots(source.variables, this->state.variables, index, true);
+        mapping.temps =
+            merge_slots(source.temp_variables, this->state.temp_variables, index, false);
+        mapping.arrays = merge_slots(source.array_state, this->state.array_state, index, true);
+
+        for (const auto& name : source.func_call_state.id_to_name) {
+            mapping.calls.push_back(this->state.func_call_state.add_id(std::string(name)));
+        }
+        // String literals hold their pool handle, only the names have to be known
+        for (const auto& name : source.string_state.id_to_name) {
+            this->state.string_state.add_id(std::string(name));
+        }
+        mapping.call_site_offset = this->state.call_site_count;
+        this->state.call_site_count += source.call_site_count;
+        // The linked program draws from its own streams, keyed by every program in it
+        this->state.program_id = (this->state.program_id ^ source.program_id) * 16777619u;
+
+        RawExpressionList statements{};
+        for (auto& statement : program.get_expressions()) {
+            auto& copy = statements.emplace_back(clone_expression(*statement));
+            remap(copy, mapping);
+        }
+        return statements;
+    }
+
+    MolangProgram ProgramLinker::link(
+        RawExpressionList&& statements, const math::MathPrecision precision
+    ) const {
+        MolangAstGenerator::MolarAst ast{};
+        ast.get_expressions() = std::move(statements);
+        auto state            = this->state;
+        return MolangProgram{std::move(ast), std::move(state), precision};
+    }
+
+    void ProgramLinker::remap(RawExpressionPtr& expression, const Mapping& mapping) {
+        for_each_child(*expression, [&](RawExpressionPtr& child) { remap(child, mapping); });
+
+        const auto slot = [&](ast::PreAllocatedVariable& variable) {
+            const auto& slots = variable.get_storage() == VariableDeclarationType::Temp
+                                    ? mapping.temps
+                                    : mapping.variables;
+            variable.get_value() = slots.at(variable.get_value());
+        };
+
+        switch (expression->get_type()) {
+        case AstKind::PreAllocatedVariableReference:
+        case AstKind::PreAllocatedAssignment:
+            slot(type_asserted_cast<ast::PreAllocatedVariable&>(*expression));
+            break;
+        case AstKind::PreAllocatedForLoop:
+            slot(
+                type_asserted_cast<ast::PreAllocatedForLoop&>(*expression).get_variable_index()
+            );
+            break;
+        case AstKind::PreAllocatedArrayAccess: {
+            auto& access       = type_asserted_cast<ast::PreAllocatedArrayAccess&>(*expression);
+            access.get_value() = mapping.arrays.at(access.get_value());
+            break;
+        }
+        case AstKind::PreAllocatedCall: {
+            // The call site has no setter, the node is rebuilt around its arguments
+            auto& call = type_asserted_cast<ast::PreAllocatedCall&>(*expression);
+            expression = std::make_unique<ast::PreAllocatedCall>(
+                mapping.calls.at(call.get_value()),
+                call.get_call_site() + mapping.call_site_offset,
+                std::move(call.get_arguments())
+            );
+            break;
+        }
+        default:
+            break;
+        }
+    }
+} // namespace molar::exec
@@ -0,0 +1,50 @@
+//
+// Created by Akashic on 10/19/2026.
+//
+
+#ifndef PROGRAM_LINKER_HPP
+#define PROGRAM_LINKER_HPP
+#include <vector>
+
+#include "execution/runtime/molang_program.hpp"
+
+namespace molar::exec {
+    ///@brief Puts the statements of separately compiled programs into one slot layout, so
+    /// they can be combined into a single program.
+    ///
+    /// `v.` variables, arrays and calls are shared by name, the way they would be if the
+    /// sources had been one. Temps stay private to the program they came from, each gets a
+    /// slot of its own named `#<program>:<name>`, and so do the hidden slots passes add.
+    /// Call sites are renumbered, so a random call of a linked program draws from a
+    /// different stream than it did on its own
+    class ProgramLinker {
+    public:
+        ///@brief A copy of the program's statements using the linked layout, the program
+        /// itself is left as is
+        molar::ast::RawExpressionList add(MolangProgram& program);
+
+        ///@brief Builds a program from statements returned by add, or built from them
+        MolangProgram link(
+            molar::ast::RawExpressionList&& statements,
+            math::MathPrecision             precision = math::MathPrecision::Exact
+        ) const;
+
+        [[nodiscard]] const AstCollectorState& get_state() const { return this->state; }
+
+    private:
+        struct Mapping {
+            std::vector<uint32_t> variables{};
+            std::vector<uint32_t> temps{};
+            std::vector<uint32_t> arrays{};
+            std::vector<uint32_t> calls{};
+            uint32_t              call_site_offset{0};
+        };
+
+        static void remap(molar::ast::RawExpressionPtr& expression, const Mapping& mapping);
+
+        AstCollectorState state{};
+        uint32_t          programs{0};
+    };
+} // namespace molar::exec
+
+#endif // PROGRAM_LINKER_HPP
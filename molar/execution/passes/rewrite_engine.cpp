@@ -0,0 +1,300 @@
+//
+// Created by Akashic on 10/19/2026.
+//
+
+#include "rewrite_engine.hpp"
+
+#include <algorithm>
+#include <format>
+#include <stdexcept>
+
+#include "ast/ast_replacer.hpp"
+#include "ast/literal.hpp"
+#include "execution/preprocessor/processed_ast_visitor.hpp"
+#include "processed_tree.hpp"
+
+namespace molar::exec {
+    using namespace molar::ast;
+    using molar::details::type_asserted_cast;
+
+    namespace {
+        // A rule and its inverse would otherwise rewrite one node forever
+        constexpr size_t max_rewrites_per_node = 16;
+
+        AstKind root_kind(const Term::Kind kind) {
+            switch (kind) {
+            case Term::Kind::Number:
+                return AstKind::NumericLiteral;
+            case Term::Kind::Binary:
+                return AstKind::BinaryExpression;
+            case Term::Kind::Unary:
+                return AstKind::UnaryExpression;
+            case Term::Kind::Call:
+                return AstKind::PreAllocatedCall;
+            default:
+                throw std::invalid_argument("A pattern has to be more than a capture");
+            }
+        }
+    } // namespace
+
+    Term Term::capture(std::string name) {
+        Term term{Kind::Capture};
+        term.name = std::move(name);
+        return term;
+    }
+
+    Term Term::call(const std::string_view name, std::vector<Term> arguments) {
+        // Named the way CallExpression::build_full_name does
+        const auto dot   = name.find('.');
+        const auto space = name.substr(0, dot);
+        char       kind  = 0;
+        if (space == "math") {
+            kind = 'm';
+        } else if (space == "q" || space == "query") {
+            kind = 'q';
+        }
+        if (dot == std::string_view::npos || kind == 0) {
+            throw std::invalid_argument(std::format("{} isn't a math or query call", name));
+        }
+
+        Term term{Kind::Call};
+        term.name     = std::format("{}{}", name.substr(dot + 1), kind);
+        term.children = std::move(arguments);
+        return term;
+    }
+
+    Term Term::binary(const BinaryOp operation, Term left, Term right) {
+        Term term{Kind::Binary};
+        term.binary_operation = operation;
+        term.children.push_back(std::move(left));
+        term.children.push_back(std::move(right));
+        return term;
+    }
+
+    Term Term::unary(const UnaryOp operation, Term operand) {
+        Term term{Kind::Unary};
+        term.unary_operation = operation;
+        term.children.push_back(std::move(operand));
+        return term;
+    }
+
+    ///@brief Applies the rules of an engine to every node an AstReplacer hands it
+    class RuleReplacer final : public AstReplaceVisitor {
+    public:
+        RuleReplacer(const RewriteEngine& engine, const AstCollectorState& state)
+            : engine(engine), state(state) {}
+
+        RawExpressionPtr replace(RawExpressionPtr&& expression) override {
+            for (size_t attempt = 0; attempt < max_rewrites_per_node; attempt++) {
+                const auto rules = this->engine.rules.find(expression->get_type());
+                if (rules == this->engine.rules.end() ||
+                    !std::ranges::any_of(rules->second, [&](const RewriteEngine::Rule& rule) {
+                        return this->apply(rule, expression);
+                    })) {
+                    break;
+                }
+                this->rewrites++;
+            }
+            return std::move(expression);
+        }
+
+        size_t rewrites{0};
+
+    private:
+        bool apply(const RewriteEngine::Rule& rule, RawExpressionPtr& expression) {
+            this->captures.clear();
+            this->calls.clear();
+            if (!this->match(rule.pattern, expression)) {
+                return false;
+            }
+            const auto inert = [](const auto& capture) { return is_inert(**capture.second); };
+            if (rule.rearranges && !std::ranges::all_of(this->captures, inert)) {
+                return false;
+            }
+
+            // Built before the assignment, the captures still live in the old tree
+            auto replacement = this->build(rule.replacement, rule.rearranges);
+            expression       = std::move(replacement);
+            return true;
+        }
+
+        bool match(const Term& term, RawExpressionPtr& node) {
+            auto* target = &node;
+            while ((*target)->get_type() == AstKind::ParenthesizedExpression) {
+                auto& inner = type_asserted_cast<ParenthesizedExpression&>(**target);
+                if (inner.get_expressions().size() != 1) {
+                    break;
+                }
+                target = &inner.get_expressions().front();
+            }
+            auto& expression = **target;
+
+            switch (term.kind) {
+            case Term::Kind::Capture:
+                if (const auto bound = this->captures.find(term.name);
+                    bound != this->captures.end()) {
+                    return same_expression(**bound->second, expression);
+                }
+                this->captures.emplace(term.name, target);
+                return true;
+            case Term::Kind::Number:
+                return expression.get_type() == AstKind::NumericLiteral &&
+                       type_asserted_cast<NumericLiteral&>(expression).get_value() ==
+                           term.number;
+            case Term::Kind::Binary: {
+                if (expression.get_type() != AstKind::BinaryExpression) {
+                    return false;
+                }
+                auto& binary = type_asserted_cast<BinaryExpression&>(expression);
+                return binary.get_operation() == term.binary_operation &&
+                       this->match(term.children[0], binary.get_left()) &&
+                       this->match(term.children[1], binary.get_right());
+            }
+            case Term::Kind::Unary: {
+                if (expression.get_type() != AstKind::UnaryExpression) {
+                    return false;
+                }
+                auto& unary = type_asserted_cast<UnaryExpression&>(expression);
+                return unary.get_operation() == term.unary_operation &&
+                       this->match(term.children[0], unary.get_expression());
+            }
+            case Term::Kind::Call: {
+                if (expression.get_type() != AstKind::PreAllocatedCall) {
+                    return false;
+                }
+                auto& call      = type_asserted_cast<ast::PreAllocatedCall&>(expression);
+                auto& arguments = call.get_arguments();
+                if (this->state.func_call_state.id_to_name.at(call.get_value()) != term.name ||
+                    arguments.size() != term.children.size()) {
+                    return false;
+                }
+                for (size_t i = 0; i < arguments.size(); i++) {
+                    if (!this->match(term.children[i], arguments[i])) {
+                        return false;
+                    }
+                }
+                this->calls.emplace(term.name, &call);
+                return true;
+            }
+            }
+            return false;
+        }
+
+        RawExpressionPtr build(const Term& term, const bool copy) {
+            switch (term.kind) {
+            case Term::Kind::Capture: {
+                auto& captured = *this->captures.at(term.name);
+                return copy ? clone_expression(*captured) : std::move(captured);
+            }
+            case Term::Kind::Number:
+                return std::make_unique<NumericLiteral>(0, 0, term.number);
+            case Term::Kind::Binary:
+                return std::make_unique<BinaryExpression>(
+                    0, 0, term.binary_operation, this->build(term.children[0], copy),
+                    this->build(term.children[1], copy)
+                );
+            case Term::Kind::Unary:
+                return std::make_unique<UnaryExpression>(
+                    0, 0, term.unary_operation, this->build(term.children[0], copy)
+                );
+            case Term::Kind::Call: {
+                const auto&       call = *this->calls.at(term.name);
+                RawExpressionList arguments{};
+                for (const auto& child : term.children) {
+                    arguments.push_back(this->build(child, copy));
+                }
+                return std::make_unique<ast::PreAllocatedCall>(
+                    call.get_value(), call.get_call_site(), std::move(arguments)
+                );
+            }
+            }
+            throw std::logic_error("Unknown term");
+        }
+
+        const RewriteEngine&      engine;
+        const AstCollectorState&  state;
+        // Where each capture's subtree is, so it can be moved into the replacement
+        std::unordered_map<std::string_view, RawExpressionPtr*>       captures{};
+        std::unordered_map<std::string_view, ast::PreAllocatedCall*> calls{};
+    };
+
+    void RewriteEngine::add(Term pattern, Term replacement) {
+        const auto kind = root_kind(pattern.get_kind());
+
+        std::vector<std::string_view> captured{};
+        std::vector<std::string_view> used{};
+        collect_names(pattern, Term::Kind::Capture, captured);
+        collect_names(replacement, Term::Kind::Capture, used);
+        for (const auto name : used) {
+            if (std::ranges::find(captured, name) == captured.end()) {
+                throw std::invalid_argument(std::format(
+                    "The replacement uses {}, which the pattern doesn't capture", name
+                ));
+            }
+        }
+
+        std::vector<std::string_view> called{};
+        std::vector<std::string_view> calls{};
+        collect_names(pattern, Term::Kind::Call, called);
+        collect_names(replacement, Term::Kind::Call, calls);
+        for (const auto name : calls) {
+            if (std::ranges::find(called, name) == called.end()) {
+                throw std::invalid_argument(
+                    std::format("The replacement calls {}, which the pattern doesn't", name)
+                );
+            }
+        }
+
+        const bool rearranges = captured != used;
+        this->rules[kind].push_back(
+            Rule{std::move(pattern), std::move(replacement), rearranges}
+        );
+        this->count++;
+    }
+
+    void RewriteEngine::collect_names(
+        const Term& term, const Term::Kind kind, std::vector<std::string_view>& names
+    ) {
+        if (term.kind == kind) {
+            names.push_back(term.name);
+        }
+        for (const auto& child : term.children) {
+            collect_names(child, kind, names);
+        }
+    }
+
+    RewriteEngine RewriteEngine::standard() {
+        const auto x = Term::capture("x");
+        const auto y = Term::capture("y");
+
+        RewriteEngine engine{};
+        // std::pow of a square rounds the same as the product for every float
+        engine.add(Term::call("math.pow", {x, 2.0f}), x * x);
+        engine.add(x - -y, x + y);
+        engine.add(x + -y, x - y);
+        engine.add(-x * -y, x * y);
+        engine.add(-x / -y, x / y);
+        // Halving is exact either way
+        engine.add(x / 2.0f, x * 0.5f);
+        engine.add(Term::call("math.abs", {-x}), Term::call("math.abs", {x}));
+        return engine;
+    }
+
+    size_t RewriteEngine::rewrite(MolangProgram& program, const size_t max_iterations) const {
+        size_t total = 0;
+        for (size_t iteration = 0; iteration < max_iterations; iteration++) {
+            RuleReplacer replacer{*this, program.get_collection_state()};
+            for (auto& statement : program.get_expressions()) {
+                AstReplacer(statement).visit_all<ast::details::ProcessedAstVisitorReplacer>(
+                    replacer
+                );
+            }
+
+            total += replacer.rewrites;
+            if (replacer.rewrites == 0) {
+                break;
+            }
+        }
+        return total;
+    }
+} // namespace molar::exec
@@ -0,0 +1,133 @@
+//
+// Created by Akashic on 10/19/2026.
+//
+
+#ifndef REWRITE_ENGINE_HPP
+#define REWRITE_ENGINE_HPP
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "execution/runtime/molang_program.hpp"
+
+namespace molar::exec {
+    ///@brief One side of a rewrite rule, built the way the expression it stands for would be
+    /// written, `Term::call("math.pow", {x, 2})` or `-x * -y`
+    class Term {
+    public:
+        enum class Kind : uint8_t { Capture, Number, Binary, Unary, Call };
+
+        ///@brief A numeric literal of exactly this value
+        Term(float value) : kind(Kind::Number), number(value) {}
+
+        ///@brief Matches any subtree. Every other use of the name in the pattern has to match
+        /// the same subtree, see same_expression, and the replacement gets it where it uses
+        /// the name
+        static Term capture(std::string name);
+
+        ///@brief A call by the name it has in the source, `math.pow` or `q.is_baby`. A call
+        /// in a replacement reuses the call of the same function the pattern matched
+        static Term call(std::string_view name, std::vector<Term> arguments);
+
+        static Term binary(BinaryOp operation, Term left, Term right);
+
+        static Term unary(UnaryOp operation, Term operand);
+
+        [[nodiscard]] Kind get_kind() const { return this->kind; }
+
+    private:
+        explicit Term(const Kind kind) : kind(kind) {}
+
+        Kind              kind;
+        float             number{0.0f};
+        BinaryOp          binary_operation{};
+        UnaryOp           unary_operation{};
+        ///@brief The capture's name or the callee the way the collector stores it
+        std::string       name{};
+        std::vector<Term> children{};
+
+        friend class RewriteEngine;
+        friend class RuleReplacer;
+    };
+
+    inline Term operator+(Term left, Term right) {
+        return Term::binary(BinaryOp::Addition, std::move(left), std::move(right));
+    }
+    inline Term operator-(Term left, Term right) {
+        return Term::binary(BinaryOp::Subtraction, std::move(left), std::move(right));
+    }
+    inline Term operator*(Term left, Term right) {
+        return Term::binary(BinaryOp::Multiplication, std::move(left), std::move(right));
+    }
+    inline Term operator/(Term left, Term right) {
+        return Term::binary(BinaryOp::Division, std::move(left), std::move(right));
+    }
+    inline Term operator<(Term left, Term right) {
+        return Term::binary(BinaryOp::LessThan, std::move(left), std::move(right));
+    }
+    inline Term operator<=(Term left, Term right) {
+        return Term::binary(BinaryOp::LessEqualThan, std::move(left), std::move(right));
+    }
+    inline Term operator>(Term left, Term right) {
+        return Term::binary(BinaryOp::GreaterThan, std::move(left), std::move(right));
+    }
+    inline Term operator>=(Term left, Term right) {
+        return Term::binary(BinaryOp::GreaterEqualThan, std::move(left), std::move(right));
+    }
+    inline Term operator-(Term operand) {
+        return Term::unary(UnaryOp::Negate, std::move(operand));
+    }
+    inline Term operator!(Term operand) {
+        return Term::unary(UnaryOp::Not, std::move(operand));
+    }
+
+    ///@brief Rewrites a program with declared rules, `pattern => replacement`, until none of
+    /// them matches anymore.
+    ///
+    /// Rules are kept by the kind of their pattern's root, so a node is only tried against
+    /// the rules which could match it. Each iteration is one walk with an AstReplacer, a node
+    /// which matched is tried again right away and the walk then continues into what replaced
+    /// it. Parentheses around a subtree are looked through.
+    ///
+    /// A rule is trusted to keep the meaning of what it matches, `!(a < b) => a >= b` for
+    /// example doesn't for NaN. Only if a rule drops, repeats or reorders the subtrees it
+    /// captured does the engine check that they are free of calls and assignments, which
+    /// would otherwise run a different number of times or in another order
+    class RewriteEngine {
+    public:
+        ///@brief Throws std::invalid_argument for a pattern which is only a capture, for a
+        /// replacement which uses a capture or calls a function its pattern doesn't
+        void add(Term pattern, Term replacement);
+
+        ///@brief Rules which give the same value for every input, `math.pow(x, 2) => x * x`,
+        /// `x - -y => x + y` and the like
+        static RewriteEngine standard();
+
+        ///@brief Returns how many rewrites were made. Stops after `max_iterations` walks if
+        /// the rules never settle, like a rule and its inverse would
+        size_t rewrite(MolangProgram& program, size_t max_iterations = 8) const;
+
+        [[nodiscard]] size_t get_rule_count() const { return this->count; }
+
+    private:
+        struct Rule {
+            Term pattern;
+            Term replacement;
+            ///@brief Whether the captures don't appear in the replacement exactly once each
+            /// and in the same order as in the pattern
+            bool rearranges;
+        };
+
+        ///@brief The names of the captures or callees of a term, in the order they run
+        static void
+        collect_names(const Term& term, Term::Kind kind, std::vector<std::string_view>& names);
+
+        friend class RuleReplacer;
+
+        std::unordered_map<molar::ast::AstKind, std::vector<Rule>> rules{};
+        size_t                                                    count{0};
+    };
+} // namespace molar::exec
+
+#endif // REWRITE_ENGINE_HPP
@@ -0,0 +1,401 @@
+//
+// Created by Akashic on 10/19/2026.
+//
+
+#include "specializer.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <ranges>
+#include <stdexcept>
+
+#include "ast/literal.hpp"
+#include "execution/preprocessor/execution_nodes/pre_allocated_string.hpp"
+#include "execution/runtime/molang_evaluator.hpp"
+#include "processed_tree.hpp"
+
+namespace molar::exec {
+    using namespace molar::ast;
+    using molar::details::type_asserted_cast;
+
+    namespace {
+        ///@brief The value of a node which is a literal, an empty `()` is null
+        std::optional<MolangValue> literal_value(RawExpression& expression) {
+            switch (expression.get_type()) {
+            case AstKind::NumericLiteral:
+                return type_asserted_cast<NumericLiteral&>(expression).get_value();
+            case AstKind::BooleanLiteral:
+                return type_asserted_cast<BoolLiteral&>(expression).get_value();
+            case AstKind::PreAllocatedString:
+                return type_asserted_cast<ast::PreAllocatedString&>(expression).get_value();
+            case AstKind::ParenthesizedExpression:
+                if (type_asserted_cast<ParenthesizedExpression&>(expression)
+                        .get_expressions()
+                        .empty()) {
+                    return MolangValue{};
+                }
+                return std::nullopt;
+            default:
+                return std::nullopt;
+            }
+        }
+
+        ///@brief `!!expression`, the truth of a value as 1 or 0 the way `&&` produces it
+        RawExpressionPtr truth_of(RawExpressionPtr&& expression, const Expression& located) {
+            const size_t position = located.get_position();
+            const size_t size     = located.get_size();
+            return std::make_unique<UnaryExpression>(
+                position, size, UnaryOp::Not,
+                std::make_unique<UnaryExpression>(
+                    position, size, UnaryOp::Not, std::move(expression)
+                )
+            );
+        }
+
+        bool same_constants(
+            const std::map<uint32_t, MolangValue>& left,
+            const std::map<uint32_t, MolangValue>& right
+        ) {
+            return std::ranges::equal(left, right, [](const auto& a, const auto& b) {
+                const auto& [left_key, left_value]   = a;
+                const auto& [right_key, right_value] = b;
+                if (left_key != right_key || left_value.get_kind() != right_value.get_kind()) {
+                    return false;
+                }
+                return left_value.is_number()
+                           ? std::bit_cast<uint32_t>(left_value.as_number()) ==
+                                 std::bit_cast<uint32_t>(right_value.as_number())
+                           : left_value == right_value;
+            });
+        }
+    } // namespace
+
+    bool SpecializationConstants::operator==(const SpecializationConstants& other) const {
+        return same_constants(this->queries, other.queries) &&
+               same_constants(this->variables, other.variables);
+    }
+
+    MolangProgram Specializer::specialize(
+        MolangProgram& program, const SpecializationConstants& constants,
+        const StringPool& string_pool
+    ) {
+        Specializer specializer{program, constants, string_pool};
+        specializer.assigned.resize(program.get_variable_slot_count());
+
+        RawExpressionList expressions{};
+        for (auto& statement : program.get_expressions()) {
+            specializer.collect_assigned(*statement);
+            expressions.emplace_back(clone_expression(*statement));
+        }
+        for (auto& statement : expressions) {
+            specializer.simplify(statement);
+        }
+        prune(expressions, true);
+
+        MolangAstGenerator::MolarAst ast{};
+        ast.get_expressions() = std::move(expressions);
+        return MolangProgram{
+            std::move(ast), std::move(specializer.state),
+            program.get_math_bindings().get_precision()
+        };
+    }
+
+    void Specializer::collect_assigned(RawExpression& expression) {
+        const auto mark = [&](const ast::PreAllocatedVariable& variable) {
+            if (variable.get_storage() != VariableDeclarationType::Temp) {
+                this->assigned.at(variable.get_value()) = true;
+            }
+        };
+
+        if (expression.get_type() == AstKind::PreAllocatedAssignment) {
+            mark(type_asserted_cast<ast::PreAllocatedVariable&>(expression));
+        } else if (expression.get_type() == AstKind::PreAllocatedForLoop) {
+            mark(
+                type_asserted_cast<ast::PreAllocatedForLoop&>(expression).get_variable_index()
+            );
+        }
+        for_each_child(expression, [&](RawExpressionPtr& child) {
+            this->collect_assigned(*child);
+        });
+    }
+
+    void Specializer::simplify(RawExpressionPtr& expression) {
+        const auto kind = expression->get_type();
+        if (kind == AstKind::ArrowAccessExpression) {
+            auto& arrow = type_asserted_cast<ArrowAccess&>(*expression);
+            this->simplify(arrow.get_lhs());
+            this->foreign++;
+            this->simplify(arrow.get_rhs());
+            this->foreign--;
+            return;
+        }
+        for_each_child(*expression, [&](RawExpressionPtr& child) { this->simplify(child); });
+
+        switch (kind) {
+        case AstKind::ParenthesizedExpression:
+            prune(
+                type_asserted_cast<ParenthesizedExpression&>(*expression).get_expressions(),
+                true
+            );
+            break;
+        case AstKind::BlockExpression:
+            prune(type_asserted_cast<BlockExpression&>(*expression).get_expressions(), false);
+            break;
+        case AstKind::PreAllocatedForLoop:
+            prune(
+                type_asserted_cast<ast::PreAllocatedForLoop&>(*expression)
+                    .get_loop()
+                    .get_expressions(),
+                false
+            );
+            break;
+        case AstKind::LoopExpression: {
+            auto& loop = type_asserted_cast<LoopExpression&>(*expression);
+            prune(loop.get_loop_expression().get_expressions(), false);
+
+            // Same clamping as MolangEvaluator::evaluate_loop, a count which isn't above 0
+            // runs nothing and the loop evaluates to null like an empty block
+            const auto count = literal_value(*loop.get_count_expression());
+            if (count && !(count->as_number() > 0.0f)) {
+                expression = std::make_unique<BlockExpression>(
+                    loop.get_position(), loop.get_size(), RawExpressionList{}
+                );
+                return;
+            }
+            break;
+        }
+        case AstKind::TernaryExpression: {
+            auto& ternary = type_asserted_cast<TernaryExpression&>(*expression);
+            if (const auto condition = literal_value(*ternary.get_condition())) {
+                expression = std::move(
+                    condition->as_bool() ? ternary.get_if_expression()
+                                         : ternary.get_else_expression()
+                );
+                return;
+            }
+            break;
+        }
+        case AstKind::ConditionalExpression: {
+            auto& conditional = type_asserted_cast<ConditionalExpression&>(*expression);
+            if (const auto condition = literal_value(*conditional.get_condition())) {
+                expression = condition->as_bool() ? std::move(conditional.get_if_expression())
+                                                  : this->literal(MolangValue{});
+                return;
+            }
+            break;
+        }
+        case AstKind::SelectExpression: {
+            auto& select = type_asserted_cast<ast::SelectExpression&>(*expression);
+            if (const auto condition = literal_value(*select.get_condition())) {
+                auto& picked = condition->as_bool() ? select.get_if_expression()
+                                                    : select.get_else_expression();
+                expression   = picked ? std::move(picked) : this->literal(MolangValue{});
+                return;
+            }
+            break;
+        }
+        case AstKind::BinaryExpression: {
+            auto&      binary    = type_asserted_cast<BinaryExpression&>(*expression);
+            const auto operation = binary.get_operation();
+            if (operation != BinaryOp::And && operation != BinaryOp::Or) {
+                break;
+            }
+
+            const auto left = literal_value(*binary.get_left());
+            if (!left) {
+                break;
+            }
+            if (left->as_bool() == (operation == BinaryOp::Or)) {
+                // The right side never runs
+                expression = this->literal(MolangValue{left->as_bool()});
+                return;
+            }
+            // Otherwise the result is the truth of the right side, which may fold further
+            expression = truth_of(std::move(binary.get_right()), binary);
+            break;
+        }
+        default:
+            if (const auto value = this->substitute(*expression)) {
+                expression = this->literal(*value);
+                return;
+            }
+            break;
+        }
+
+        if (literal_value(*expression)) {
+            return;
+        }
+        if (const auto value = this->fold(*expression)) {
+            expression = this->literal(*value);
+        }
+    }
+
+    void Specializer::prune(RawExpressionList& list, const bool keep_last) {
+        const auto end = keep_last && !list.empty() ? list.end() - 1 : list.end();
+        list.erase(
+            std::remove_if(
+                list.begin(), end,
+                [](const RawExpressionPtr& element) {
+                    return literal_value(*element).has_value();
+                }
+            ),
+            end
+        );
+    }
+
+    std::optional<MolangValue> Specializer::substitute(RawExpression& expression) const {
+        if (expression.get_type() == AstKind::PreAllocatedVariableReference) {
+            const auto& read = type_asserted_cast<ast::PreAllocatedVariable&>(expression);
+            if (read.get_storage() == VariableDeclarationType::Temp ||
+                this->assigned.at(read.get_value())) {
+                return std::nullopt;
+            }
+            if (const auto it = this->constants.variables.find(read.get_value());
+                it != this->constants.variables.end()) {
+                return it->second;
+            }
+            return std::nullopt;
+        }
+
+        if (expression.get_type() != AstKind::PreAllocatedCall || this->foreign > 0) {
+            return std::nullopt;
+        }
+
+        auto&      call = type_asserted_cast<ast::PreAllocatedCall&>(expression);
+        const auto it   = this->constants.queries.find(call.get_value());
+        if (it == this->constants.queries.end() ||
+            std::ranges::any_of(call.get_arguments(), [&](RawExpressionPtr& argument) {
+                return this->has_effects(*argument);
+            })) {
+            return std::nullopt;
+        }
+        return it->second;
+    }
+
+    std::optional<MolangValue> Specializer::fold(RawExpression& expression) const {
+        if (const auto number = fold_constant(expression, this->program)) {
+            return *number;
+        }
+        if (expression.get_type() == AstKind::ParenthesizedExpression) {
+            auto& list =
+                type_asserted_cast<ParenthesizedExpression&>(expression).get_expressions();
+            return list.size() == 1 ? literal_value(*list.front()) : std::nullopt;
+        }
+        if (expression.get_type() != AstKind::BinaryExpression) {
+            return std::nullopt;
+        }
+
+        // Only strings are left, fold_constant does every operator on numbers
+        auto&      binary    = type_asserted_cast<BinaryExpression&>(expression);
+        const auto operation = binary.get_operation();
+        const auto left      = literal_value(*binary.get_left());
+        if (!left) {
+            return std::nullopt;
+        }
+        if (operation == BinaryOp::Coalesce && !left->is_null()) {
+            return left;
+        }
+
+        const auto right = literal_value(*binary.get_right());
+        if (!right) {
+            return std::nullopt;
+        }
+        switch (operation) {
+        case BinaryOp::Coalesce:
+            return right;
+        case BinaryOp::Equality:
+        case BinaryOp::Inequality: {
+            // Same comparison as MolangEvaluator::evaluate_binary
+            const bool numeric = !left->is_string() && !right->is_string();
+            const bool equal =
+                numeric ? left->as_number() == right->as_number() : *left == *right;
+            return MolangValue{operation == BinaryOp::Equality ? equal : !equal};
+        }
+        default:
+            return std::nullopt;
+        }
+    }
+
+    bool Specializer::has_effects(RawExpression& expression) const {
+        switch (expression.get_type()) {
+        case AstKind::PreAllocatedAssignment:
+        case AstKind::PreAllocatedForLoop:
+        case AstKind::LoopExpression:
+        case AstKind::ArrowAccessExpression:
+        case AstKind::Break:
+        case AstKind::Continue:
+        case AstKind::Return:
+            return true;
+        case AstKind::PreAllocatedCall: {
+            // A query may change what the program reads, a random call advances the stream
+            const auto* function = this->program.get_math_bindings().get(
+                type_asserted_cast<ast::PreAllocatedCall&>(expression).get_value()
+            );
+            if (function == nullptr || function->is_random) {
+                return true;
+            }
+            break;
+        }
+        default:
+            break;
+        }
+
+        bool effects = false;
+        for_each_child(expression, [&](RawExpressionPtr& child) {
+            effects = effects || this->has_effects(*child);
+        });
+        return effects;
+    }
+
+    RawExpressionPtr Specializer::literal(const MolangValue value) {
+        // Processed literals have no source to point at
+        switch (value.get_kind()) {
+        case ValueKind::Number:
+            return std::make_unique<NumericLiteral>(0, 0, value.as_number());
+        case ValueKind::String:
+            // A program binary stores its literals by their collector id
+            this->state.string_state.add_id(
+                std::string(this->string_pool.resolve(value.as_string()))
+            );
+            return std::make_unique<ast::PreAllocatedString>(value.as_string());
+        case ValueKind::Null:
+            return std::make_unique<ParenthesizedExpression>(0, 0, RawExpressionList{});
+        default:
+            throw std::invalid_argument("An entity can't be a specialization constant");
+        }
+    }
+
+    MolangProgram& SpecializationCache::get(
+        MolangProgram& program, const SpecializationConstants& constants,
+        const StringPool& string_pool
+    ) {
+        std::lock_guard guard{this->lock};
+
+        auto& variants = this->variants[&program];
+        for (const auto& variant : variants) {
+            if (variant.constants == constants) {
+                return *variant.program;
+            }
+        }
+
+        auto specialized = std::make_unique<MolangProgram>(
+            Specializer::specialize(program, constants, string_pool)
+        );
+        return *variants.emplace_back(Variant{constants, std::move(specialized)}).program;
+    }
+
+    void SpecializationCache::forget(const MolangProgram& program) {
+        std::lock_guard guard{this->lock};
+        this->variants.erase(&program);
+    }
+
+    size_t SpecializationCache::get_variant_count() const {
+        std::lock_guard guard{this->lock};
+
+        size_t count = 0;
+        for (const auto& variants : this->variants | std::views::values) {
+            count += variants.size();
+        }
+        return count;
+    }
+} // namespace molar::exec
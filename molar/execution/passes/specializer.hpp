@@ -0,0 +1,118 @@
+//
+// Created by Akashic on 10/19/2026.
+//
+
+#ifndef SPECIALIZER_HPP
+#define SPECIALIZER_HPP
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include "execution/runtime/molang_program.hpp"
+#include "execution/runtime/molang_value.hpp"
+
+namespace molar::exec {
+    ///@brief What a program may assume about every entity of one variant, `q.is_baby` or
+    /// `q.variant` for a render controller
+    struct SpecializationConstants {
+        ///@brief Keyed by call id, see MolangProgram::find_query. Every call of the query on
+        /// the program's own entity answers the value, whatever its arguments
+        std::map<uint32_t, MolangValue> queries{};
+        ///@brief Keyed by `v.` slot, see MolangProgram::find_variable_slot. Ignored for a
+        /// variable the program assigns itself
+        std::map<uint32_t, MolangValue> variables{};
+
+        ///@brief Numbers compare by their bits, so a NaN constant finds its own variant again
+        /// and 0 and -0, which can fold differently, get one each
+        bool operator==(const SpecializationConstants& other) const;
+    };
+
+    ///@brief Builds the variant of a program for a set of constants.
+    ///
+    /// The constants replace the query calls and variable reads they are for, then every
+    /// subtree which only depends on literals is folded into one, branches on a literal
+    /// condition are replaced by the side which runs, loops which run 0 times are dropped
+    /// and so are statements which are only a literal and whose value isn't used.
+    ///
+    /// A call whose arguments have side effects is kept, as is every call on the right of
+    /// an arrow, which asks another entity
+    class Specializer {
+    public:
+        ///@brief A new program, the original is left as is. Throws std::invalid_argument for
+        /// an entity constant, which has no literal
+        static MolangProgram specialize(
+            MolangProgram& program, const SpecializationConstants& constants,
+            const StringPool& string_pool = StringPool::shared()
+        );
+
+    private:
+        Specializer(
+            MolangProgram& program, const SpecializationConstants& constants,
+            const StringPool& string_pool
+        )
+            : program(program), constants(constants), string_pool(string_pool),
+              state(program.get_collection_state()) {}
+
+        void collect_assigned(molar::ast::RawExpression& expression);
+
+        void simplify(molar::ast::RawExpressionPtr& expression);
+
+        ///@brief Drops the elements of a list which are a literal, except a last element
+        /// whose value is used
+        static void prune(molar::ast::RawExpressionList& list, bool keep_last);
+
+        ///@brief The value of a constant, nothing if the node isn't one
+        [[nodiscard]] std::optional<MolangValue>
+        substitute(molar::ast::RawExpression& expression) const;
+
+        [[nodiscard]] std::optional<MolangValue> fold(molar::ast::RawExpression& expression
+        ) const;
+
+        [[nodiscard]] bool has_effects(molar::ast::RawExpression& expression) const;
+
+        molar::ast::RawExpressionPtr literal(MolangValue value);
+
+        const MolangProgram&           program;
+        const SpecializationConstants& constants;
+        const StringPool&              string_pool;
+        // The variant's, a string constant may add a literal
+        AstCollectorState              state;
+        std::vector<bool>              assigned{};
+        // How many arrows deep the walk is on the right side
+        uint32_t                       foreign{0};
+    };
+
+    ///@brief The specialized variants of programs, built on first use and kept keyed by the
+    /// program and its constants. Safe to use from any thread, a variant stays at the same
+    /// address until its program is forgotten
+    class SpecializationCache {
+    public:
+        ///@brief The variant for the constants, built with Specializer::specialize on first
+        /// use. The pool has to be the one the program was compiled with
+        MolangProgram& get(
+            MolangProgram& program, const SpecializationConstants& constants,
+            const StringPool& string_pool = StringPool::shared()
+        );
+
+        ///@brief Drops the variants of a program, has to be called before it's destroyed if
+        /// another program could later be created at the same address
+        void forget(const MolangProgram& program);
+
+        [[nodiscard]] size_t get_variant_count() const;
+
+    private:
+        struct Variant {
+            SpecializationConstants        constants;
+            std::unique_ptr<MolangProgram> program;
+        };
+
+        mutable std::mutex lock{};
+        // A program only has a handful of variants, they are searched in order
+        std::unordered_map<const MolangProgram*, std::vector<Variant>> variants{};
+    };
+} // namespace molar::exec
+
+#endif // SPECIALIZER_HPP
@@ -0,0 +1,108 @@
+//
+// Created by Akashic on 10/19/2026.
+//
+
+#include "stage_splitter.hpp"
+
+#include "processed_tree.hpp"
+
+namespace molar::exec {
+    using namespace molar::ast;
+    using molar::details::type_asserted_cast;
+
+    namespace {
+        bool makes_call(RawExpression& expression) {
+            if (expression.get_type() == AstKind::PreAllocatedCall) {
+                return true;
+            }
+
+            bool found = false;
+            for_each_child(expression, [&](RawExpressionPtr& child) {
+                found = found || makes_call(*child);
+            });
+            return found;
+        }
+    } // namespace
+
+    StagedProgram StageSplitter::split(MolangProgram& program, const StageOptions& options) {
+        StageSplitter splitter{program, options};
+        for (auto& statement : program.get_expressions()) {
+            splitter.hoist(statement);
+        }
+
+        const size_t hoisted = splitter.init.size();
+        MolangAstGenerator::MolarAst ast{};
+        ast.get_expressions() = std::move(splitter.init);
+
+        // A copy of the layout with the hidden slots, so one frame fits both stages
+        auto state = program.get_collection_state();
+        return StagedProgram{
+            MolangProgram{
+                std::move(ast), std::move(state), program.get_math_bindings().get_precision()
+            },
+            hoisted
+        };
+    }
+
+    void StageSplitter::hoist(RawExpressionPtr& expression) {
+        if (this->is_stable(*expression) && makes_call(*expression)) {
+            const auto slot = this->program.add_variable("stage");
+            this->init.emplace_back(std::make_unique<ast::PreAllocatedVariableAssign>(
+                slot, VariableDeclarationType::Var, std::move(expression)
+            ));
+            expression =
+                std::make_unique<ast::PreAllocatedVariable>(slot, VariableDeclarationType::Var);
+            return;
+        }
+
+        if (expression->get_type() == AstKind::ArrowAccessExpression) {
+            auto& arrow = type_asserted_cast<ArrowAccess&>(*expression);
+            this->hoist(arrow.get_lhs());
+            this->foreign++;
+            this->hoist(arrow.get_rhs());
+            this->foreign--;
+            return;
+        }
+        for_each_child(*expression, [&](RawExpressionPtr& child) { this->hoist(child); });
+    }
+
+    bool StageSplitter::is_stable(RawExpression& expression) const {
+        switch (expression.get_type()) {
+        case AstKind::NumericLiteral:
+        case AstKind::BooleanLiteral:
+        case AstKind::PreAllocatedString:
+            return true;
+        case AstKind::PreAllocatedCall: {
+            const auto call =
+                type_asserted_cast<ast::PreAllocatedCall&>(expression).get_value();
+            const bool query = this->program.get_math_bindings().get(call) == nullptr;
+            if (!this->purity.is_pure(call) || (query && this->foreign > 0)) {
+                return false;
+            }
+            break;
+        }
+        case AstKind::ParenthesizedExpression:
+            if (type_asserted_cast<ParenthesizedExpression&>(expression)
+                    .get_expressions()
+                    .empty()) {
+                return false;
+            }
+            break;
+        case AstKind::BinaryExpression:
+        case AstKind::UnaryExpression:
+        case AstKind::ConditionalExpression:
+        case AstKind::TernaryExpression:
+        case AstKind::SelectExpression:
+            break;
+        default:
+            // Slots and `this` change between ticks, the rest has effects
+            return false;
+        }
+
+        bool stable = true;
+        for_each_child(expression, [&](RawExpressionPtr& child) {
+            stable = stable && this->is_stable(*child);
+        });
+        return stable;
+    }
+} // namespace molar::exec
@@ -0,0 +1,60 @@
+//
+// Created by Akashic on 10/19/2026.
+//
+
+#ifndef STAGE_SPLITTER_HPP
+#define STAGE_SPLITTER_HPP
+#include <string>
+#include <unordered_set>
+
+#include "execution/analysis/purity.hpp"
+#include "execution/runtime/molang_program.hpp"
+
+namespace molar::exec {
+    struct StageOptions {
+        ///@brief Queries whose answer never changes during an entity's lifetime and which
+        /// have no side effects, keyed like CallPurity. Every other query is read per tick
+        std::unordered_set<std::string> stable_queries{};
+    };
+
+    struct StagedProgram {
+        ///@brief Assigns every hidden slot, has to run once for an entity before its first
+        /// tick, with the same frame
+        MolangProgram init;
+        ///@brief How many subexpressions moved into the init stage
+        size_t        hoisted{0};
+    };
+
+    ///@brief Splits the work of a program into what only has to happen once per entity and
+    /// what has to happen every tick.
+    ///
+    /// A subexpression which only calls stable queries and non random math on literals gives
+    /// the same value for the whole life of an entity. Every largest such subexpression is
+    /// moved into an init program which stores it in a hidden `v.` slot, and the program
+    /// reads the slot instead. Arithmetic on literals alone is left to constant folding.
+    ///
+    /// Moved subexpressions run in the init stage even if the tick never reaches them, which
+    /// the purity of stable queries makes unobservable. A query on the right of an arrow
+    /// asks another entity and is never stable. The program gets new variable slots, frames
+    /// have to be sized afterwards and both stages use the same layout
+    class StageSplitter {
+    public:
+        static StagedProgram split(MolangProgram& program, const StageOptions& options = {});
+
+    private:
+        StageSplitter(MolangProgram& program, const StageOptions& options)
+            : program(program), purity(program, options.stable_queries) {}
+
+        void hoist(molar::ast::RawExpressionPtr& expression);
+
+        [[nodiscard]] bool is_stable(molar::ast::RawExpression& expression) const;
+
+        MolangProgram&                program;
+        const CallPurity              purity;
+        molar::ast::RawExpressionList init{};
+        // How many arrows deep the walk is on the right side
+        uint32_t                      foreign{0};
+    };
+} // namespace molar::exec
+
+#endif // STAGE_SPLITTER_HPP
@@ -0,0 +1,403 @@
+//
+// Created by Akashic on 10/19/2026.
+//
+
+#include "superinstructions.hpp"
+
+#include <algorithm>
+#include <format>
+#include <ranges>
+
+#include "ast/literal.hpp"
+#include "processed_tree.hpp"
+
+namespace molar::exec {
+    using namespace molar::ast;
+    using molar::details::type_asserted_cast;
+    using ast::Superinstruction;
+
+    namespace {
+        // How far below the node a pattern looks
+        constexpr uint32_t pattern_depth = 2;
+
+        bool is_arithmetic(const BinaryOp operation) {
+            return operation == BinaryOp::Addition || operation == BinaryOp::Subtraction ||
+                   operation == BinaryOp::Multiplication || operation == BinaryOp::Division;
+        }
+
+        bool is_ordering(const BinaryOp operation) {
+            return operation == BinaryOp::LessThan || operation == BinaryOp::LessEqualThan ||
+                   operation == BinaryOp::GreaterThan ||
+                   operation == BinaryOp::GreaterEqualThan;
+        }
+
+        std::string_view operator_text(const BinaryOp operation) {
+            switch (operation) {
+            case BinaryOp::Equality:
+                return "==";
+            case BinaryOp::Inequality:
+                return "!=";
+            case BinaryOp::LessThan:
+                return "<";
+            case BinaryOp::LessEqualThan:
+                return "<=";
+            case BinaryOp::GreaterThan:
+                return ">";
+            case BinaryOp::GreaterEqualThan:
+                return ">=";
+            case BinaryOp::Addition:
+                return "+";
+            case BinaryOp::Subtraction:
+                return "-";
+            case BinaryOp::Multiplication:
+                return "*";
+            case BinaryOp::Division:
+                return "/";
+            case BinaryOp::And:
+                return "&&";
+            case BinaryOp::Or:
+                return "||";
+            case BinaryOp::Coalesce:
+                return "??";
+            default:
+                return "?";
+            }
+        }
+
+        ///@brief The pointer to the node a chain of single element parentheses holds
+        RawExpressionPtr& unwrap(RawExpressionPtr& expression) {
+            RawExpressionPtr* current = &expression;
+            while ((*current)->get_type() == AstKind::ParenthesizedExpression) {
+                auto& inner =
+                    type_asserted_cast<ParenthesizedExpression&>(**current).get_expressions();
+                if (inner.size() != 1) {
+                    break;
+                }
+                current = &inner.front();
+            }
+            return *current;
+        }
+
+        bool is_slot(const RawExpression& expression) {
+            return expression.get_type() == AstKind::PreAllocatedVariableReference;
+        }
+
+        std::optional<float> constant_of(RawExpression& expression) {
+            if (expression.get_type() != AstKind::NumericLiteral) {
+                return std::nullopt;
+            }
+            return type_asserted_cast<NumericLiteral&>(expression).get_value();
+        }
+
+        ///@brief The math function of a call which isn't random, nullptr for anything else
+        const math::MathFunctionInfo*
+        pure_math_call(const MolangProgram& program, RawExpression& expression) {
+            if (expression.get_type() != AstKind::PreAllocatedCall) {
+                return nullptr;
+            }
+            const auto* function = program.get_math_bindings().get(
+                type_asserted_cast<ast::PreAllocatedCall&>(expression).get_value()
+            );
+            return function != nullptr && !function->is_random ? function : nullptr;
+        }
+
+        ///@brief The shape of the subtree down to `depth` levels, and how many of its nodes
+        /// the shape fixes
+        std::string render(
+            const MolangProgram& program, RawExpression& expression, const uint32_t depth,
+            size_t& fixed
+        ) {
+            const auto child = [&](RawExpressionPtr& node) {
+                return render(program, *unwrap(node), depth - 1, fixed);
+            };
+
+            switch (expression.get_type()) {
+            case AstKind::NumericLiteral:
+            case AstKind::BooleanLiteral:
+                fixed++;
+                return "k";
+            case AstKind::PreAllocatedVariableReference:
+                fixed++;
+                return "slot";
+            default:
+                break;
+            }
+            if (depth == 0) {
+                return "_";
+            }
+
+            switch (expression.get_type()) {
+            case AstKind::BinaryExpression: {
+                auto& binary = type_asserted_cast<BinaryExpression&>(expression);
+                fixed++;
+                auto left  = child(binary.get_left());
+                auto right = child(binary.get_right());
+                return std::format(
+                    "({} {} {})", left, operator_text(binary.get_operation()), right
+                );
+            }
+            case AstKind::UnaryExpression: {
+                auto& unary = type_asserted_cast<UnaryExpression&>(expression);
+                fixed++;
+                return std::format(
+                    "{}{}", unary.get_operation() == UnaryOp::Not ? "!" : "-",
+                    child(unary.get_expression())
+                );
+            }
+            case AstKind::TernaryExpression: {
+                auto& ternary = type_asserted_cast<TernaryExpression&>(expression);
+                fixed++;
+                auto condition = child(ternary.get_condition());
+                auto if_side   = child(ternary.get_if_expression());
+                auto else_side = child(ternary.get_else_expression());
+                return std::format("({} ? {} : {})", condition, if_side, else_side);
+            }
+            case AstKind::PreAllocatedCall: {
+                auto&       call     = type_asserted_cast<ast::PreAllocatedCall&>(expression);
+                const auto* function = program.get_math_bindings().get(call.get_value());
+                fixed++;
+
+                std::string arguments{};
+                for (auto& argument : call.get_arguments()) {
+                    if (!arguments.empty()) {
+                        arguments += ", ";
+                    }
+                    arguments += child(argument);
+                }
+                return function != nullptr
+                           ? std::format("math.{}({})", function->name, arguments)
+                           : std::format("query({})", arguments);
+            }
+            default:
+                return "_";
+            }
+        }
+    } // namespace
+
+    void PatternProfile::add(MolangProgram& program, const DispatchProfile& profile) {
+        for (auto& statement : program.get_expressions()) {
+            this->add_node(program, *statement, profile);
+        }
+    }
+
+    void PatternProfile::add_node(
+        MolangProgram& program, RawExpression& expression, const DispatchProfile& profile
+    ) {
+        for_each_child(expression, [&](RawExpressionPtr& child) {
+            this->add_node(program, *child, profile);
+        });
+
+        const auto executions = profile.get_count(expression);
+        if (executions == 0) {
+            return;
+        }
+
+        size_t     fixed   = 0;
+        const auto pattern = render(program, expression, pattern_depth, fixed);
+        if (fixed < 2) {
+            return;
+        }
+
+        auto& candidate   = this->patterns[pattern];
+        candidate.pattern = pattern;
+        candidate.executions += executions;
+        candidate.saved += executions * (fixed - 1);
+        if (!candidate.covered_by) {
+            candidate.covered_by = Superinstructions::match(program, expression);
+        }
+    }
+
+    std::vector<PatternCandidate> PatternProfile::ranked(const size_t count) const {
+        std::vector<PatternCandidate> result{};
+        result.reserve(this->patterns.size());
+        for (const auto& candidate : this->patterns | std::views::values) {
+            result.push_back(candidate);
+        }
+
+        std::ranges::sort(result, [](const PatternCandidate& a, const PatternCandidate& b) {
+            return a.saved != b.saved ? a.saved > b.saved : a.pattern < b.pattern;
+        });
+        result.resize(std::min(count, result.size()));
+        return result;
+    }
+
+    size_t Superinstructions::fuse(MolangProgram& program) {
+        size_t fused = 0;
+        for (auto& statement : program.get_expressions()) {
+            fused += fuse(program, statement);
+        }
+        return fused;
+    }
+
+    size_t Superinstructions::fuse(const MolangProgram& program, RawExpressionPtr& expression) {
+        size_t fused = 0;
+
+        // The biggest shape wins, what's fused inside an operand is found after
+        if (auto fusion = find(program, *expression)) {
+            RawExpressionList operands{};
+            operands.reserve(fusion->operands.size());
+            for (auto* operand : fusion->operands) {
+                operands.push_back(std::move(*operand));
+            }
+            expression = std::make_unique<ast::FusedExpression>(
+                fusion->instruction, fusion->parameters, std::move(operands)
+            );
+            fused++;
+        }
+
+        for_each_child(*expression, [&](RawExpressionPtr& child) {
+            fused += fuse(program, child);
+        });
+        return fused;
+    }
+
+    std::optional<Superinstruction>
+    Superinstructions::match(const MolangProgram& program, RawExpression& expression) {
+        if (const auto fusion = find(program, expression)) {
+            return fusion->instruction;
+        }
+        return std::nullopt;
+    }
+
+    std::optional<Superinstructions::Fusion>
+    Superinstructions::find(const MolangProgram& program, RawExpression& expression) {
+        switch (expression.get_type()) {
+        case AstKind::BinaryExpression:
+            return find_binary(type_asserted_cast<BinaryExpression&>(expression));
+        case AstKind::TernaryExpression: {
+            auto& ternary   = type_asserted_cast<TernaryExpression&>(expression);
+            auto& condition = *unwrap(ternary.get_condition());
+            if (condition.get_type() != AstKind::BinaryExpression) {
+                return std::nullopt;
+            }
+
+            auto& compare = type_asserted_cast<BinaryExpression&>(condition);
+            if (!is_ordering(compare.get_operation())) {
+                return std::nullopt;
+            }
+
+            Fusion fusion{Superinstruction::CompareSelect};
+            fusion.parameters.operation = compare.get_operation();
+            fusion.operands             = {
+                &unwrap(compare.get_left()), &unwrap(compare.get_right()),
+                &ternary.get_if_expression(), &ternary.get_else_expression()
+            };
+            return fusion;
+        }
+        case AstKind::PreAllocatedCall: {
+            auto& outer     = type_asserted_cast<ast::PreAllocatedCall&>(expression);
+            auto& arguments = outer.get_arguments();
+            if (pure_math_call(program, outer) == nullptr || arguments.empty()) {
+                return std::nullopt;
+            }
+
+            auto& first = *unwrap(arguments.front());
+            if (pure_math_call(program, first) == nullptr) {
+                return std::nullopt;
+            }
+
+            auto&  inner = type_asserted_cast<ast::PreAllocatedCall&>(first);
+            Fusion fusion{Superinstruction::MathChain};
+            fusion.parameters.outer_call      = outer.get_value();
+            fusion.parameters.inner_call      = inner.get_value();
+            fusion.parameters.inner_arguments =
+                static_cast<uint32_t>(inner.get_arguments().size());
+            for (auto& argument : inner.get_arguments()) {
+                fusion.operands.push_back(&argument);
+            }
+            for (size_t i = 1; i < arguments.size(); i++) {
+                fusion.operands.push_back(&arguments[i]);
+            }
+            return fusion;
+        }
+        default:
+            return std::nullopt;
+        }
+    }
+
+    std::optional<Superinstructions::Fusion>
+    Superinstructions::find_binary(BinaryExpression& binary) {
+        const auto operation = binary.get_operation();
+        if (!is_arithmetic(operation) && !is_ordering(operation)) {
+            return std::nullopt;
+        }
+
+        auto& left  = unwrap(binary.get_left());
+        auto& right = unwrap(binary.get_right());
+
+        const auto with_constant = [&](const Superinstruction instruction,
+                                       RawExpressionPtr& operand, const float constant,
+                                       const bool reversed) {
+            Fusion fusion{instruction};
+            fusion.parameters.operation = operation;
+            fusion.parameters.constant  = constant;
+            fusion.parameters.reversed  = reversed;
+            fusion.operands             = {&operand};
+            return fusion;
+        };
+
+        const auto left_constant  = constant_of(*left);
+        const auto right_constant = constant_of(*right);
+        if (is_slot(*left) && right_constant) {
+            return with_constant(Superinstruction::SlotOpConst, left, *right_constant, false);
+        }
+        if (left_constant && is_slot(*right)) {
+            return with_constant(Superinstruction::SlotOpConst, right, *left_constant, true);
+        }
+        if (is_slot(*left) && is_slot(*right)) {
+            Fusion fusion{Superinstruction::SlotOpSlot};
+            fusion.parameters.operation = operation;
+            fusion.operands             = {&left, &right};
+            return fusion;
+        }
+        if (left->get_type() == AstKind::PreAllocatedCall && right_constant) {
+            return with_constant(Superinstruction::CallOpConst, left, *right_constant, false);
+        }
+        if (left_constant && right->get_type() == AstKind::PreAllocatedCall) {
+            return with_constant(Superinstruction::CallOpConst, right, *left_constant, true);
+        }
+
+        // `slot op k` on one side, `k op slot` too when op doesn't care about the order
+        const auto chain = [&](RawExpressionPtr& side, RawExpressionPtr& other,
+                               const bool reversed) -> std::optional<Fusion> {
+            if (side->get_type() != AstKind::BinaryExpression) {
+                return std::nullopt;
+            }
+
+            auto&      inner           = type_asserted_cast<BinaryExpression&>(*side);
+            const auto inner_operation = inner.get_operation();
+            if (!is_arithmetic(inner_operation)) {
+                return std::nullopt;
+            }
+
+            auto&      inner_left  = unwrap(inner.get_left());
+            auto&      inner_right = unwrap(inner.get_right());
+            const bool commutative = inner_operation == BinaryOp::Addition ||
+                                     inner_operation == BinaryOp::Multiplication;
+
+            RawExpressionPtr*    slot     = nullptr;
+            std::optional<float> constant = std::nullopt;
+            if (is_slot(*inner_left) && (constant = constant_of(*inner_right))) {
+                slot = &inner_left;
+            } else if (commutative && is_slot(*inner_right) &&
+                       (constant = constant_of(*inner_left))) {
+                slot = &inner_right;
+            } else {
+                return std::nullopt;
+            }
+
+            Fusion fusion{Superinstruction::SlotConstChain};
+            fusion.parameters.operation       = inner_operation;
+            fusion.parameters.outer_operation = operation;
+            fusion.parameters.constant        = *constant;
+            fusion.parameters.reversed        = reversed;
+            fusion.operands                   = {slot, &other};
+            return fusion;
+        };
+
+        if (auto fusion = chain(left, right, false)) {
+            return fusion;
+        }
+        return chain(right, left, true);
+    }
+} // namespace molar::exec
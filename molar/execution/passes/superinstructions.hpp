@@ -0,0 +1,92 @@
+//
+// Created by Akashic on 10/19/2026.
+//
+
+#ifndef SUPERINSTRUCTIONS_HPP
+#define SUPERINSTRUCTIONS_HPP
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "execution/preprocessor/execution_nodes/fused_expression.hpp"
+#include "execution/runtime/dispatch_profile.hpp"
+#include "execution/runtime/molang_program.hpp"
+
+namespace molar::exec {
+    ///@brief A shape of nodes which ran in a profiled corpus
+    struct PatternCandidate {
+        ///@brief The node and two levels below it, `slot` for a slot read, `k` for a
+        /// literal and `_` for anything else, `((slot * k) + _)` for example
+        std::string                          pattern{};
+        ///@brief How often a node of this shape was dispatched
+        uint64_t                             executions{0};
+        ///@brief The dispatches one superinstruction for the whole shape would save
+        uint64_t                             saved{0};
+        ///@brief The superinstruction nodes of the shape were fused into, if any
+        std::optional<ast::Superinstruction> covered_by{};
+    };
+
+    ///@brief Ranks the shapes of a corpus by the dispatches fusing them would save, which is
+    /// where the shapes Superinstructions covers came from. Every node adds the shape rooted
+    /// at it, so the shapes overlap and their savings don't add up
+    class PatternProfile {
+    public:
+        ///@brief Adds every node of the program with how often the profile saw it, the
+        /// profile has to come from evaluating this program before it was changed
+        void add(MolangProgram& program, const DispatchProfile& profile);
+
+        ///@brief The candidates which save the most first, at most `count` of them
+        [[nodiscard]] std::vector<PatternCandidate> ranked(size_t count) const;
+
+    private:
+        void add_node(
+            MolangProgram& program, molar::ast::RawExpression& expression,
+            const DispatchProfile& profile
+        );
+
+        std::unordered_map<std::string, PatternCandidate> patterns{};
+    };
+
+    ///@brief Fuses the shapes which dominated a profiled corpus into FusedExpressions, which
+    /// MolangEvaluator runs in one dispatch, see Superinstruction for the shapes. Short
+    /// expressions spend most of their time dispatching, `v.x * 2 + 1` goes from five
+    /// dispatches to two.
+    ///
+    /// Every shape is parameterized by its arithmetic or ordering operators, so the six
+    /// instructions cover far more than twenty concrete patterns, molar_profile ranks the
+    /// shapes of a corpus. Single element parentheses are looked through, and a chain
+    /// starting with `k * slot` or `k + slot` is fused as `slot * k` or `slot + k`, which
+    /// is exact. Operands still run in the order they did.
+    ///
+    /// Fusing is for programs which stay on the interpreter, and runs after every other
+    /// pass. The JIT keeps a fused program on the interpreter, and the C++ emitter and
+    /// program binaries don't take one
+    class Superinstructions {
+    public:
+        ///@brief Returns how many nodes were fused
+        static size_t fuse(MolangProgram& program);
+
+        ///@brief The superinstruction the node would be fused into
+        static std::optional<ast::Superinstruction>
+        match(const MolangProgram& program, molar::ast::RawExpression& expression);
+
+    private:
+        ///@brief A shape found at a node, the operands point at the child pointers which
+        /// become the operands of the fused node
+        struct Fusion {
+            ast::Superinstruction                      instruction;
+            ast::FusedParameters                       parameters{};
+            std::vector<molar::ast::RawExpressionPtr*> operands{};
+        };
+
+        static std::optional<Fusion>
+        find(const MolangProgram& program, molar::ast::RawExpression& expression);
+
+        static std::optional<Fusion> find_binary(molar::ast::BinaryExpression& binary);
+
+        static size_t fuse(const MolangProgram& program, molar::ast::RawExpressionPtr& expression);
+    };
+} // namespace molar::exec
+
+#endif // SUPERINSTRUCTIONS_HPP
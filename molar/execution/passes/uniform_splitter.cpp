@@ -0,0 +1,119 @@
+//
+// Created by Akashic on 10/19/2026.
+//
+
+#include "uniform_splitter.hpp"
+
+#include "processed_tree.hpp"
+
+namespace molar::exec {
+    using namespace molar::ast;
+    using molar::details::type_asserted_cast;
+
+    namespace {
+        struct Inputs {
+            bool calls{false};
+            bool reads{false};
+        };
+
+        void find_inputs(RawExpression& expression, Inputs& inputs) {
+            if (expression.get_type() == AstKind::PreAllocatedCall) {
+                inputs.calls = true;
+            } else if (expression.get_type() == AstKind::PreAllocatedVariableReference) {
+                inputs.reads = true;
+            }
+            for_each_child(expression, [&](RawExpressionPtr& child) {
+                find_inputs(*child, inputs);
+            });
+        }
+    } // namespace
+
+    void EmitterStage::broadcast(
+        const std::span<const MolangValue> emitter_variables,
+        const std::span<MolangValue>       particle_variables
+    ) const {
+        for (const auto slot : this->slots) {
+            particle_variables[slot] = emitter_variables[slot];
+        }
+    }
+
+    EmitterStage
+    UniformSplitter::split(MolangProgram& program, const UniformityOptions& options) {
+        UniformSplitter splitter{program, options};
+        for (auto& statement : program.get_expressions()) {
+            splitter.collect_assigned(*statement);
+        }
+        for (auto& statement : program.get_expressions()) {
+            splitter.hoist(statement);
+        }
+
+        MolangAstGenerator::MolarAst ast{};
+        ast.get_expressions() = std::move(splitter.emitter);
+
+        // A copy of the layout with the hidden slots, so both stages index frames alike
+        auto state = program.get_collection_state();
+        return EmitterStage{
+            MolangProgram{
+                std::move(ast), std::move(state), program.get_math_bindings().get_precision()
+            },
+            std::move(splitter.slots)
+        };
+    }
+
+    void UniformSplitter::collect_assigned(RawExpression& expression) {
+        const auto mark = [&](const ast::PreAllocatedVariable& variable) {
+            if (variable.get_storage() != VariableDeclarationType::Temp) {
+                this->assigned.at(variable.get_value()) = true;
+            }
+        };
+
+        if (expression.get_type() == AstKind::PreAllocatedAssignment) {
+            mark(type_asserted_cast<ast::PreAllocatedVariable&>(expression));
+        } else if (expression.get_type() == AstKind::PreAllocatedForLoop) {
+            mark(
+                type_asserted_cast<ast::PreAllocatedForLoop&>(expression).get_variable_index()
+            );
+        }
+        for_each_child(expression, [&](RawExpressionPtr& child) {
+            this->collect_assigned(*child);
+        });
+    }
+
+    void UniformSplitter::hoist(RawExpressionPtr& expression) {
+        if (this->is_hoistable(*expression)) {
+            // A lone read or arithmetic on literals costs less than the copy, or folds
+            Inputs inputs{};
+            find_inputs(*expression, inputs);
+            if (inputs.calls || (inputs.reads && count_nodes(*expression) > 2)) {
+                const auto slot = this->program.add_variable("uniform");
+                this->slots.push_back(slot);
+                this->emitter.emplace_back(std::make_unique<ast::PreAllocatedVariableAssign>(
+                    slot, VariableDeclarationType::Var, std::move(expression)
+                ));
+                expression = std::make_unique<ast::PreAllocatedVariable>(
+                    slot, VariableDeclarationType::Var
+                );
+            }
+            return;
+        }
+        for_each_child(*expression, [&](RawExpressionPtr& child) { this->hoist(child); });
+    }
+
+    bool UniformSplitter::is_hoistable(RawExpression& expression) const {
+        if (!this->info.is_uniform(expression)) {
+            return false;
+        }
+        if (expression.get_type() == AstKind::PreAllocatedVariableReference) {
+            // A temp is null on the emitter's frame, a stored slot depends on when it's read
+            const auto& read = type_asserted_cast<ast::PreAllocatedVariable&>(expression);
+            return read.get_storage() != VariableDeclarationType::Temp &&
+                   !this->assigned.at(read.get_value());
+        }
+
+        bool hoistable = true;
+        for_each_child(expression, [&](RawExpressionPtr& child) {
+            hoistable = hoistable && this->is_hoistable(*child);
+        });
+        return hoistable;
+    }
+} // namespace molar::exec
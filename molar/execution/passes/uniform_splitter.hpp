@@ -0,0 +1,63 @@
+//
+// Created by Akashic on 10/19/2026.
+//
+
+#ifndef UNIFORM_SPLITTER_HPP
+#define UNIFORM_SPLITTER_HPP
+#include <span>
+#include <vector>
+
+#include "execution/analysis/uniformity.hpp"
+#include "execution/runtime/molang_program.hpp"
+#include "execution/runtime/molang_value.hpp"
+
+namespace molar::exec {
+    struct EmitterStage {
+        ///@brief Assigns every hidden slot, runs once per emitter each tick before any of
+        /// its particles, on a frame with the emitter's variables, arrays and queries
+        MolangProgram         emitter;
+        ///@brief The hidden `v.` slots the emitter stage assigns
+        std::vector<uint32_t> slots{};
+
+        ///@brief Copies the hidden slots from the frame the emitter stage ran on into the
+        /// frame of a particle, has to happen for every particle before it's evaluated
+        void broadcast(
+            std::span<const MolangValue> emitter_variables,
+            std::span<MolangValue>       particle_variables
+        ) const;
+    };
+
+    ///@brief Moves the uniform work of a particle program into a stage which runs once per
+    /// emitter, see UniformityAnalysis.
+    ///
+    /// Every largest uniform subexpression which reads a variable or calls something, and
+    /// which only reads variables the program never assigns, is moved into the emitter
+    /// stage. It stores the value in a hidden `v.` slot and the program reads the slot
+    /// instead. The program gets new variable slots, frames have to be sized afterwards and
+    /// the emitter's frame uses the same layout as the particles'
+    class UniformSplitter {
+    public:
+        static EmitterStage
+        split(MolangProgram& program, const UniformityOptions& options = {});
+
+    private:
+        UniformSplitter(MolangProgram& program, const UniformityOptions& options)
+            : program(program), info(UniformityAnalysis::analyze(program, options)),
+              assigned(program.get_variable_slot_count()) {}
+
+        void collect_assigned(molar::ast::RawExpression& expression);
+
+        void hoist(molar::ast::RawExpressionPtr& expression);
+
+        [[nodiscard]] bool is_hoistable(molar::ast::RawExpression& expression) const;
+
+        MolangProgram&                program;
+        const UniformityInfo          info;
+        // `v.` slots the program stores in, their value depends on where they're read
+        std::vector<bool>             assigned;
+        molar::ast::RawExpressionList emitter{};
+        std::vector<uint32_t>         slots{};
+    };
+} // namespace molar::exec
+
+#endif // UNIFORM_SPLITTER_HPP
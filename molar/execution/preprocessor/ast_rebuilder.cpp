@@ -8,6 +8,7 @@
 #include "ast/ast_replacer.hpp"
 #include "ast/controll_flow.hpp"
 #include "execution_nodes/pre_allocated.hpp"
+#include "execution_nodes/pre_allocated_string.hpp"
 #include "execution_nodes/pre_allocated_variable.hpp"
 #include "internal/checked_down_cast.hpp"
 #include "processed_ast_visitor.hpp"
@@ -19,7 +20,8 @@ namespace molar::exec {
     public:
         ~Replacer() override = default;
 
-        explicit Replacer(AstCollectorState& state) : state(state) {}
+        Replacer(AstCollectorState& state, StringPool& string_pool)
+            : state(state), string_pool(string_pool) {}
 
         [[nodiscard]] ast::PreAllocatedVariable
         build_variable(const VariableReference& expression) const {
@@ -27,12 +29,13 @@ namespace molar::exec {
             const auto variable           = this->state.get_state(expression.get_access_type())
                                       .variable_index_map.at(full_id);
 
-            return ast::PreAllocatedVariable{variable};
+            return ast::PreAllocatedVariable{variable, expression.get_access_type()};
         }
 
         [[nodiscard]] RawExpressionPtr rebuild_assignment(VariableAssign& expression) const {
+            const auto variable = this->build_variable(expression.get_variable());
             return std::make_unique<ast::PreAllocatedVariableAssign>(
-                this->build_variable(expression.get_variable()).get_value(),
+                variable.get_value(), variable.get_storage(),
                 std::move(expression.get_expression())
             );
         }
@@ -42,7 +45,7 @@ namespace molar::exec {
             const auto index = this->state.func_call_state.name_to_id.at(id);
 
             return std::make_unique<ast::PreAllocatedCall>(
-                index, std::move(expression.get_arguments())
+                index, this->state.call_site_count++, std::move(expression.get_arguments())
             );
         }
 
@@ -54,13 +57,29 @@ namespace molar::exec {
         }
 
         [[nodiscard]] RawExpressionPtr rebuild_for_loop(ForEachExpression& expression) const {
-            const auto var = this->build_variable(expression.get_storage());
             return std::make_unique<ast::PreAllocatedForLoop>(
-                var.get_value(), std::move(expression.get_array_fetch_expression()),
+                this->build_variable(expression.get_storage()),
+                std::move(expression.get_array_fetch_expression()),
                 std::move(expression.get_loop_expression())
             );
         }
 
+        [[nodiscard]] RawExpressionPtr rebuild_array_access(ArrayAccess& expression) const {
+            const auto index = this->state.array_state.variable_index_map.at(
+                std::string(expression.get_array_id().get_value())
+            );
+
+            return std::make_unique<ast::PreAllocatedArrayAccess>(
+                index, std::move(expression.get_index_expression())
+            );
+        }
+
+        [[nodiscard]] RawExpressionPtr rebuild_string(const StringLiteral& expression) const {
+            return std::make_unique<ast::PreAllocatedString>(
+                this->string_pool.intern(expression.get_value())
+            );
+        }
+
         RawExpressionPtr replace(RawExpressionPtr&& expression) override {
             if (expression->get_type() == AstKind::VariableReference) {
                 return this->rebuild_variable(
@@ -86,11 +105,24 @@ namespace molar::exec {
                 );
             }
 
+            if (expression->get_type() == AstKind::ArrayAccessExpression) {
+                return this->rebuild_array_access(
+                    molar::details::type_asserted_cast<ArrayAccess&>(*expression)
+                );
+            }
+
+            if (expression->get_type() == AstKind::StringLiteral) {
+                return this->rebuild_string(
+                    molar::details::type_asserted_cast<StringLiteral&>(*expression)
+                );
+            }
+
             return std::move(expression);
         }
 
     private:
         AstCollectorState& state;
+        StringPool&        string_pool;
     };
 
     void Rebuilder::rebuild() const {
@@ -100,7 +132,7 @@ namespace molar::exec {
     }
 
     void Rebuilder::replace_in_expression(RawExpressionPtr& expression) const {
-        auto replacer = Replacer{this->ast_information};
+        auto replacer = Replacer{this->ast_information, this->string_pool};
 
         AstReplacer(expression).visit_all<ast::details::ProcessedAstVisitorReplacer>(replacer);
     }
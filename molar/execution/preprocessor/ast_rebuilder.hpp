@@ -9,8 +9,10 @@
 namespace molar::exec {
     class Rebuilder {
     public:
-        Rebuilder(AstCollectorState& state, MolangAstGenerator::MolarAst& ast)
-            : ast_information(state), ast(ast) {}
+        Rebuilder(
+            AstCollectorState& state, MolangAstGenerator::MolarAst& ast, StringPool& string_pool
+        )
+            : ast_information(state), ast(ast), string_pool(string_pool) {}
 
         void rebuild() const;
 
@@ -20,6 +22,7 @@ namespace molar::exec {
     private:
         AstCollectorState&            ast_information;
         MolangAstGenerator::MolarAst& ast;
+        StringPool&                   string_pool;
     };
 } // namespace molar::exec
 
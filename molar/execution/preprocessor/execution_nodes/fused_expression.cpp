@@ -0,0 +1,30 @@
+//
+// Created by Akashic on 10/19/2026.
+//
+
+#include "fused_expression.hpp"
+#include <ostream>
+
+#include "execution/preprocessor/processed_ast_visitor.hpp"
+#include "internal/checked_down_cast.hpp"
+
+namespace molar::exec::ast {
+    void FusedExpression::print(std::ostream& out, const uint32_t index) {
+        molar::ast::Expression::print_util_tab(out, index);
+        out << "FusedExpression: " << static_cast<uint32_t>(this->instruction) << "\n";
+        for (const auto& operand : this->operands) {
+            operand->print(out, index + 1);
+        }
+    }
+
+    void FusedExpression::visit_node(molar::ast::AstVisitor& visitor) {
+        if (auto& visit = molar::details::type_asserted_cast<ProcessedAstVisitor>(visitor);
+            !visit.visit_processed_fused(*this)) {
+            return;
+        }
+
+        for (const auto& operand : this->operands) {
+            operand->visit_node(visitor);
+        }
+    }
+} // namespace molar::exec::ast
@@ -0,0 +1,82 @@
+//
+// Created by Akashic on 10/19/2026.
+//
+
+#ifndef FUSED_EXPRESSION_HPP
+#define FUSED_EXPRESSION_HPP
+#include "ast/expression.hpp"
+
+namespace molar::exec::ast {
+    ///@brief The shapes a FusedExpression runs in one dispatch. `op` is the arithmetic or
+    /// ordering comparison in FusedParameters::operation, `k` its constant
+    enum class Superinstruction : uint8_t {
+        ///@brief `slot op k`, or `k op slot` when reversed. Operands: the slot
+        SlotOpConst,
+        ///@brief `slot op slot`. Operands: both slots
+        SlotOpSlot,
+        ///@brief `(slot op k) outer x`, or `x outer (slot op k)` when reversed, `v.x * 2 + 1`
+        /// for example. Operands: the slot and `x`
+        SlotConstChain,
+        ///@brief `call op k`, a query or math call compared to or combined with a constant.
+        /// Operands: the call
+        CallOpConst,
+        ///@brief `a op b ? if : else` with an ordering comparison. Operands: `a`, `b`, the
+        /// if side and the else side
+        CompareSelect,
+        ///@brief `outer(inner(...), ...)` for two math calls which aren't random,
+        /// `math.clamp(math.sqrt(x), 0, 1)` for example. Operands: the arguments of the inner
+        /// call followed by the other arguments of the outer one
+        MathChain,
+    };
+
+    ///@brief What a FusedExpression needs besides its operands, only the fields its
+    /// instruction uses are set
+    struct FusedParameters {
+        molar::BinaryOp operation{molar::BinaryOp::Addition};
+        ///@brief The operation applied to the result of `operation`, for SlotConstChain
+        molar::BinaryOp outer_operation{molar::BinaryOp::Addition};
+        float           constant{0.0f};
+        ///@brief The constant or the chain is on the right side
+        bool            reversed{false};
+        ///@brief The call ids of a MathChain
+        uint32_t        outer_call{0};
+        uint32_t        inner_call{0};
+        ///@brief How many operands are arguments of the inner call of a MathChain
+        uint32_t        inner_arguments{0};
+    };
+
+    ///@brief A few nodes which are evaluated by one dispatch of the interpreter instead of one
+    /// per node. Only made by Superinstructions, which also documents what may run a
+    /// program once it has these.
+    ///
+    /// Slots are kept as operands so every pass still sees what the node reads. The
+    /// evaluator reads an operand which is still a slot directly and evaluates anything a
+    /// pass replaced it with
+    class FusedExpression : public molar::ast::RawExpression {
+    public:
+        FusedExpression(
+            const Superinstruction instruction, const FusedParameters& parameters,
+            molar::ast::RawExpressionList&& operands
+        )
+            : RawExpression(molar::ast::AstKind::FusedExpression), instruction(instruction),
+              parameters(parameters), operands(std::move(operands)) {}
+
+        ~FusedExpression() override = default;
+
+        void print(std::ostream& out, uint32_t index) override;
+        void visit_node(class molar::ast::AstVisitor& visitor) override;
+
+        [[nodiscard]] Superinstruction get_instruction() const { return this->instruction; }
+
+        [[nodiscard]] const FusedParameters& get_parameters() const { return this->parameters; }
+
+        [[nodiscard]] molar::ast::RawExpressionList& get_operands() { return this->operands; }
+
+    protected:
+        Superinstruction              instruction;
+        FusedParameters               parameters;
+        molar::ast::RawExpressionList operands;
+    };
+} // namespace molar::exec::ast
+
+#endif // FUSED_EXPRESSION_HPP
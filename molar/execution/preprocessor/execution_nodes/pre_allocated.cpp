@@ -24,6 +24,8 @@ namespace molar::exec::ast {
         molar::ast::Expression::print_util_tab(out, index);
         out << "Id: " << this->value << "\n";
         molar::ast::Expression::print_util_tab(out, index);
+        out << "Call Site: " << this->call_site << "\n";
+        molar::ast::Expression::print_util_tab(out, index);
         out << "Arguments: \n";
         for (const auto& arg : this->arguments) {
             arg->print(out, index + 1);
@@ -53,4 +55,21 @@ namespace molar::exec::ast {
         this->array_fetch_expression->visit_node(visitor);
         this->loop.visit_node(visitor);
     }
+
+    void PreAllocatedArrayAccess::print(std::ostream& out, const uint32_t index) {
+        molar::ast::Expression::print_util_tab(out, index);
+        out << "PreAllocatedArrayAccess: \n";
+        molar::ast::Expression::print_util_tab(out, index);
+        out << "Array Id: " << this->value << "\n";
+        molar::ast::Expression::print_util_tab(out, index);
+        out << "Index Expression: \n";
+        this->index_expression->print(out, index + 1);
+    }
+
+    void PreAllocatedArrayAccess::visit_node(molar::ast::AstVisitor& visitor) {
+        if (auto& visit = molar::details::type_asserted_cast<ProcessedAstVisitor>(visitor);
+            visit.visit_processed_array_access(*this)) {
+            this->index_expression->visit_node(visitor);
+        }
+    }
 } // namespace molar::exec::ast
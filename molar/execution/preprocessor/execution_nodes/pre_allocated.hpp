@@ -11,8 +11,12 @@ namespace molar::exec::ast {
     class PreAllocatedCall : public molar::ast::RawExpression,
                              public molar::ast::VariableManager<uint32_t> {
     public:
-        PreAllocatedCall(const uint32_t call_index, molar::ast::RawExpressionList&& arguments)
-            : VariableManager(call_index), arguments(std::move(arguments)) {
+        PreAllocatedCall(
+            const uint32_t call_index, const uint32_t call_site,
+            molar::ast::RawExpressionList&& arguments
+        )
+            : VariableManager(call_index), call_site(call_site),
+              arguments(std::move(arguments)) {
             this->type = molar::ast::AstKind::PreAllocatedCall;
         }
 
@@ -22,21 +26,25 @@ namespace molar::exec::ast {
 
         [[nodiscard]] molar::ast::RawExpressionList& get_arguments() { return this->arguments; }
 
+        ///@brief Unique per call expression in the program, used to key random streams
+        [[nodiscard]] uint32_t get_call_site() const { return this->call_site; }
+
         void print(std::ostream& out, const uint32_t index) override;
 
     protected:
+        uint32_t                      call_site;
         molar::ast::RawExpressionList arguments;
     };
 
     class PreAllocatedForLoop : public molar::ast::RawExpression {
     public:
         PreAllocatedForLoop(
-            const uint32_t                 variable_index,
+            PreAllocatedVariable&&         variable_index,
             molar::ast::RawExpressionPtr&& array_fetch_expression,
             molar::ast::BlockExpression&&  loop
         )
             : RawExpression(molar::ast::AstKind::PreAllocatedForLoop),
-              variable_index(variable_index),
+              variable_index(std::move(variable_index)),
               array_fetch_expression(
                   std::forward<molar::ast::RawExpressionPtr>(array_fetch_expression)
               ),
@@ -61,6 +69,28 @@ namespace molar::exec::ast {
         molar::ast::BlockExpression  loop;
     };
 
+    ///@brief `array.name[index]` with the array name resolved to its slot
+    class PreAllocatedArrayAccess : public molar::ast::RawExpression,
+                                    public molar::ast::VariableManager<uint32_t> {
+    public:
+        PreAllocatedArrayAccess(
+            const uint32_t array_index, molar::ast::RawExpressionPtr&& index_expression
+        )
+            : RawExpression(molar::ast::AstKind::PreAllocatedArrayAccess),
+              VariableManager(array_index), index_expression(std::move(index_expression)) {}
+
+        ~PreAllocatedArrayAccess() override = default;
+
+        void print(std::ostream& out, const uint32_t index) override;
+        void visit_node(class molar::ast::AstVisitor& visitor) override;
+
+        [[nodiscard]] molar::ast::RawExpressionPtr& get_index_expression() {
+            return this->index_expression;
+        }
+
+    protected:
+        molar::ast::RawExpressionPtr index_expression;
+    };
 } // namespace molar::exec::ast
 
 #endif // PRE_ALLOCATED_HPP
@@ -0,0 +1,23 @@
+//
+// Created by Akashic on 10/19/2026.
+//
+
+#include "pre_allocated_string.hpp"
+#include <ostream>
+
+#include "execution/preprocessor/processed_ast_visitor.hpp"
+#include "internal/checked_down_cast.hpp"
+
+namespace molar::exec::ast {
+    void PreAllocatedString::print(std::ostream& out, const uint32_t index) {
+        molar::ast::Expression::print_util_tab(out, index);
+        out << "PreAllocatedString: \n";
+        molar::ast::Expression::print_util_tab(out, index);
+        out << "String Id: " << this->get_value().get_id() << "\n";
+    }
+
+    void PreAllocatedString::visit_node(molar::ast::AstVisitor& visitor) {
+        auto& visit = molar::details::type_asserted_cast<ProcessedAstVisitor>(visitor);
+        (void)visit.visit_processed_string(*this);
+    }
+} // namespace molar::exec::ast
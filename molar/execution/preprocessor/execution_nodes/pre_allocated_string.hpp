@@ -0,0 +1,27 @@
+//
+// Created by Akashic on 10/19/2026.
+//
+
+#ifndef PRE_ALLOCATED_STRING_HPP
+#define PRE_ALLOCATED_STRING_HPP
+#include "ast/expression.hpp"
+#include "ast/internal/variable_manager.hpp"
+#include "execution/runtime/string_pool.hpp"
+
+namespace molar::exec::ast {
+    ///@brief A string literal which has been interned into the program's string pool
+    class PreAllocatedString : public molar::ast::RawExpression,
+                               public molar::ast::VariableManager<InternedString> {
+    public:
+        ~PreAllocatedString() override = default;
+
+        explicit PreAllocatedString(const InternedString string)
+            : RawExpression(molar::ast::AstKind::PreAllocatedString), VariableManager(string) {}
+
+        void print(std::ostream& out, uint32_t index) override;
+
+        void visit_node(class molar::ast::AstVisitor& visitor) override;
+    };
+} // namespace molar::exec::ast
+
+#endif // PRE_ALLOCATED_STRING_HPP
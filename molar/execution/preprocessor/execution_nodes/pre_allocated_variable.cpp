@@ -17,6 +17,8 @@ namespace molar::exec::ast {
         out << "PreAllocatedVariable: \n";
         Expression::print_util_tab(out, index);
         out << "Variable Id: " << this->get_value() << "\n";
+        Expression::print_util_tab(out, index);
+        out << "Storage: " << VariableReference::var_decl_type_to_string(this->storage) << "\n";
     }
 
     void PreAllocatedVariable::visit_node(molar::ast::AstVisitor& visitor) {
@@ -30,6 +32,8 @@ namespace molar::exec::ast {
         Expression::print_util_tab(out, index);
         out << "Variable Id: " << this->get_value() << "\n";
         Expression::print_util_tab(out, index);
+        out << "Storage: " << VariableReference::var_decl_type_to_string(this->storage) << "\n";
+        Expression::print_util_tab(out, index);
         out << "Expression:\n";
         this->assignment->print(out, index + 1);
     }
@@ -6,6 +6,7 @@
 #define PRE_ALLOCATED_VARIABLE_HPP
 #include "ast/expression.hpp"
 #include "ast/internal/variable_manager.hpp"
+#include "ast/variable.hpp"
 
 namespace molar::exec::ast {
 
@@ -14,13 +15,23 @@ namespace molar::exec::ast {
     public:
         ~PreAllocatedVariable() override = default;
 
-        explicit PreAllocatedVariable(const uint32_t id)
+        PreAllocatedVariable(
+            const uint32_t id, const molar::ast::VariableDeclarationType storage
+        )
             : RawExpression(molar::ast::AstKind::PreAllocatedVariableReference),
-              VariableManager(id) {}
+              VariableManager(id), storage(storage) {}
 
         void print(std::ostream& out, uint32_t index) override;
 
         void visit_node(class molar::ast::AstVisitor& visitor) override;
+
+        ///@brief Which slot array the id indexes, `v.` and `t.` are numbered separately
+        [[nodiscard]] molar::ast::VariableDeclarationType get_storage() const {
+            return this->storage;
+        }
+
+    protected:
+        molar::ast::VariableDeclarationType storage{};
     };
 
     class PreAllocatedVariableAssign : public PreAllocatedVariable {
@@ -28,9 +39,10 @@ namespace molar::exec::ast {
         ~PreAllocatedVariableAssign() override = default;
 
         PreAllocatedVariableAssign(
-            const uint32_t id, molar::ast::RawExpressionPtr&& rawExpression
+            const uint32_t id, const molar::ast::VariableDeclarationType storage,
+            molar::ast::RawExpressionPtr&& rawExpression
         )
-            : PreAllocatedVariable(id), assignment(std::move(rawExpression)) {
+            : PreAllocatedVariable(id, storage), assignment(std::move(rawExpression)) {
             this->type = molar::ast::AstKind::PreAllocatedAssignment;
         }
 
@@ -0,0 +1,40 @@
+//
+// Created by Akashic on 10/19/2026.
+//
+
+#include "select_expression.hpp"
+#include <ostream>
+
+#include "execution/preprocessor/processed_ast_visitor.hpp"
+#include "internal/checked_down_cast.hpp"
+
+namespace molar::exec::ast {
+    void SelectExpression::print(std::ostream& out, const uint32_t index) {
+        molar::ast::Expression::print_util_tab(out, index);
+        out << "SelectExpression: \n";
+        molar::ast::Expression::print_util_tab(out, index);
+        out << "Condition: \n";
+        this->condition->print(out, index + 1);
+        molar::ast::Expression::print_util_tab(out, index);
+        out << "If Expression: \n";
+        this->if_expression->print(out, index + 1);
+        if (this->else_expression) {
+            molar::ast::Expression::print_util_tab(out, index);
+            out << "Else Expression: \n";
+            this->else_expression->print(out, index + 1);
+        }
+    }
+
+    void SelectExpression::visit_node(molar::ast::AstVisitor& visitor) {
+        if (auto& visit = molar::details::type_asserted_cast<ProcessedAstVisitor>(visitor);
+            !visit.visit_processed_select(*this)) {
+            return;
+        }
+
+        this->condition->visit_node(visitor);
+        this->if_expression->visit_node(visitor);
+        if (this->else_expression) {
+            this->else_expression->visit_node(visitor);
+        }
+    }
+} // namespace molar::exec::ast
@@ -0,0 +1,45 @@
+//
+// Created by Akashic on 10/19/2026.
+//
+
+#ifndef SELECT_EXPRESSION_HPP
+#define SELECT_EXPRESSION_HPP
+#include "ast/expression.hpp"
+
+namespace molar::exec::ast {
+    ///@brief `condition ? if_expression : else_expression` which evaluates both sides before
+    /// picking one, so it can run without a branch. Only made by IfConversion, from sides
+    /// which have no side effects. Without an else side it picks null, like a conditional
+    class SelectExpression : public molar::ast::RawExpression {
+    public:
+        SelectExpression(
+            molar::ast::RawExpressionPtr&& condition,
+            molar::ast::RawExpressionPtr&& if_expression,
+            molar::ast::RawExpressionPtr&& else_expression
+        )
+            : RawExpression(molar::ast::AstKind::SelectExpression),
+              condition(std::move(condition)), if_expression(std::move(if_expression)),
+              else_expression(std::move(else_expression)) {}
+
+        ~SelectExpression() override = default;
+
+        void print(std::ostream& out, uint32_t index) override;
+        void visit_node(class molar::ast::AstVisitor& visitor) override;
+
+        [[nodiscard]] molar::ast::RawExpressionPtr& get_condition() { return this->condition; }
+        [[nodiscard]] molar::ast::RawExpressionPtr& get_if_expression() {
+            return this->if_expression;
+        }
+        ///@brief Null when the select picks null for a false condition
+        [[nodiscard]] molar::ast::RawExpressionPtr& get_else_expression() {
+            return this->else_expression;
+        }
+
+    protected:
+        molar::ast::RawExpressionPtr condition;
+        molar::ast::RawExpressionPtr if_expression;
+        molar::ast::RawExpressionPtr else_expression;
+    };
+} // namespace molar::exec::ast
+
+#endif // SELECT_EXPRESSION_HPP
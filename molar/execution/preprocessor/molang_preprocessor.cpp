@@ -13,6 +13,7 @@
 #include "ast/access_expression.hpp"
 #include "ast/ast_visitor.hpp"
 #include "ast/expression.hpp"
+#include "ast/literal.hpp"
 
 namespace molar::exec {
     class SlotCollectorInner final : public ast::AstVisitor {
@@ -48,6 +49,11 @@ namespace molar::exec {
 
         bool visit_resource(ast::ResourceExpression& expression) override { return true; }
 
+        bool visit_string(ast::StringLiteral& string) override {
+            this->state.string_state.add_id(std::string(string.get_value()));
+            return true;
+        }
+
     private:
         AstCollectorState& state;
     };
@@ -122,6 +128,6 @@ namespace molar::exec {
     }
 
     void MolangPreprocessor::rebuild() {
-        Rebuilder(this->collection_state, this->ast).rebuild();
+        Rebuilder(this->collection_state, this->ast, this->string_pool).rebuild();
     }
 } // namespace molar::exec
@@ -6,6 +6,7 @@
 #define MOLANG_PREPROCESSOR_HPP
 #include <unordered_map>
 
+#include "execution/runtime/string_pool.hpp"
 #include "molang_ast_generator.hpp"
 
 namespace molar::exec {
@@ -42,8 +43,14 @@ namespace molar::exec {
         VariableState temp_variables{};
         VariableState array_state{};
         NamedIdMap    func_call_state{};
-
-        VariableState& get_state(ast::VariableDeclarationType type);
+        NamedIdMap    string_state{};
+        // Every call expression gets its own site, even calls to the same function, so two
+        // `math.random` calls in one program draw from different random streams
+        uint32_t      call_site_count{0};
+        // Keeps the random streams of different programs apart, see math::program_id
+        uint32_t      program_id{0};
+
+        VariableState& get_state(molar::ast::VariableDeclarationType type);
     };
 
     ///@brief This class is responsible with the processing of the raw molang AST into a more
@@ -72,7 +79,11 @@ namespace molar::exec {
         };
 
     public:
-        explicit MolangPreprocessor(MolangAstGenerator::MolarAst&& ast) : ast(std::move(ast)) {}
+        explicit MolangPreprocessor(MolangAstGenerator::MolarAst&& ast)
+            : ast(std::move(ast)), string_pool(StringPool::shared()) {}
+
+        MolangPreprocessor(MolangAstGenerator::MolarAst&& ast, StringPool& string_pool)
+            : ast(std::move(ast)), string_pool(string_pool) {}
 
         void process();
 
@@ -80,9 +91,18 @@ namespace molar::exec {
 
         MolangAstGenerator::MolarAst consume_ast() { return std::move(this->ast); }
 
+        [[nodiscard]] const AstCollectorState& get_collection_state() const {
+            return this->collection_state;
+        }
+
+        AstCollectorState consume_collection_state() {
+            return std::move(this->collection_state);
+        }
+
     private:
         MolangAstGenerator::MolarAst ast;
         AstCollectorState            collection_state{};
+        StringPool&                  string_pool;
     };
 } // namespace molar::exec
 
@@ -4,8 +4,10 @@
 
 #include "processed_ast_visitor.hpp"
 
+#include "execution_nodes/fused_expression.hpp"
 #include "execution_nodes/pre_allocated.hpp"
 #include "execution_nodes/pre_allocated_variable.hpp"
+#include "execution_nodes/select_expression.hpp"
 
 namespace molar::exec::ast::details {
     bool ProcessedAstVisitorReplacer::visit_processed_variable_assign(
@@ -22,4 +24,44 @@ namespace molar::exec::ast::details {
         }
         return true;
     }
+
+    bool ProcessedAstVisitorReplacer::visit_processed_for_loop(
+        class PreAllocatedForLoop& expression
+    ) {
+        // The loop body is a block so it gets visited normally, but the array expression is
+        // only a child of the loop and would otherwise never be replaced itself
+        expression.get_array_fetch_expression() =
+            std::move(this->visitor.replace(std::move(expression.get_array_fetch_expression()))
+            );
+        return true;
+    }
+
+    bool ProcessedAstVisitorReplacer::visit_processed_array_access(
+        class PreAllocatedArrayAccess& expression
+    ) {
+        expression.get_index_expression() =
+            std::move(this->visitor.replace(std::move(expression.get_index_expression())));
+        return true;
+    }
+
+    bool ProcessedAstVisitorReplacer::visit_processed_select(
+        class SelectExpression& expression
+    ) {
+        expression.get_condition() =
+            std::move(this->visitor.replace(std::move(expression.get_condition())));
+        expression.get_if_expression() =
+            std::move(this->visitor.replace(std::move(expression.get_if_expression())));
+        if (expression.get_else_expression()) {
+            expression.get_else_expression() =
+                std::move(this->visitor.replace(std::move(expression.get_else_expression())));
+        }
+        return true;
+    }
+
+    bool ProcessedAstVisitorReplacer::visit_processed_fused(class FusedExpression& expression) {
+        for (auto& operand : expression.get_operands()) {
+            operand = std::move(this->visitor.replace(std::move(operand)));
+        }
+        return true;
+    }
 } // namespace molar::exec::ast::details
@@ -25,6 +25,14 @@ namespace molar::exec::ast {
         virtual bool visit_processed_for_loop(class PreAllocatedForLoop& expression) {
             return true;
         }
+        virtual bool visit_processed_string(class PreAllocatedString& expression) {
+            return true;
+        }
+        virtual bool visit_processed_array_access(class PreAllocatedArrayAccess& expression) {
+            return true;
+        }
+        virtual bool visit_processed_select(class SelectExpression& expression) { return true; }
+        virtual bool visit_processed_fused(class FusedExpression& expression) { return true; }
     };
 
 #pragma warning(push)
@@ -44,6 +52,15 @@ namespace molar::exec::ast {
             ) override;
 
             bool visit_processed_call(class PreAllocatedCall& expression) override;
+
+            bool visit_processed_for_loop(class PreAllocatedForLoop& expression) override;
+
+            bool visit_processed_array_access(class PreAllocatedArrayAccess& expression
+            ) override;
+
+            bool visit_processed_select(class SelectExpression& expression) override;
+
+            bool visit_processed_fused(class FusedExpression& expression) override;
         };
     } // namespace details
 #pragma warning(pop)
@@ -0,0 +1,53 @@
+//
+// Created by Akashic on 10/19/2026.
+//
+
+#ifndef DISPATCH_PROFILE_HPP
+#define DISPATCH_PROFILE_HPP
+#include <cstdint>
+#include <unordered_map>
+
+#include "ast/expression.hpp"
+
+namespace molar::exec {
+    ///@brief Counts how often a MolangEvaluator dispatched on every node of a program, see
+    /// MolangEvaluator::set_profile. What PatternProfile ranks fusion candidates by. Node
+    /// addresses are only meaningful while the program isn't changed
+    class DispatchProfile {
+    public:
+        void count(const molar::ast::RawExpression& expression) {
+            this->nodes[&expression]++;
+            this->dispatches++;
+        }
+
+        void count_evaluation() { this->evaluations++; }
+
+        [[nodiscard]] uint64_t get_count(const molar::ast::RawExpression& expression) const {
+            const auto found = this->nodes.find(&expression);
+            return found != this->nodes.end() ? found->second : 0;
+        }
+
+        [[nodiscard]] uint64_t get_dispatches() const { return this->dispatches; }
+
+        [[nodiscard]] uint64_t get_evaluations() const { return this->evaluations; }
+
+        [[nodiscard]] double get_dispatches_per_evaluation() const {
+            return this->evaluations == 0 ? 0.0
+                                          : static_cast<double>(this->dispatches) /
+                                                static_cast<double>(this->evaluations);
+        }
+
+        void clear() {
+            this->nodes.clear();
+            this->dispatches  = 0;
+            this->evaluations = 0;
+        }
+
+    private:
+        std::unordered_map<const molar::ast::RawExpression*, uint64_t> nodes{};
+        uint64_t                                                       dispatches{0};
+        uint64_t                                                       evaluations{0};
+    };
+} // namespace molar::exec
+
+#endif // DISPATCH_PROFILE_HPP
@@ -0,0 +1,54 @@
+//
+// Created by Akashic on 10/19/2026.
+//
+
+#ifndef EXECUTION_FRAME_HPP
+#define EXECUTION_FRAME_HPP
+#include <cstdint>
+#include <span>
+
+#include "molang_array.hpp"
+#include "molang_value.hpp"
+
+namespace molar::exec {
+    ///@brief Implemented by the host to answer `query.*` calls. The call id is the id of the
+    /// call in the program, see MolangProgram::find_query
+    class QueryHandler {
+    public:
+        virtual ~QueryHandler() = default;
+
+        virtual MolangValue query(uint32_t call_id, std::span<const MolangValue> arguments) = 0;
+
+        ///@brief Queries used as the array of a `for_each`. The returned view has to stay
+        /// valid until the evaluation returns, it is never copied
+        virtual MolangArray
+        query_array(const uint32_t call_id, const std::span<const MolangValue> arguments) {
+            return {};
+        }
+
+        ///@brief The handler used for the right side of `entity->query`. Returning nullptr
+        /// makes the access read as null
+        virtual QueryHandler* for_entity(const EntityHandle entity) { return nullptr; }
+    };
+
+    ///@brief Everything a single evaluation reads and writes. The slot spans are owned by the
+    /// host and have to be at least as long as the program's slot counts
+    struct ExecutionFrame {
+        // `v.` slots, these persist between evaluations of the same entity
+        std::span<MolangValue>       variables{};
+        // `t.` slots, reset to null at the start of every evaluation
+        std::span<MolangValue>       temps{};
+        // `array.` slots
+        std::span<const MolangArray> arrays{};
+        QueryHandler*                queries{nullptr};
+
+        // Keys the random streams, see RandomStream
+        uint64_t    entity{0};
+        // Advanced by every random draw, persist it next to the entity to replay draws
+        uint64_t    random_counter{0};
+        // What `this` reads as
+        MolangValue this_value{};
+    };
+} // namespace molar::exec
+
+#endif // EXECUTION_FRAME_HPP
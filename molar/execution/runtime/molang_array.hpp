@@ -0,0 +1,81 @@
+//
+// Created by Akashic on 10/19/2026.
+//
+
+#ifndef MOLANG_ARRAY_HPP
+#define MOLANG_ARRAY_HPP
+#include <algorithm>
+#include <cstddef>
+#include <span>
+
+#include "molang_value.hpp"
+
+namespace molar::exec {
+    ///@brief A read only view of an array owned by the host, such as the entities returned by
+    /// `q.players()` or the values bound to an `array.` slot. Nothing is copied, the host has
+    /// to keep the memory alive until the evaluation which uses it returns
+    class MolangArray {
+    public:
+        enum class ElementKind : uint8_t { Value, Entity };
+
+        constexpr MolangArray() = default;
+
+        constexpr MolangArray(const std::span<const MolangValue> values)
+            : element_kind(ElementKind::Value), value_data(values.data()),
+              count(values.size()) {}
+
+        constexpr MolangArray(const std::span<const EntityHandle> entities)
+            : element_kind(ElementKind::Entity), entity_data(entities.data()),
+              count(entities.size()) {}
+
+        [[nodiscard]] constexpr size_t size() const { return this->count; }
+
+        [[nodiscard]] constexpr bool empty() const { return this->count == 0; }
+
+        [[nodiscard]] constexpr ElementKind get_element_kind() const {
+            return this->element_kind;
+        }
+
+        [[nodiscard]] constexpr std::span<const MolangValue> values() const {
+            return this->element_kind == ElementKind::Value
+                       ? std::span{this->value_data, this->count}
+                       : std::span<const MolangValue>{};
+        }
+
+        [[nodiscard]] constexpr std::span<const EntityHandle> entities() const {
+            return this->element_kind == ElementKind::Entity
+                       ? std::span{this->entity_data, this->count}
+                       : std::span<const EntityHandle>{};
+        }
+
+        [[nodiscard]] constexpr MolangValue operator[](const size_t index) const {
+            if (this->element_kind == ElementKind::Entity) {
+                return this->entity_data[index];
+            }
+            return this->value_data[index];
+        }
+
+        ///@brief Molang array indexing, the index is floored, negative indices read the first
+        /// element and indices past the end wrap around. An empty array reads as null
+        [[nodiscard]] MolangValue at_wrapped(const float index) const {
+            if (this->count == 0) {
+                return MolangValue{};
+            }
+
+            // Above 2^24 a float can't hold every integer anyway, clamping keeps the cast valid
+            const auto floored =
+                index > 0.0f ? static_cast<size_t>(std::min(index, 0x1.0p24f)) : size_t{0};
+            return (*this)[floored % this->count];
+        }
+
+    private:
+        ElementKind element_kind{ElementKind::Value};
+        union {
+            const MolangValue*  value_data{nullptr};
+            const EntityHandle* entity_data;
+        };
+        size_t count{0};
+    };
+} // namespace molar::exec
+
+#endif // MOLANG_ARRAY_HPP
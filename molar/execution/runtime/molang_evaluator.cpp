@@ -0,0 +1,496 @@
+//
+// Created by Akashic on 10/19/2026.
+//
+
+#include "molang_evaluator.hpp"
+
+#include <algorithm>
+#include <array>
+#include <format>
+#include <stdexcept>
+
+#include "ast/access_expression.hpp"
+#include "ast/keyword.hpp"
+#include "execution/preprocessor/execution_nodes/fused_expression.hpp"
+#include "execution/preprocessor/execution_nodes/pre_allocated.hpp"
+#include "execution/preprocessor/execution_nodes/pre_allocated_string.hpp"
+#include "execution/preprocessor/execution_nodes/pre_allocated_variable.hpp"
+#include "execution/preprocessor/execution_nodes/select_expression.hpp"
+#include "internal/checked_down_cast.hpp"
+
+namespace molar::exec {
+    using namespace molar::ast;
+    using molar::details::type_asserted_cast;
+
+    namespace {
+        ///@brief Answers the frame's queries with another entity's handler until it goes out
+        /// of scope, also when a query throws
+        class EntityQueryScope {
+        public:
+            EntityQueryScope(ExecutionFrame& frame, QueryHandler* const handler)
+                : frame(frame), previous(frame.queries) {
+                frame.queries = handler;
+            }
+
+            ~EntityQueryScope() { this->frame.queries = this->previous; }
+
+            EntityQueryScope(const EntityQueryScope&)            = delete;
+            EntityQueryScope& operator=(const EntityQueryScope&) = delete;
+
+        private:
+            ExecutionFrame&     frame;
+            QueryHandler* const previous;
+        };
+
+        ///@brief The operations which read both sides as numbers, shared by binary
+        /// expressions and superinstructions
+        MolangValue apply_numeric(const BinaryOp operation, const float lhs, const float rhs) {
+            switch (operation) {
+            case BinaryOp::LessThan:
+                return lhs < rhs;
+            case BinaryOp::LessEqualThan:
+                return lhs <= rhs;
+            case BinaryOp::GreaterThan:
+                return lhs > rhs;
+            case BinaryOp::GreaterEqualThan:
+                return lhs >= rhs;
+            case BinaryOp::Addition:
+                return lhs + rhs;
+            case BinaryOp::Subtraction:
+                return lhs - rhs;
+            case BinaryOp::Multiplication:
+                return lhs * rhs;
+            case BinaryOp::Division:
+                return lhs / rhs;
+            default:
+                throw std::logic_error("Unknown binary operation");
+            }
+        }
+    } // namespace
+
+    MolangValue MolangEvaluator::evaluate(ExecutionFrame& frame) {
+        if (frame.variables.size() < this->program.get_variable_slot_count() ||
+            frame.temps.size() < this->program.get_temp_slot_count()) {
+            throw std::invalid_argument("The frame has less slots than the program uses");
+        }
+
+        if (this->profile != nullptr) {
+            this->profile->count_evaluation();
+        }
+
+        this->frame        = &frame;
+        this->flow         = Flow::Normal;
+        this->return_value = MolangValue{};
+        std::ranges::fill(frame.temps, MolangValue{});
+        // A query which threw last time left its arguments behind
+        this->argument_stack.clear();
+
+        MolangValue last{};
+        for (auto& expression : this->program.get_expressions()) {
+            last = this->evaluate_expression(*expression);
+
+            if (this->flow == Flow::Return) {
+                return this->return_value;
+            }
+            // A break or continue outside of a loop does nothing
+            this->flow = Flow::Normal;
+        }
+        return last;
+    }
+
+    MolangValue MolangEvaluator::evaluate_expression(RawExpression& expression) {
+        if (this->profile != nullptr) [[unlikely]] {
+            this->profile->count(expression);
+        }
+
+        switch (expression.get_type()) {
+        case AstKind::NumericLiteral:
+            return type_asserted_cast<NumericLiteral&>(expression).get_value();
+        case AstKind::BooleanLiteral:
+            return type_asserted_cast<BoolLiteral&>(expression).get_value();
+        case AstKind::PreAllocatedString:
+            return type_asserted_cast<ast::PreAllocatedString&>(expression).get_value();
+        case AstKind::PreAllocatedVariableReference:
+            return this->slot(type_asserted_cast<ast::PreAllocatedVariable&>(expression));
+        case AstKind::PreAllocatedAssignment: {
+            auto& assign = type_asserted_cast<ast::PreAllocatedVariableAssign&>(expression);
+            const auto value = this->evaluate_expression(*assign.get_assignment());
+            this->slot(assign) = value;
+            return value;
+        }
+        case AstKind::ParenthesizedExpression: {
+            MolangValue last{};
+            for (auto& inner :
+                 type_asserted_cast<ParenthesizedExpression&>(expression).get_expressions()) {
+                last = this->evaluate_expression(*inner);
+                if (this->flow != Flow::Normal) {
+                    break;
+                }
+            }
+            return last;
+        }
+        case AstKind::BlockExpression:
+            this->evaluate_block(type_asserted_cast<BlockExpression&>(expression));
+            return MolangValue{};
+        case AstKind::BinaryExpression:
+            return this->evaluate_binary(type_asserted_cast<BinaryExpression&>(expression));
+        case AstKind::UnaryExpression: {
+            auto&      unary = type_asserted_cast<UnaryExpression&>(expression);
+            const auto value = this->evaluate_expression(*unary.get_expression());
+            return unary.get_operation() == UnaryOp::Not ? MolangValue{!value.as_bool()}
+                                                         : MolangValue{-value.as_number()};
+        }
+        case AstKind::ConditionalExpression: {
+            auto& conditional = type_asserted_cast<ConditionalExpression&>(expression);
+            if (this->evaluate_expression(*conditional.get_condition()).as_bool()) {
+                return this->evaluate_expression(*conditional.get_if_expression());
+            }
+            return MolangValue{};
+        }
+        case AstKind::TernaryExpression: {
+            auto& ternary = type_asserted_cast<TernaryExpression&>(expression);
+            if (this->evaluate_expression(*ternary.get_condition()).as_bool()) {
+                return this->evaluate_expression(*ternary.get_if_expression());
+            }
+            return this->evaluate_expression(*ternary.get_else_expression());
+        }
+        case AstKind::SelectExpression: {
+            auto&      select    = type_asserted_cast<ast::SelectExpression&>(expression);
+            const bool condition = this->evaluate_expression(*select.get_condition()).as_bool();
+            const auto if_value  = this->evaluate_expression(*select.get_if_expression());
+            const auto else_value =
+                select.get_else_expression()
+                    ? this->evaluate_expression(*select.get_else_expression())
+                    : MolangValue{};
+            return condition ? if_value : else_value;
+        }
+        case AstKind::PreAllocatedCall:
+            return this->evaluate_call(type_asserted_cast<ast::PreAllocatedCall&>(expression));
+        case AstKind::FusedExpression:
+            return this->evaluate_fused(type_asserted_cast<ast::FusedExpression&>(expression));
+        case AstKind::PreAllocatedArrayAccess: {
+            auto& access = type_asserted_cast<ast::PreAllocatedArrayAccess&>(expression);
+            const auto index = this->evaluate_expression(*access.get_index_expression());
+
+            if (access.get_value() >= this->frame->arrays.size()) {
+                return MolangValue{};
+            }
+            return this->frame->arrays[access.get_value()].at_wrapped(index.as_number());
+        }
+        case AstKind::ArrowAccessExpression: {
+            auto&      arrow  = type_asserted_cast<ArrowAccess&>(expression);
+            const auto target = this->evaluate_expression(*arrow.get_lhs());
+
+            auto* const previous = this->frame->queries;
+            if (!target.is_entity() || previous == nullptr) {
+                return MolangValue{};
+            }
+
+            auto* const handler = previous->for_entity(target.as_entity());
+            if (handler == nullptr) {
+                return MolangValue{};
+            }
+
+            const EntityQueryScope scope{*this->frame, handler};
+            return this->evaluate_expression(*arrow.get_rhs());
+        }
+        case AstKind::LoopExpression:
+            this->evaluate_loop(type_asserted_cast<LoopExpression&>(expression));
+            return MolangValue{};
+        case AstKind::PreAllocatedForLoop:
+            this->evaluate_for_each(type_asserted_cast<ast::PreAllocatedForLoop&>(expression));
+            return MolangValue{};
+        case AstKind::Break:
+            this->flow = Flow::Break;
+            return MolangValue{};
+        case AstKind::Continue:
+            this->flow = Flow::Continue;
+            return MolangValue{};
+        case AstKind::Return: {
+            auto& node = type_asserted_cast<ReturnNode&>(expression);
+            this->return_value =
+                node.get_value() ? this->evaluate_expression(*node.get_value()) : MolangValue{};
+            this->flow = Flow::Return;
+            return this->return_value;
+        }
+        case AstKind::This:
+            return this->frame->this_value;
+        case AstKind::ResourceExpression:
+            // Resources are resolved by the renderer, they have no value in an expression
+            return MolangValue{};
+        default:
+            throw std::logic_error(std::format(
+                "{} can't be evaluated, the program wasn't preprocessed",
+                ast_kind_to_string(expression.get_type())
+            ));
+        }
+    }
+
+    MolangValue MolangEvaluator::evaluate_binary(BinaryExpression& expression) {
+        const auto operation = expression.get_operation();
+
+        // The short circuiting operators only evaluate the right side when they need it
+        switch (operation) {
+        case BinaryOp::And:
+            return this->evaluate_expression(*expression.get_left()).as_bool() &&
+                   this->evaluate_expression(*expression.get_right()).as_bool();
+        case BinaryOp::Or:
+            return this->evaluate_expression(*expression.get_left()).as_bool() ||
+                   this->evaluate_expression(*expression.get_right()).as_bool();
+        case BinaryOp::Coalesce: {
+            const auto left = this->evaluate_expression(*expression.get_left());
+            return left.is_null() ? this->evaluate_expression(*expression.get_right()) : left;
+        }
+        default:
+            break;
+        }
+
+        const auto left  = this->evaluate_expression(*expression.get_left());
+        const auto right = this->evaluate_expression(*expression.get_right());
+
+        if (operation == BinaryOp::Equality || operation == BinaryOp::Inequality) {
+            // Null reads as 0 so it only compares as a number
+            const bool numeric = !left.is_string() && !left.is_entity() &&
+                                 !right.is_string() && !right.is_entity();
+            const bool equal = numeric ? left.as_number() == right.as_number() : left == right;
+            return operation == BinaryOp::Equality ? equal : !equal;
+        }
+
+        return apply_numeric(operation, left.as_number(), right.as_number());
+    }
+
+    MolangValue MolangEvaluator::evaluate_call(ast::PreAllocatedCall& expression) {
+        const auto call_id = expression.get_value();
+
+        if (const auto* function = this->program.get_math_bindings().get(call_id)) {
+            // Missing arguments are passed as 0, extra ones are still evaluated for their side
+            // effects but ignored
+            std::array<float, 4> arguments{};
+            size_t               index = 0;
+            for (auto& argument : expression.get_arguments()) {
+                const auto value = this->evaluate_expression(*argument);
+                if (index < arguments.size()) {
+                    arguments[index++] = value.as_number();
+                }
+            }
+
+            if (!function->is_random) {
+                math::RandomStream unused{};
+                return function->scalar(arguments.data(), unused);
+            }
+
+            math::RandomStream stream{
+                this->frame->entity, expression.get_call_site(), this->frame->random_counter,
+                this->program.get_program_id()
+            };
+            const float result          = function->scalar(arguments.data(), stream);
+            this->frame->random_counter = stream.get_counter();
+            return result;
+        }
+
+        const auto start = this->push_arguments(expression.get_arguments());
+        MolangValue result{};
+        if (this->frame->queries != nullptr) {
+            result = this->frame->queries->query(
+                call_id, std::span{this->argument_stack}.subspan(start)
+            );
+        }
+        this->argument_stack.resize(start);
+        return result;
+    }
+
+    MolangValue MolangEvaluator::evaluate_fused(ast::FusedExpression& expression) {
+        using ast::Superinstruction;
+
+        const auto& parameters = expression.get_parameters();
+        auto&       operands   = expression.get_operands();
+        const auto  operation  = parameters.operation;
+        const float constant   = parameters.constant;
+
+        switch (expression.get_instruction()) {
+        case Superinstruction::SlotOpConst: {
+            const float value = this->evaluate_operand(*operands[0]).as_number();
+            return parameters.reversed ? apply_numeric(operation, constant, value)
+                                       : apply_numeric(operation, value, constant);
+        }
+        case Superinstruction::SlotOpSlot: {
+            const float lhs = this->evaluate_operand(*operands[0]).as_number();
+            const float rhs = this->evaluate_operand(*operands[1]).as_number();
+            return apply_numeric(operation, lhs, rhs);
+        }
+        case Superinstruction::SlotConstChain: {
+            // The sides still run in source order, the other side may write the slot
+            if (parameters.reversed) {
+                const float other = this->evaluate_operand(*operands[1]).as_number();
+                const float chain = apply_numeric(
+                    operation, this->evaluate_operand(*operands[0]).as_number(), constant
+                ).as_number();
+                return apply_numeric(parameters.outer_operation, other, chain);
+            }
+            const float chain = apply_numeric(
+                operation, this->evaluate_operand(*operands[0]).as_number(), constant
+            ).as_number();
+            const float other = this->evaluate_operand(*operands[1]).as_number();
+            return apply_numeric(parameters.outer_operation, chain, other);
+        }
+        case Superinstruction::CallOpConst: {
+            const float value = this->evaluate_operand(*operands[0]).as_number();
+            return parameters.reversed ? apply_numeric(operation, constant, value)
+                                       : apply_numeric(operation, value, constant);
+        }
+        case Superinstruction::CompareSelect: {
+            const float lhs = this->evaluate_operand(*operands[0]).as_number();
+            const float rhs = this->evaluate_operand(*operands[1]).as_number();
+            return this->evaluate_expression(
+                apply_numeric(operation, lhs, rhs).as_bool() ? *operands[2] : *operands[3]
+            );
+        }
+        case Superinstruction::MathChain: {
+            // Same argument handling as evaluate_call, for both calls
+            const auto& bindings = this->program.get_math_bindings();
+            const auto* inner    = bindings.get(parameters.inner_call);
+            const auto* outer    = bindings.get(parameters.outer_call);
+
+            math::RandomStream   unused{};
+            std::array<float, 4> arguments{};
+            size_t               index = 0;
+            for (uint32_t i = 0; i < parameters.inner_arguments; i++) {
+                const auto value = this->evaluate_operand(*operands[i]);
+                if (index < arguments.size()) {
+                    arguments[index++] = value.as_number();
+                }
+            }
+
+            std::array<float, 4> outer_arguments{inner->scalar(arguments.data(), unused)};
+            index = 1;
+            for (size_t i = parameters.inner_arguments; i < operands.size(); i++) {
+                const auto value = this->evaluate_operand(*operands[i]);
+                if (index < outer_arguments.size()) {
+                    outer_arguments[index++] = value.as_number();
+                }
+            }
+            return outer->scalar(outer_arguments.data(), unused);
+        }
+        default:
+            throw std::logic_error("Unknown superinstruction");
+        }
+    }
+
+    MolangValue MolangEvaluator::evaluate_operand(RawExpression& expression) {
+        switch (expression.get_type()) {
+        case AstKind::PreAllocatedVariableReference:
+            return this->slot(type_asserted_cast<ast::PreAllocatedVariable&>(expression));
+        case AstKind::PreAllocatedCall:
+            return this->evaluate_call(type_asserted_cast<ast::PreAllocatedCall&>(expression));
+        default:
+            return this->evaluate_expression(expression);
+        }
+    }
+
+    MolangArray MolangEvaluator::evaluate_array(RawExpression& expression) {
+        if (expression.get_type() != AstKind::PreAllocatedCall) {
+            // Anything else can't produce an array, still evaluate it for its side effects
+            (void)this->evaluate_expression(expression);
+            return MolangArray{};
+        }
+
+        auto& call = type_asserted_cast<ast::PreAllocatedCall&>(expression);
+        if (this->program.get_math_bindings().get(call.get_value()) != nullptr) {
+            (void)this->evaluate_call(call);
+            return MolangArray{};
+        }
+
+        const auto  start = this->push_arguments(call.get_arguments());
+        MolangArray result{};
+        if (this->frame->queries != nullptr) {
+            result = this->frame->queries->query_array(
+                call.get_value(), std::span{this->argument_stack}.subspan(start)
+            );
+        }
+        this->argument_stack.resize(start);
+        return result;
+    }
+
+    void MolangEvaluator::evaluate_block(BlockExpression& block) {
+        for (auto& expression : block.get_expressions()) {
+            (void)this->evaluate_expression(*expression);
+            if (this->flow != Flow::Normal) {
+                return;
+            }
+        }
+    }
+
+    bool MolangEvaluator::run_iteration(BlockExpression& body) {
+        this->evaluate_block(body);
+
+        switch (this->flow) {
+        case Flow::Break:
+            this->flow = Flow::Normal;
+            return false;
+        case Flow::Continue:
+            this->flow = Flow::Normal;
+            return true;
+        case Flow::Return:
+            return false;
+        default:
+            return true;
+        }
+    }
+
+    void MolangEvaluator::evaluate_loop(LoopExpression& expression) {
+        constexpr auto max_iterations = static_cast<float>(max_loop_iterations);
+
+        const auto  count = this->evaluate_expression(*expression.get_count_expression());
+        const float limit = std::min(count.as_number(), max_iterations);
+        const auto  iterations = limit > 0.0f ? static_cast<uint32_t>(limit) : 0u;
+
+        for (uint32_t i = 0; i < iterations; i++) {
+            if (!this->run_iteration(expression.get_loop_expression())) {
+                return;
+            }
+        }
+    }
+
+    void MolangEvaluator::evaluate_for_each(ast::PreAllocatedForLoop& expression) {
+        const auto array = this->evaluate_array(*expression.get_array_fetch_expression());
+        auto&      body  = expression.get_loop();
+
+        // The element goes straight into the loop variable's slot, the slot spans are owned by
+        // the host so the reference stays valid for the whole loop
+        MolangValue& variable = this->slot(expression.get_variable_index());
+
+        if (array.get_element_kind() == MolangArray::ElementKind::Entity) {
+            for (const auto entity : array.entities()) {
+                variable = entity;
+                if (!this->run_iteration(body)) {
+                    return;
+                }
+            }
+            return;
+        }
+
+        for (const auto& value : array.values()) {
+            variable = value;
+            if (!this->run_iteration(body)) {
+                return;
+            }
+        }
+    }
+
+    size_t MolangEvaluator::push_arguments(RawExpressionList& arguments) {
+        const auto start = this->argument_stack.size();
+        for (auto& argument : arguments) {
+            // Evaluated before pushing since a nested call can grow the stack
+            const auto value = this->evaluate_expression(*argument);
+            this->argument_stack.emplace_back(value);
+        }
+        return start;
+    }
+
+    MolangValue& MolangEvaluator::slot(const ast::PreAllocatedVariable& variable) const {
+        auto& slots = variable.get_storage() == VariableDeclarationType::Temp
+                          ? this->frame->temps
+                          : this->frame->variables;
+        return slots[variable.get_value()];
+    }
+} // namespace molar::exec
@@ -0,0 +1,79 @@
+//
+// Created by Akashic on 10/19/2026.
+//
+
+#ifndef MOLANG_EVALUATOR_HPP
+#define MOLANG_EVALUATOR_HPP
+#include <vector>
+
+#include "ast/controll_flow.hpp"
+#include "dispatch_profile.hpp"
+#include "execution_frame.hpp"
+#include "molang_program.hpp"
+
+namespace molar::exec {
+    namespace ast {
+        class PreAllocatedVariable;
+        class PreAllocatedCall;
+        class PreAllocatedForLoop;
+        class FusedExpression;
+    } // namespace ast
+
+    ///@brief Walks a processed program. An evaluator is cheap to keep around and reuses its
+    /// argument storage, so a host should keep one per thread instead of one per evaluation
+    class MolangEvaluator {
+    public:
+        // Molang caps `loop` to stop runaway scripts
+        static constexpr uint32_t max_loop_iterations = 1024;
+
+        explicit MolangEvaluator(MolangProgram& program) : program(program) {}
+
+        ///@brief Evaluates the whole program. The result is the value of `return` if one ran,
+        /// otherwise the value of the last expression
+        MolangValue evaluate(ExecutionFrame& frame);
+
+        ///@brief Counts every evaluation and every node dispatched into the profile until it's
+        /// set back to nullptr. Costs a branch per node while unset
+        void set_profile(DispatchProfile* profile) { this->profile = profile; }
+
+    private:
+        enum class Flow : uint8_t { Normal, Break, Continue, Return };
+
+        MolangValue evaluate_expression(molar::ast::RawExpression& expression);
+
+        MolangValue evaluate_binary(molar::ast::BinaryExpression& expression);
+
+        MolangValue evaluate_call(ast::PreAllocatedCall& expression);
+
+        MolangValue evaluate_fused(ast::FusedExpression& expression);
+
+        ///@brief Evaluates an operand of a superinstruction, slots and calls without a dispatch
+        MolangValue evaluate_operand(molar::ast::RawExpression& expression);
+
+        MolangArray evaluate_array(molar::ast::RawExpression& expression);
+
+        void evaluate_block(molar::ast::BlockExpression& block);
+
+        void evaluate_loop(molar::ast::LoopExpression& expression);
+
+        void evaluate_for_each(ast::PreAllocatedForLoop& expression);
+
+        ///@brief Evaluates the arguments onto the argument stack, returns where they start
+        size_t push_arguments(molar::ast::RawExpressionList& arguments);
+
+        MolangValue& slot(const ast::PreAllocatedVariable& variable) const;
+
+        ///@brief Runs a loop body, returns false once the loop should stop
+        bool run_iteration(molar::ast::BlockExpression& body);
+
+    private:
+        MolangProgram&           program;
+        ExecutionFrame*          frame{nullptr};
+        Flow                     flow{Flow::Normal};
+        MolangValue              return_value{};
+        std::vector<MolangValue> argument_stack{};
+        DispatchProfile*         profile{nullptr};
+    };
+} // namespace molar::exec
+
+#endif // MOLANG_EVALUATOR_HPP
@@ -0,0 +1,91 @@
+//
+// Created by Akashic on 10/19/2026.
+//
+
+#include "molang_program.hpp"
+
+#include <format>
+#include <string>
+
+#include "molang_ast_generator.hpp"
+#include "molang_tokenizer.hpp"
+
+namespace molar::exec {
+    MolangProgram::MolangProgram(
+        MolangAstGenerator::MolarAst&& ast, AstCollectorState&& state,
+        const math::MathPrecision precision
+    )
+        : ast(std::move(ast)), state(std::move(state)),
+          math_bindings(math::MathBindings::bind(this->state, precision)) {}
+
+    MolangProgram MolangProgram::compile(
+        const std::string_view source, StringPool& string_pool,
+        const math::MathPrecision precision, const PhaseCallback& on_phase
+    ) {
+        MolangTokenizer    tokenizer{std::string(source)};
+        auto               tokens = tokenizer.parse_tokens();
+        molar::TokenBuffer buffer{std::move(tokens)};
+
+        MolangAstGenerator generator(std::move(buffer), tokenizer.move_buffer());
+
+        MolangPreprocessor processor{generator.build_ast(), string_pool};
+        if (on_phase) {
+            on_phase("parse");
+        }
+
+        processor.process();
+        if (on_phase) {
+            on_phase("collect");
+        }
+
+        // Binding the math calls is part of the rebuild
+        processor.rebuild();
+
+        auto state       = processor.consume_collection_state();
+        state.program_id = math::program_id(source);
+        return MolangProgram{processor.consume_ast(), std::move(state), precision};
+    }
+
+    std::optional<uint32_t> MolangProgram::find_variable_slot(
+        const molar::ast::VariableDeclarationType type, const std::string_view name
+    ) const {
+        const auto& variables = type == molar::ast::VariableDeclarationType::Temp
+                                    ? this->state.temp_variables
+                                    : this->state.variables;
+
+        if (const auto it = variables.variable_index_map.find(std::string(name));
+            it != variables.variable_index_map.end()) {
+            return it->second;
+        }
+        return std::nullopt;
+    }
+
+    std::optional<uint32_t> MolangProgram::find_array_slot(const std::string_view name) const {
+        const auto& arrays = this->state.array_state.variable_index_map;
+
+        if (const auto it = arrays.find(std::string(name)); it != arrays.end()) {
+            return it->second;
+        }
+        return std::nullopt;
+    }
+
+    uint32_t MolangProgram::add_temp(const std::string_view purpose) {
+        auto& temps = this->state.temp_variables;
+        return temps.add_variable(std::format("#{}{}", purpose, temps.variable_index));
+    }
+
+    uint32_t MolangProgram::add_variable(const std::string_view purpose) {
+        auto& variables = this->state.variables;
+        return variables.add_variable(std::format("#{}{}", purpose, variables.variable_index));
+    }
+
+    std::optional<uint32_t> MolangProgram::find_query(const std::string_view name) const {
+        const auto& calls = this->state.func_call_state.name_to_id;
+
+        // See CallExpression::build_full_name
+        if (const auto it = calls.find(std::string(name) + "q"); it != calls.end()) {
+            return it->second;
+        }
+        return std::nullopt;
+    }
+} // namespace molar::exec
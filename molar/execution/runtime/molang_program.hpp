@@ -0,0 +1,94 @@
+//
+// Created by Akashic on 10/19/2026.
+//
+
+#ifndef MOLANG_PROGRAM_HPP
+#define MOLANG_PROGRAM_HPP
+#include <functional>
+#include <optional>
+#include <string_view>
+
+#include "execution/math/math_bindings.hpp"
+#include "execution/preprocessor/molang_preprocessor.hpp"
+
+namespace molar::exec {
+    ///@brief A Molang source which has been parsed, preprocessed and had its math calls bound,
+    /// ready to be evaluated by any number of frames
+    class MolangProgram {
+    public:
+        ///@brief Has to be bumped whenever compile builds a different tree for the same
+        /// source and options, a preprocessor or folding change for example, even when the
+        /// binary layout stays the same. Cached programs from another version are recompiled
+        static constexpr uint32_t compiler_version = 1;
+
+        MolangProgram(
+            MolangAstGenerator::MolarAst&& ast, AstCollectorState&& state,
+            math::MathPrecision precision = math::MathPrecision::Exact
+        );
+
+        ///@brief Called with "parse" and "collect" as those front end phases finish, the
+        /// last one, "rebuild", finishes when compile returns. PassManager times them with it
+        using PhaseCallback = std::function<void(std::string_view phase)>;
+
+        ///@brief Runs the full pipeline over a source string. Throws MolangSyntaxError for
+        /// invalid sources and std::invalid_argument for unknown math functions. Every entry
+        /// point which builds a program from source goes through here
+        static MolangProgram compile(
+            std::string_view source, StringPool& string_pool = StringPool::shared(),
+            math::MathPrecision precision = math::MathPrecision::Exact,
+            const PhaseCallback& on_phase = {}
+        );
+
+        [[nodiscard]] molar::ast::RawExpressionList& get_expressions() {
+            return this->ast.get_expressions();
+        }
+
+        [[nodiscard]] const AstCollectorState& get_collection_state() const {
+            return this->state;
+        }
+
+        [[nodiscard]] const math::MathBindings& get_math_bindings() const {
+            return this->math_bindings;
+        }
+
+        ///@brief The math::program_id of the source, 0 for programs which weren't compiled
+        /// from one
+        [[nodiscard]] uint32_t get_program_id() const { return this->state.program_id; }
+
+        [[nodiscard]] size_t get_variable_slot_count() const {
+            return this->state.variables.variable_index;
+        }
+        [[nodiscard]] size_t get_temp_slot_count() const {
+            return this->state.temp_variables.variable_index;
+        }
+        [[nodiscard]] size_t get_array_slot_count() const {
+            return this->state.array_state.variable_index;
+        }
+
+        ///@brief The slot of a variable, named the way the collector stores it (`x` for
+        /// `v.x`)
+        [[nodiscard]] std::optional<uint32_t> find_variable_slot(
+            molar::ast::VariableDeclarationType type, std::string_view name
+        ) const;
+
+        [[nodiscard]] std::optional<uint32_t> find_array_slot(std::string_view name) const;
+
+        ///@brief Adds a temp slot for a pass which needs somewhere to keep a value, returns
+        /// its slot. The name starts with `#` so it never clashes with a `t.` of the source.
+        /// Frames have to be sized after the passes ran
+        uint32_t add_temp(std::string_view purpose);
+
+        ///@brief Like add_temp for a `v.` slot, which keeps its value between evaluations
+        uint32_t add_variable(std::string_view purpose);
+
+        ///@brief The call id the evaluator passes to the QueryHandler for `q.name`
+        [[nodiscard]] std::optional<uint32_t> find_query(std::string_view name) const;
+
+    private:
+        MolangAstGenerator::MolarAst ast;
+        AstCollectorState            state;
+        math::MathBindings           math_bindings;
+    };
+} // namespace molar::exec
+
+#endif // MOLANG_PROGRAM_HPP
@@ -0,0 +1,113 @@
+//
+// Created by Akashic on 10/19/2026.
+//
+
+#ifndef MOLANG_VALUE_HPP
+#define MOLANG_VALUE_HPP
+#include <cstdint>
+#include <type_traits>
+
+#include "string_pool.hpp"
+
+namespace molar::exec {
+    enum class ValueKind : uint8_t { Null, Number, String, Entity };
+
+    ///@brief An entity owned by the host, the id is whatever the host uses to find it again
+    struct EntityHandle {
+        uint32_t id{0};
+
+        constexpr bool operator==(const EntityHandle&) const = default;
+    };
+
+    ///@brief The value every Molang expression evaluates to. Booleans are stored as 1.0 and
+    /// 0.0 like the language expects, and strings are stored as pool handles so a value is
+    /// always trivially copyable and never allocates
+    class MolangValue {
+    public:
+        // Spelled out since the handle members make a defaulted constructor deleted
+        constexpr MolangValue() : kind(ValueKind::Null), number(0.0f) {}
+
+        constexpr MolangValue(const float number) : kind(ValueKind::Number), number(number) {}
+
+        constexpr MolangValue(const bool boolean)
+            : kind(ValueKind::Number), number(boolean ? 1.0f : 0.0f) {}
+
+        constexpr MolangValue(const InternedString string)
+            : kind(ValueKind::String), string(string) {}
+
+        constexpr MolangValue(const EntityHandle entity)
+            : kind(ValueKind::Entity), entity(entity) {}
+
+        ///@brief Converts a string coming from the host at the query boundary
+        static MolangValue from_host_string(StringPool& pool, const std::string_view string) {
+            return MolangValue{pool.intern(string)};
+        }
+
+        [[nodiscard]] constexpr ValueKind get_kind() const { return this->kind; }
+
+        [[nodiscard]] constexpr bool is_null() const { return this->kind == ValueKind::Null; }
+        [[nodiscard]] constexpr bool is_number() const {
+            return this->kind == ValueKind::Number;
+        }
+        [[nodiscard]] constexpr bool is_string() const {
+            return this->kind == ValueKind::String;
+        }
+        [[nodiscard]] constexpr bool is_entity() const {
+            return this->kind == ValueKind::Entity;
+        }
+
+        ///@brief Reads the value as a number, anything which isn't a number reads as 0
+        [[nodiscard]] constexpr float as_number() const {
+            return this->kind == ValueKind::Number ? this->number : 0.0f;
+        }
+
+        [[nodiscard]] constexpr bool as_bool() const { return this->as_number() != 0.0f; }
+
+        [[nodiscard]] constexpr InternedString as_string() const {
+            return this->kind == ValueKind::String ? this->string : InternedString{};
+        }
+
+        [[nodiscard]] constexpr EntityHandle as_entity() const {
+            return this->kind == ValueKind::Entity ? this->entity : EntityHandle{};
+        }
+
+        // Strings of one pool compare by handle, strings of different pools by their
+        // contents, see StringPool::equal
+        constexpr bool operator==(const MolangValue& other) const {
+            if (this->kind != other.kind) {
+                return false;
+            }
+
+            switch (this->kind) {
+            case ValueKind::Number:
+                return this->number == other.number;
+            case ValueKind::String:
+                if (this->string.get_pool() == other.string.get_pool()) {
+                    return this->string == other.string;
+                }
+                if consteval {
+                    return false;
+                } else {
+                    return StringPool::equal(this->string, other.string);
+                }
+            case ValueKind::Entity:
+                return this->entity == other.entity;
+            default:
+                return true;
+            }
+        }
+
+    private:
+        ValueKind kind{ValueKind::Null};
+        union {
+            float          number;
+            InternedString string;
+            EntityHandle   entity;
+        };
+    };
+
+    static_assert(std::is_trivially_copyable_v<MolangValue>);
+    static_assert(sizeof(MolangValue) == 8);
+} // namespace molar::exec
+
+#endif // MOLANG_VALUE_HPP
@@ -0,0 +1,444 @@
+//
+// Created by Akashic on 10/19/2026.
+//
+
+#include "particle_kernel.hpp"
+
+#include <algorithm>
+#include <bit>
+
+#include "ast/keyword.hpp"
+#include "ast/literal.hpp"
+#include "execution/math/float_lanes.hpp"
+#include "execution/preprocessor/execution_nodes/pre_allocated.hpp"
+#include "execution/preprocessor/execution_nodes/pre_allocated_variable.hpp"
+#include "execution/preprocessor/execution_nodes/select_expression.hpp"
+#include "internal/checked_down_cast.hpp"
+
+namespace molar::exec {
+    using namespace molar::ast;
+    using molar::details::type_asserted_cast;
+
+    namespace {
+        // Thrown while compiling a node the kernel doesn't cover
+        struct Unsupported {};
+
+        // The value conversions of MolangValue on the register encoding, branch free so the
+        // loops over a block vectorise
+
+        float number(const float value) {
+            return math::lanes::blend(
+                std::bit_cast<uint32_t>(value) == ParticleKernel::null_bits, 0.0f, value
+            );
+        }
+
+        bool truthy(const float value) { return number(value) != 0.0f; }
+
+        float boolean(const bool value) { return math::lanes::blend(value, 1.0f, 0.0f); }
+
+        template <typename Operation>
+        void map_block(
+            const size_t count, float* const out, const float* const value, Operation&& operation
+        ) {
+            for (size_t i = 0; i < count; i++) {
+                out[i] = operation(value[i]);
+            }
+        }
+
+        template <typename Operation>
+        void zip_block(
+            const size_t count, float* const out, const float* const lhs, const float* const rhs,
+            Operation&& operation
+        ) {
+            for (size_t i = 0; i < count; i++) {
+                out[i] = operation(lhs[i], rhs[i]);
+            }
+        }
+    } // namespace
+
+    ParticleKernel::ParticleKernel(MolangProgram& program)
+        : program(program), fallback(program) {
+        try {
+            // The first pass finds the assigned slots, the second copies reads of them
+            this->compile_program();
+            this->compile_program();
+            this->columnar = true;
+        } catch (const Unsupported&) {
+            this->ops.clear();
+            this->constants.clear();
+            this->register_count = 0;
+        }
+    }
+
+    void ParticleKernel::compile_program() {
+        const auto variables = static_cast<uint32_t>(this->program.get_variable_slot_count());
+        const auto temps     = static_cast<uint32_t>(this->program.get_temp_slot_count());
+
+        this->ops.clear();
+        this->constants.clear();
+        this->register_count = variables + temps;
+        this->effects        = 0;
+        this->used_variables.assign(variables, false);
+        if (this->assigned_variables.size() != variables) {
+            this->assigned_variables.assign(variables, false);
+            this->assigned_temps.assign(temps, false);
+        }
+
+        // Same result as MolangEvaluator::evaluate, the value of a top level `return` or of
+        // the last expression
+        this->result = this->constant(std::bit_cast<float>(null_bits));
+        for (auto& expression : this->program.get_expressions()) {
+            if (expression->get_type() == AstKind::Return) {
+                auto& node   = type_asserted_cast<ReturnNode&>(*expression);
+                this->result = node.get_value() ? this->compile(*node.get_value())
+                                                : this->constant(std::bit_cast<float>(null_bits));
+                return;
+            }
+            this->result = this->compile(*expression);
+        }
+    }
+
+    uint32_t ParticleKernel::compile(RawExpression& expression) {
+        switch (expression.get_type()) {
+        case AstKind::NumericLiteral:
+            return this->constant(type_asserted_cast<NumericLiteral&>(expression).get_value());
+        case AstKind::BooleanLiteral:
+            return this->constant(
+                type_asserted_cast<BoolLiteral&>(expression).get_value() ? 1.0f : 0.0f
+            );
+        case AstKind::PreAllocatedVariableReference: {
+            const auto& variable = type_asserted_cast<ast::PreAllocatedVariable&>(expression);
+            const auto  slot     = variable.get_value();
+            const auto  target   = this->slot_register(variable.get_storage(), slot);
+
+            const bool temp = variable.get_storage() == VariableDeclarationType::Temp;
+            if (!temp) {
+                this->used_variables[slot] = true;
+            }
+            if (temp ? this->assigned_temps[slot] : this->assigned_variables[slot]) {
+                return this->emit({.kind = OpKind::Copy, .operands = {target}});
+            }
+            return target;
+        }
+        case AstKind::PreAllocatedAssignment: {
+            auto&      assign = type_asserted_cast<ast::PreAllocatedVariableAssign&>(expression);
+            const auto value  = this->compile(*assign.get_assignment());
+            const auto slot   = assign.get_value();
+
+            if (assign.get_storage() == VariableDeclarationType::Temp) {
+                this->assigned_temps[slot] = true;
+            } else {
+                this->assigned_variables[slot] = true;
+                this->used_variables[slot]     = true;
+            }
+            this->effects++;
+            this->ops.push_back(
+                {.kind     = OpKind::Copy,
+                 .target   = this->slot_register(assign.get_storage(), slot),
+                 .operands = {value}}
+            );
+            return value;
+        }
+        case AstKind::ParenthesizedExpression: {
+            auto result = this->constant(std::bit_cast<float>(null_bits));
+            for (auto& inner :
+                 type_asserted_cast<ParenthesizedExpression&>(expression).get_expressions()) {
+                result = this->compile(*inner);
+            }
+            return result;
+        }
+        case AstKind::BlockExpression:
+            for (auto& inner : type_asserted_cast<BlockExpression&>(expression).get_expressions()) {
+                (void)this->compile(*inner);
+            }
+            return this->constant(std::bit_cast<float>(null_bits));
+        case AstKind::BinaryExpression: {
+            auto&      binary    = type_asserted_cast<BinaryExpression&>(expression);
+            const auto operation = binary.get_operation();
+            const auto lhs       = this->compile(*binary.get_left());
+
+            switch (operation) {
+            // The right side of these only runs when it's needed, it's computed for every
+            // particle here
+            case BinaryOp::And:
+                return this->emit(
+                    {.kind     = OpKind::And,
+                     .operands = {lhs, this->compile_pure(*binary.get_right())}}
+                );
+            case BinaryOp::Or:
+                return this->emit(
+                    {.kind     = OpKind::Or,
+                     .operands = {lhs, this->compile_pure(*binary.get_right())}}
+                );
+            case BinaryOp::Coalesce:
+                return this->emit(
+                    {.kind     = OpKind::Coalesce,
+                     .operands = {lhs, this->compile_pure(*binary.get_right())}}
+                );
+            case BinaryOp::Equality:
+            case BinaryOp::Inequality:
+                // Registers only hold numbers and null, which compares as 0
+                return this->emit(
+                    {.kind = operation == BinaryOp::Equality ? OpKind::Equal : OpKind::NotEqual,
+                     .operands = {lhs, this->compile(*binary.get_right())}}
+                );
+            case BinaryOp::LessThan:
+            case BinaryOp::LessEqualThan:
+            case BinaryOp::GreaterThan:
+            case BinaryOp::GreaterEqualThan:
+            case BinaryOp::Addition:
+            case BinaryOp::Subtraction:
+            case BinaryOp::Multiplication:
+            case BinaryOp::Division:
+                return this->emit(
+                    {.kind      = OpKind::Numeric,
+                     .operation = operation,
+                     .operands  = {lhs, this->compile(*binary.get_right())}}
+                );
+            default:
+                throw Unsupported{};
+            }
+        }
+        case AstKind::UnaryExpression: {
+            auto&      unary = type_asserted_cast<UnaryExpression&>(expression);
+            const auto value = this->compile(*unary.get_expression());
+            return this->emit(
+                {.kind     = unary.get_operation() == UnaryOp::Not ? OpKind::Not : OpKind::Negate,
+                 .operands = {value}}
+            );
+        }
+        case AstKind::ConditionalExpression: {
+            auto&      conditional = type_asserted_cast<ConditionalExpression&>(expression);
+            const auto condition   = this->compile(*conditional.get_condition());
+            const auto if_value    = this->compile_pure(*conditional.get_if_expression());
+            return this->emit(
+                {.kind     = OpKind::Select,
+                 .operands = {
+                     condition, if_value, this->constant(std::bit_cast<float>(null_bits))
+                 }}
+            );
+        }
+        case AstKind::TernaryExpression: {
+            auto&      ternary   = type_asserted_cast<TernaryExpression&>(expression);
+            const auto condition = this->compile(*ternary.get_condition());
+            const auto if_value  = this->compile_pure(*ternary.get_if_expression());
+            const auto else_value = this->compile_pure(*ternary.get_else_expression());
+            return this->emit(
+                {.kind = OpKind::Select, .operands = {condition, if_value, else_value}}
+            );
+        }
+        case AstKind::SelectExpression: {
+            // Both sides of a select always run, so they may have effects
+            auto&      select    = type_asserted_cast<ast::SelectExpression&>(expression);
+            const auto condition = this->compile(*select.get_condition());
+            const auto if_value  = this->compile(*select.get_if_expression());
+            const auto else_value =
+                select.get_else_expression()
+                    ? this->compile(*select.get_else_expression())
+                    : this->constant(std::bit_cast<float>(null_bits));
+            return this->emit(
+                {.kind = OpKind::Select, .operands = {condition, if_value, else_value}}
+            );
+        }
+        case AstKind::PreAllocatedCall: {
+            auto&       call     = type_asserted_cast<ast::PreAllocatedCall&>(expression);
+            const auto* function = this->program.get_math_bindings().get(call.get_value());
+            if (function == nullptr) {
+                // Queries go to the host one particle at a time
+                throw Unsupported{};
+            }
+
+            // Same argument handling as MolangEvaluator::evaluate_call, extra arguments still
+            // run but only the first four are passed
+            Op op{
+                .kind      = function->is_random ? OpKind::RandomMath : OpKind::Math,
+                .function  = function,
+                .call_site = call.get_call_site()
+            };
+            op.operands.fill(this->constant(0.0f));
+            size_t index = 0;
+            for (auto& argument : call.get_arguments()) {
+                const auto value = this->compile(*argument);
+                if (index < op.operands.size()) {
+                    op.operands[index++] = value;
+                }
+            }
+            if (function->is_random) {
+                this->effects++;
+            }
+            return this->emit(op);
+        }
+        default:
+            throw Unsupported{};
+        }
+    }
+
+    uint32_t ParticleKernel::compile_pure(RawExpression& expression) {
+        const auto before = this->effects;
+        const auto value  = this->compile(expression);
+        if (this->effects != before) {
+            throw Unsupported{};
+        }
+        return value;
+    }
+
+    uint32_t ParticleKernel::constant(const float value) {
+        for (const auto& constant : this->constants) {
+            if (std::bit_cast<uint32_t>(constant.value) == std::bit_cast<uint32_t>(value)) {
+                return constant.target;
+            }
+        }
+        const auto target = this->allocate();
+        this->constants.push_back({target, value});
+        return target;
+    }
+
+    uint32_t ParticleKernel::emit(Op op) {
+        op.target = this->allocate();
+        this->ops.push_back(op);
+        return op.target;
+    }
+
+    uint32_t ParticleKernel::slot_register(
+        const VariableDeclarationType storage, const uint32_t slot
+    ) const {
+        if (storage == VariableDeclarationType::Temp) {
+            return static_cast<uint32_t>(this->program.get_variable_slot_count()) + slot;
+        }
+        return slot;
+    }
+
+    void ParticleKernel::run_block(
+        const std::span<float* const> registers, const size_t count,
+        const std::span<const uint64_t> ids, const std::span<uint64_t> random_counters
+    ) const {
+        for (const auto& op : this->ops) {
+            float* const       out = registers[op.target];
+            const float* const a   = registers[op.operands[0]];
+            const float* const b   = registers[op.operands[1]];
+            const float* const c   = registers[op.operands[2]];
+
+            switch (op.kind) {
+            case OpKind::Copy:
+                std::copy_n(a, count, out);
+                break;
+            case OpKind::Numeric:
+                // One loop per operator, a switch inside the loop would stop it vectorising
+                switch (op.operation) {
+                case BinaryOp::LessThan:
+                    zip_block(count, out, a, b, [](const float x, const float y) {
+                        return boolean(number(x) < number(y));
+                    });
+                    break;
+                case BinaryOp::LessEqualThan:
+                    zip_block(count, out, a, b, [](const float x, const float y) {
+                        return boolean(number(x) <= number(y));
+                    });
+                    break;
+                case BinaryOp::GreaterThan:
+                    zip_block(count, out, a, b, [](const float x, const float y) {
+                        return boolean(number(x) > number(y));
+                    });
+                    break;
+                case BinaryOp::GreaterEqualThan:
+                    zip_block(count, out, a, b, [](const float x, const float y) {
+                        return boolean(number(x) >= number(y));
+                    });
+                    break;
+                case BinaryOp::Addition:
+                    zip_block(count, out, a, b, [](const float x, const float y) {
+                        return number(x) + number(y);
+                    });
+                    break;
+                case BinaryOp::Subtraction:
+                    zip_block(count, out, a, b, [](const float x, const float y) {
+                        return number(x) - number(y);
+                    });
+                    break;
+                case BinaryOp::Multiplication:
+                    zip_block(count, out, a, b, [](const float x, const float y) {
+                        return number(x) * number(y);
+                    });
+                    break;
+                default:
+                    zip_block(count, out, a, b, [](const float x, const float y) {
+                        return number(x) / number(y);
+                    });
+                    break;
+                }
+                break;
+            case OpKind::Equal:
+                zip_block(count, out, a, b, [](const float x, const float y) {
+                    return boolean(number(x) == number(y));
+                });
+                break;
+            case OpKind::NotEqual:
+                zip_block(count, out, a, b, [](const float x, const float y) {
+                    return boolean(number(x) != number(y));
+                });
+                break;
+            case OpKind::Not:
+                map_block(count, out, a, [](const float x) { return boolean(!truthy(x)); });
+                break;
+            case OpKind::Negate:
+                map_block(count, out, a, [](const float x) { return -number(x); });
+                break;
+            case OpKind::And:
+                zip_block(count, out, a, b, [](const float x, const float y) {
+                    return boolean(truthy(x) & truthy(y));
+                });
+                break;
+            case OpKind::Or:
+                zip_block(count, out, a, b, [](const float x, const float y) {
+                    return boolean(truthy(x) | truthy(y));
+                });
+                break;
+            case OpKind::Coalesce:
+                zip_block(count, out, a, b, [](const float x, const float y) {
+                    return math::lanes::blend(std::bit_cast<uint32_t>(x) == null_bits, y, x);
+                });
+                break;
+            case OpKind::Select:
+                for (size_t i = 0; i < count; i++) {
+                    out[i] = math::lanes::blend(truthy(a[i]), b[i], c[i]);
+                }
+                break;
+            case OpKind::Math: {
+                // Eight particles per call of the wide version, the lanes past the end of the
+                // block are padded with 0
+                std::array<math::FloatLanes8, 4> arguments{};
+                math::RandomLanes<8>             unused{};
+                for (size_t start = 0; start < count; start += 8) {
+                    const size_t lanes = std::min<size_t>(8, count - start);
+                    for (size_t k = 0; k < arguments.size(); k++) {
+                        const float* const argument = registers[op.operands[k]] + start;
+                        for (size_t i = 0; i < 8; i++) {
+                            arguments[k][i] = i < lanes ? number(argument[i]) : 0.0f;
+                        }
+                    }
+                    const auto value = op.function->wide_8(arguments.data(), unused);
+                    std::copy_n(value.lanes.data(), lanes, out + start);
+                }
+                break;
+            }
+            case OpKind::RandomMath: {
+                // Every particle draws from its own stream, in the same order as it would
+                // alone
+                const float* const d = registers[op.operands[3]];
+                for (size_t i = 0; i < count; i++) {
+                    const std::array arguments{
+                        number(a[i]), number(b[i]), number(c[i]), number(d[i])
+                    };
+                    math::RandomStream stream{
+                        ids[i], op.call_site, random_counters[i],
+                        this->program.get_program_id()
+                    };
+                    out[i]             = op.function->scalar(arguments.data(), stream);
+                    random_counters[i] = stream.get_counter();
+                }
+                break;
+            }
+            }
+        }
+    }
+} // namespace molar::exec
@@ -0,0 +1,122 @@
+//
+// Created by Akashic on 10/19/2026.
+//
+
+#ifndef PARTICLE_KERNEL_HPP
+#define PARTICLE_KERNEL_HPP
+#include <array>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "ast/expression.hpp"
+#include "molang_evaluator.hpp"
+#include "molang_program.hpp"
+
+namespace molar::exec {
+    ///@brief A program compiled for ParticlePool::evaluate, which runs it node by node over
+    /// blocks of particles instead of particle by particle. Every node becomes one loop over
+    /// the block: float columns are read and written in place, fp16 columns are decoded
+    /// into a scratch column per block and encoded back, and temps and intermediate values
+    /// are scratch columns of the block as well.
+    ///
+    /// Covers numeric programs: literals, arithmetic, comparisons, logic, `??`,
+    /// conditionals, `v.` and `t.` slots, math builtins including the random ones and a
+    /// top level `return`. The untaken side of a conditional is computed and discarded, so
+    /// conditional sides which assign or draw random numbers aren't covered. Anything else,
+    /// queries, loops, strings, arrays, `->` and superinstructions for instance, leaves
+    /// the kernel unsupported and the pool runs the program through a MolangEvaluator per
+    /// particle instead. Like the evaluator a kernel holds scratch space, keep one per thread
+    class ParticleKernel {
+    public:
+        // Particles per block, the scratch columns of a block stay in the L1 cache
+        static constexpr size_t block_size = 256;
+
+        // A quiet NaN whose payload is kept by binary16, arithmetic makes NaNs without one.
+        // Columns and registers hold null as this
+        static constexpr uint32_t null_bits = 0x7fc02000u;
+
+        explicit ParticleKernel(MolangProgram& program);
+
+        ///@brief Whether the program runs column by column, see the class description
+        [[nodiscard]] bool is_columnar() const { return this->columnar; }
+
+        [[nodiscard]] MolangProgram& get_program() const { return this->program; }
+
+    private:
+        friend class ParticlePool;
+
+        enum class OpKind : uint8_t {
+            Copy,
+            // The operators of apply_numeric, both sides read as numbers
+            Numeric,
+            Equal,
+            NotEqual,
+            Not,
+            Negate,
+            And,
+            Or,
+            Coalesce,
+            Select,
+            Math,
+            RandomMath,
+        };
+
+        struct Op {
+            OpKind                        kind{};
+            molar::BinaryOp               operation{};
+            uint32_t                      target{0};
+            std::array<uint32_t, 4>       operands{};
+            const math::MathFunctionInfo* function{nullptr};
+            uint32_t                      call_site{0};
+        };
+
+        struct Constant {
+            uint32_t target;
+            float    value;
+        };
+
+        ///@brief Emits the ops of an expression and returns the register holding its value
+        uint32_t compile(molar::ast::RawExpression& expression);
+
+        ///@brief Like compile for a side of a conditional, which mustn't have effects
+        uint32_t compile_pure(molar::ast::RawExpression& expression);
+
+        uint32_t constant(float value);
+
+        uint32_t allocate() { return this->register_count++; }
+
+        uint32_t emit(Op op);
+
+        ///@brief The register of a slot. The first registers are the `v.` slots, the temps
+        /// follow
+        [[nodiscard]] uint32_t
+        slot_register(molar::ast::VariableDeclarationType storage, uint32_t slot) const;
+
+        void compile_program();
+
+        ///@brief Runs every op over the first `count` particles of the bound registers
+        void run_block(
+            std::span<float* const> registers, size_t count, std::span<const uint64_t> ids,
+            std::span<uint64_t> random_counters
+        ) const;
+
+        MolangProgram&          program;
+        MolangEvaluator         fallback;
+        bool                    columnar{false};
+        std::vector<Op>         ops{};
+        std::vector<Constant>   constants{};
+        uint32_t                register_count{0};
+        uint32_t                result{0};
+        uint32_t                effects{0};
+        // Slots some op writes, reads of them are copied since a later write would change
+        // the value under the reader
+        std::vector<bool>       assigned_variables{};
+        std::vector<bool>       assigned_temps{};
+        std::vector<bool>       used_variables{};
+        std::vector<float>      scratch{};
+        std::vector<float*>     bound{};
+    };
+} // namespace molar::exec
+
+#endif // PARTICLE_KERNEL_HPP
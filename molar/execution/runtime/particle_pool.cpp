@@ -0,0 +1,206 @@
+//
+// Created by Akashic on 10/19/2026.
+//
+
+#include "particle_pool.hpp"
+
+#include <algorithm>
+#include <format>
+#include <stdexcept>
+
+#include "execution/math/float_lanes.hpp"
+
+namespace molar::exec {
+    ParticlePool::ParticlePool(
+        const std::span<const ParticleColumn> columns, const uint64_t first_id
+    )
+        : next_id(first_id) {
+        this->columns.reserve(columns.size());
+        for (const auto& column : columns) {
+            this->columns.emplace_back(Column{column.slot, column.format});
+        }
+    }
+
+    std::vector<ParticleColumn> ParticlePool::columns_for(
+        const MolangProgram& program, const std::string_view prefix, const ColumnFormat format
+    ) {
+        std::vector<ParticleColumn> columns{};
+        for (const auto& [name, slot] :
+             program.get_collection_state().variables.variable_index_map) {
+            if (name.starts_with(prefix)) {
+                columns.emplace_back(ParticleColumn{slot, format});
+            }
+        }
+        // The map has no order, slot order keeps the loads walking the frame forward
+        std::ranges::sort(columns, {}, &ParticleColumn::slot);
+        return columns;
+    }
+
+    size_t ParticlePool::spawn() {
+        for (auto& column : this->columns) {
+            if (column.format == ColumnFormat::Float16) {
+                column.narrow.push_back(math::to_half(std::bit_cast<float>(null_bits)));
+            } else {
+                column.wide.push_back(std::bit_cast<float>(null_bits));
+            }
+        }
+        this->ids.push_back(this->next_id++);
+        this->random_counters.push_back(0);
+        return this->ids.size() - 1;
+    }
+
+    void ParticlePool::kill(const size_t index) {
+        this->check_index(index);
+        const auto remove = [index](auto& values) {
+            values[index] = values.back();
+            values.pop_back();
+        };
+        for (auto& column : this->columns) {
+            if (column.format == ColumnFormat::Float16) {
+                remove(column.narrow);
+            } else {
+                remove(column.wide);
+            }
+        }
+        remove(this->ids);
+        remove(this->random_counters);
+    }
+
+    MolangValue ParticlePool::get(const size_t column, const size_t index) const {
+        this->check_index(index);
+        return load(this->columns.at(column), index);
+    }
+
+    void ParticlePool::set(const size_t column, const size_t index, const MolangValue value) {
+        this->check_index(index);
+        store(this->columns.at(column), index, value);
+    }
+
+    void ParticlePool::evaluate(
+        ParticleKernel& kernel, ExecutionFrame& frame, const std::span<float> results
+    ) {
+        auto&      program   = kernel.get_program();
+        const auto variables = program.get_variable_slot_count();
+        const auto temps     = program.get_temp_slot_count();
+
+        std::vector<Column*> columns_by_slot(variables, nullptr);
+        for (auto& column : this->columns) {
+            if (column.slot < variables) {
+                columns_by_slot[column.slot] = &column;
+            }
+        }
+
+        // The kernel only sees numbers, anything else goes through the evaluator which also
+        // reports a frame with too few slots
+        bool columnar = kernel.is_columnar() && frame.variables.size() >= variables &&
+                        frame.temps.size() >= temps;
+        for (size_t slot = 0; columnar && slot < variables; slot++) {
+            if (columns_by_slot[slot] == nullptr) {
+                const auto& value = frame.variables[slot];
+                columnar = !kernel.assigned_variables[slot] &&
+                           (!kernel.used_variables[slot] || value.is_null() || value.is_number());
+            }
+        }
+        if (!columnar) {
+            this->evaluate(kernel.fallback, frame, results);
+            return;
+        }
+        this->check_frame(frame, results);
+
+        constexpr size_t block_size = ParticleKernel::block_size;
+        constexpr float  null       = std::bit_cast<float>(null_bits);
+
+        kernel.scratch.resize(kernel.register_count * block_size);
+        kernel.bound.resize(kernel.register_count);
+        for (uint32_t r = 0; r < kernel.register_count; r++) {
+            kernel.bound[r] = kernel.scratch.data() + r * block_size;
+        }
+        for (const auto& constant : kernel.constants) {
+            std::fill_n(kernel.bound[constant.target], block_size, constant.value);
+        }
+        // The emitter's slots are the same for every particle
+        for (size_t slot = 0; slot < variables; slot++) {
+            if (columns_by_slot[slot] == nullptr && kernel.used_variables[slot]) {
+                const auto& value = frame.variables[slot];
+                std::fill_n(
+                    kernel.bound[slot], block_size, value.is_null() ? null : value.as_number()
+                );
+            }
+        }
+
+        const size_t count = this->ids.size();
+        for (size_t start = 0; start < count; start += block_size) {
+            const size_t length = std::min(block_size, count - start);
+
+            for (auto* const column : columns_by_slot) {
+                if (column == nullptr || !kernel.used_variables[column->slot]) {
+                    continue;
+                }
+                float*& registers = kernel.bound[column->slot];
+                if (column->format == ColumnFormat::Float32) {
+                    // Read and written in place
+                    registers = column->wide.data() + start;
+                } else {
+                    registers = kernel.scratch.data() + column->slot * block_size;
+                    for (size_t i = 0; i < length; i++) {
+                        registers[i] = math::from_half(column->narrow[start + i]);
+                    }
+                }
+            }
+            for (size_t slot = 0; slot < temps; slot++) {
+                std::fill_n(kernel.bound[variables + slot], length, null);
+            }
+
+            kernel.run_block(
+                kernel.bound, length, std::span{this->ids}.subspan(start, length),
+                std::span{this->random_counters}.subspan(start, length)
+            );
+
+            for (auto* const column : columns_by_slot) {
+                if (column == nullptr || column->format != ColumnFormat::Float16 ||
+                    !kernel.assigned_variables[column->slot]) {
+                    continue;
+                }
+                const float* const registers = kernel.bound[column->slot];
+                for (size_t i = 0; i < length; i++) {
+                    column->narrow[start + i] = math::to_half(registers[i]);
+                }
+            }
+            if (!results.empty()) {
+                const float* const value = kernel.bound[kernel.result];
+                for (size_t i = 0; i < length; i++) {
+                    results[start + i] = math::lanes::blend(
+                        std::bit_cast<uint32_t>(value[i]) == null_bits, 0.0f, value[i]
+                    );
+                }
+            }
+        }
+    }
+
+    void ParticlePool::check_index(const size_t index) const {
+        if (index >= this->ids.size()) {
+            throw std::out_of_range(
+                std::format("Particle {} is out of range of {}", index, this->ids.size())
+            );
+        }
+    }
+
+    void ParticlePool::check_frame(
+        const ExecutionFrame& frame, const std::span<float> results
+    ) const {
+        for (const auto& column : this->columns) {
+            if (column.slot >= frame.variables.size()) {
+                throw std::invalid_argument(std::format(
+                    "The frame has {} variable slots but a column is for slot {}",
+                    frame.variables.size(), column.slot
+                ));
+            }
+        }
+        if (!results.empty() && results.size() < this->ids.size()) {
+            throw std::invalid_argument(std::format(
+                "{} results can't hold the values of {} particles", results.size(),
+                this->ids.size()
+            ));
+        }
+    }
+} // namespace molar::exec
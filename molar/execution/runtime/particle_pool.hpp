@@ -0,0 +1,160 @@
+//
+// Created by Akashic on 10/19/2026.
+//
+
+#ifndef PARTICLE_POOL_HPP
+#define PARTICLE_POOL_HPP
+#include <bit>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "execution/math/half_float.hpp"
+#include "execution_frame.hpp"
+#include "molang_program.hpp"
+#include "molang_value.hpp"
+#include "particle_kernel.hpp"
+
+namespace molar::exec {
+    enum class ColumnFormat : uint8_t {
+        Float32,
+        // IEEE binary16, half the memory for values which don't need the precision
+        Float16,
+    };
+
+    struct ParticleColumn {
+        ///@brief The `v.` slot the column holds, see MolangProgram::find_variable_slot
+        uint32_t     slot{0};
+        ColumnFormat format{ColumnFormat::Float32};
+    };
+
+    ///@brief The per particle state of a large population, one packed column per variable
+    /// slot. Particles are only ever at the start of the columns, killing one moves the last
+    /// particle into its place, so an index is only valid until the next kill.
+    ///
+    /// Columns hold numbers. Null is kept as a NaN with a payload no arithmetic produces,
+    /// anything else which isn't a number reads back as 0
+    class ParticlePool {
+    public:
+        ///@brief `first_id` is the entity of the first particle spawned, every particle
+        /// gets the next one. It keys the random streams of the particle, see ExecutionFrame
+        explicit ParticlePool(std::span<const ParticleColumn> columns, uint64_t first_id = 0);
+
+        ///@brief Every `v.` slot of the program whose name starts with `prefix`
+        static std::vector<ParticleColumn> columns_for(
+            const MolangProgram& program, std::string_view prefix = "particle_",
+            ColumnFormat format = ColumnFormat::Float32
+        );
+
+        ///@brief Adds a particle whose slots are null and returns its index
+        size_t spawn();
+
+        ///@brief Removes a particle by moving the last one into its place
+        void kill(size_t index);
+
+        ///@brief Kills every particle the predicate, called with an index, is true for.
+        /// Returns how many were killed
+        template <typename Predicate> size_t kill_if(Predicate&& predicate) {
+            size_t killed = 0;
+            for (size_t i = 0; i < this->ids.size();) {
+                if (predicate(i)) {
+                    // The last particle is now at i and still has to be checked
+                    this->kill(i);
+                    killed++;
+                } else {
+                    i++;
+                }
+            }
+            return killed;
+        }
+
+        [[nodiscard]] size_t size() const { return this->ids.size(); }
+
+        [[nodiscard]] uint64_t get_id(const size_t index) const { return this->ids.at(index); }
+
+        [[nodiscard]] MolangValue get(size_t column, size_t index) const;
+
+        void set(size_t column, size_t index, MolangValue value);
+
+        ///@brief Evaluates the kernel's program for every particle, block by block straight
+        /// over the columns, see ParticleKernel. Slots without a column are the emitter's and
+        /// are read from the frame. Falls back to the per particle loop below with the
+        /// kernel's MolangEvaluator if the kernel isn't columnar, the program writes a slot
+        /// without a column, or reads one which holds a string or an entity. The value of each
+        /// evaluation goes to `results` if it isn't empty
+        void
+        evaluate(ParticleKernel& kernel, ExecutionFrame& frame, std::span<float> results = {});
+
+        ///@brief Evaluates the program once for every particle, in order. Anything with an
+        /// `evaluate(ExecutionFrame&)` works, MolangEvaluator, JitProgram or TieredProgram.
+        ///
+        /// The frame is shared by every particle: slots without a column are the emitter's,
+        /// its temps are scratch, and the column slots are loaded before and stored after
+        /// each evaluation. The value of each evaluation goes to `results` if it isn't empty
+        template <typename Program>
+        void evaluate(Program& program, ExecutionFrame& frame, std::span<float> results = {}) {
+            this->check_frame(frame, results);
+
+            for (size_t i = 0; i < this->ids.size(); i++) {
+                for (const auto& column : this->columns) {
+                    frame.variables[column.slot] = load(column, i);
+                }
+                frame.entity         = this->ids[i];
+                frame.random_counter = this->random_counters[i];
+
+                const MolangValue result = program.evaluate(frame);
+
+                for (auto& column : this->columns) {
+                    store(column, i, frame.variables[column.slot]);
+                }
+                this->random_counters[i] = frame.random_counter;
+                if (!results.empty()) {
+                    results[i] = result.as_number();
+                }
+            }
+        }
+
+    private:
+        struct Column {
+            uint32_t              slot;
+            ColumnFormat          format;
+            // Only the one for the format is used
+            std::vector<float>    wide{};
+            std::vector<uint16_t> narrow{};
+        };
+
+        static constexpr uint32_t null_bits = ParticleKernel::null_bits;
+
+        static MolangValue load(const Column& column, const size_t index) {
+            const float number = column.format == ColumnFormat::Float16
+                                     ? math::from_half(column.narrow[index])
+                                     : column.wide[index];
+            if (std::bit_cast<uint32_t>(number) == null_bits) {
+                return MolangValue{};
+            }
+            return MolangValue{number};
+        }
+
+        static void store(Column& column, const size_t index, const MolangValue value) {
+            const float number =
+                value.is_null() ? std::bit_cast<float>(null_bits) : value.as_number();
+            if (column.format == ColumnFormat::Float16) {
+                column.narrow[index] = math::to_half(number);
+            } else {
+                column.wide[index] = number;
+            }
+        }
+
+        void check_index(size_t index) const;
+
+        void check_frame(const ExecutionFrame& frame, std::span<float> results) const;
+
+        std::vector<Column>   columns{};
+        std::vector<uint64_t> ids{};
+        std::vector<uint64_t> random_counters{};
+        uint64_t              next_id;
+    };
+} // namespace molar::exec
+
+#endif // PARTICLE_POOL_HPP
@@ -0,0 +1,734 @@
+//
+// Created by Akashic on 10/19/2026.
+//
+
+#include "program_binary.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <string>
+
+#include "ast/access_expression.hpp"
+#include "ast/controll_flow.hpp"
+#include "ast/keyword.hpp"
+#include "execution/preprocessor/execution_nodes/pre_allocated.hpp"
+#include "execution/preprocessor/execution_nodes/pre_allocated_string.hpp"
+#include "execution/preprocessor/execution_nodes/select_expression.hpp"
+#include "internal/checked_down_cast.hpp"
+
+namespace molar::exec {
+    static_assert(
+        std::endian::native == std::endian::little,
+        "Program binaries are stored little endian and copied as is"
+    );
+
+    namespace {
+        using molar::ast::AstKind;
+        using molar::ast::RawExpression;
+        using molar::ast::RawExpressionList;
+        using molar::ast::RawExpressionPtr;
+        using molar::ast::VariableDeclarationType;
+        using molar::details::type_asserted_cast;
+
+        constexpr size_t  header_size = 16;
+        // Deeper trees than this only come from a corrupt or hostile binary, stops the reader
+        // from overflowing the stack
+        constexpr int32_t max_depth   = 1024;
+        // Marks an absent child, a `return` without a value or a select without an else side
+        constexpr uint8_t null_node   = 0xFF;
+
+        uint32_t fnv1a(const std::span<const std::byte> data) {
+            uint32_t hash = 2166136261u;
+            for (const auto byte : data) {
+                hash ^= static_cast<uint32_t>(byte);
+                hash *= 16777619u;
+            }
+            return hash;
+        }
+
+        class Writer {
+        public:
+            template <typename T> void put(const T value) {
+                static_assert(std::is_trivially_copyable_v<T>);
+                const auto offset = this->bytes.size();
+                this->bytes.resize(offset + sizeof(T));
+                std::memcpy(this->bytes.data() + offset, &value, sizeof(T));
+            }
+
+            void put_u32(const size_t value) {
+                if (value > UINT32_MAX) {
+                    throw std::length_error("Value does not fit a program binary");
+                }
+                this->put(static_cast<uint32_t>(value));
+            }
+
+            void put_string(const std::string_view string) {
+                this->put_u32(string.size());
+                const auto offset = this->bytes.size();
+                this->bytes.resize(offset + string.size());
+                std::memcpy(this->bytes.data() + offset, string.data(), string.size());
+            }
+
+            std::vector<std::byte> bytes{};
+        };
+
+        class Reader {
+        public:
+            explicit Reader(const std::span<const std::byte> data) : data(data) {}
+
+            template <typename T> T get() {
+                static_assert(std::is_trivially_copyable_v<T>);
+                T value;
+                std::memcpy(&value, this->take(sizeof(T)).data(), sizeof(T));
+                return value;
+            }
+
+            ///@brief Reads a list length, every element takes at least `element_size` bytes
+            /// so a count the remaining data can't hold is rejected before allocating
+            uint32_t get_count(const size_t element_size) {
+                const auto count = this->get<uint32_t>();
+                if (count > this->remaining() / element_size) {
+                    throw ProgramBinaryError("List length exceeds the program binary");
+                }
+                return count;
+            }
+
+            std::string get_string() {
+                const auto size  = this->get_count(1);
+                const auto bytes = this->take(size);
+                return {reinterpret_cast<const char*>(bytes.data()), bytes.size()};
+            }
+
+            [[nodiscard]] size_t remaining() const { return this->data.size() - this->offset; }
+
+        private:
+            std::span<const std::byte> take(const size_t size) {
+                if (size > this->remaining()) {
+                    throw ProgramBinaryError("Program binary is truncated");
+                }
+                const auto bytes = this->data.subspan(this->offset, size);
+                this->offset += size;
+                return bytes;
+            }
+
+            std::span<const std::byte> data;
+            size_t                     offset{0};
+        };
+
+        // Hash maps iterate in an unspecified order, sorting keeps the same program producing
+        // the same bytes
+        template <typename Map> auto sorted_entries(const Map& map) {
+            std::vector<std::pair<typename Map::key_type, typename Map::mapped_type>> entries(
+                map.begin(), map.end()
+            );
+            std::ranges::sort(entries, [](const auto& lhs, const auto& rhs) {
+                return lhs.first < rhs.first;
+            });
+            return entries;
+        }
+
+        void
+        write_variable_state(Writer& writer, const AstCollectorState::VariableState& state) {
+            writer.put_u32(state.variable_index);
+
+            writer.put_u32(state.variable_index_map.size());
+            for (const auto& [name, id] : sorted_entries(state.variable_index_map)) {
+                writer.put_string(name);
+                writer.put_u32(id);
+            }
+
+            writer.put_u32(state.index_variable_map.size());
+            for (const auto& [id, name] : sorted_entries(state.index_variable_map)) {
+                writer.put_u32(id);
+                writer.put_string(name);
+            }
+
+            writer.put_u32(state.struct_info_map.size());
+            for (const auto& [key, info] : sorted_entries(state.struct_info_map)) {
+                writer.put_string(key);
+                writer.put_string(info.name);
+                writer.put_u32(info.children_id.size());
+                for (const auto child : info.children_id) {
+                    writer.put_u32(child);
+                }
+            }
+        }
+
+        AstCollectorState::VariableState read_variable_state(Reader& reader) {
+            AstCollectorState::VariableState state{};
+            state.variable_index = reader.get<uint32_t>();
+
+            const auto check_id = [&](const uint32_t id) {
+                if (id >= state.variable_index) {
+                    throw ProgramBinaryError("Variable slot is out of range");
+                }
+                return id;
+            };
+
+            for (auto count = reader.get_count(8); count > 0; --count) {
+                auto       name = reader.get_string();
+                const auto id   = check_id(reader.get<uint32_t>());
+                state.variable_index_map.emplace(std::move(name), id);
+            }
+
+            for (auto count = reader.get_count(8); count > 0; --count) {
+                const auto id = check_id(reader.get<uint32_t>());
+                state.index_variable_map.emplace(id, reader.get_string());
+            }
+
+            for (auto count = reader.get_count(12); count > 0; --count) {
+                auto key  = reader.get_string();
+                auto info = AstCollectorState::VariableState::MolangStructInfo{};
+                info.name = reader.get_string();
+                for (auto children = reader.get_count(4); children > 0; --children) {
+                    info.children_id.emplace_back(check_id(reader.get<uint32_t>()));
+                }
+                state.struct_info_map.emplace(std::move(key), std::move(info));
+            }
+            return state;
+        }
+
+        void write_named_ids(Writer& writer, const AstCollectorState::NamedIdMap& map) {
+            writer.put_u32(map.id_to_name.size());
+            for (const auto& name : map.id_to_name) {
+                writer.put_string(name);
+            }
+        }
+
+        AstCollectorState::NamedIdMap read_named_ids(Reader& reader) {
+            AstCollectorState::NamedIdMap map{};
+            for (auto count = reader.get_count(4); count > 0; --count) {
+                const auto size = map.id_to_name.size();
+                if (map.add_id(reader.get_string()) != size) {
+                    throw ProgramBinaryError("Duplicate name");
+                }
+            }
+            return map;
+        }
+
+        class TreeWriter {
+        public:
+            TreeWriter(Writer& writer, const AstCollectorState& state, const StringPool& pool)
+                : writer(writer), state(state), string_pool(pool) {}
+
+            void write_list(RawExpressionList& expressions) {
+                this->writer.put_u32(expressions.size());
+                for (auto& expression : expressions) {
+                    this->write_node(expression.get());
+                }
+            }
+
+            void write_node(RawExpression* expression) {
+                if (expression == nullptr) {
+                    this->writer.put(null_node);
+                    return;
+                }
+
+                const auto kind = expression->get_type();
+                this->writer.put(static_cast<uint8_t>(kind));
+
+                if (const auto* located = dynamic_cast<molar::ast::Expression*>(expression)) {
+                    this->writer.put_u32(located->get_position());
+                    this->writer.put_u32(located->get_size());
+                }
+
+                switch (kind) {
+                case AstKind::BooleanLiteral:
+                    this->writer.put(static_cast<uint8_t>(
+                        type_asserted_cast<molar::ast::BoolLiteral>(*expression).get_value()
+                    ));
+                    return;
+                case AstKind::NumericLiteral:
+                    this->writer.put(
+                        type_asserted_cast<molar::ast::NumericLiteral>(*expression).get_value()
+                    );
+                    return;
+                case AstKind::ParenthesizedExpression:
+                case AstKind::BlockExpression:
+                    this->write_list(
+                        type_asserted_cast<molar::ast::ParenthesizedExpression>(*expression)
+                            .get_expressions()
+                    );
+                    return;
+                case AstKind::BinaryExpression: {
+                    auto& binary =
+                        type_asserted_cast<molar::ast::BinaryExpression>(*expression);
+                    this->writer.put(static_cast<uint8_t>(binary.get_operation()));
+                    this->write_node(binary.get_left().get());
+                    this->write_node(binary.get_right().get());
+                    return;
+                }
+                case AstKind::UnaryExpression: {
+                    auto& unary = type_asserted_cast<molar::ast::UnaryExpression>(*expression);
+                    this->writer.put(static_cast<uint8_t>(unary.get_operation()));
+                    this->write_node(unary.get_expression().get());
+                    return;
+                }
+                case AstKind::ConditionalExpression:
+                case AstKind::TernaryExpression: {
+                    auto& conditional =
+                        type_asserted_cast<molar::ast::ConditionalExpression>(*expression);
+                    this->write_node(conditional.get_condition().get());
+                    this->write_node(conditional.get_if_expression().get());
+                    if (kind == AstKind::TernaryExpression) {
+                        this->write_node(
+                            type_asserted_cast<molar::ast::TernaryExpression>(*expression)
+                                .get_else_expression()
+                                .get()
+                        );
+                    }
+                    return;
+                }
+                case AstKind::ResourceExpression: {
+                    auto& resource =
+                        type_asserted_cast<molar::ast::ResourceExpression>(*expression);
+                    this->writer.put(static_cast<uint8_t>(resource.get_resource_kind()));
+                    this->writer.put_string(resource.get_resource_id().get_value());
+                    return;
+                }
+                case AstKind::ArrowAccessExpression: {
+                    auto& arrow = type_asserted_cast<molar::ast::ArrowAccess>(*expression);
+                    this->write_node(arrow.get_lhs().get());
+                    this->write_node(arrow.get_rhs().get());
+                    return;
+                }
+                case AstKind::LoopExpression: {
+                    auto& loop = type_asserted_cast<molar::ast::LoopExpression>(*expression);
+                    this->write_node(loop.get_count_expression().get());
+                    this->write_node(&loop.get_loop_expression());
+                    return;
+                }
+                case AstKind::Break:
+                case AstKind::Continue:
+                case AstKind::This:
+                    return;
+                case AstKind::Return:
+                    this->write_node(
+                        type_asserted_cast<molar::ast::ReturnNode>(*expression)
+                            .get_value()
+                            .get()
+                    );
+                    return;
+                case AstKind::PreAllocatedVariableReference:
+                    this->write_variable(
+                        type_asserted_cast<ast::PreAllocatedVariable>(*expression)
+                    );
+                    return;
+                case AstKind::PreAllocatedAssignment: {
+                    auto& assign =
+                        type_asserted_cast<ast::PreAllocatedVariableAssign>(*expression);
+                    this->write_variable(assign);
+                    this->write_node(assign.get_assignment().get());
+                    return;
+                }
+                case AstKind::PreAllocatedCall: {
+                    auto& call = type_asserted_cast<ast::PreAllocatedCall>(*expression);
+                    this->writer.put(call.get_value());
+                    this->writer.put(call.get_call_site());
+                    this->write_list(call.get_arguments());
+                    return;
+                }
+                case AstKind::PreAllocatedForLoop: {
+                    auto& loop = type_asserted_cast<ast::PreAllocatedForLoop>(*expression);
+                    this->write_variable(loop.get_variable_index());
+                    this->write_node(loop.get_array_fetch_expression().get());
+                    this->write_node(&loop.get_loop());
+                    return;
+                }
+                case AstKind::PreAllocatedString:
+                    this->write_string(
+                        type_asserted_cast<ast::PreAllocatedString>(*expression).get_value()
+                    );
+                    return;
+                case AstKind::PreAllocatedArrayAccess: {
+                    auto& access =
+                        type_asserted_cast<ast::PreAllocatedArrayAccess>(*expression);
+                    this->writer.put(access.get_value());
+                    this->write_node(access.get_index_expression().get());
+                    return;
+                }
+                case AstKind::SelectExpression: {
+                    auto& select = type_asserted_cast<ast::SelectExpression>(*expression);
+                    this->write_node(select.get_condition().get());
+                    this->write_node(select.get_if_expression().get());
+                    this->write_node(select.get_else_expression().get());
+                    return;
+                }
+                case AstKind::FusedExpression:
+                    // Superinstructions are picked for the interpreter which loads the program,
+                    // a binary keeps the plain tree so the loader can fuse it again
+                    throw ProgramBinaryError(
+                        "Programs with superinstructions can't be serialized, fuse them after "
+                        "loading"
+                    );
+                default:
+                    throw std::logic_error(
+                        "Only processed programs can be serialized, found " +
+                        molar::ast::ast_kind_to_string(kind)
+                    );
+                }
+            }
+
+        private:
+            void write_variable(const ast::PreAllocatedVariable& variable) {
+                this->writer.put(static_cast<uint8_t>(variable.get_storage()));
+                this->writer.put(variable.get_value());
+            }
+
+            // Handles only mean something inside the pool which made them, the literal is
+            // stored by its index in the collector's string table instead
+            void write_string(const InternedString string) {
+                const auto text = std::string(this->string_pool.resolve(string));
+                const auto& ids = this->state.string_state.name_to_id;
+
+                const auto it = ids.find(text);
+                if (it == ids.end()) {
+                    throw std::logic_error("String literal is missing from the collector");
+                }
+                this->writer.put(it->second);
+            }
+
+            Writer&                  writer;
+            const AstCollectorState& state;
+            const StringPool&        string_pool;
+        };
+
+        class TreeReader {
+        public:
+            TreeReader(Reader& reader, const AstCollectorState& state, StringPool& pool)
+                : reader(reader), state(state), string_pool(pool) {}
+
+            RawExpressionList read_list() {
+                RawExpressionList expressions{};
+                for (auto count = this->reader.get_count(1); count > 0; --count) {
+                    expressions.emplace_back(this->read_node());
+                }
+                return expressions;
+            }
+
+            RawExpressionPtr read_node(const bool nullable = false) {
+                if (--this->depth < 0) {
+                    throw ProgramBinaryError("Program binary nests too deeply");
+                }
+                auto node = this->read_node_inner(nullable);
+                ++this->depth;
+                return node;
+            }
+
+        private:
+            RawExpressionPtr read_node_inner(const bool nullable) {
+                const auto raw_kind = this->reader.get<uint8_t>();
+                if (raw_kind == null_node) {
+                    if (!nullable) {
+                        throw ProgramBinaryError("Program binary is missing an expression");
+                    }
+                    return nullptr;
+                }
+                if (raw_kind > static_cast<uint8_t>(AstKind::SelectExpression)) {
+                    throw ProgramBinaryError("Unknown node kind");
+                }
+
+                const auto kind = static_cast<AstKind>(raw_kind);
+                if (kind >= AstKind::PreAllocatedVariableReference) {
+                    return this->read_processed(kind);
+                }
+
+                const size_t position = this->reader.get<uint32_t>();
+                const size_t size     = this->reader.get<uint32_t>();
+
+                switch (kind) {
+                case AstKind::BooleanLiteral:
+                    return std::make_unique<molar::ast::BoolLiteral>(
+                        position, size, this->reader.get<uint8_t>() != 0
+                    );
+                case AstKind::NumericLiteral:
+                    return std::make_unique<molar::ast::NumericLiteral>(
+                        position, size, this->reader.get<float>()
+                    );
+                case AstKind::ParenthesizedExpression:
+                    return std::make_unique<molar::ast::ParenthesizedExpression>(
+                        position, size, this->read_list()
+                    );
+                case AstKind::BlockExpression:
+                    return std::make_unique<molar::ast::BlockExpression>(
+                        position, size, this->read_list()
+                    );
+                case AstKind::BinaryExpression: {
+                    const auto operation = this->read_binary_op();
+                    auto       left      = this->read_node();
+                    return std::make_unique<molar::ast::BinaryExpression>(
+                        position, size, operation, std::move(left), this->read_node()
+                    );
+                }
+                case AstKind::UnaryExpression: {
+                    const auto operation = static_cast<UnaryOp>(this->reader.get<uint8_t>());
+                    if (operation != UnaryOp::Negate && operation != UnaryOp::Not) {
+                        throw ProgramBinaryError("Unknown unary operator");
+                    }
+                    return std::make_unique<molar::ast::UnaryExpression>(
+                        position, size, operation, this->read_node()
+                    );
+                }
+                case AstKind::ConditionalExpression: {
+                    auto condition = this->read_node();
+                    return std::make_unique<molar::ast::ConditionalExpression>(
+                        position, size, std::move(condition), this->read_node()
+                    );
+                }
+                case AstKind::TernaryExpression: {
+                    auto condition     = this->read_node();
+                    auto if_expression = this->read_node();
+                    return std::make_unique<molar::ast::TernaryExpression>(
+                        position, size, std::move(condition), std::move(if_expression),
+                        this->read_node()
+                    );
+                }
+                case AstKind::ResourceExpression: {
+                    const auto resource =
+                        static_cast<ResourceKind>(this->reader.get<uint8_t>());
+                    if (resource != ResourceKind::Geometry &&
+                        resource != ResourceKind::Material &&
+                        resource != ResourceKind::Texture) {
+                        throw ProgramBinaryError("Unknown resource kind");
+                    }
+                    molar::ast::IdentifierLiteral id{
+                        position, size, this->reader.get_string()
+                    };
+                    return std::make_unique<molar::ast::ResourceExpression>(
+                        position, size, resource, std::move(id)
+                    );
+                }
+                case AstKind::ArrowAccessExpression: {
+                    auto lhs = this->read_node();
+                    return std::make_unique<molar::ast::ArrowAccess>(
+                        position, size, std::move(lhs), this->read_node()
+                    );
+                }
+                case AstKind::LoopExpression: {
+                    auto count = this->read_node();
+                    return std::make_unique<molar::ast::LoopExpression>(
+                        position, size, std::move(count), this->read_block()
+                    );
+                }
+                case AstKind::Break:
+                    return std::make_unique<molar::ast::BreakNode>(position, size);
+                case AstKind::Continue:
+                    return std::make_unique<molar::ast::ContinueNode>(position, size);
+                case AstKind::This:
+                    return std::make_unique<molar::ast::ThisNode>(position, size);
+                case AstKind::Return:
+                    return std::make_unique<molar::ast::ReturnNode>(
+                        position, size, this->read_node(true)
+                    );
+                default:
+                    throw ProgramBinaryError(
+                        "Unprocessed " + molar::ast::ast_kind_to_string(kind)
+                    );
+                }
+            }
+
+            RawExpressionPtr read_processed(const AstKind kind) {
+                switch (kind) {
+                case AstKind::PreAllocatedVariableReference:
+                    return std::make_unique<ast::PreAllocatedVariable>(this->read_variable());
+                case AstKind::PreAllocatedAssignment: {
+                    const auto variable = this->read_variable();
+                    return std::make_unique<ast::PreAllocatedVariableAssign>(
+                        variable.get_value(), variable.get_storage(), this->read_node()
+                    );
+                }
+                case AstKind::PreAllocatedCall: {
+                    const auto call_index = this->reader.get<uint32_t>();
+                    const auto call_site  = this->reader.get<uint32_t>();
+                    if (call_index >= this->state.func_call_state.next_id ||
+                        call_site >= this->state.call_site_count) {
+                        throw ProgramBinaryError("Call is out of range");
+                    }
+                    return std::make_unique<ast::PreAllocatedCall>(
+                        call_index, call_site, this->read_list()
+                    );
+                }
+                case AstKind::PreAllocatedForLoop: {
+                    auto variable = this->read_variable();
+                    auto fetch    = this->read_node();
+                    return std::make_unique<ast::PreAllocatedForLoop>(
+                        std::move(variable), std::move(fetch), this->read_block()
+                    );
+                }
+                case AstKind::PreAllocatedString: {
+                    const auto  index   = this->reader.get<uint32_t>();
+                    const auto& strings = this->state.string_state.id_to_name;
+                    if (index >= strings.size()) {
+                        throw ProgramBinaryError("String literal is out of range");
+                    }
+                    return std::make_unique<ast::PreAllocatedString>(
+                        this->string_pool.intern(strings[index])
+                    );
+                }
+                case AstKind::PreAllocatedArrayAccess: {
+                    const auto array_index = this->reader.get<uint32_t>();
+                    if (array_index >= this->state.array_state.variable_index) {
+                        throw ProgramBinaryError("Array is out of range");
+                    }
+                    return std::make_unique<ast::PreAllocatedArrayAccess>(
+                        array_index, this->read_node()
+                    );
+                }
+                case AstKind::SelectExpression: {
+                    auto condition     = this->read_node();
+                    auto if_expression = this->read_node();
+                    return std::make_unique<ast::SelectExpression>(
+                        std::move(condition), std::move(if_expression),
+                        this->read_node(true)
+                    );
+                }
+                default:
+                    std::unreachable();
+                }
+            }
+
+            ast::PreAllocatedVariable read_variable() {
+                const auto storage = static_cast<VariableDeclarationType>(
+                    this->reader.get<uint8_t>()
+                );
+                const auto id = this->reader.get<uint32_t>();
+
+                // The preprocessor never produces context slots
+                const auto* slots = storage == VariableDeclarationType::Temp
+                                        ? &this->state.temp_variables
+                                    : storage == VariableDeclarationType::Var
+                                        ? &this->state.variables
+                                        : nullptr;
+                if (slots == nullptr || id >= slots->variable_index) {
+                    throw ProgramBinaryError("Variable is out of range");
+                }
+                return {id, storage};
+            }
+
+            molar::ast::BlockExpression read_block() {
+                const auto node = this->read_node();
+                if (node->get_type() != AstKind::BlockExpression) {
+                    throw ProgramBinaryError("Loop body is not a block");
+                }
+                return std::move(type_asserted_cast<molar::ast::BlockExpression>(*node));
+            }
+
+            BinaryOp read_binary_op() {
+                const auto operation = static_cast<BinaryOp>(this->reader.get<uint8_t>());
+                switch (operation) {
+                case BinaryOp::Equality:
+                case BinaryOp::Inequality:
+                case BinaryOp::LessThan:
+                case BinaryOp::LessEqualThan:
+                case BinaryOp::GreaterThan:
+                case BinaryOp::GreaterEqualThan:
+                case BinaryOp::Addition:
+                case BinaryOp::Subtraction:
+                case BinaryOp::Multiplication:
+                case BinaryOp::Division:
+                case BinaryOp::Or:
+                case BinaryOp::And:
+                case BinaryOp::Coalesce:
+                    return operation;
+                default:
+                    throw ProgramBinaryError("Unknown binary operator");
+                }
+            }
+
+            Reader&                  reader;
+            const AstCollectorState& state;
+            StringPool&              string_pool;
+            int32_t                  depth{max_depth};
+        };
+    } // namespace
+
+    std::vector<std::byte>
+    ProgramBinary::serialize(MolangProgram& program, const StringPool& string_pool) {
+        const auto& state = program.get_collection_state();
+
+        Writer payload{};
+        write_variable_state(payload, state.variables);
+        write_variable_state(payload, state.temp_variables);
+        write_variable_state(payload, state.array_state);
+        write_named_ids(payload, state.func_call_state);
+        write_named_ids(payload, state.string_state);
+        payload.put(state.call_site_count);
+        payload.put(state.program_id);
+
+        TreeWriter(payload, state, string_pool).write_list(program.get_expressions());
+
+        Writer binary{};
+        for (const auto character : magic) {
+            binary.put(character);
+        }
+        binary.put(version);
+        binary.put(static_cast<uint8_t>(program.get_math_bindings().get_precision()));
+        binary.put(uint8_t{0});
+        binary.put_u32(payload.bytes.size());
+        binary.put(fnv1a(payload.bytes));
+
+        binary.bytes.insert(binary.bytes.end(), payload.bytes.begin(), payload.bytes.end());
+        return std::move(binary.bytes);
+    }
+
+    MolangProgram
+    ProgramBinary::deserialize(const std::span<const std::byte> data, StringPool& string_pool) {
+        Reader header{data};
+        for (const auto character : magic) {
+            if (header.get<char>() != character) {
+                throw ProgramBinaryError("Not a Molang program binary");
+            }
+        }
+        if (const auto found = header.get<uint16_t>(); found != version) {
+            throw ProgramBinaryError(
+                "Program binary version " + std::to_string(found) + " does not match " +
+                std::to_string(version)
+            );
+        }
+
+        const auto precision = header.get<uint8_t>();
+        if (precision > static_cast<uint8_t>(math::MathPrecision::Fast)) {
+            throw ProgramBinaryError("Unknown math precision");
+        }
+        (void)header.get<uint8_t>();
+
+        const auto payload_size = header.get<uint32_t>();
+        const auto checksum     = header.get<uint32_t>();
+        if (payload_size != header.remaining()) {
+            throw ProgramBinaryError("Program binary size does not match its header");
+        }
+
+        const auto payload = data.subspan(header_size);
+        if (fnv1a(payload) != checksum) {
+            throw ProgramBinaryError("Program binary checksum does not match");
+        }
+
+        Reader            reader{payload};
+        AstCollectorState state{};
+        state.variables       = read_variable_state(reader);
+        state.temp_variables  = read_variable_state(reader);
+        state.array_state     = read_variable_state(reader);
+        state.func_call_state = read_named_ids(reader);
+        state.string_state    = read_named_ids(reader);
+        state.call_site_count = reader.get<uint32_t>();
+        state.program_id      = reader.get<uint32_t>();
+
+        auto expressions = TreeReader(reader, state, string_pool).read_list();
+        if (reader.remaining() != 0) {
+            throw ProgramBinaryError("Trailing data after program binary");
+        }
+
+        MolangAstGenerator::MolarAst ast{};
+        ast.get_expressions() = std::move(expressions);
+
+        try {
+            return MolangProgram{
+                std::move(ast), std::move(state), static_cast<math::MathPrecision>(precision)
+            };
+        } catch (const std::invalid_argument& error) {
+            // Binding rejects math names this build doesn't know
+            throw ProgramBinaryError(error.what());
+        }
+    }
+} // namespace molar::exec
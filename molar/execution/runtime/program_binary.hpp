@@ -0,0 +1,51 @@
+//
+// Created by Akashic on 10/19/2026.
+//
+
+#ifndef PROGRAM_BINARY_HPP
+#define PROGRAM_BINARY_HPP
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+#include "molang_program.hpp"
+
+namespace molar::exec {
+    ///@brief Thrown when a program binary is truncated, corrupt or from another version
+    class ProgramBinaryError : public std::runtime_error {
+    public:
+        explicit ProgramBinaryError(const std::string& message) : runtime_error(message) {}
+    };
+
+    ///@brief A versioned binary form of a compiled MolangProgram, so packs can be compiled
+    /// once at build time and loaded without tokenizing, parsing or preprocessing again.
+    ///
+    /// The binary holds the processed tree, the slot layout and call ids of the collector
+    /// state, the program id, the string literals and the math precision. String handles are
+    /// pool specific, so literals are stored as text and interned into the loading pool
+    class ProgramBinary {
+    public:
+        static constexpr std::array<char, 4> magic{'M', 'L', 'R', 'B'};
+        // Has to be bumped whenever the layout changes, including reordering AstKind or any
+        // of the operator enums since their values are stored as is
+        static constexpr uint16_t version = 3;
+
+        ///@brief Every optimization level can be saved, as long as the program wasn't fused,
+        /// see PipelineOptions::fuse. Throws ProgramBinaryError for a program with
+        /// superinstructions
+        static std::vector<std::byte>
+        serialize(MolangProgram& program, const StringPool& string_pool = StringPool::shared());
+
+        ///@brief Validates and rebuilds a program. Throws ProgramBinaryError for anything
+        /// which isn't a well formed binary of this version, a corrupt binary never produces
+        /// a program which can index outside its slots
+        static MolangProgram deserialize(
+            std::span<const std::byte> data, StringPool& string_pool = StringPool::shared()
+        );
+    };
+} // namespace molar::exec
+
+#endif // PROGRAM_BINARY_HPP
@@ -0,0 +1,166 @@
+//
+// Created by Akashic on 10/19/2026.
+//
+
+#include "program_cache.hpp"
+
+#include <cstring>
+#include <format>
+#include <fstream>
+#include <optional>
+#include <random>
+#include <span>
+#include <utility>
+#include <vector>
+
+#include "program_binary.hpp"
+
+namespace molar::exec {
+    namespace {
+        // An entry is the source it was compiled from followed by the program binary. The
+        // source is compared on load, so a hash collision is a miss rather than a wrong program
+        constexpr std::string_view entry_extension = ".mlrc";
+
+        uint64_t fnv1a_64(const std::span<const std::byte> data, uint64_t hash) {
+            for (const auto byte : data) {
+                hash ^= static_cast<uint64_t>(byte);
+                hash *= 1099511628211ull;
+            }
+            return hash;
+        }
+
+        ///@brief The whole entry file, or nothing if it can't be read. Entries are never
+        /// written in place, so the read can't see a partial entry
+        std::optional<std::vector<std::byte>> read_entry(const std::filesystem::path& path) {
+            std::ifstream stream(path, std::ios::binary | std::ios::ate);
+            if (!stream) {
+                return std::nullopt;
+            }
+
+            std::vector<std::byte> entry(static_cast<size_t>(stream.tellg()));
+            stream.seekg(0);
+            if (!stream.read(
+                    reinterpret_cast<char*>(entry.data()),
+                    static_cast<std::streamsize>(entry.size())
+                )) {
+                return std::nullopt;
+            }
+            return entry;
+        }
+
+        std::vector<std::byte>
+        build_entry(
+            const std::string_view source, MolangProgram& program, const StringPool& string_pool
+        ) {
+            // String literals are written as indices into the pool the program was compiled
+            // with, any other pool would swap them on load
+            const auto binary = ProgramBinary::serialize(program, string_pool);
+
+            std::vector<std::byte> entry(sizeof(uint64_t) + source.size() + binary.size());
+            const uint64_t         source_size = source.size();
+
+            std::memcpy(entry.data(), &source_size, sizeof(uint64_t));
+            std::memcpy(entry.data() + sizeof(uint64_t), source.data(), source.size());
+            std::memcpy(
+                entry.data() + sizeof(uint64_t) + source.size(), binary.data(), binary.size()
+            );
+            return entry;
+        }
+
+        ///@brief The binary stored in an entry, or nothing if the entry is for another source
+        std::optional<std::span<const std::byte>>
+        entry_binary(const std::span<const std::byte> entry, const std::string_view source) {
+            uint64_t source_size{};
+            if (entry.size() < sizeof(uint64_t)) {
+                return std::nullopt;
+            }
+            std::memcpy(&source_size, entry.data(), sizeof(uint64_t));
+
+            const auto rest = entry.subspan(sizeof(uint64_t));
+            if (source_size != source.size() || rest.size() < source.size() ||
+                std::memcmp(rest.data(), source.data(), source.size()) != 0) {
+                return std::nullopt;
+            }
+            return rest.subspan(source.size());
+        }
+
+        void
+        write_entry(const std::filesystem::path& path, const std::span<const std::byte> entry) {
+            // Each writer uses its own temporary name, whichever rename lands last wins and
+            // both wrote the same bytes
+            thread_local std::mt19937_64 random{std::random_device{}()};
+
+            auto temporary = path;
+            temporary += std::format(".{:016x}.tmp", random());
+            {
+                std::ofstream stream(temporary, std::ios::binary | std::ios::trunc);
+                stream.write(
+                    reinterpret_cast<const char*>(entry.data()),
+                    static_cast<std::streamsize>(entry.size())
+                );
+                if (!stream) {
+                    std::error_code ignored{};
+                    std::filesystem::remove(temporary, ignored);
+                    return;
+                }
+            }
+
+            std::error_code error{};
+            std::filesystem::rename(temporary, path, error);
+            if (error) {
+                std::filesystem::remove(temporary, error);
+            }
+        }
+    } // namespace
+
+    ProgramCache::ProgramCache(std::filesystem::path directory)
+        : directory(std::move(directory)) {
+        std::filesystem::create_directories(this->directory);
+    }
+
+    std::filesystem::path ProgramCache::entry_path(
+        const std::string_view source, const math::MathPrecision precision
+    ) const {
+        // Anything which changes the binary for the same source belongs in the key: the
+        // layout, the compiler which built the tree and every option passed to compile
+        uint64_t hash = 14695981039346656037ull;
+        hash          = fnv1a_64(std::as_bytes(std::span(source)), hash);
+        hash          = fnv1a_64(std::as_bytes(std::span(&ProgramBinary::version, 1)), hash);
+        hash          = fnv1a_64(
+            std::as_bytes(std::span(&MolangProgram::compiler_version, 1)), hash
+        );
+        hash          = fnv1a_64(std::as_bytes(std::span(&precision, 1)), hash);
+
+        return this->directory / std::format("{:016x}{}", hash, entry_extension);
+    }
+
+    MolangProgram ProgramCache::load_or_compile(
+        const std::string_view source, StringPool& string_pool,
+        const math::MathPrecision precision
+    ) {
+        const auto path = this->entry_path(source, precision);
+
+        if (const auto entry = read_entry(path)) {
+            if (const auto binary = entry_binary(*entry, source)) {
+                try {
+                    auto program = ProgramBinary::deserialize(*binary, string_pool);
+                    ++this->hits;
+                    return program;
+                } catch (const ProgramBinaryError&) {
+                    // Corrupt entries are rebuilt below
+                }
+            }
+        }
+
+        ++this->misses;
+        auto program = MolangProgram::compile(source, string_pool, precision);
+
+        // A cache which can't be written to only costs the compile, it shouldn't fail the load.
+        // A program which can't be serialized is a bug and is left to throw
+        const auto entry = build_entry(source, program, string_pool);
+        try {
+            write_entry(path, entry);
+        } catch (const std::filesystem::filesystem_error&) {}
+        return program;
+    }
+} // namespace molar::exec
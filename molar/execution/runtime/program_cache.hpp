@@ -0,0 +1,54 @@
+//
+// Created by Akashic on 10/19/2026.
+//
+
+#ifndef PROGRAM_CACHE_HPP
+#define PROGRAM_CACHE_HPP
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <string_view>
+
+#include "molang_program.hpp"
+
+namespace molar::exec {
+    ///@brief An on-disk cache of program binaries, shared by every process pointed at the
+    /// same directory. Entries are keyed by the source, the binary version, the compiler
+    /// version and the compile options, so a pack which didn't change is never compiled
+    /// twice, even across restarts, and a new compiler never loads an old tree.
+    ///
+    /// Only the compile is shared. A hit reads the entry and deserializes it into a program
+    /// private to the process, so every process holds its own copy of every program it
+    /// loads. Entries are written to a temporary file and renamed into place, so a reader
+    /// never sees a partial entry while another process is writing it
+    class ProgramCache {
+    public:
+        ///@brief Creates the directory if it doesn't exist yet
+        explicit ProgramCache(std::filesystem::path directory);
+
+        ///@brief Loads the cached program for the source, compiling and storing it on a miss.
+        /// A corrupt or stale entry is treated as a miss and replaced
+        MolangProgram load_or_compile(
+            std::string_view source, StringPool& string_pool = StringPool::shared(),
+            math::MathPrecision precision = math::MathPrecision::Exact
+        );
+
+        ///@brief Where the entry for a source lives, whether or not it exists yet
+        [[nodiscard]] std::filesystem::path
+        entry_path(std::string_view source, math::MathPrecision precision) const;
+
+        [[nodiscard]] const std::filesystem::path& get_directory() const {
+            return this->directory;
+        }
+
+        [[nodiscard]] uint64_t get_hits() const { return this->hits; }
+        [[nodiscard]] uint64_t get_misses() const { return this->misses; }
+
+    private:
+        std::filesystem::path directory;
+        std::atomic<uint64_t> hits{0};
+        std::atomic<uint64_t> misses{0};
+    };
+} // namespace molar::exec
+
+#endif // PROGRAM_CACHE_HPP
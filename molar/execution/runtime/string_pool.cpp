@@ -0,0 +1,113 @@
+//
+// Created by Akashic on 10/19/2026.
+//
+
+#include "string_pool.hpp"
+
+#include <algorithm>
+#include <array>
+#include <mutex>
+#include <stdexcept>
+
+namespace molar::exec {
+    namespace {
+        // Every live pool by its index, so handles of different pools can be resolved
+        std::mutex                                     registry_mutex{};
+        std::array<StringPool*, StringPool::max_pools> registry{};
+    } // namespace
+
+    StringPool::StringPool() {
+        std::lock_guard lock{registry_mutex};
+
+        // Slot 0 is kept for the shared pool
+        const auto free = std::ranges::find(registry.begin() + 1, registry.end(), nullptr);
+        if (free == registry.end()) {
+            throw std::length_error("Too many string pools are alive");
+        }
+        *free      = this;
+        this->pool = static_cast<uint32_t>(free - registry.begin());
+    }
+
+    StringPool::StringPool(SharedTag) {
+        std::lock_guard lock{registry_mutex};
+        registry[0] = this;
+    }
+
+    StringPool::~StringPool() {
+        std::lock_guard lock{registry_mutex};
+        registry[this->pool] = nullptr;
+    }
+
+    StringPool& StringPool::shared() {
+        static StringPool pool{SharedTag{}};
+        return pool;
+    }
+
+    bool StringPool::equal(const InternedString left, const InternedString right) {
+        if (left == right) {
+            return true;
+        }
+        if (left.get_pool() == right.get_pool() || !left.is_valid() || !right.is_valid()) {
+            return false;
+        }
+
+        // Held while reading, so neither pool can go away in between
+        std::lock_guard lock{registry_mutex};
+        const auto*     left_pool  = registry[left.get_pool()];
+        const auto*     right_pool = registry[right.get_pool()];
+        if (left_pool == nullptr || right_pool == nullptr) {
+            return false;
+        }
+        return left_pool->resolve(left) == right_pool->resolve(right);
+    }
+
+    InternedString StringPool::intern(const std::string_view string) {
+        if (const auto existing = this->find(string); existing.has_value()) {
+            return existing.value();
+        }
+
+        std::unique_lock lock{this->mutex};
+
+        // Someone else could have interned it between the shared and the unique lock
+        if (const auto it = this->lookup.find(string); it != this->lookup.end()) {
+            return it->second;
+        }
+
+        // The last index of the last pool would be invalid_id
+        if (this->strings.size() >= InternedString::index_mask) {
+            throw std::length_error("The string pool is full");
+        }
+
+        const auto id = InternedString{
+            (this->pool << InternedString::index_bits) |
+            static_cast<uint32_t>(this->strings.size())
+        };
+        this->strings.emplace_back(string);
+        this->lookup.emplace(std::string_view{this->strings.back()}, id);
+        return id;
+    }
+
+    std::optional<InternedString> StringPool::find(const std::string_view string) const {
+        std::shared_lock lock{this->mutex};
+
+        if (const auto it = this->lookup.find(string); it != this->lookup.end()) {
+            return it->second;
+        }
+        return std::nullopt;
+    }
+
+    std::string_view StringPool::resolve(const InternedString string) const {
+        std::shared_lock lock{this->mutex};
+
+        if (!string.is_valid() || string.get_pool() != this->pool ||
+            string.get_index() >= this->strings.size()) {
+            throw std::out_of_range("String handle does not belong to this pool");
+        }
+        return this->strings[string.get_index()];
+    }
+
+    size_t StringPool::size() const {
+        std::shared_lock lock{this->mutex};
+        return this->strings.size();
+    }
+} // namespace molar::exec
@@ -0,0 +1,99 @@
+//
+// Created by Akashic on 10/19/2026.
+//
+
+#ifndef STRING_POOL_HPP
+#define STRING_POOL_HPP
+#include <cstdint>
+#include <deque>
+#include <optional>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+namespace molar::exec {
+    ///@brief A handle to a string stored inside a StringPool. Two handles from the same pool
+    /// compare equal if and only if the strings they point to are equal, handles of different
+    /// pools never do, see StringPool::equal for comparing those.
+    ///
+    /// The top bits of the id say which pool it came from, the rest is the string's index in
+    /// that pool. The shared pool is pool 0, so its ids are plain indices
+    class InternedString {
+    public:
+        static constexpr uint32_t invalid_id = UINT32_MAX;
+        static constexpr uint32_t index_bits = 24;
+        static constexpr uint32_t index_mask = (1u << index_bits) - 1;
+
+        constexpr InternedString() = default;
+
+        constexpr explicit InternedString(const uint32_t id) : id(id) {}
+
+        [[nodiscard]] constexpr uint32_t get_id() const { return this->id; }
+
+        [[nodiscard]] constexpr uint32_t get_pool() const { return this->id >> index_bits; }
+
+        [[nodiscard]] constexpr uint32_t get_index() const { return this->id & index_mask; }
+
+        [[nodiscard]] constexpr bool is_valid() const { return this->id != invalid_id; }
+
+        constexpr bool operator==(const InternedString& other) const = default;
+
+    private:
+        uint32_t id{invalid_id};
+    };
+
+    ///@brief Owns every string a compiled program (or the host) can produce. Strings are
+    /// interned once, at compile time for literals and at the query boundary for host values,
+    /// so runtime string handling is just copying and comparing InternedString handles
+    class StringPool {
+    public:
+        ///@brief How many pools can be alive at once, the shared one included
+        static constexpr size_t max_pools = size_t{1} << (32 - InternedString::index_bits);
+
+        ///@brief Throws std::length_error if max_pools pools are already alive
+        StringPool();
+        ~StringPool();
+
+        StringPool(const StringPool&)            = delete;
+        StringPool& operator=(const StringPool&) = delete;
+
+        ///@brief The pool used by every program which was not given an explicit pool
+        static StringPool& shared();
+
+        ///@brief Whether the two handles hold the same string. Handles of one pool compare
+        /// by id, handles of different pools by their contents, which takes both pools'
+        /// locks. A handle whose pool is gone equals nothing of another pool
+        static bool equal(InternedString left, InternedString right);
+
+        ///@brief Interns the string, returning the existing handle if it was already present
+        InternedString intern(std::string_view string);
+
+        ///@brief Looks up a string without interning it
+        [[nodiscard]] std::optional<InternedString> find(std::string_view string) const;
+
+        [[nodiscard]] std::string_view resolve(InternedString string) const;
+
+        [[nodiscard]] size_t size() const;
+
+    private:
+        struct SharedTag {};
+
+        explicit StringPool(SharedTag);
+
+        // Which bits mark the handles of this pool, see InternedString
+        uint32_t                  pool{};
+        mutable std::shared_mutex mutex{};
+        // A deque never moves its elements, so the views used as keys stay valid
+        std::deque<std::string>                              strings{};
+        std::unordered_map<std::string_view, InternedString> lookup{};
+    };
+} // namespace molar::exec
+
+template <> struct std::hash<molar::exec::InternedString> {
+    size_t operator()(const molar::exec::InternedString& string) const noexcept {
+        return std::hash<uint32_t>{}(string.get_id());
+    }
+};
+
+#endif // STRING_POOL_HPP
@@ -0,0 +1,666 @@
+//
+// Created by Akashic on 10/19/2026.
+//
+
+#ifndef STATIC_PARSER_HPP
+#define STATIC_PARSER_HPP
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+#include <string_view>
+
+#include "ast/variable.hpp"
+#include "execution/math/molang_math.hpp"
+#include "internal/token_tables.hpp"
+#include "molang_token.hpp"
+
+// A tokenizer and parser which run during constant evaluation. They follow MolangTokenizer
+// and MolangAstGenerator rule for rule, but write into fixed size arrays instead of heap
+// nodes so the result can be used as a template argument by StaticProgram
+namespace molar::exec::compile_time {
+    ///@brief A string literal usable as a template argument
+    template <size_t N> struct FixedString {
+        char data[N]{};
+
+        consteval FixedString(const char (&string)[N]) { std::copy_n(string, N, this->data); }
+
+        [[nodiscard]] constexpr std::string_view view() const { return {this->data, N - 1}; }
+    };
+
+    ///@brief Never constant evaluated, reaching it while compiling a StaticProgram makes the
+    /// compiler report the call together with the message
+    inline void compile_error(const char* message) { throw std::logic_error(message); }
+
+    constexpr bool is_digit(const char c) { return c >= '0' && c <= '9'; }
+
+    constexpr bool is_alpha(const char c) {
+        return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z');
+    }
+
+    constexpr char to_upper(const char c) {
+        return c >= 'a' && c <= 'z' ? static_cast<char>(c - 'a' + 'A') : c;
+    }
+
+    struct StaticToken {
+        TokenType type{};
+        uint32_t  position{};
+        uint32_t  size{};
+    };
+
+    template <size_t Capacity> struct StaticTokens {
+        std::array<StaticToken, Capacity> tokens{};
+        size_t                            count{0};
+    };
+
+    template <size_t Capacity>
+    constexpr StaticTokens<Capacity> tokenize(std::string_view source) {
+        StaticTokens<Capacity> result{};
+        size_t                 position = 0;
+
+        const auto starts_with = [&](const std::string_view text) {
+            return source.substr(position).starts_with(text);
+        };
+        const auto emit = [&](const TokenType type, const size_t start, const size_t size) {
+            result.tokens[result.count++] = {
+                type, static_cast<uint32_t>(start), static_cast<uint32_t>(size)
+            };
+        };
+        const auto at = [&](const size_t index) {
+            return index < source.size() ? source[index] : '\0';
+        };
+
+        while (position < source.size()) {
+            const auto skipped = std::ranges::find_if(details::skip, starts_with);
+            if (skipped != details::skip.end()) {
+                position += skipped->size();
+                continue;
+            }
+
+            if (at(position) == '\'') {
+                const auto start   = position++;
+                bool       escaped = false;
+                while (position < source.size()) {
+                    const auto c = source[position++];
+                    if (!escaped && c == '\'') {
+                        break;
+                    }
+                    escaped = !escaped && c == '\\';
+                }
+                if (source[position - 1] != '\'' || position - start < 2) {
+                    compile_error("Unterminated string");
+                }
+                emit(TokenType::String, start, position - start);
+                continue;
+            }
+
+            const auto caseless = std::ranges::find_if(
+                details::case_insensitive_tokens,
+                [&](const auto& entry) {
+                    const auto text = entry.second;
+                    return source.size() - position >= text.size() &&
+                           std::ranges::equal(
+                               source.substr(position, text.size()), text, {}, to_upper,
+                               to_upper
+                           );
+                }
+            );
+            if (caseless != details::case_insensitive_tokens.end()) {
+                emit(caseless->first, position, caseless->second.size());
+                position += caseless->second.size();
+                continue;
+            }
+
+            const auto multi = std::ranges::find_if(
+                details::multi_char_tokens,
+                [&](const auto& entry) { return starts_with(entry.second); }
+            );
+            if (multi != details::multi_char_tokens.end()) {
+                emit(multi->first, position, multi->second.size());
+                position += multi->second.size();
+                continue;
+            }
+
+            if (is_digit(at(position)) || (at(position) == '-' && is_digit(at(position + 1)))) {
+                const auto start = position++;
+                while (is_digit(at(position)) || at(position) == '.') {
+                    ++position;
+                }
+                emit(TokenType::Number, start, position - start);
+                // The `f` suffix is consumed but isn't part of the token
+                if (to_upper(at(position)) == 'F') {
+                    ++position;
+                }
+                continue;
+            }
+
+            const auto simple = std::ranges::find(
+                details::simple_tokens, at(position), &std::pair<TokenType, char>::second
+            );
+            if (simple != details::simple_tokens.end()) {
+                emit(simple->first, position++, 1);
+                continue;
+            }
+
+            // `v.`, `q.` and friends are left for the single character tokens below
+            const bool short_prefix =
+                std::ranges::contains(std::array{'v', 'q', 't', 'c', 'm'}, at(position)) &&
+                at(position + 1) == '.';
+            if (!short_prefix && (is_alpha(at(position)) || at(position) == '_')) {
+                const auto start = position++;
+                while (is_alpha(at(position)) || is_digit(at(position)) ||
+                       at(position) == '_') {
+                    ++position;
+                }
+                emit(TokenType::Identifier, start, position - start);
+                continue;
+            }
+
+            const auto single = std::ranges::find(
+                details::single_char_complex, at(position), &std::pair<TokenType, char>::second
+            );
+            if (single != details::single_char_complex.end()) {
+                emit(single->first, position++, 1);
+                continue;
+            }
+
+            // Just skip an unknown character
+            ++position;
+        }
+
+        return result;
+    }
+
+    // 10^0 through 10^22, every one of them is exact in a double
+    inline constexpr auto powers_of_ten = [] {
+        std::array<double, 23> powers{1.0};
+        for (size_t i = 1; i < powers.size(); ++i) {
+            powers[i] = powers[i - 1] * 10.0;
+        }
+        return powers;
+    }();
+
+    ///@brief Parses a number the way std::stof reads the literals the tokenizer produces.
+    /// The digits are scaled once by an exact power of ten, so up to 15 significant digits
+    /// and 22 decimals only the final conversion to float rounds. Longer literals round more
+    /// than once and may differ from std::stof by an ulp
+    constexpr float parse_number(const std::string_view text) {
+        size_t     index    = 0;
+        const bool negative = !text.empty() && text[0] == '-';
+        index += negative ? 1 : 0;
+
+        uint64_t mantissa = 0;
+        int32_t  exponent = 0;
+        bool     fraction = false;
+        for (; index < text.size(); ++index) {
+            const auto c = text[index];
+            if (c == '.') {
+                if (fraction) {
+                    break;
+                }
+                fraction = true;
+                continue;
+            }
+            // Digits past what a uint64 holds can't change the float
+            if (mantissa < UINT64_MAX / 10 - 9) {
+                mantissa = mantissa * 10 + static_cast<uint64_t>(c - '0');
+                exponent -= fraction ? 1 : 0;
+            } else {
+                exponent += fraction ? 0 : 1;
+            }
+        }
+
+        constexpr int32_t largest = static_cast<int32_t>(powers_of_ten.size()) - 1;
+
+        double value = static_cast<double>(mantissa);
+        for (; exponent > largest; exponent -= largest) {
+            value *= powers_of_ten[largest];
+        }
+        for (; exponent < -largest; exponent += largest) {
+            value /= powers_of_ten[largest];
+        }
+        value = exponent >= 0 ? value * powers_of_ten[exponent] : value / powers_of_ten[-exponent];
+        return static_cast<float>(negative ? -value : value);
+    }
+
+    inline constexpr uint16_t no_node = UINT16_MAX;
+
+    enum class StaticNodeKind : uint8_t {
+        Number,
+        // `(a; b)`, the value is the last expression
+        Sequence,
+        Unary,
+        Binary,
+        Conditional,
+        Ternary,
+        Variable,
+        Assign,
+        MathCall,
+        QueryCall,
+        Return,
+    };
+
+    ///@brief One node of a parsed program. Children are node indices, lists are chained
+    /// through `next`
+    struct StaticNode {
+        StaticNodeKind kind{};
+        // The BinaryOp, UnaryOp, MathFunction or VariableDeclarationType of the node
+        uint8_t        operation{};
+        float          number{};
+        // Variable slot or query id
+        uint16_t       slot{};
+        uint16_t       call_site{};
+        uint16_t       first{no_node};
+        uint16_t       second{no_node};
+        uint16_t       third{no_node};
+        uint16_t       next{no_node};
+        uint16_t       count{0};
+    };
+
+    struct StaticName {
+        uint32_t position{};
+        uint32_t size{};
+    };
+
+    template <size_t Capacity> struct StaticTree {
+        static_assert(Capacity < no_node, "Static programs are limited to 65534 nodes");
+
+        std::array<StaticNode, Capacity> nodes{};
+        uint16_t                         node_count{0};
+        // The top level expressions
+        uint16_t                         first{no_node};
+
+        // Slot i of each kind is named by entry i, like the collector state of a program
+        std::array<StaticName, Capacity> variables{};
+        std::array<StaticName, Capacity> temps{};
+        std::array<StaticName, Capacity> queries{};
+        uint16_t                         variable_count{0};
+        uint16_t                         temp_count{0};
+        uint16_t                         query_count{0};
+        uint16_t                         call_site_count{0};
+    };
+
+    ///@brief Builds a StaticTree, see MolangAstGenerator for the grammar. Everything which
+    /// needs a string, an array, an entity or a loop is rejected with a compile error
+    template <size_t Capacity> class StaticParser {
+    public:
+        constexpr explicit StaticParser(const std::string_view source)
+            : source(source), tokens(tokenize<Capacity>(source)) {}
+
+        constexpr StaticTree<Capacity> parse() {
+            uint16_t last = no_node;
+            while (this->has_any()) {
+                const auto node = this->parse_progress();
+                if (node == no_node) {
+                    continue;
+                }
+                (last == no_node ? this->tree.first : this->tree.nodes[last].next) = node;
+                last = node;
+            }
+
+            for (auto node = this->tree.first; node != no_node;
+                 node      = this->tree.nodes[node].next) {
+                this->number_call_site(node);
+                this->number_children(node);
+            }
+            return this->tree;
+        }
+
+    private:
+        [[nodiscard]] constexpr bool has_any() const {
+            return this->current < this->tokens.count;
+        }
+
+        [[nodiscard]] constexpr bool peek_is(const TokenType type) const {
+            return this->has_any() && this->tokens.tokens[this->current].type == type;
+        }
+
+        constexpr bool next(const TokenType type) {
+            if (this->peek_is(type)) {
+                ++this->current;
+                return true;
+            }
+            return false;
+        }
+
+        constexpr StaticToken take() {
+            if (!this->has_any()) {
+                compile_error("Unexpected end of expression");
+            }
+            return this->tokens.tokens[this->current++];
+        }
+
+        [[nodiscard]] constexpr std::string_view text(const StaticToken token) const {
+            return this->source.substr(token.position, token.size);
+        }
+
+        constexpr uint16_t add(const StaticNode node) {
+            this->tree.nodes[this->tree.node_count] = node;
+            return this->tree.node_count++;
+        }
+
+        static constexpr bool is_binary_operator(const TokenType type) {
+            return std::ranges::contains(
+                std::array{
+                    TokenType::Eq, TokenType::NotEq, TokenType::Lt, TokenType::LtEq,
+                    TokenType::Gt, TokenType::GtEq, TokenType::Plus, TokenType::Minus,
+                    TokenType::Star, TokenType::Slash, TokenType::Or, TokenType::And,
+                    TokenType::NullCoal
+                },
+                type
+            );
+        }
+
+        // Call sites are numbered in the order the preprocessor's rebuilder replaces calls,
+        // which replaces all children of a node before descending into any of them. Random
+        // calls then draw the same values as they do through MolangEvaluator
+        constexpr void number_call_site(const uint16_t node) {
+            auto& call = this->tree.nodes[node];
+            if (call.kind == StaticNodeKind::MathCall ||
+                call.kind == StaticNodeKind::QueryCall) {
+                call.call_site = this->tree.call_site_count++;
+            }
+        }
+
+        template <typename Visitor>
+        constexpr void for_each_child(const uint16_t node, Visitor&& visitor) {
+            const auto& parent = this->tree.nodes[node];
+            if (parent.kind == StaticNodeKind::Sequence ||
+                parent.kind == StaticNodeKind::MathCall ||
+                parent.kind == StaticNodeKind::QueryCall) {
+                for (auto child = parent.first; child != no_node;
+                     child      = this->tree.nodes[child].next) {
+                    visitor(child);
+                }
+                return;
+            }
+            for (const auto child : {parent.first, parent.second, parent.third}) {
+                if (child != no_node) {
+                    visitor(child);
+                }
+            }
+        }
+
+        // NOLINTNEXTLINE
+        constexpr void number_children(const uint16_t node) {
+            this->for_each_child(node, [this](const uint16_t child) {
+                this->number_call_site(child);
+            });
+            this->for_each_child(node, [this](const uint16_t child) {
+                this->number_children(child);
+            });
+        }
+
+        ///@brief Parses the next expression of a list, which may be empty after a `;`. A
+        /// token no expression can start with would make the list loop forever
+        constexpr uint16_t parse_progress() {
+            const auto start = this->current;
+            const auto node  = this->parse_expression(0);
+            if (node == no_node && this->current == start) {
+                compile_error("Unexpected token");
+            }
+            return node;
+        }
+
+        // NOLINTNEXTLINE
+        constexpr uint16_t parse_expression(const uint8_t min_binding_power) {
+            if (this->next(TokenType::Semi)) {
+                return no_node;
+            }
+
+            auto lhs = this->parse_primary();
+            if (lhs == no_node) {
+                return no_node;
+            }
+
+            while (this->has_any()) {
+                const auto type = this->tokens.tokens[this->current].type;
+                if (type == TokenType::Arrow) {
+                    compile_error("Static programs can't use `->`");
+                }
+
+                const auto bind_power = token_bind_power(type);
+                if (!bind_power || bind_power->first < min_binding_power) {
+                    break;
+                }
+
+                if (this->next(TokenType::Conditional)) {
+                    const auto if_expression = this->expect(this->parse_expression(0));
+                    if (this->next(TokenType::Colon)) {
+                        const auto else_expression = this->expect(this->parse_expression(0));
+                        lhs                        = this->add({
+                                                   .kind   = StaticNodeKind::Ternary,
+                                                   .first  = lhs,
+                                                   .second = if_expression,
+                                                   .third  = else_expression,
+                        });
+                    } else {
+                        lhs = this->add({
+                            .kind   = StaticNodeKind::Conditional,
+                            .first  = lhs,
+                            .second = if_expression,
+                        });
+                    }
+                    continue;
+                }
+
+                if (!is_binary_operator(type)) {
+                    break;
+                }
+                ++this->current;
+
+                const auto rhs = this->expect(this->parse_expression(bind_power->second));
+                lhs            = this->add({
+                               .kind      = StaticNodeKind::Binary,
+                               .operation = static_cast<uint8_t>(type),
+                               .first     = lhs,
+                               .second    = rhs,
+                });
+            }
+
+            return lhs;
+        }
+
+        constexpr uint16_t expect(const uint16_t node) {
+            if (node == no_node) {
+                compile_error("Expected expression");
+            }
+            return node;
+        }
+
+        // NOLINTNEXTLINE
+        constexpr uint16_t parse_primary() {
+            if (!this->has_any()) {
+                return no_node;
+            }
+
+            const auto token = this->take();
+            switch (token.type) {
+            case TokenType::Variable:
+            case TokenType::Temporary:
+                return this->parse_variable(token);
+            case TokenType::Context:
+                compile_error("Static programs can't use context variables");
+                return no_node;
+            case TokenType::Number:
+                return this->add({
+                    .kind   = StaticNodeKind::Number,
+                    .number = parse_number(this->text(token)),
+                });
+            case TokenType::True:
+            case TokenType::False:
+                return this->add({
+                    .kind   = StaticNodeKind::Number,
+                    .number = token.type == TokenType::True ? 1.0f : 0.0f,
+                });
+            case TokenType::LeftParen:
+                return this->parse_sequence();
+            case TokenType::Minus:
+            case TokenType::Not:
+                return this->add({
+                    .kind      = StaticNodeKind::Unary,
+                    .operation = static_cast<uint8_t>(token.type),
+                    .first     = this->expect(this->parse_expression(0)),
+                });
+            case TokenType::Math:
+            case TokenType::Query:
+                return this->parse_call(token);
+            case TokenType::Return:
+                return this->add({
+                    .kind  = StaticNodeKind::Return,
+                    .first = this->parse_expression(0),
+                });
+            case TokenType::String:
+                compile_error("Static programs can't use strings");
+                return no_node;
+            case TokenType::LeftBrace:
+            case TokenType::Loop:
+            case TokenType::ForEach:
+            case TokenType::Break:
+            case TokenType::Continue:
+                compile_error("Static programs can't use blocks or loops");
+                return no_node;
+            case TokenType::Array:
+            case TokenType::Geometry:
+            case TokenType::Material:
+            case TokenType::Texture:
+            case TokenType::This:
+                compile_error("Static programs can't use arrays, resources or `this`");
+                return no_node;
+            default:
+                // Not the start of an expression, like MolangAstGenerator it is left alone
+                --this->current;
+                return no_node;
+            }
+        }
+
+        constexpr StaticToken take_name() {
+            const auto name = this->take();
+            if (!std::ranges::contains(tokens_which_could_be_names, name.type)) {
+                compile_error("Expected identifier");
+            }
+            return name;
+        }
+
+        ///@brief The slot of a name, adding it if this is its first use
+        constexpr uint16_t
+        slot(std::array<StaticName, Capacity>& names, uint16_t& count, const StaticToken name) {
+            for (uint16_t i = 0; i < count; ++i) {
+                if (this->source.substr(names[i].position, names[i].size) == this->text(name)) {
+                    return i;
+                }
+            }
+            names[count] = {name.position, name.size};
+            return count++;
+        }
+
+        constexpr uint16_t parse_variable(const StaticToken token) {
+            if (!this->next(TokenType::Dot)) {
+                compile_error("Expected dot after variable declaration");
+            }
+            const auto name = this->take_name();
+            if (this->peek_is(TokenType::Dot)) {
+                compile_error("Static programs can't use struct variables");
+            }
+
+            const bool is_temp = token.type == TokenType::Temporary;
+            const auto storage =
+                is_temp ? molar::ast::VariableDeclarationType::Temp
+                        : molar::ast::VariableDeclarationType::Var;
+            const auto slot =
+                is_temp ? this->slot(this->tree.temps, this->tree.temp_count, name)
+                        : this->slot(this->tree.variables, this->tree.variable_count, name);
+
+            StaticNode node{
+                .kind      = StaticNodeKind::Variable,
+                .operation = static_cast<uint8_t>(storage),
+                .slot      = slot,
+            };
+            if (this->next(TokenType::Assign)) {
+                node.kind  = StaticNodeKind::Assign;
+                node.first = this->expect(this->parse_expression(0));
+            }
+            return this->add(node);
+        }
+
+        constexpr uint16_t parse_sequence() {
+            StaticNode sequence{.kind = StaticNodeKind::Sequence};
+            uint16_t   last = no_node;
+
+            while (!this->next(TokenType::RightParen)) {
+                if (!this->has_any()) {
+                    compile_error("Expected right paren");
+                }
+                const auto node = this->parse_progress();
+                if (node == no_node) {
+                    continue;
+                }
+                (last == no_node ? sequence.first : this->tree.nodes[last].next) = node;
+                last = node;
+                ++sequence.count;
+            }
+            return this->add(sequence);
+        }
+
+        constexpr uint16_t parse_call(const StaticToken token) {
+            if (!this->next(TokenType::Dot)) {
+                compile_error("Expected Dot after Call Type (math, or query)");
+            }
+            const auto name = this->take_name();
+
+            StaticNode call{};
+
+            if (token.type == TokenType::Math) {
+                const auto function = std::ranges::find_if(
+                    math::math_function_names,
+                    [&](const std::string_view candidate) {
+                        return std::ranges::equal(
+                            candidate, this->text(name), {}, to_upper, to_upper
+                        );
+                    }
+                );
+                if (function == math::math_function_names.end()) {
+                    compile_error("Unknown math function");
+                }
+                call.kind      = StaticNodeKind::MathCall;
+                call.operation = static_cast<uint8_t>(
+                    std::distance(math::math_function_names.begin(), function)
+                );
+            } else {
+                call.kind = StaticNodeKind::QueryCall;
+                call.slot = this->slot(this->tree.queries, this->tree.query_count, name);
+            }
+
+            uint16_t last = no_node;
+            if (this->next(TokenType::LeftParen)) {
+                while (!this->next(TokenType::RightParen)) {
+                    if (!this->has_any()) {
+                        compile_error("Unexpected End Of File at call expression");
+                    }
+                    if (this->next(TokenType::Comma)) {
+                        continue;
+                    }
+                    const auto argument = this->expect(this->parse_expression(0));
+                    (last == no_node ? call.first : this->tree.nodes[last].next) = argument;
+                    last = argument;
+                    ++call.count;
+                }
+            }
+            return this->add(call);
+        }
+
+    private:
+        std::string_view       source;
+        StaticTokens<Capacity> tokens;
+        size_t                 current{0};
+        StaticTree<Capacity>   tree{};
+    };
+
+    template <FixedString Source> constexpr auto parse_static() {
+        // A program never has more nodes than tokens, nor more tokens than characters
+        constexpr auto capacity = Source.view().size() + 1;
+        return StaticParser<capacity>(Source.view()).parse();
+    }
+} // namespace molar::exec::compile_time
+
+#endif // STATIC_PARSER_HPP
@@ -0,0 +1,431 @@
+//
+// Created by Akashic on 10/19/2026.
+//
+
+#ifndef STATIC_PROGRAM_HPP
+#define STATIC_PROGRAM_HPP
+#include <array>
+#include <optional>
+#include <string_view>
+#include <utility>
+
+#include "execution/aot/aot_program.hpp"
+#include "execution/math/molang_math_fast.hpp"
+#include "execution/runtime/execution_frame.hpp"
+#include "static_parser.hpp"
+
+namespace molar::exec {
+    ///@brief A Molang expression compiled while compiling the C++ around it. Every node
+    /// becomes its own template instantiation, so the whole program inlines into the caller
+    /// with constants folded and nothing parsed or allocated at startup.
+    ///
+    /// Results match MolangProgram run through MolangEvaluator, with the same frame. Queries
+    /// are passed to `frame.queries` with their index in `query_names` as the id, and
+    /// variables use the slots named by `variable_names` and `temp_names`. `return` works as a
+    /// statement and in the branches of `?` and `? :`, including inside `( ... )` blocks, not
+    /// inside other expressions. Strings, arrays, entities, loops and struct variables aren't
+    /// supported and fail to compile
+    template <compile_time::FixedString Source, math::MathPrecision Precision>
+    class StaticProgram {
+        using Kind = compile_time::StaticNodeKind;
+
+        static constexpr auto     tree    = compile_time::parse_static<Source>();
+        static constexpr uint16_t no_node = compile_time::no_node;
+        // Same id as MolangProgram::compile gives the source, so draws match
+        static constexpr uint32_t random_id = math::program_id(Source.view());
+
+        template <size_t Count>
+        static constexpr auto names(const std::array<compile_time::StaticName, Count>& from) {
+            return [&]<size_t... I>(std::index_sequence<I...>) {
+                return std::array<std::string_view, sizeof...(I)>{
+                    Source.view().substr(from[I].position, from[I].size)...
+                };
+            };
+        }
+
+    public:
+        static constexpr auto variable_names =
+            names(tree.variables)(std::make_index_sequence<tree.variable_count>{});
+        static constexpr auto temp_names =
+            names(tree.temps)(std::make_index_sequence<tree.temp_count>{});
+        static constexpr auto query_names =
+            names(tree.queries)(std::make_index_sequence<tree.query_count>{});
+
+        ///@brief The id `frame.queries` receives for `q.name`
+        static constexpr std::optional<uint32_t> find_query(const std::string_view name) {
+            for (uint32_t i = 0; i < query_names.size(); ++i) {
+                if (query_names[i] == name) {
+                    return i;
+                }
+            }
+            return std::nullopt;
+        }
+
+        ///@brief Evaluates the program. The result is the value of `return` if one ran,
+        /// otherwise the value of the last expression. Like the evaluator every temp is reset
+        /// first, and std::invalid_argument is thrown if the frame has less slots than
+        /// `variable_names` and `temp_names` name
+        MolangValue operator()(ExecutionFrame& frame) const {
+            aot::prepare_frame(frame, variable_names.size(), temp_names.size());
+            return run<tree.first>(frame);
+        }
+
+    private:
+        template <uint16_t Index> static MolangValue run(ExecutionFrame& frame) {
+            if constexpr (Index == no_node) {
+                return MolangValue{};
+            } else {
+                constexpr auto& node = tree.nodes[Index];
+                if constexpr (returns(Index)) {
+                    bool       returned = false;
+                    const auto result   = statement<Index>(frame, returned);
+                    if constexpr (node.next == no_node) {
+                        return result;
+                    } else {
+                        if (returned) {
+                            return result;
+                        }
+                        return run<node.next>(frame);
+                    }
+                } else if constexpr (node.next == no_node) {
+                    return value<Index>(frame);
+                } else {
+                    (void)value<Index>(frame);
+                    return run<node.next>(frame);
+                }
+            }
+        }
+
+        ///@brief Whether a statement can run a `return`, itself or in a branch or block. Only
+        /// these go through `statement` and check the returned flag, like the evaluator's
+        /// Flow::Return
+        static constexpr bool returns(const uint16_t index) {
+            const auto& node = tree.nodes[index];
+            switch (node.kind) {
+            case Kind::Return:
+                return true;
+            case Kind::Conditional:
+                return returns(node.second);
+            case Kind::Ternary:
+                return returns(node.second) || returns(node.third);
+            case Kind::Sequence:
+                for (auto i = node.first; i != no_node; i = tree.nodes[i].next) {
+                    if (returns(i)) {
+                        return true;
+                    }
+                }
+                return false;
+            default:
+                return false;
+            }
+        }
+
+        ///@brief Runs a statement which can return, `returned` is set once a `return` ran
+        template <uint16_t Index>
+        static MolangValue statement(ExecutionFrame& frame, bool& returned) {
+            constexpr auto& node = tree.nodes[Index];
+
+            if constexpr (node.kind == Kind::Return) {
+                returned = true;
+                if constexpr (node.first == no_node) {
+                    return MolangValue{};
+                } else {
+                    return value<node.first>(frame);
+                }
+            } else if constexpr (!returns(Index)) {
+                return value<Index>(frame);
+            } else if constexpr (node.kind == Kind::Conditional) {
+                if (number<node.first>(frame) != 0.0f) {
+                    return statement<node.second>(frame, returned);
+                }
+                return MolangValue{};
+            } else if constexpr (node.kind == Kind::Ternary) {
+                return number<node.first>(frame) != 0.0f
+                           ? statement<node.second>(frame, returned)
+                           : statement<node.third>(frame, returned);
+            } else {
+                return statement_sequence<node.first>(frame, returned);
+            }
+        }
+
+        template <uint16_t First>
+        static MolangValue statement_sequence(ExecutionFrame& frame, bool& returned) {
+            constexpr auto next   = tree.nodes[First].next;
+            const auto     result = statement<First>(frame, returned);
+            if constexpr (next == no_node) {
+                return result;
+            } else {
+                if (returned) {
+                    return result;
+                }
+                return statement_sequence<next>(frame, returned);
+            }
+        }
+
+        ///@brief Whether a node always produces a number, these are generated as plain float
+        /// arithmetic
+        static constexpr bool is_numeric(const uint16_t index) {
+            const auto& node = tree.nodes[index];
+            switch (node.kind) {
+            case Kind::Number:
+            case Kind::Unary:
+            case Kind::MathCall:
+                return true;
+            case Kind::Binary:
+                return static_cast<BinaryOp>(node.operation) != BinaryOp::Coalesce;
+            default:
+                return false;
+            }
+        }
+
+        static constexpr auto arguments_of(const uint16_t index) {
+            std::array<uint16_t, tree.nodes.size()> arguments{};
+            size_t                                  count = 0;
+            for (auto i = tree.nodes[index].first; i != no_node; i = tree.nodes[i].next) {
+                arguments[count++] = i;
+            }
+            return arguments;
+        }
+
+        template <uint16_t Index> static MolangValue value(ExecutionFrame& frame) {
+            constexpr auto& node = tree.nodes[Index];
+
+            if constexpr (is_numeric(Index)) {
+                return number<Index>(frame);
+            } else if constexpr (node.kind == Kind::Variable) {
+                return slot<Index>(frame);
+            } else if constexpr (node.kind == Kind::Assign) {
+                const auto result = value<node.first>(frame);
+                slot<Index>(frame) = result;
+                return result;
+            } else if constexpr (node.kind == Kind::Sequence) {
+                return run_sequence<node.first>(frame);
+            } else if constexpr (node.kind == Kind::Conditional) {
+                if (number<node.first>(frame) != 0.0f) {
+                    return value<node.second>(frame);
+                }
+                return MolangValue{};
+            } else if constexpr (node.kind == Kind::Ternary) {
+                return number<node.first>(frame) != 0.0f ? value<node.second>(frame)
+                                                         : value<node.third>(frame);
+            } else if constexpr (node.kind == Kind::Binary) {
+                // Only `??` isn't numeric
+                const auto left = value<node.first>(frame);
+                return left.is_null() ? value<node.second>(frame) : left;
+            } else if constexpr (node.kind == Kind::QueryCall) {
+                return query<Index>(frame);
+            } else {
+                static_assert(
+                    node.kind != Kind::Return,
+                    "`return` is only supported as a statement or in the branch of a `?`"
+                );
+            }
+        }
+
+        template <uint16_t Index> static float number(ExecutionFrame& frame) {
+            constexpr auto& node = tree.nodes[Index];
+
+            if constexpr (!is_numeric(Index)) {
+                if constexpr (node.kind == Kind::Ternary) {
+                    return number<node.first>(frame) != 0.0f ? number<node.second>(frame)
+                                                             : number<node.third>(frame);
+                } else {
+                    return value<Index>(frame).as_number();
+                }
+            } else if constexpr (node.kind == Kind::Number) {
+                return node.number;
+            } else if constexpr (node.kind == Kind::Unary) {
+                if constexpr (static_cast<UnaryOp>(node.operation) == UnaryOp::Not) {
+                    return number<node.first>(frame) == 0.0f ? 1.0f : 0.0f;
+                } else {
+                    return -number<node.first>(frame);
+                }
+            } else if constexpr (node.kind == Kind::Binary) {
+                return binary<Index>(frame);
+            } else {
+                return math_call<Index>(frame);
+            }
+        }
+
+        template <uint16_t Index> static float binary(ExecutionFrame& frame) {
+            constexpr auto& node      = tree.nodes[Index];
+            constexpr auto  operation = static_cast<BinaryOp>(node.operation);
+
+            if constexpr (operation == BinaryOp::And) {
+                return number<node.first>(frame) != 0.0f && number<node.second>(frame) != 0.0f
+                           ? 1.0f
+                           : 0.0f;
+            } else if constexpr (operation == BinaryOp::Or) {
+                return number<node.first>(frame) != 0.0f || number<node.second>(frame) != 0.0f
+                           ? 1.0f
+                           : 0.0f;
+            } else if constexpr (operation == BinaryOp::Equality ||
+                                 operation == BinaryOp::Inequality) {
+                bool equal{};
+                if constexpr (is_numeric(node.first) && is_numeric(node.second)) {
+                    equal = number<node.first>(frame) == number<node.second>(frame);
+                } else {
+                    // Same rule as the evaluator, queries can produce entities and strings
+                    const auto left  = value<node.first>(frame);
+                    const auto right = value<node.second>(frame);
+                    const bool numeric =
+                        !left.is_string() && !left.is_entity() && !right.is_string() &&
+                        !right.is_entity();
+                    equal = numeric ? left.as_number() == right.as_number() : left == right;
+                }
+                return equal == (operation == BinaryOp::Equality) ? 1.0f : 0.0f;
+            } else {
+                const float lhs = number<node.first>(frame);
+                const float rhs = number<node.second>(frame);
+
+                if constexpr (operation == BinaryOp::LessThan) {
+                    return lhs < rhs ? 1.0f : 0.0f;
+                } else if constexpr (operation == BinaryOp::LessEqualThan) {
+                    return lhs <= rhs ? 1.0f : 0.0f;
+                } else if constexpr (operation == BinaryOp::GreaterThan) {
+                    return lhs > rhs ? 1.0f : 0.0f;
+                } else if constexpr (operation == BinaryOp::GreaterEqualThan) {
+                    return lhs >= rhs ? 1.0f : 0.0f;
+                } else if constexpr (operation == BinaryOp::Addition) {
+                    return lhs + rhs;
+                } else if constexpr (operation == BinaryOp::Subtraction) {
+                    return lhs - rhs;
+                } else if constexpr (operation == BinaryOp::Multiplication) {
+                    return lhs * rhs;
+                } else {
+                    return lhs / rhs;
+                }
+            }
+        }
+
+        template <uint16_t Index> static MolangValue& slot(ExecutionFrame& frame) {
+            constexpr auto& node = tree.nodes[Index];
+            if constexpr (static_cast<molar::ast::VariableDeclarationType>(node.operation) ==
+                          molar::ast::VariableDeclarationType::Temp) {
+                return frame.temps[node.slot];
+            } else {
+                return frame.variables[node.slot];
+            }
+        }
+
+        template <uint16_t First> static MolangValue run_sequence(ExecutionFrame& frame) {
+            if constexpr (First == no_node) {
+                return MolangValue{};
+            } else if constexpr (tree.nodes[First].next == no_node) {
+                return value<First>(frame);
+            } else {
+                (void)value<First>(frame);
+                return run_sequence<tree.nodes[First].next>(frame);
+            }
+        }
+
+        template <uint16_t Index> static MolangValue query(ExecutionFrame& frame) {
+            constexpr auto& node      = tree.nodes[Index];
+            constexpr auto  arguments = arguments_of(Index);
+
+            return [&]<size_t... I>(std::index_sequence<I...>) {
+                // Braced initialisation evaluates the arguments in order
+                const std::array<MolangValue, sizeof...(I)> values{
+                    value<arguments[I]>(frame)...
+                };
+                if (frame.queries == nullptr) {
+                    return MolangValue{};
+                }
+                return frame.queries->query(node.slot, values);
+            }(std::make_index_sequence<node.count>{});
+        }
+
+        template <uint16_t Index> static float math_call(ExecutionFrame& frame) {
+            constexpr auto& node      = tree.nodes[Index];
+            constexpr auto  function  = static_cast<math::MathFunction>(node.operation);
+            constexpr auto  arguments = arguments_of(Index);
+
+            // Missing arguments are passed as 0, extra ones are still evaluated for their
+            // side effects but ignored, like the evaluator does
+            const auto a = [&]<size_t... I>(std::index_sequence<I...>) {
+                const std::array<float, sizeof...(I) + 4> values{
+                    number<arguments[I]>(frame)...
+                };
+                return std::array{values[0], values[1], values[2], values[3]};
+            }(std::make_index_sequence<node.count>{});
+
+            using namespace math;
+            constexpr bool fast = Precision == MathPrecision::Fast;
+
+            if constexpr (is_random_math_function(function)) {
+                RandomStream stream{
+                    frame.entity, node.call_site, frame.random_counter, random_id
+                };
+                float        result{};
+                if constexpr (function == MathFunction::Random) {
+                    result = kernels::random(a[0], a[1], stream.next_unit());
+                } else if constexpr (function == MathFunction::RandomInteger) {
+                    result = kernels::random_integer(a[0], a[1], stream.next_unit());
+                } else if constexpr (function == MathFunction::DieRoll) {
+                    result = kernels::die_roll(a[0], a[1], a[2], stream);
+                } else {
+                    result = kernels::die_roll_integer(a[0], a[1], a[2], stream);
+                }
+                frame.random_counter = stream.get_counter();
+                return result;
+            } else if constexpr (function == MathFunction::Abs) {
+                return kernels::abs(a[0]);
+            } else if constexpr (function == MathFunction::Acos) {
+                return kernels::acos(a[0]);
+            } else if constexpr (function == MathFunction::Asin) {
+                return kernels::asin(a[0]);
+            } else if constexpr (function == MathFunction::Atan) {
+                return kernels::atan(a[0]);
+            } else if constexpr (function == MathFunction::Atan2) {
+                return kernels::atan2(a[0], a[1]);
+            } else if constexpr (function == MathFunction::Ceil) {
+                return kernels::ceil(a[0]);
+            } else if constexpr (function == MathFunction::Clamp) {
+                return kernels::clamp(a[0], a[1], a[2]);
+            } else if constexpr (function == MathFunction::Cos) {
+                return fast ? fast_kernels::cos(a[0]) : kernels::cos(a[0]);
+            } else if constexpr (function == MathFunction::Exp) {
+                return kernels::exp(a[0]);
+            } else if constexpr (function == MathFunction::Floor) {
+                return kernels::floor(a[0]);
+            } else if constexpr (function == MathFunction::HermiteBlend) {
+                return kernels::hermite_blend(a[0]);
+            } else if constexpr (function == MathFunction::Lerp) {
+                return kernels::lerp(a[0], a[1], a[2]);
+            } else if constexpr (function == MathFunction::LerpRotate) {
+                return kernels::lerp_rotate(a[0], a[1], a[2]);
+            } else if constexpr (function == MathFunction::Ln) {
+                return kernels::ln(a[0]);
+            } else if constexpr (function == MathFunction::Max) {
+                return kernels::max(a[0], a[1]);
+            } else if constexpr (function == MathFunction::Min) {
+                return kernels::min(a[0], a[1]);
+            } else if constexpr (function == MathFunction::MinAngle) {
+                return kernels::min_angle(a[0]);
+            } else if constexpr (function == MathFunction::Mod) {
+                return kernels::mod(a[0], a[1]);
+            } else if constexpr (function == MathFunction::Pi) {
+                return kernels::pi();
+            } else if constexpr (function == MathFunction::Pow) {
+                return kernels::pow(a[0], a[1]);
+            } else if constexpr (function == MathFunction::Round) {
+                return kernels::round(a[0]);
+            } else if constexpr (function == MathFunction::Sin) {
+                return fast ? fast_kernels::sin(a[0]) : kernels::sin(a[0]);
+            } else if constexpr (function == MathFunction::Sqrt) {
+                return kernels::sqrt(a[0]);
+            } else {
+                return kernels::trunc(a[0]);
+            }
+        }
+    };
+
+    ///@brief `static_program<"math.sin(q.anim_time * 38) * 2">(frame)` evaluates the
+    /// expression through code generated at C++ compile time, see StaticProgram
+    template <
+        compile_time::FixedString Source,
+        math::MathPrecision       Precision = math::MathPrecision::Exact>
+    constexpr StaticProgram<Source, Precision> static_program{};
+} // namespace molar::exec
+
+#endif // STATIC_PROGRAM_HPP
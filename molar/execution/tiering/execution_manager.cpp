@@ -0,0 +1,106 @@
+//
+// Created by Akashic on 10/19/2026.
+//
+
+#include "execution_manager.hpp"
+
+namespace molar::exec {
+    MolangValue TieredProgram::evaluate(ExecutionFrame& frame) {
+        if (const auto* code = this->native.load(std::memory_order_acquire)) {
+            return code->evaluate(frame);
+        }
+
+        // Counting stops once the program was handed to the compiler, programs the JIT
+        // rejected keep the flag set and stay off any read modify write. Only one thread
+        // evaluates at a time, so the count doesn't need one either
+        if (!this->promotion_requested.load(std::memory_order_relaxed)) {
+            const auto count = this->evaluations.load(std::memory_order_relaxed) + 1;
+            this->evaluations.store(count, std::memory_order_relaxed);
+
+            if (count >= this->manager.promotion_threshold &&
+                !this->promotion_requested.exchange(true, std::memory_order_relaxed) &&
+                !this->manager.try_request_promotion(*this)) {
+                this->promotion_requested.store(false, std::memory_order_relaxed);
+            }
+        }
+        return this->interpreter.evaluate(frame);
+    }
+
+    ExecutionManager::ExecutionManager(
+        const uint64_t promotion_threshold, TypeSignatures signatures
+    )
+        : promotion_threshold(promotion_threshold), signatures(std::move(signatures)),
+          compiler([this] { this->run_compiler(); }) {}
+
+    ExecutionManager::~ExecutionManager() {
+        {
+            std::lock_guard lock{this->queue_lock};
+            this->stopping = true;
+        }
+        this->queue_changed.notify_all();
+        this->compiler.join();
+    }
+
+    TieredProgram& ExecutionManager::add(MolangProgram&& program) {
+        // The constructor is private, so make_unique can't reach it
+        auto entry =
+            std::unique_ptr<TieredProgram>(new TieredProgram{*this, std::move(program)});
+
+        std::lock_guard lock{this->programs_lock};
+        return *this->programs.emplace_back(std::move(entry));
+    }
+
+    void ExecutionManager::wait_for_promotions() {
+        std::unique_lock lock{this->queue_lock};
+        this->queue_changed.wait(lock, [this] {
+            return this->stopping || (this->queue.empty() && this->compiling == 0);
+        });
+    }
+
+    size_t ExecutionManager::get_program_count() const {
+        std::lock_guard lock{this->programs_lock};
+        return this->programs.size();
+    }
+
+    bool ExecutionManager::try_request_promotion(TieredProgram& program) {
+        // The tick thread only ever takes the lock if it's free, the queue is only held
+        // for a push or a pop so the next evaluation will get it
+        std::unique_lock lock{this->queue_lock, std::try_to_lock};
+        if (!lock.owns_lock()) {
+            return false;
+        }
+
+        this->queue.push_back(&program);
+        lock.unlock();
+        this->queue_changed.notify_all();
+        return true;
+    }
+
+    void ExecutionManager::run_compiler() {
+        std::unique_lock lock{this->queue_lock};
+        while (true) {
+            this->queue_changed.wait(lock, [this] {
+                return this->stopping || !this->queue.empty();
+            });
+            if (this->stopping) {
+                return;
+            }
+
+            auto& program = *this->queue.front();
+            this->queue.pop_front();
+            this->compiling++;
+            lock.unlock();
+
+            // Programs the JIT doesn't cover stay on the interpreter for good, they are never
+            // queued again
+            if (auto code = jit::JitProgram::compile(program.program, this->signatures)) {
+                program.compiled = std::make_unique<jit::JitProgram>(std::move(*code));
+                program.native.store(program.compiled.get(), std::memory_order_release);
+            }
+
+            lock.lock();
+            this->compiling--;
+            this->queue_changed.notify_all();
+        }
+    }
+} // namespace molar::exec
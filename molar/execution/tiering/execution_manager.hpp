@@ -0,0 +1,135 @@
+//
+// Created by Akashic on 10/19/2026.
+//
+
+#ifndef EXECUTION_MANAGER_HPP
+#define EXECUTION_MANAGER_HPP
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "execution/jit/jit_program.hpp"
+
+namespace molar::exec {
+    enum class ExecutionTier : uint8_t {
+        // Walked by MolangEvaluator, free to prepare
+        Interpreted,
+        // Compiled to machine code by the JIT
+        Native,
+    };
+
+    class ExecutionManager;
+
+    ///@brief A program owned by an ExecutionManager. It starts on the interpreter and moves
+    /// to native code once it's been evaluated often enough, without the caller noticing.
+    ///
+    /// Like MolangEvaluator, a program is evaluated by one thread at a time
+    class TieredProgram {
+    public:
+        TieredProgram(const TieredProgram&)            = delete;
+        TieredProgram& operator=(const TieredProgram&) = delete;
+
+        ///@brief Same contract as MolangEvaluator::evaluate. Never waits for a promotion, the
+        /// interpreter keeps running the program until the native code is ready
+        MolangValue evaluate(ExecutionFrame& frame);
+
+        [[nodiscard]] ExecutionTier get_tier() const {
+            return this->native.load(std::memory_order_acquire) != nullptr
+                       ? ExecutionTier::Native
+                       : ExecutionTier::Interpreted;
+        }
+
+        ///@brief How often the program was evaluated before it was handed to the compiler
+        [[nodiscard]] uint64_t get_evaluations() const {
+            return this->evaluations.load(std::memory_order_relaxed);
+        }
+
+        [[nodiscard]] MolangProgram& get_program() { return this->program; }
+
+    private:
+        friend class ExecutionManager;
+
+        TieredProgram(ExecutionManager& manager, MolangProgram&& program)
+            : manager(manager), program(std::move(program)), interpreter(this->program) {}
+
+        ExecutionManager& manager;
+        MolangProgram     program;
+        MolangEvaluator   interpreter;
+
+        // promotion_requested is set once the program was handed to the compiler thread,
+        // whatever came out of it. compiled is written by the compiler thread before native
+        // publishes it and never touched after
+        std::atomic<uint64_t>               evaluations{0};
+        std::atomic<bool>                   promotion_requested{false};
+        std::unique_ptr<jit::JitProgram>    compiled{};
+        std::atomic<const jit::JitProgram*> native{nullptr};
+    };
+
+    ///@brief Owns programs and promotes the ones which run often. Most programs of a pack run
+    /// rarely and stay on the interpreter, which costs nothing to prepare, while the few
+    /// which dominate a tick are compiled to native code on a background thread.
+    ///
+    /// Programs live as long as the manager, so the compiler thread never reads a program
+    /// which is gone
+    class ExecutionManager {
+    public:
+        static constexpr uint64_t default_promotion_threshold = 1000;
+
+        ///@brief A program is promoted once it was evaluated `promotion_threshold` times.
+        /// The signatures are what the host promises about its queries and variables, see
+        /// JitProgram::compile
+        explicit ExecutionManager(
+            uint64_t promotion_threshold = default_promotion_threshold,
+            TypeSignatures signatures = {}
+        );
+
+        ExecutionManager(const ExecutionManager&)            = delete;
+        ExecutionManager& operator=(const ExecutionManager&) = delete;
+
+        ///@brief Stops the compiler thread, promotions which didn't start yet are dropped
+        ~ExecutionManager();
+
+        ///@brief Takes ownership of the program, the reference stays valid as long as the
+        /// manager does
+        TieredProgram& add(MolangProgram&& program);
+
+        ///@brief Blocks until every requested promotion finished. Meant for tools and warm up,
+        /// a tick should never call it
+        void wait_for_promotions();
+
+        [[nodiscard]] uint64_t get_promotion_threshold() const {
+            return this->promotion_threshold;
+        }
+
+        [[nodiscard]] size_t get_program_count() const;
+
+    private:
+        friend class TieredProgram;
+
+        ///@brief Queues the program for the compiler thread, false if the queue is busy and
+        /// the caller should try again on a later evaluation
+        bool try_request_promotion(TieredProgram& program);
+
+        void run_compiler();
+
+        const uint64_t       promotion_threshold;
+        const TypeSignatures signatures;
+
+        mutable std::mutex                         programs_lock{};
+        std::deque<std::unique_ptr<TieredProgram>> programs{};
+
+        std::mutex                 queue_lock{};
+        std::condition_variable    queue_changed{};
+        std::deque<TieredProgram*> queue{};
+        size_t                     compiling{0};
+        bool                       stopping{false};
+
+        // Last so it starts after everything it reads exists
+        std::thread compiler{};
+    };
+} // namespace molar::exec
+
+#endif // EXECUTION_MANAGER_HPP
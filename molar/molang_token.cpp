@@ -4,38 +4,6 @@
 #include "molang_token.hpp"
 
 namespace molar {
-    // Stolen from Nolana
-    std::optional<std::pair<uint8_t, uint8_t>> token_bind_power(const TokenType type) {
-        switch (type) {
-        case TokenType::Not:
-            return std::pair(16, 17);
-        case TokenType::Star:
-        case TokenType::Slash:
-            return std::pair(14, 15);
-        case TokenType::Plus:
-        case TokenType::Minus:
-            return std::pair(12, 13);
-        case TokenType::Lt:
-        case TokenType::Gt:
-        case TokenType::LtEq:
-        case TokenType::GtEq:
-            return std::pair(10, 11);
-        case TokenType::Eq:
-        case TokenType::NotEq:
-            return std::pair(8, 9);
-        case TokenType::And:
-            return std::pair(6, 7);
-        case TokenType::Or:
-            return std::pair(4, 5);
-        case TokenType::Conditional:
-            return std::pair(3, 4);
-        case TokenType::NullCoal:
-            return std::pair(1, 2);
-        default:
-            return std::nullopt;
-        }
-    }
-
     std::string to_string(const TokenType type) {
         switch (type) {
         case TokenType::Eof:
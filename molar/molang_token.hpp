@@ -7,6 +7,7 @@
 #include <array>
 #include <cassert>
 #include <cstdint>
+#include <optional>
 #include <string>
 #include <string_view>
 #include <vector>
@@ -206,7 +207,38 @@ namespace molar {
         Texture  = TokenType::Texture,
     };
 
-    std::optional<std::pair<uint8_t, uint8_t>> token_bind_power(TokenType type);
+    // Stolen from Nolana
+    constexpr std::optional<std::pair<uint8_t, uint8_t>>
+    token_bind_power(const TokenType type) {
+        switch (type) {
+        case TokenType::Not:
+            return std::pair(16, 17);
+        case TokenType::Star:
+        case TokenType::Slash:
+            return std::pair(14, 15);
+        case TokenType::Plus:
+        case TokenType::Minus:
+            return std::pair(12, 13);
+        case TokenType::Lt:
+        case TokenType::Gt:
+        case TokenType::LtEq:
+        case TokenType::GtEq:
+            return std::pair(10, 11);
+        case TokenType::Eq:
+        case TokenType::NotEq:
+            return std::pair(8, 9);
+        case TokenType::And:
+            return std::pair(6, 7);
+        case TokenType::Or:
+            return std::pair(4, 5);
+        case TokenType::Conditional:
+            return std::pair(3, 4);
+        case TokenType::NullCoal:
+            return std::pair(1, 2);
+        default:
+            return std::nullopt;
+        }
+    }
 
     constexpr auto tokens_which_could_be_names = std::array{
         TokenType::Math,     TokenType::Query,      TokenType::Variable, TokenType::Geometry,
@@ -9,69 +9,10 @@
 #include <format>
 #include <ostream>
 
+#include "internal/token_tables.hpp"
 #include "molang_error.hpp"
 
 namespace molar {
-    constexpr auto simple_tokens = std::array{
-        std::pair{TokenType::LeftParen, '('},   std::pair{TokenType::RightParen, ')'},
-        std::pair{TokenType::LeftBrace, '{'},   std::pair{TokenType::RightBrace, '}'},
-        std::pair{TokenType::LeftBracket, '['}, std::pair{TokenType::RightBracket, ']'},
-        std::pair{TokenType::Assign, '='},      std::pair{TokenType::Not, '!'},
-        std::pair{TokenType::Lt, '<'},          std::pair{TokenType::Gt, '>'},
-        std::pair{TokenType::Dot, '.'},         std::pair{TokenType::Conditional, '?'},
-        std::pair{TokenType::Colon, ':'},       std::pair{TokenType::Semi, ';'},
-        std::pair{TokenType::Comma, ','},       std::pair{TokenType::Minus, '-'},
-        std::pair{TokenType::Plus, '+'},        std::pair{TokenType::Star, '*'},
-        std::pair{TokenType::Slash, '/'}
-    };
-
-    constexpr auto single_char_complex = std::array{
-        std::pair{TokenType::Query, 'q'},   std::pair{TokenType::Variable, 'v'},
-        std::pair{TokenType::Context, 'c'}, std::pair{TokenType::Temporary, 't'},
-        std::pair{TokenType::Math, 'm'},
-    };
-
-    constexpr auto skip = std::array{
-        std::string_view{" "},
-        std::string_view{"\r\n"},
-        std::string_view{"\n"},
-        std::string_view{"\t"},
-    };
-
-    constexpr auto multi_char_tokens =
-        std::array{// Multi-char symbolic operators
-                   std::pair{TokenType::Eq, std::string_view{"=="}},
-                   std::pair{TokenType::NotEq, std::string_view{"!="}},
-                   std::pair{TokenType::LtEq, std::string_view{"<="}},
-                   std::pair{TokenType::GtEq, std::string_view{">="}},
-                   std::pair{TokenType::Or, std::string_view{"||"}},
-                   std::pair{TokenType::And, std::string_view{"&&"}},
-                   std::pair{TokenType::Arrow, std::string_view{"->"}},
-                   std::pair{TokenType::NullCoal, std::string_view{"??"}},
-
-                   // Keywords (unambiguous)
-                   std::pair{TokenType::True, std::string_view{"true"}},
-                   std::pair{TokenType::False, std::string_view{"false"}},
-                   std::pair{TokenType::This, std::string_view{"this"}},
-                   std::pair{TokenType::Break, std::string_view{"break"}},
-                   std::pair{TokenType::Continue, std::string_view{"continue"}},
-                   std::pair{TokenType::ForEach, std::string_view{"for_each"}},
-                   std::pair{TokenType::Loop, std::string_view{"loop"}},
-                   std::pair{TokenType::Return, std::string_view{"return"}},
-                   std::pair{TokenType::Temporary, std::string_view{"temp"}},
-                   std::pair{TokenType::Context, std::string_view{"context"}}
-        };
-
-    constexpr auto case_insensitive_tokens = std::array{
-        std::pair{TokenType::Math, std::string_view{"math"}},
-        std::pair{TokenType::Query, std::string_view{"query"}},
-        std::pair{TokenType::Variable, std::string_view{"variable"}},
-        std::pair{TokenType::Geometry, std::string_view{"geometry"}},
-        std::pair{TokenType::Material, std::string_view{"material"}},
-        std::pair{TokenType::Texture, std::string_view{"texture"}},
-        std::pair{TokenType::Array, std::string_view{"array"}}
-    };
-
     std::optional<Token> MolangTokenizer::parse_identifier() {
         try {
             const auto restore    = this->buffer.get_rollback_point();
@@ -194,7 +135,7 @@ namespace molar {
         std::vector<Token> tokens{};
 
         while (this->buffer.has_any()) {
-            for (const auto text : skip) {
+            for (const auto text : details::skip) {
                 if (const auto token_start = this->buffer.next(text); token_start.has_value()) {
                     goto end;
                 }
@@ -205,7 +146,7 @@ namespace molar {
                 goto end;
             }
 
-            for (const auto [token, text] : case_insensitive_tokens) {
+            for (const auto [token, text] : details::case_insensitive_tokens) {
                 if (const auto token_start = this->buffer.caseless_next(text);
                     token_start.has_value()) {
                     tokens.emplace_back(token_start.value(), text, token);
@@ -213,7 +154,7 @@ namespace molar {
                 }
             }
 
-            for (const auto [token, text] : multi_char_tokens) {
+            for (const auto [token, text] : details::multi_char_tokens) {
                 if (const auto token_start = this->buffer.next(text); token_start.has_value()) {
                     tokens.emplace_back(token_start.value(), text, token);
                     goto end;
@@ -225,7 +166,7 @@ namespace molar {
                 goto end;
             }
 
-            for (const auto [token, text] : simple_tokens) {
+            for (const auto [token, text] : details::simple_tokens) {
                 if (const auto token_start = this->buffer.next(text); token_start.has_value()) {
                     tokens.emplace_back(token_start.value(), token);
                     goto end;
@@ -237,7 +178,7 @@ namespace molar {
                 goto end;
             }
 
-            for (const auto [token, text] : single_char_complex) {
+            for (const auto [token, text] : details::single_char_complex) {
                 if (const auto token_start = this->buffer.next(text); token_start.has_value()) {
                     tokens.emplace_back(token_start.value(), token);
                     goto end;
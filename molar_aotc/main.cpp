@@ -0,0 +1,220 @@
+//
+// Created by Akashic on 10/19/2026.
+//
+
+#include <algorithm>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "execution/aot/cpp_emitter.hpp"
+
+// Compiles a corpus of Molang programs into a C++ header and source, every program becomes a
+// plain function over an ExecutionFrame. Each line of the corpus is the name of the function
+// followed by the program, blank lines and lines starting with `#` are skipped:
+//
+//     walk_bob math.sin(q.anim_time * 38) * 2
+//
+// Usage: molar_aotc <corpus> <output stem> [--namespace name] [--fast]
+
+namespace {
+    struct Options {
+        std::filesystem::path corpus{};
+        std::filesystem::path output{};
+        std::string           name_space{"molar_aot"};
+        bool                  fast{false};
+    };
+
+    struct Entry {
+        std::string name{};
+        std::string source{};
+        size_t      line{};
+    };
+
+    bool is_identifier(const std::string_view name) {
+        const auto is_start = [](const char c) {
+            return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_';
+        };
+        return !name.empty() && is_start(name.front()) &&
+               std::ranges::all_of(name, [&](const char c) {
+                   return is_start(c) || (c >= '0' && c <= '9');
+               });
+    }
+
+    std::vector<Entry> read_corpus(const std::filesystem::path& path) {
+        std::ifstream stream(path);
+        if (!stream) {
+            throw std::runtime_error(std::format("Can't open {}", path.string()));
+        }
+
+        std::vector<Entry>    entries{};
+        std::set<std::string> names{};
+        std::string           text{};
+        for (size_t line = 1; std::getline(stream, text); line++) {
+            if (text.ends_with('\r')) {
+                text.pop_back();
+            }
+
+            const auto start = text.find_first_not_of(" \t");
+            if (start == std::string::npos || text[start] == '#') {
+                continue;
+            }
+
+            const auto name_end = text.find_first_of(" \t", start);
+            auto       name     = text.substr(start, name_end - start);
+            const auto source_start = name_end == std::string::npos
+                                          ? name_end
+                                          : text.find_first_not_of(" \t", name_end);
+
+            if (!is_identifier(name) || source_start == std::string::npos) {
+                throw std::runtime_error(std::format(
+                    "{}:{}: expected a function name followed by a program", path.string(), line
+                ));
+            }
+            if (!names.insert(name).second) {
+                throw std::runtime_error(
+                    std::format("{}:{}: {} is defined twice", path.string(), line, name)
+                );
+            }
+            entries.push_back({std::move(name), text.substr(source_start), line});
+        }
+        return entries;
+    }
+
+    std::string indented(const std::string_view text) {
+        std::string result{};
+        size_t      start = 0;
+        while (start < text.size()) {
+            const auto end  = std::min(text.find('\n', start), text.size());
+            const auto line = text.substr(start, end - start);
+            if (!line.empty()) {
+                result += "    ";
+            }
+            result += line;
+            result += '\n';
+            start = end + 1;
+        }
+        return result;
+    }
+
+    void write_file(const std::filesystem::path& path, const std::string_view content) {
+        // Only touch the file if it changed, so an unchanged corpus doesn't rebuild the host
+        if (std::ifstream existing(path, std::ios::binary); existing) {
+            const std::string current{
+                std::istreambuf_iterator<char>(existing), std::istreambuf_iterator<char>()
+            };
+            if (current == content) {
+                return;
+            }
+        }
+
+        std::ofstream stream(path, std::ios::binary | std::ios::trunc);
+        stream << content;
+        if (!stream) {
+            throw std::runtime_error(std::format("Can't write {}", path.string()));
+        }
+    }
+
+    void compile(const Options& options) {
+        const auto entries   = read_corpus(options.corpus);
+        const auto precision = options.fast ? molar::exec::math::MathPrecision::Fast
+                                            : molar::exec::math::MathPrecision::Exact;
+        const auto stem      = options.output.filename().string();
+        const auto banner    = std::format(
+            "// Generated by molar_aotc from {}, do not edit\n",
+            options.corpus.filename().string()
+        );
+
+        std::string declarations{};
+        std::string definitions{};
+        std::string table{};
+        for (const auto& entry : entries) {
+            try {
+                auto program = molar::exec::MolangProgram::compile(
+                    entry.source, molar::exec::StringPool::shared(), precision
+                );
+                molar::exec::aot::CppEmitter emitter{program};
+                definitions += indented(emitter.emit(entry.name, entry.source)) + "\n";
+            } catch (const std::exception& error) {
+                throw std::runtime_error(std::format(
+                    "{}:{}: {}: {}", options.corpus.string(), entry.line, entry.name,
+                    error.what()
+                ));
+            }
+
+            declarations += std::format(
+                "    molar::exec::MolangValue {}(molar::exec::ExecutionFrame& frame);\n",
+                entry.name
+            );
+            table += std::format("{}{}_program", table.empty() ? "" : ", ", entry.name);
+        }
+
+        auto guard = std::format("MOLAR_AOT_{}_HPP", stem);
+        std::ranges::transform(guard, guard.begin(), [](const char c) {
+            return (c >= 'a' && c <= 'z') ? static_cast<char>(c - 'a' + 'A')
+                   : (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') ? c
+                                                                     : '_';
+        });
+
+        write_file(
+            std::filesystem::path(options.output) += ".hpp",
+            std::format(
+                "{0}\n#ifndef {1}\n#define {1}\n#include <span>\n\n"
+                "#include \"execution/aot/aot_program.hpp\"\n\n"
+                "namespace {2} {{\n{3}\n"
+                "    ///@brief Every program of the corpus, see molar::exec::find_aot_program\n"
+                "    std::span<const molar::exec::AotProgram> programs();\n"
+                "}} // namespace {2}\n\n#endif // {1}\n",
+                banner, guard, options.name_space, declarations
+            )
+        );
+
+        write_file(
+            std::filesystem::path(options.output) += ".cpp",
+            std::format(
+                "{0}\n#include \"{1}.hpp\"\n\n#include <array>\n#include <cstdint>\n"
+                "#include <limits>\n#include <span>\n#include <string_view>\n\n"
+                "#include \"execution/math/molang_math_fast.hpp\"\n\n"
+                "namespace {2} {{\n    using namespace molar::exec;\n\n{3}"
+                "    constexpr std::array<AotProgram, {4}> program_table{{{5}}};\n\n"
+                "    std::span<const AotProgram> programs() {{ return program_table; }}\n"
+                "}} // namespace {2}\n",
+                banner, stem, options.name_space, definitions, entries.size(), table
+            )
+        );
+    }
+} // namespace
+
+int main(const int argc, char** argv) {
+    Options                  options{};
+    std::vector<std::string> positional{};
+    for (int i = 1; i < argc; i++) {
+        const std::string_view argument = argv[i];
+        if (argument == "--fast") {
+            options.fast = true;
+        } else if (argument == "--namespace" && i + 1 < argc) {
+            options.name_space = argv[++i];
+        } else {
+            positional.emplace_back(argument);
+        }
+    }
+
+    if (positional.size() != 2) {
+        std::cerr << "Usage: molar_aotc <corpus> <output stem> [--namespace name] [--fast]\n";
+        return 2;
+    }
+    options.corpus = positional[0];
+    options.output = positional[1];
+
+    try {
+        compile(options);
+    } catch (const std::exception& error) {
+        std::cerr << "molar_aotc: " << error.what() << '\n';
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,147 @@
+//
+// Created by Akashic on 10/19/2026.
+//
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cmath>
+#include <format>
+#include <iostream>
+#include <vector>
+
+#include "execution/math/molang_math.hpp"
+
+using namespace molar::exec::math;
+
+struct BenchCase {
+    MathFunction function;
+    // Inputs are drawn uniformly from [low, high] for every argument
+    float        low;
+    float        high;
+    // Relative error is used above this magnitude, absolute below
+    double       relative_above;
+};
+
+constexpr size_t sample_count   = 1 << 16;
+constexpr size_t repeats        = 64;
+// Every sample gets a full argument array, like the callers pass, see ScalarMathFn
+constexpr size_t argument_count = 4;
+
+std::vector<float> make_inputs(const BenchCase& bench) {
+    std::vector<float> inputs(sample_count * argument_count);
+    RandomStream       stream{0x5EED};
+
+    for (auto& input : inputs) {
+        input = bench.low + (bench.high - bench.low) * stream.next_unit();
+    }
+    return inputs;
+}
+
+// Returns evaluations per second
+double time_scalar(const MathFunctionInfo& info, const std::vector<float>& inputs) {
+    RandomStream stream{};
+    float        sink = 0.0f;
+
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t repeat = 0; repeat < repeats; repeat++) {
+        for (size_t i = 0; i < sample_count; i++) {
+            sink += info.scalar(&inputs[i * argument_count], stream);
+        }
+    }
+    const auto end = std::chrono::steady_clock::now();
+
+    // Keeps the loop from being removed
+    if (sink == 1.2345f) std::cout << "";
+
+    return static_cast<double>(sample_count * repeats) /
+           std::chrono::duration<double>(end - start).count();
+}
+
+template <size_t Width>
+double time_wide(WideMathFn<Width> function, const std::vector<float>& inputs) {
+    std::vector<FloatLanes<Width>> lanes(sample_count / Width * argument_count);
+    for (size_t group = 0; group < sample_count / Width; group++) {
+        for (size_t argument = 0; argument < argument_count; argument++) {
+            for (size_t lane = 0; lane < Width; lane++) {
+                lanes[group * argument_count + argument][lane] =
+                    inputs[(group * Width + lane) * argument_count + argument];
+            }
+        }
+    }
+
+    RandomLanes<Width> streams{};
+    FloatLanes<Width>  sink{};
+
+    const auto start = std::chrono::steady_clock::now();
+    for (size_t repeat = 0; repeat < repeats; repeat++) {
+        for (size_t group = 0; group < sample_count / Width; group++) {
+            sink = sink + function(&lanes[group * argument_count], streams);
+        }
+    }
+    const auto end = std::chrono::steady_clock::now();
+
+    if (sink[0] == 1.2345f) std::cout << "";
+
+    return static_cast<double>(sample_count * repeats) /
+           std::chrono::duration<double>(end - start).count();
+}
+
+double max_error(const BenchCase& bench, const std::vector<float>& inputs) {
+    const auto&  exact          = get_math_function(bench.function, MathPrecision::Exact);
+    const auto&  fast           = get_math_function(bench.function, MathPrecision::Fast);
+    RandomStream stream{};
+    double       error = 0.0;
+
+    for (size_t i = 0; i < sample_count; i++) {
+        const double expected = exact.scalar(&inputs[i * argument_count], stream);
+        const double actual   = fast.scalar(&inputs[i * argument_count], stream);
+
+        if (!std::isfinite(expected)) {
+            continue;
+        }
+
+        const double difference = std::abs(actual - expected);
+        const bool   relative   = std::abs(expected) > bench.relative_above;
+
+        error = std::max(error, relative ? difference / std::abs(expected) : difference);
+    }
+    return error;
+}
+
+int main() {
+    constexpr auto cases = std::array{
+        BenchCase{MathFunction::Sin, -3600.0f, 3600.0f, 2.0},
+        BenchCase{MathFunction::Cos, -3600.0f, 3600.0f, 2.0},
+        BenchCase{MathFunction::Sqrt, 0.0f, 10000.0f, 0.0},
+        BenchCase{MathFunction::Exp, -20.0f, 20.0f, 0.0},
+        BenchCase{MathFunction::Ln, 0.001f, 10000.0f, 1.0},
+        BenchCase{MathFunction::Pow, 0.01f, 8.0f, 0.0},
+    };
+
+    std::cout << std::format(
+        "{:<6}{:>10}{:>10}{:>10}{:>10}{:>10}{:>10}{:>12}\n", "func", "exact x1", "fast x1",
+        "exact x4", "fast x4", "exact x8", "fast x8", "max error"
+    );
+    std::cout << "(million evaluations per second, error is relative unless noted)\n";
+
+    for (const auto& bench : cases) {
+        const auto& exact  = get_math_function(bench.function, MathPrecision::Exact);
+        const auto& fast   = get_math_function(bench.function, MathPrecision::Fast);
+        const auto  inputs = make_inputs(bench);
+
+        const auto rate = [](const double value) { return value / 1e6; };
+
+        std::cout << std::format(
+            "{:<6}{:>10.1f}{:>10.1f}{:>10.1f}{:>10.1f}{:>10.1f}{:>10.1f}{:>12.2e}{}\n",
+            exact.name, rate(time_scalar(exact, inputs)), rate(time_scalar(fast, inputs)),
+            rate(time_wide<4>(exact.wide_4, inputs)),
+            rate(time_wide<4>(fast.wide_4, inputs)),
+            rate(time_wide<8>(exact.wide_8, inputs)),
+            rate(time_wide<8>(fast.wide_8, inputs)), max_error(bench, inputs),
+            bench.relative_above > 0.0
+                ? std::format(" (absolute below {})", bench.relative_above)
+                : std::string{}
+        );
+    }
+}
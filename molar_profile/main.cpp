@@ -0,0 +1,225 @@
+//
+// Created by Akashic on 10/19/2026.
+//
+
+#include <algorithm>
+#include <charconv>
+#include <filesystem>
+#include <format>
+#include <fstream>
+#include <iostream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "execution/passes/pass_manager.hpp"
+#include "execution/passes/superinstructions.hpp"
+#include "execution/runtime/molang_evaluator.hpp"
+
+// Runs a corpus of Molang programs through a counting interpreter and ranks the node shapes
+// by the dispatches a superinstruction for them would save, then fuses the corpus with
+// Superinstructions and reports the dispatches per evaluation before and after. Programs are
+// compiled at O1. Each line of the corpus is a program, blank lines and lines starting with
+// `#` are skipped. The molar_aotc corpus format, a name followed by the program, works too:
+//
+//     walk_bob math.sin(q.anim_time * 38) * 2
+//
+// Usage: molar_profile <corpus> [--evaluations n] [--top n]
+
+namespace {
+    using molar::exec::ast::Superinstruction;
+
+    struct Options {
+        std::filesystem::path corpus{};
+        uint64_t              evaluations{64};
+        size_t                top{20};
+    };
+
+    ///@brief Answers queries with small numbers which change between evaluations, so both
+    /// sides of a branch on a query get to run
+    class CorpusQueries final : public molar::exec::QueryHandler {
+    public:
+        molar::exec::MolangValue
+        query(const uint32_t call_id, std::span<const molar::exec::MolangValue>) override {
+            return static_cast<float>((this->evaluation + call_id) % 8);
+        }
+
+        uint64_t evaluation{0};
+    };
+
+    ///@brief Whether the first word of a line is the function name of the molar_aotc
+    /// format. Molang words without a `.` are keywords, anything else is a name
+    bool is_name(const std::string_view word) {
+        constexpr std::string_view keywords[] = {
+            "return", "loop", "for_each", "break", "continue", "this", "true", "false",
+        };
+        const auto is_start = [](const char c) {
+            return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || c == '_';
+        };
+        return !word.empty() && is_start(word.front()) &&
+               std::ranges::all_of(word, [&](const char c) {
+                   return is_start(c) || (c >= '0' && c <= '9');
+               }) &&
+               std::ranges::find(keywords, word) == std::end(keywords);
+    }
+
+    std::vector<std::string> read_corpus(const std::filesystem::path& path) {
+        std::ifstream stream(path);
+        if (!stream) {
+            throw std::runtime_error(std::format("Can't open {}", path.string()));
+        }
+
+        std::vector<std::string> sources{};
+        std::string              text{};
+        while (std::getline(stream, text)) {
+            if (text.ends_with('\r')) {
+                text.pop_back();
+            }
+
+            auto start = text.find_first_not_of(" \t");
+            if (start == std::string::npos || text[start] == '#') {
+                continue;
+            }
+
+            const auto word_end = text.find_first_of(" \t", start);
+            if (word_end != std::string::npos &&
+                is_name(std::string_view{text}.substr(start, word_end - start))) {
+                start = text.find_first_not_of(" \t", word_end);
+            }
+            if (start != std::string::npos) {
+                sources.push_back(text.substr(start));
+            }
+        }
+        return sources;
+    }
+
+    molar::exec::MolangProgram compile(const std::string& source) {
+        const auto manager =
+            molar::exec::PassManager::for_level(molar::exec::OptimizationLevel::O1);
+        std::vector<molar::exec::PassRecord> records{};
+        return manager.compile(source, records);
+    }
+
+    void evaluate(
+        molar::exec::MolangProgram& program, const uint64_t evaluations,
+        molar::exec::DispatchProfile& profile
+    ) {
+        std::vector<molar::exec::MolangValue> variables(program.get_variable_slot_count());
+        std::vector<molar::exec::MolangValue> temps(program.get_temp_slot_count());
+        CorpusQueries                         queries{};
+
+        molar::exec::ExecutionFrame frame{
+            .variables = variables, .temps = temps, .queries = &queries
+        };
+
+        molar::exec::MolangEvaluator evaluator{program};
+        evaluator.set_profile(&profile);
+        for (uint64_t i = 0; i < evaluations; i++) {
+            queries.evaluation = i;
+            frame.entity       = i;
+            (void)evaluator.evaluate(frame);
+        }
+    }
+
+    std::string_view instruction_name(const Superinstruction instruction) {
+        switch (instruction) {
+        case Superinstruction::SlotOpConst:
+            return "SlotOpConst";
+        case Superinstruction::SlotOpSlot:
+            return "SlotOpSlot";
+        case Superinstruction::SlotConstChain:
+            return "SlotConstChain";
+        case Superinstruction::CallOpConst:
+            return "CallOpConst";
+        case Superinstruction::CompareSelect:
+            return "CompareSelect";
+        case Superinstruction::MathChain:
+            return "MathChain";
+        default:
+            return "?";
+        }
+    }
+
+    void profile(const Options& options) {
+        molar::exec::PatternProfile  patterns{};
+        molar::exec::DispatchProfile after{};
+        uint64_t                     dispatches = 0;
+        size_t                       fused      = 0;
+
+        const auto sources = read_corpus(options.corpus);
+        for (size_t i = 0; i < sources.size(); i++) {
+            try {
+                auto program = compile(sources[i]);
+
+                molar::exec::DispatchProfile counts{};
+                evaluate(program, options.evaluations, counts);
+                patterns.add(program, counts);
+                dispatches += counts.get_dispatches();
+
+                fused += molar::exec::Superinstructions::fuse(program);
+                evaluate(program, options.evaluations, after);
+            } catch (const std::exception& error) {
+                throw std::runtime_error(std::format(
+                    "{}: program {}: {}", options.corpus.string(), i + 1, error.what()
+                ));
+            }
+        }
+
+        std::cout << std::format(
+            "{} programs, dispatches per evaluation {:.2f} -> {:.2f}, {} nodes fused\n\n",
+            sources.size(),
+            after.get_evaluations() == 0
+                ? 0.0
+                : static_cast<double>(dispatches) / static_cast<double>(after.get_evaluations()),
+            after.get_dispatches_per_evaluation(), fused
+        );
+        std::cout << std::format(
+            "{:>12} {:>12}  {:<16} {}\n", "saved", "executions", "fused as", "pattern"
+        );
+        for (const auto& candidate : patterns.ranked(options.top)) {
+            std::cout << std::format(
+                "{:>12} {:>12}  {:<16} {}\n", candidate.saved, candidate.executions,
+                candidate.covered_by ? instruction_name(*candidate.covered_by) : "-",
+                candidate.pattern
+            );
+        }
+    }
+
+    bool parse_count(const std::string_view text, uint64_t& value) {
+        const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+        return error == std::errc{} && end == text.data() + text.size() && value > 0;
+    }
+} // namespace
+
+int main(const int argc, char** argv) {
+    Options                  options{};
+    std::vector<std::string> positional{};
+    bool                     valid = true;
+    for (int i = 1; i < argc; i++) {
+        const std::string_view argument = argv[i];
+        uint64_t               count    = 0;
+        if (argument == "--evaluations" && i + 1 < argc) {
+            valid               = valid && parse_count(argv[++i], count);
+            options.evaluations = count;
+        } else if (argument == "--top" && i + 1 < argc) {
+            valid       = valid && parse_count(argv[++i], count);
+            options.top = static_cast<size_t>(count);
+        } else {
+            positional.emplace_back(argument);
+        }
+    }
+
+    if (!valid || positional.size() != 1) {
+        std::cerr << "Usage: molar_profile <corpus> [--evaluations n] [--top n]\n";
+        return 2;
+    }
+    options.corpus = positional[0];
+
+    try {
+        profile(options);
+    } catch (const std::exception& error) {
+        std::cerr << "molar_profile: " << error.what() << '\n';
+        return 1;
+    }
+    return 0;
+}
@@ -3,14 +3,49 @@
 //
 
 #include <array>
+#include <bit>
+#include <filesystem>
 #include <iostream>
+#include <limits>
 #include <print>
+#include <stdexcept>
+#include <vector>
 
+#include "ast/keyword.hpp"
 #include "ast/variable.hpp"
+#include "execution/analysis/definite_assignment.hpp"
+#include "execution/analysis/type_inference.hpp"
+#include "execution/analysis/uniformity.hpp"
+#include "execution/animation/channel_program.hpp"
+#include "execution/animation/transition_program.hpp"
+#include "execution/aot/cpp_emitter.hpp"
+#include "execution/jit/jit_program.hpp"
+#include "execution/math/molang_math.hpp"
+#include "execution/math/molang_math_fast.hpp"
+#include "execution/passes/dead_code.hpp"
+#include "execution/passes/if_conversion.hpp"
+#include "execution/passes/loop_optimizer.hpp"
+#include "execution/passes/pass_manager.hpp"
+#include "execution/passes/rewrite_engine.hpp"
+#include "execution/passes/specializer.hpp"
+#include "execution/passes/stage_splitter.hpp"
+#include "execution/passes/superinstructions.hpp"
+#include "execution/passes/uniform_splitter.hpp"
 #include "execution/preprocessor/molang_preprocessor.hpp"
+#include "execution/runtime/molang_evaluator.hpp"
+#include "execution/runtime/particle_pool.hpp"
+#include "execution/runtime/program_binary.hpp"
+#include "execution/runtime/program_cache.hpp"
+#include "execution/static/static_program.hpp"
+#include "execution/tiering/execution_manager.hpp"
+#include "internal/checked_down_cast.hpp"
 #include "molang_ast_generator.hpp"
 #include "molang_tokenizer.hpp"
 
+#ifdef MOLAR_TEST_AOT
+#include "aot_corpus.hpp"
+#endif
+
 void simple_token() {
     constexpr auto expressions =
         std::array{"==", "m.sin(v.x + v.z * q.pos())", "v.our_id == 'some_string :3'"};
@@ -77,7 +112,8 @@ void execution_tree_builder() {
                                "t.speed / (v.mass + 0.1) + "
                                "temp.counter * 4 - v.xtra * "
                                "v.a + v.b * "
-                               "v.location.x + v.location.y + v.location.z"
+                               "v.location.x + v.location.y + v.location.z",
+        "v.our_id == 'some_string :3';"
     };
 
     for (const auto expression : expressions) {
@@ -100,4 +136,785 @@ void execution_tree_builder() {
     }
 }
 
-int main() { execution_tree_builder(); }
+class PlayerQueries final : public molar::exec::QueryHandler {
+public:
+    molar::exec::MolangValue
+    query(uint32_t call_id, std::span<const molar::exec::MolangValue> arguments) override {
+        return {};
+    }
+
+    molar::exec::MolangArray query_array(
+        const uint32_t call_id, const std::span<const molar::exec::MolangValue> arguments
+    ) override {
+        return std::span<const molar::exec::EntityHandle>{this->players};
+    }
+
+private:
+    std::array<molar::exec::EntityHandle, 3> players{{{1}, {2}, {3}}};
+};
+
+void evaluate_for_each() {
+    auto program = molar::exec::MolangProgram::compile(
+        "t.count = 0; for_each(t.player, q.players(), {t.count = t.count + 1;}); "
+        "return t.count;"
+    );
+
+    std::vector<molar::exec::MolangValue> variables(program.get_variable_slot_count());
+    std::vector<molar::exec::MolangValue> temps(program.get_temp_slot_count());
+    PlayerQueries                         queries{};
+
+    molar::exec::ExecutionFrame frame{
+        .variables = variables, .temps = temps, .queries = &queries
+    };
+    molar::exec::MolangEvaluator evaluator{program};
+
+    std::cout << evaluator.evaluate(frame).as_number() << std::endl;
+}
+
+void load_program_binary() {
+    auto compiled = molar::exec::MolangProgram::compile("v.speed = 4; return v.speed * 2;");
+    const auto bytes = molar::exec::ProgramBinary::serialize(compiled);
+
+    auto program = molar::exec::ProgramBinary::deserialize(bytes);
+
+    std::vector<molar::exec::MolangValue> variables(program.get_variable_slot_count());
+    molar::exec::ExecutionFrame           frame{.variables = variables};
+    molar::exec::MolangEvaluator          evaluator{program};
+
+    std::cout << bytes.size() << " bytes: " << evaluator.evaluate(frame).as_number()
+              << std::endl;
+}
+
+void load_cached_program() {
+    constexpr auto source = "v.x = 'a'; v.y = 'b';";
+
+    // A private pool whose indices differ from the shared one
+    molar::exec::StringPool string_pool{};
+    string_pool.intern("b");
+
+    molar::exec::ProgramCache cache{std::filesystem::temp_directory_path() / "molar_cache"};
+    std::filesystem::remove(cache.entry_path(source, molar::exec::math::MathPrecision::Exact));
+    (void)cache.load_or_compile(source, string_pool);
+    auto program = cache.load_or_compile(source, string_pool);
+
+    std::vector<molar::exec::MolangValue> variables(program.get_variable_slot_count());
+    molar::exec::ExecutionFrame           frame{.variables = variables};
+    molar::exec::MolangEvaluator          evaluator{program};
+    (void)evaluator.evaluate(frame);
+
+    // Expected: x=a y=b
+    for (const auto* name : {"x", "y"}) {
+        const auto slot =
+            *program.find_variable_slot(molar::ast::VariableDeclarationType::Var, name);
+        std::cout << name << "=" << string_pool.resolve(variables[slot].as_string()) << " ";
+    }
+    std::cout << cache.get_hits() << " hit" << std::endl;
+}
+
+void compare_across_pools() {
+    molar::exec::StringPool string_pool{};
+    string_pool.intern("b");
+
+    auto       program = molar::exec::MolangProgram::compile("v.x = 'a';", string_pool);
+    const auto slot =
+        *program.find_variable_slot(molar::ast::VariableDeclarationType::Var, "x");
+
+    std::vector<molar::exec::MolangValue> variables(program.get_variable_slot_count());
+    molar::exec::ExecutionFrame           frame{.variables = variables};
+    (void)molar::exec::MolangEvaluator{program}.evaluate(frame);
+
+    // Expected: 1 0
+    auto& shared = molar::exec::StringPool::shared();
+    std::cout << (variables[slot] == molar::exec::MolangValue{shared.intern("a")}) << " "
+              << (variables[slot] == molar::exec::MolangValue{shared.intern("b")}) << std::endl;
+}
+
+void draw_per_program() {
+    const auto draw = [](const std::string_view source) {
+        auto program = molar::exec::MolangProgram::compile(source);
+
+        std::vector<molar::exec::MolangValue> variables(program.get_variable_slot_count());
+        molar::exec::ExecutionFrame           frame{.variables = variables, .entity = 7};
+        molar::exec::MolangEvaluator          evaluator{program};
+        return evaluator.evaluate(frame).as_number();
+    };
+
+    // Both programs draw at call site 0 for the same entity, the draws have to differ
+    std::cout << draw("math.random(0, 1)") << " " << draw("v.x = 1; math.random(0, 1)")
+              << std::endl;
+
+    // The pipeline keys its programs the same way, expected: 1
+    std::vector<molar::exec::PassRecord> records{};
+    const auto piped = molar::exec::PassManager::for_level(molar::exec::OptimizationLevel::O2)
+                           .compile("math.random(0, 1)", records);
+    std::cout << (piped.get_program_id() ==
+                  molar::exec::MolangProgram::compile("math.random(0, 1)").get_program_id())
+              << std::endl;
+}
+
+void evaluate_static_program() {
+    constexpr auto& program = molar::exec::static_program<"v.speed = 4; return v.speed * 2;">;
+
+    std::array<molar::exec::MolangValue, program.variable_names.size()> variables{};
+    molar::exec::ExecutionFrame frame{.variables = variables};
+
+    std::cout << program(frame).as_number() << std::endl;
+}
+
+void evaluate_static_return() {
+    constexpr auto& program =
+        molar::exec::static_program<"v.a = 1; v.a > 0 ? return 5; return 0;">;
+
+    std::array<molar::exec::MolangValue, program.variable_names.size()> variables{};
+    molar::exec::ExecutionFrame frame{.variables = variables};
+
+    // Expected: 5
+    std::cout << program(frame).as_number() << std::endl;
+}
+
+void evaluate_static_temps() {
+    constexpr auto& program = molar::exec::static_program<"t.x = t.x + 1; return t.x;">;
+
+    std::array<molar::exec::MolangValue, program.temp_names.size()> temps{};
+    molar::exec::ExecutionFrame frame{.temps = temps};
+
+    // Temps start over on every call, expected: 1 1
+    std::cout << program(frame).as_number() << " ";
+    std::cout << program(frame).as_number() << std::endl;
+}
+
+void evaluate_jit() {
+    auto program = molar::exec::MolangProgram::compile("v.speed = 4; return v.speed * 2;");
+    molar::exec::jit::JitEvaluator evaluator{program};
+
+    std::vector<molar::exec::MolangValue> variables(program.get_variable_slot_count());
+    molar::exec::ExecutionFrame           frame{.variables = variables};
+
+    std::cout << evaluator.evaluate(frame).as_number()
+              << (evaluator.is_native() ? " (native)" : " (interpreted)") << std::endl;
+}
+
+void evaluate_jit_throwing_query() {
+    auto program = molar::exec::MolangProgram::compile("v.hit = 1; q.health * 2");
+    molar::exec::jit::JitEvaluator evaluator{program};
+
+    struct Throwing final : molar::exec::QueryHandler {
+        molar::exec::MolangValue
+        query(const uint32_t, std::span<const molar::exec::MolangValue>) override {
+            throw std::runtime_error("no health");
+        }
+    };
+
+    std::vector<molar::exec::MolangValue> variables(program.get_variable_slot_count());
+    Throwing                              queries{};
+    molar::exec::ExecutionFrame frame{.variables = variables, .queries = &queries};
+
+    // Expected: no health
+    try {
+        evaluator.evaluate(frame);
+    } catch (const std::runtime_error& error) {
+        std::cout << error.what() << std::endl;
+    }
+}
+
+void evaluate_tiered() {
+    molar::exec::ExecutionManager manager{100};
+    auto& program =
+        manager.add(molar::exec::MolangProgram::compile("v.speed = 4; v.speed * 2"));
+
+    std::vector<molar::exec::MolangValue> variables(
+        program.get_program().get_variable_slot_count()
+    );
+    molar::exec::ExecutionFrame frame{.variables = variables};
+    for (int i = 0; i < 1000; i++) {
+        program.evaluate(frame);
+    }
+    manager.wait_for_promotions();
+
+    std::cout << program.evaluate(frame).as_number()
+              << (program.get_tier() == molar::exec::ExecutionTier::Native ? " (native)"
+                                                                            : " (interpreted)")
+              << std::endl;
+}
+
+void infer_types() {
+    auto program = molar::exec::MolangProgram::compile("math.sin(q.anim_time * 38) * 2");
+
+    molar::exec::TypeSignatures signatures{};
+    signatures.queries.emplace("anim_time", molar::exec::ValueKind::Number);
+
+    const auto types = molar::exec::TypeInference::infer(program, signatures);
+    std::cout << "float only: " << types.is_float_only() << std::endl;
+}
+
+void fold_coalesce() {
+    auto program = molar::exec::MolangProgram::compile("t.x = 1; v.y = t.x ?? 5; v.y ?? 2");
+
+    const auto info   = molar::exec::DefiniteAssignment::analyze(program);
+    const auto folded = molar::exec::DefiniteAssignment::fold_coalesce(program, info);
+    std::cout << "folded: " << folded << std::endl;
+}
+
+void optimize_loops() {
+    auto program =
+        molar::exec::MolangProgram::compile("loop(700 * 1.1, {v.q + math.sin(q.pos);});");
+
+    molar::exec::LoopOptions options{};
+    options.pure_queries.emplace("pos");
+
+    const auto stats = molar::exec::LoopOptimizer::optimize(program, options);
+    std::cout << "hoisted: " << stats.hoisted << ", unrolled: " << stats.unrolled << std::endl;
+    for (const auto& expression : program.get_expressions()) {
+        expression->print(std::cout, 0);
+        std::cout << std::endl;
+    }
+}
+
+void convert_branches() {
+    auto program = molar::exec::MolangProgram::compile(
+        "v.speed = q.is_moving && v.x > 2 ? math.abs(v.x) : 0; return v.speed;"
+    );
+
+    molar::exec::IfConversionOptions options{};
+    options.pure_queries.emplace("is_moving");
+
+    std::cout << "selects: " << molar::exec::IfConversion::convert(program, options)
+              << std::endl;
+    molar::exec::jit::JitEvaluator evaluator{program};
+
+    std::vector<molar::exec::MolangValue> variables(program.get_variable_slot_count());
+    variables[*program.find_variable_slot(molar::ast::VariableDeclarationType::Var, "x")] =
+        -3.0f;
+    molar::exec::ExecutionFrame frame{.variables = variables};
+    std::cout << evaluator.evaluate(frame).as_number() << std::endl;
+}
+
+void specialize_variant() {
+    auto program = molar::exec::MolangProgram::compile(
+        "q.is_baby ? 0.5 : (q.variant == 2 ? v.size * 1.2 : v.size)"
+    );
+
+    molar::exec::SpecializationConstants constants{};
+    constants.queries.emplace(*program.find_query("is_baby"), false);
+    constants.queries.emplace(*program.find_query("variant"), 2.0f);
+
+    molar::exec::SpecializationCache cache{};
+    for (const auto& expression : cache.get(program, constants).get_expressions()) {
+        expression->print(std::cout, 0);
+        std::cout << std::endl;
+    }
+
+    // A NaN constant has to find its own variant again, expected: 2
+    constants.queries[*program.find_query("variant")] =
+        std::numeric_limits<float>::quiet_NaN();
+    cache.get(program, constants);
+    cache.get(program, constants);
+    std::cout << cache.get_variant_count() << std::endl;
+}
+
+void split_stages() {
+    auto program = molar::exec::MolangProgram::compile(
+        "v.bob = math.sin(q.life_time * 20) * math.sqrt(q.scale * 2);"
+    );
+
+    molar::exec::StageOptions options{};
+    options.stable_queries.emplace("scale");
+
+    auto staged = molar::exec::StageSplitter::split(program, options);
+    std::cout << "hoisted: " << staged.hoisted << std::endl;
+
+    std::vector<molar::exec::MolangValue> variables(program.get_variable_slot_count());
+    molar::exec::ExecutionFrame           frame{.variables = variables};
+    molar::exec::MolangEvaluator{staged.init}.evaluate(frame);
+    std::cout << molar::exec::MolangEvaluator{program}.evaluate(frame).as_number() << std::endl;
+}
+
+void split_emitter() {
+    auto program = molar::exec::MolangProgram::compile(
+        "return math.sin(q.anim_time * 90 + v.emitter_phase) * v.particle_age;"
+    );
+
+    molar::exec::UniformityOptions options{};
+    options.uniform_queries.emplace("anim_time");
+
+    auto stage = molar::exec::UniformSplitter::split(program, options);
+    std::cout << "broadcast slots: " << stage.slots.size() << std::endl;
+
+    struct AnimTime final : molar::exec::QueryHandler {
+        molar::exec::MolangValue
+        query(uint32_t, std::span<const molar::exec::MolangValue>) override {
+            return 0.5f;
+        }
+    } queries{};
+
+    const auto phase = program.find_variable_slot(
+        molar::ast::VariableDeclarationType::Var, "emitter_phase"
+    );
+    const auto age =
+        program.find_variable_slot(molar::ast::VariableDeclarationType::Var, "particle_age");
+
+    std::vector<molar::exec::MolangValue> emitter(program.get_variable_slot_count());
+    emitter[*phase] = 10.0f;
+    molar::exec::ExecutionFrame frame{.variables = emitter, .queries = &queries};
+    molar::exec::MolangEvaluator{stage.emitter}.evaluate(frame);
+
+    molar::exec::MolangEvaluator evaluator{program};
+    for (const float particle_age : {1.0f, 2.0f, 3.0f}) {
+        auto particle  = emitter;
+        particle[*age]         = particle_age;
+        stage.broadcast(emitter, particle);
+        frame.variables = particle;
+        std::cout << evaluator.evaluate(frame).as_number() << std::endl;
+    }
+}
+
+void split_emitter_break() {
+    auto program = molar::exec::MolangProgram::compile(
+        "{ v.particle_age > 1 ? break; t.x = 1; }; return t.x;"
+    );
+
+    // The particles which broke never stored t.x, expected: 0 0
+    const auto info = molar::exec::UniformityAnalysis::analyze(program);
+    const auto slot = program.find_variable_slot(molar::ast::VariableDeclarationType::Temp, "x");
+    auto&      last = molar::details::type_asserted_cast<molar::ast::ReturnNode&>(
+        *program.get_expressions().back()
+    );
+    std::cout << info.is_uniform_slot(molar::ast::VariableDeclarationType::Temp, *slot) << " "
+              << info.is_uniform(*last.get_value()) << std::endl;
+}
+
+void evaluate_particles() {
+    auto program = molar::exec::MolangProgram::compile(
+        "v.particle_age = (v.particle_age ?? 0) + v.emitter_delta;"
+        "v.particle_size = 0.5 + math.random(0, 0.5) * v.particle_age;"
+    );
+
+    const auto columns = molar::exec::ParticlePool::columns_for(
+        program, "particle_", molar::exec::ColumnFormat::Float16
+    );
+    molar::exec::ParticlePool pool{columns};
+    for (int i = 0; i < 100000; i++) {
+        pool.spawn();
+    }
+
+    std::vector<molar::exec::MolangValue> variables(program.get_variable_slot_count());
+    variables[*program.find_variable_slot(
+        molar::ast::VariableDeclarationType::Var, "emitter_delta"
+    )] = 0.05f;
+    molar::exec::ExecutionFrame frame{.variables = variables};
+
+    molar::exec::MolangEvaluator evaluator{program};
+    for (int tick = 0; tick < 3; tick++) {
+        pool.evaluate(evaluator, frame);
+    }
+    // Kill every other particle, the rest are compacted to the front
+    pool.kill_if([&](const size_t index) { return pool.get_id(index) % 2 == 0; });
+    std::cout << "particles: " << pool.size() << ", age "
+              << pool.get(0, 0).as_number() << std::endl;
+}
+
+void evaluate_particle_blocks() {
+    auto program = molar::exec::MolangProgram::compile(
+        "t.age = (v.particle_age ?? 0) + v.emitter_delta;"
+        "v.particle_age = t.age;"
+        "t.jitter = math.random(0, 0.5);"
+        "v.particle_size = t.age > 0.1 ? math.sin(t.age * 90) : 0.5 + t.jitter;"
+        "return v.particle_size * 2;"
+    );
+    molar::exec::ParticleKernel kernel{program};
+
+    // The same particles once through the kernel and once through the evaluator, 1000 isn't
+    // a multiple of the block size so the last block is partial
+    const auto columns = molar::exec::ParticlePool::columns_for(
+        program, "particle_", molar::exec::ColumnFormat::Float16
+    );
+    molar::exec::ParticlePool blocks{columns};
+    molar::exec::ParticlePool particles{columns};
+    for (int i = 0; i < 1000; i++) {
+        blocks.spawn();
+        particles.spawn();
+    }
+
+    std::vector<molar::exec::MolangValue> variables(program.get_variable_slot_count());
+    std::vector<molar::exec::MolangValue> temps(program.get_temp_slot_count());
+    variables[*program.find_variable_slot(
+        molar::ast::VariableDeclarationType::Var, "emitter_delta"
+    )] = 0.05f;
+    molar::exec::ExecutionFrame frame{.variables = variables, .temps = temps};
+
+    molar::exec::MolangEvaluator evaluator{program};
+    std::vector<float>           block_results(1000);
+    std::vector<float>           particle_results(1000);
+    for (int tick = 0; tick < 3; tick++) {
+        blocks.evaluate(kernel, frame, block_results);
+        particles.evaluate(evaluator, frame, particle_results);
+    }
+
+    bool equal = block_results == particle_results;
+    for (size_t column = 0; column < columns.size(); column++) {
+        for (size_t i = 0; i < blocks.size(); i++) {
+            equal = equal && blocks.get(column, i) == particles.get(column, i);
+        }
+    }
+    // Queries run one particle at a time
+    auto queries = molar::exec::MolangProgram::compile("v.particle_age = q.life_time;");
+    molar::exec::ParticleKernel fallback{queries};
+
+    // Expected: columnar 1, equal 1, query columnar 0
+    std::cout << "columnar " << kernel.is_columnar() << ", equal " << equal
+              << ", query columnar " << fallback.is_columnar() << std::endl;
+}
+
+#ifdef MOLAR_TEST_AOT
+void aot_matches_evaluator() {
+    struct Health final : molar::exec::QueryHandler {
+        molar::exec::MolangValue
+        query(uint32_t, std::span<const molar::exec::MolangValue>) override {
+            return 20.0f;
+        }
+    };
+    Health queries{};
+
+    bool equal = true;
+    for (const auto& aot : molar_test_aot::programs()) {
+        auto program = molar::exec::MolangProgram::compile(
+            aot.source, molar::exec::StringPool::shared(), aot.precision
+        );
+        molar::exec::MolangEvaluator evaluator{program};
+        const auto input =
+            program.find_variable_slot(molar::ast::VariableDeclarationType::Var, "input");
+
+        for (const float value : {-2.0f, 0.0f, 0.5f, 1.5f, 3.0f}) {
+            std::vector<molar::exec::MolangValue> variables(program.get_variable_slot_count());
+            std::vector<molar::exec::MolangValue> temps(program.get_temp_slot_count());
+            if (input) {
+                variables[*input] = value;
+            }
+            auto aot_variables = variables;
+            auto aot_temps     = temps;
+
+            molar::exec::ExecutionFrame frame{
+                .variables = variables, .temps = temps, .queries = &queries, .entity = 7
+            };
+            molar::exec::ExecutionFrame aot_frame{
+                .variables = aot_variables, .temps = aot_temps, .queries = &queries, .entity = 7
+            };
+            const auto expected = evaluator.evaluate(frame);
+            const auto actual   = aot.function(aot_frame);
+            if (expected != actual || variables != aot_variables) {
+                std::cout << "aot mismatch: " << aot.source << " for " << value << std::endl;
+                equal = false;
+            }
+        }
+    }
+    // Expected: aot programs 7, equal 1
+    std::cout << "aot programs " << molar_test_aot::programs().size() << ", equal " << equal
+              << std::endl;
+}
+#endif
+
+void emit_twice() {
+    constexpr auto source = "t.i = 0; loop(3, { t.i = t.i + 1; }); return t.i == 3 ? 'a' : 'b';";
+    auto           program = molar::exec::MolangProgram::compile(source);
+
+    // A reused emitter starts from scratch, temporaries and strings are numbered the same
+    molar::exec::aot::CppEmitter emitter{program};
+    const auto                   first  = emitter.emit("count", source);
+    const auto                   second = emitter.emit("count", source);
+
+    // Expected: 1
+    std::cout << (first == second) << std::endl;
+}
+
+void evaluate_transitions() {
+    const std::array<std::string_view, 3> conditions{
+        "q.is_on_ground && q.modified_move_speed > 0.8",
+        "q.is_on_ground && q.modified_move_speed > 0.1",
+        "!q.is_on_ground",
+    };
+
+    molar::exec::TransitionOptions options{};
+    options.pure_queries = {"is_on_ground", "modified_move_speed"};
+    auto state = molar::exec::TransitionProgram::compile(conditions, options);
+    std::cout << "shared: " << state.get_shared_count() << std::endl;
+
+    struct Movement final : molar::exec::QueryHandler {
+        const molar::exec::MolangProgram* program{};
+        float                             speed{};
+
+        molar::exec::MolangValue
+        query(const uint32_t call_id, std::span<const molar::exec::MolangValue>) override {
+            if (call_id == program->find_query("modified_move_speed")) {
+                return speed;
+            }
+            return true;
+        }
+    };
+
+    auto&                                 program = state.get_program();
+    std::vector<molar::exec::MolangValue> temps(program.get_temp_slot_count());
+    std::array<Movement, 3>               entities{};
+    std::vector<molar::exec::ExecutionFrame> frames{};
+    for (size_t i = 0; i < entities.size(); i++) {
+        entities[i].program = &program;
+        entities[i].speed   = static_cast<float>(i) * 0.5f;
+        frames.push_back(molar::exec::ExecutionFrame{.temps = temps, .queries = &entities[i]});
+    }
+
+    std::vector<molar::exec::TransitionHit> hits{};
+    state.evaluate_batch(frames, hits);
+    for (const auto& hit : hits) {
+        std::println("entity {} takes transition {}", hit.entity, hit.transition);
+    }
+}
+
+void evaluate_channels() {
+    const std::array<std::string_view, 3> channels{
+        "math.sin(q.anim_time * 360) * 30",
+        "math.cos(q.anim_time * 360) * 30",
+        "math.sin(q.anim_time * 360) * -15",
+    };
+
+    molar::exec::ChannelOptions options{};
+    options.pure_queries.emplace("anim_time");
+    auto animation = molar::exec::ChannelProgram::compile(channels, options);
+    std::cout << "shared: " << animation.get_shared_count() << std::endl;
+
+    struct AnimTime final : molar::exec::QueryHandler {
+        molar::exec::MolangValue
+        query(uint32_t, std::span<const molar::exec::MolangValue>) override {
+            return 0.125f;
+        }
+    } queries{};
+
+    auto& program = animation.get_program();
+    std::vector<molar::exec::MolangValue> variables(program.get_variable_slot_count());
+    std::vector<molar::exec::MolangValue> temps(program.get_temp_slot_count());
+    molar::exec::ExecutionFrame frame{
+        .variables = variables, .temps = temps, .queries = &queries
+    };
+
+    std::array<float, channels.size()> outputs{};
+    animation.evaluate(frame, outputs);
+    std::println("{} {} {}", outputs[0], outputs[1], outputs[2]);
+}
+
+void run_pipeline() {
+    molar::exec::PipelineOptions options{};
+    options.pure_queries.emplace("anim_time");
+
+    for (const auto level :
+         {molar::exec::OptimizationLevel::O0, molar::exec::OptimizationLevel::O2}) {
+        const auto manager = molar::exec::PassManager::for_level(level, options);
+
+        std::vector<molar::exec::PassRecord> records{};
+        manager.compile(
+            "t.a = math.sin(q.anim_time * (180 + 180)); t.a > 0.5 ? t.a * 2 : t.a / 2", records
+        );
+        for (const auto& record : records) {
+            std::println(
+                "{:>14} {:>8} {:>3} -> {:<3} {}", record.name, record.time, record.nodes_before,
+                record.nodes_after, record.changes
+            );
+        }
+    }
+}
+
+void rewrite_rules() {
+    using molar::exec::Term;
+    const auto a = Term::capture("a");
+    const auto b = Term::capture("b");
+
+    // Only holds without NaN, which is why it isn't one of the standard rules
+    auto rules = molar::exec::RewriteEngine::standard();
+    rules.add(!(a < b), a >= b);
+
+    auto program = molar::exec::MolangProgram::compile(
+        "t.x = math.pow(v.speed, 2) / 2; t.y = !(t.x < 4); t.y ? t.x : v.speed - -1"
+    );
+    std::cout << "rules: " << rules.get_rule_count() << ", rewrites: " << rules.rewrite(program)
+              << std::endl;
+
+    std::vector<molar::exec::MolangValue> variables(program.get_variable_slot_count());
+    std::vector<molar::exec::MolangValue> temps(program.get_temp_slot_count());
+    variables[*program.find_variable_slot(molar::ast::VariableDeclarationType::Var, "speed")] =
+        3.0f;
+    molar::exec::ExecutionFrame  frame{.variables = variables, .temps = temps};
+    molar::exec::MolangEvaluator evaluator{program};
+    std::cout << evaluator.evaluate(frame).as_number() << std::endl;
+}
+
+void eliminate_dead_code() {
+    auto program = molar::exec::MolangProgram::compile(
+        "t.unused = v.speed * 2; t.x = 1; t.x = v.speed; "
+        "loop(4, { v.count = v.count + t.x; break; v.count = 0; }); "
+        "return v.count; v.count = -1;"
+    );
+    const auto stats = molar::exec::DeadCodeElimination::eliminate(program);
+    std::cout << "unreachable: " << stats.unreachable << ", dead stores: " << stats.dead_stores
+              << ", removed nodes: " << stats.removed_nodes << std::endl;
+
+    std::vector<molar::exec::MolangValue> variables(program.get_variable_slot_count());
+    std::vector<molar::exec::MolangValue> temps(program.get_temp_slot_count());
+    variables[*program.find_variable_slot(molar::ast::VariableDeclarationType::Var, "speed")] =
+        3.0f;
+    molar::exec::ExecutionFrame  frame{.variables = variables, .temps = temps};
+    molar::exec::MolangEvaluator evaluator{program};
+    std::cout << evaluator.evaluate(frame).as_number() << std::endl;
+}
+
+void eliminate_store_before_jump() {
+    auto program = molar::exec::MolangProgram::compile(
+        "loop(3, { t.b = 1; t.a = v.c ? break : 2; t.b = 3; }); return t.b;"
+    );
+    molar::exec::DeadCodeElimination::eliminate(program);
+
+    std::vector<molar::exec::MolangValue> variables(program.get_variable_slot_count());
+    std::vector<molar::exec::MolangValue> temps(program.get_temp_slot_count());
+    variables[*program.find_variable_slot(molar::ast::VariableDeclarationType::Var, "c")] =
+        1.0f;
+    molar::exec::ExecutionFrame  frame{.variables = variables, .temps = temps};
+    molar::exec::MolangEvaluator evaluator{program};
+    // Expected: 1
+    std::cout << evaluator.evaluate(frame).as_number() << std::endl;
+}
+
+void fuse_superinstructions() {
+    auto program = molar::exec::MolangProgram::compile(
+        "t.s = math.clamp(math.sqrt(v.speed * 2 + 1), 0, 2); "
+        "q.is_moving > 0 ? t.s * 2 : -v.speed"
+    );
+
+    struct Moving final : molar::exec::QueryHandler {
+        molar::exec::MolangValue
+        query(const uint32_t, std::span<const molar::exec::MolangValue>) override {
+            return true;
+        }
+    };
+
+    std::vector<molar::exec::MolangValue> variables(program.get_variable_slot_count());
+    std::vector<molar::exec::MolangValue> temps(program.get_temp_slot_count());
+    variables[*program.find_variable_slot(molar::ast::VariableDeclarationType::Var, "speed")] =
+        4.0f;
+    Moving                      queries{};
+    molar::exec::ExecutionFrame frame{.variables = variables, .temps = temps, .queries = &queries};
+
+    molar::exec::DispatchProfile profile{};
+    {
+        molar::exec::MolangEvaluator evaluator{program};
+        evaluator.set_profile(&profile);
+        std::cout << evaluator.evaluate(frame).as_number() << std::endl;
+    }
+
+    molar::exec::PatternProfile patterns{};
+    patterns.add(program, profile);
+    for (const auto& candidate : patterns.ranked(3)) {
+        std::cout << candidate.saved << " " << candidate.pattern << std::endl;
+    }
+
+    const auto fused  = molar::exec::Superinstructions::fuse(program);
+    const auto before = profile.get_dispatches();
+    profile.clear();
+
+    molar::exec::MolangEvaluator evaluator{program};
+    evaluator.set_profile(&profile);
+    std::cout << evaluator.evaluate(frame).as_number() << std::endl;
+    std::cout << "fused: " << fused << ", dispatches: " << before << " -> "
+              << profile.get_dispatches() << std::endl;
+}
+
+void reduce_large_angles() {
+    // Expected: -0.99939 0.866025 0.469472
+    for (const auto degrees : {1e20f, 1e30f, 3e38f}) {
+        std::cout << molar::exec::math::kernels::sin(degrees) << " ";
+    }
+    std::cout << std::endl;
+}
+
+void exact_special_inputs() {
+    namespace kernels  = molar::exec::math::kernels;
+    constexpr auto nan = std::numeric_limits<float>::quiet_NaN();
+    constexpr auto inf = std::numeric_limits<float>::infinity();
+
+    molar::exec::math::RandomStream stream{};
+    // Expected: nan nan 0 0 1024
+    std::cout << kernels::sin(inf) << " " << kernels::cos(nan) << " "
+              << kernels::die_roll(nan, 1, 1, stream) << " "
+              << kernels::die_roll_integer(-inf, 1, 1, stream) << " "
+              << kernels::die_roll_integer(1e30f, 1, 1, stream) << std::endl;
+}
+
+void wide_matches_scalar() {
+    using namespace molar::exec::math;
+    constexpr auto nan = std::numeric_limits<float>::quiet_NaN();
+
+    // The 1e20 and NaN lanes take the scalar fallback of the lane sin and cos
+    FloatLanes8 degrees{{-360.0f, 30.0f, 1e20f, nan, 540.0f, -45.5f, 0.25f, -2.5f}};
+    RandomLanes<8> streams{};
+    RandomStream   stream{};
+
+    // Expected: 1 1 1 1
+    for (const auto function : {MathFunction::Sin, MathFunction::Cos, MathFunction::Floor,
+                                MathFunction::Round}) {
+        const auto& info  = get_math_function(function);
+        const auto  wide  = info.wide_8(&degrees, streams);
+        bool        equal = true;
+        for (size_t i = 0; i < 8; i++) {
+            const float scalar = info.scalar(&degrees[i], stream);
+            equal = equal && std::bit_cast<uint32_t>(scalar) == std::bit_cast<uint32_t>(wide[i]);
+        }
+        std::cout << equal << " ";
+    }
+    std::cout << std::endl;
+}
+
+void fast_special_inputs() {
+    namespace fast = molar::exec::math::fast_kernels;
+    constexpr auto nan = std::numeric_limits<float>::quiet_NaN();
+
+    constexpr auto inf = std::numeric_limits<float>::infinity();
+
+    // Expected: nan nan nan
+    std::cout << fast::sin(nan) << " " << fast::cos(inf) << " " << fast::sin(-inf)
+              << std::endl;
+}
+
+int main() {
+    reduce_large_angles();
+    exact_special_inputs();
+    wide_matches_scalar();
+    fast_special_inputs();
+    execution_tree_builder();
+    evaluate_for_each();
+    load_program_binary();
+    load_cached_program();
+    compare_across_pools();
+    draw_per_program();
+    evaluate_static_program();
+    evaluate_static_return();
+    evaluate_static_temps();
+    evaluate_jit();
+    evaluate_jit_throwing_query();
+    evaluate_tiered();
+    infer_types();
+    fold_coalesce();
+    optimize_loops();
+    convert_branches();
+    specialize_variant();
+    split_stages();
+    split_emitter();
+    split_emitter_break();
+    evaluate_particles();
+    evaluate_particle_blocks();
+#ifdef MOLAR_TEST_AOT
+    aot_matches_evaluator();
+#endif
+    emit_twice();
+    evaluate_transitions();
+    evaluate_channels();
+    run_pipeline();
+    rewrite_rules();
+    eliminate_dead_code();
+    eliminate_store_before_jump();
+    fuse_superinstructions();
+}